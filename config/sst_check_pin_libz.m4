@@ -0,0 +1,34 @@
+AC_DEFUN([SST_CHECK_PIN_LIBZ],
+[
+  sst_check_pin_libz_happy="no"
+
+  AC_ARG_WITH([pin-libz],
+    [AS_HELP_STRING([--with-pin-libz@<:@=DIR@:>@],
+      [Use a libz built against the Pin CRT found in DIR for compressed Pin tool traces])])
+
+dnl The Pin tools link against the Pin CRT with -nostdlib, a libz built for the
+dnl host C library cannot be linked into them, so this is never picked up
+dnl from the system and the library cannot be link tested with the host compiler.
+  AS_IF([test ! -z "$with_pin_libz" -a "$with_pin_libz" != "no" -a "$with_pin_libz" != "yes"],
+    [AS_IF([test -f "$with_pin_libz/include/zlib.h" -a \( -f "$with_pin_libz/lib/libz.a" -o -f "$with_pin_libz/lib/libz.so" \)],
+      [sst_check_pin_libz_happy="yes"
+       PIN_LIBZ_CPPFLAGS="-I$with_pin_libz/include"
+       PIN_LIBZ_LDFLAGS="-L$with_pin_libz/lib"
+       PIN_LIBZ_LIB="-lz"])])
+
+  AS_IF([test "$sst_check_pin_libz_happy" = "no"],
+    [PIN_LIBZ_CPPFLAGS=
+     PIN_LIBZ_LDFLAGS=
+     PIN_LIBZ_LIB=])
+
+  AC_SUBST([PIN_LIBZ_CPPFLAGS])
+  AC_SUBST([PIN_LIBZ_LDFLAGS])
+  AC_SUBST([PIN_LIBZ_LIB])
+  AS_IF([test "x$sst_check_pin_libz_happy" = "xyes"], [AC_DEFINE([HAVE_PIN_LIBZ],[1],[Defines whether we have a libz built against the Pin CRT])])
+  AM_CONDITIONAL([USE_PIN_LIBZ], [test "x$sst_check_pin_libz_happy" = "xyes"])
+
+  AC_MSG_CHECKING([for libz built against the Pin CRT])
+  AC_MSG_RESULT([$sst_check_pin_libz_happy])
+  AS_IF([test "$sst_check_pin_libz_happy" = "no" -a ! -z "$with_pin_libz" -a "$with_pin_libz" != "no"], [$3])
+  AS_IF([test "$sst_check_pin_libz_happy" = "yes"], [$1], [$2])
+])
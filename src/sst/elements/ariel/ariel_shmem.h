@@ -45,6 +45,20 @@
 
 #define ARIEL_MAX_PAYLOAD_SIZE 64
 
+/*
+ * Space for packed records in an ARIEL_PERFORM_BATCH command, chosen so that
+ * the batch fits in the same space as the inst payload and ArielCommand does
+ * not grow. The largest record (write with a full payload) is 80 bytes.
+ */
+#define ARIEL_BATCH_PAYLOAD_SIZE 84
+
+/*
+ * A core that finds its buffer empty raises a flush request so the writer does
+ * not hold back a partly filled batch while the core has nothing to do. Cores
+ * beyond the number of slots share a slot, which only costs an early flush.
+ */
+#define ARIEL_FLUSH_REQUEST_SLOTS 64
+
 namespace SST {
 namespace ArielComponent {
 
@@ -68,6 +82,32 @@ enum ArielShmemCmd_t {
     ARIEL_ISSUE_RTL = 150,
     ARIEL_FLUSHLINE_INSTRUCTION = 154,
     ARIEL_FENCE_INSTRUCTION = 155,
+    ARIEL_PERFORM_BATCH = 160,
+    ARIEL_SAMPLE_PHASE = 170,
+};
+
+/*
+ * Phases of a sampled run. In fast-forward the frontend runs the application
+ * uninstrumented and sends nothing, in detailed windows it sends every
+ * operation as usual. ARIEL_SAMPLE_PHASE reports the end of a phase.
+ */
+enum ArielSamplePhase_t {
+    ARIEL_SAMPLE_DETAILED = 0,
+    ARIEL_SAMPLE_FAST_FORWARD = 1,
+};
+
+/*
+ * Records packed into an ARIEL_PERFORM_BATCH command. Each record starts with
+ * one byte holding the record type in the low two bits and, for accesses, the
+ * access size in the upper six bits (0 means the size follows as a varint).
+ * Access addresses are zigzag varint deltas from the previous access in the
+ * same batch so that strided streams take one or two bytes per address.
+ */
+enum ArielBatchRecord_t {
+    ARIEL_BATCH_READ = 0,
+    ARIEL_BATCH_WRITE = 1,
+    ARIEL_BATCH_WRITE_PAYLOAD = 2,
+    ARIEL_BATCH_START_INSTRUCTION = 3,
 };
 
 #ifdef HAVE_CUDA
@@ -175,6 +215,16 @@ struct ArielCommand {
         struct {
             uint64_t vaddr;
         } flushline;
+        struct {
+            uint16_t count;
+            uint16_t length;
+            uint8_t  data[ARIEL_BATCH_PAYLOAD_SIZE];
+        } batch;
+        struct {
+            uint64_t instructions;
+            uint32_t endedPhase;
+            uint32_t nextPhase;
+        } sample;
         struct {
             void* inp_ptr;
             void* ctrl_ptr;
@@ -193,12 +243,167 @@ struct ArielCommand {
     };
 };
 
+/*
+ * Packs memory operations of one thread into ARIEL_PERFORM_BATCH commands
+ */
+class ArielBatchEncoder {
+public:
+    ArielBatchEncoder() { reset(); }
+
+    void reset() {
+        cmd.command = ARIEL_PERFORM_BATCH;
+        cmd.instPtr = 0;
+        cmd.batch.count = 0;
+        cmd.batch.length = 0;
+        lastAddr = 0;
+    }
+
+    bool empty() const { return 0 == cmd.batch.count; }
+
+    const ArielCommand& getCommand() const { return cmd; }
+
+    /* Returns false if the record does not fit, the caller must write out the batch and retry */
+    bool addAccess(bool isWrite, uint64_t addr, uint32_t size, const uint8_t* payload) {
+        const uint32_t payloadLength = (isWrite && NULL != payload) ?
+            (size < ARIEL_MAX_PAYLOAD_SIZE ? size : ARIEL_MAX_PAYLOAD_SIZE) : 0;
+
+        /* header + size + address + payload, assuming worst-case varints */
+        if ( cmd.batch.length + 1 + 5 + 10 + payloadLength > ARIEL_BATCH_PAYLOAD_SIZE ) {
+            return false;
+        }
+
+        uint8_t type = isWrite ? (payloadLength > 0 ? ARIEL_BATCH_WRITE_PAYLOAD : ARIEL_BATCH_WRITE) : ARIEL_BATCH_READ;
+        const bool smallSize = size > 0 && size < 64;
+
+        cmd.batch.data[cmd.batch.length++] = (uint8_t) (type | (smallSize ? (size << 2) : 0));
+
+        if ( ! smallSize ) {
+            putVarint(size);
+        }
+
+        const int64_t delta = (int64_t) (addr - lastAddr);
+        putVarint((((uint64_t) delta) << 1) ^ (uint64_t) (delta >> 63));
+        lastAddr = addr;
+
+        for ( uint32_t i = 0; i < payloadLength; i++ ) {
+            cmd.batch.data[cmd.batch.length++] = payload[i];
+        }
+
+        cmd.batch.count++;
+        return true;
+    }
+
+    bool addInstructionStart(uint32_t instClass, uint32_t simdElemCount) {
+        if ( cmd.batch.length + 1 + 5 + 5 > ARIEL_BATCH_PAYLOAD_SIZE ) {
+            return false;
+        }
+
+        cmd.batch.data[cmd.batch.length++] = ARIEL_BATCH_START_INSTRUCTION;
+        putVarint(instClass);
+        putVarint(simdElemCount);
+
+        cmd.batch.count++;
+        return true;
+    }
+
+private:
+    void putVarint(uint64_t value) {
+        while ( value >= 0x80 ) {
+            cmd.batch.data[cmd.batch.length++] = (uint8_t) (value | 0x80);
+            value >>= 7;
+        }
+        cmd.batch.data[cmd.batch.length++] = (uint8_t) value;
+    }
+
+    ArielCommand cmd;
+    uint64_t lastAddr;
+};
+
+struct ArielBatchRecord {
+    ArielBatchRecord_t type;
+    uint64_t addr;
+    uint32_t size;
+    uint32_t instClass;
+    uint32_t simdElemCount;
+    uint32_t payloadLength;
+    const uint8_t* payload;
+};
+
+/*
+ * Walks the records of an ARIEL_PERFORM_BATCH command in order
+ */
+class ArielBatchDecoder {
+public:
+    ArielBatchDecoder(const ArielCommand& batchCmd) : cmd(batchCmd), offset(0), lastAddr(0) {}
+
+    bool next(ArielBatchRecord* rec) {
+        if ( offset >= cmd.batch.length ) {
+            return false;
+        }
+
+        const uint8_t header = cmd.batch.data[offset++];
+        rec->type = (ArielBatchRecord_t) (header & 0x3);
+        rec->payloadLength = 0;
+        rec->payload = NULL;
+
+        if ( ARIEL_BATCH_START_INSTRUCTION == rec->type ) {
+            rec->instClass = (uint32_t) getVarint();
+            rec->simdElemCount = (uint32_t) getVarint();
+            rec->addr = 0;
+            rec->size = 0;
+            return true;
+        }
+
+        rec->size = header >> 2;
+        if ( 0 == rec->size ) {
+            rec->size = (uint32_t) getVarint();
+        }
+
+        const uint64_t zigzag = getVarint();
+        lastAddr += (uint64_t) ((int64_t) (zigzag >> 1) ^ -((int64_t) (zigzag & 1)));
+        rec->addr = lastAddr;
+
+        if ( ARIEL_BATCH_WRITE_PAYLOAD == rec->type ) {
+            rec->payloadLength = rec->size < ARIEL_MAX_PAYLOAD_SIZE ? rec->size : ARIEL_MAX_PAYLOAD_SIZE;
+            rec->payload = &cmd.batch.data[offset];
+            offset += rec->payloadLength;
+        }
+
+        return true;
+    }
+
+private:
+    uint64_t getVarint() {
+        uint64_t value = 0;
+        int shift = 0;
+        uint8_t next;
+
+        do {
+            next = cmd.batch.data[offset++];
+            value |= ((uint64_t) (next & 0x7f)) << shift;
+            shift += 7;
+        } while ( next & 0x80 );
+
+        return value;
+    }
+
+    const ArielCommand& cmd;
+    uint32_t offset;
+    uint64_t lastAddr;
+};
+
+struct ArielFlushRequest {
+    volatile uint32_t requested;
+    uint8_t __pad[ 64 - sizeof(uint32_t) ];
+};
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
     uint64_t cycles;
     volatile uint32_t child_attached;
     uint8_t __pad[ 256 - sizeof(uint32_t) - sizeof(size_t) - sizeof(uint64_t) - sizeof(uint64_t)];
+    ArielFlushRequest flushRequest[ARIEL_FLUSH_REQUEST_SLOTS];
 };
 
 class ArielTunnel : public SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>
@@ -208,13 +413,15 @@ public:
      * Create a new Ariel Tunnel
      */
     ArielTunnel(size_t numCores, size_t bufferSize, uint32_t expectedChildren = 1) :
-        SST::Core::Interprocess::TunnelDef<ArielSharedData,ArielCommand>(numCores, bufferSize, expectedChildren) { }
+        SST::Core::Interprocess::TunnelDef<ArielSharedData,ArielCommand>(numCores, bufferSize, expectedChildren),
+        batching(false) { }
 
     /**
      * Attach to an existing Ariel Tunnel (Created in another process)
      */
     ArielTunnel(void* sPtr) :
-        SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>(sPtr) { }
+        SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>(sPtr),
+        batching(false) { }
 
     /**
      * Initialize tunnel
@@ -227,9 +434,13 @@ public:
             sharedData->simTime = 0;
             sharedData->cycles = 0;
             sharedData->child_attached = 0;
+            for ( size_t i = 0; i < ARIEL_FLUSH_REQUEST_SLOTS; i++ ) {
+                sharedData->flushRequest[i].requested = 0;
+            }
         } else {
             /* Ideally, this would be done atomically, but we'll only have 1 child */
             sharedData->child_attached++;
+            batches.resize(getNumBuffers());
         }
         return childnum;
     }
@@ -238,6 +449,64 @@ public:
         while ( sharedData->child_attached == 0 ) ;
     }
 
+    /**
+     * Writer side: pack reads, writes and instruction starts into batch commands
+     * rather than sending one command per operation. Each buffer may only be
+     * written by one thread, which is already the case for the Ariel frontends.
+     * A batch is written out when it is full, before any other command, and as
+     * soon as the reading core has asked for a flush because it ran dry.
+     */
+    void setBatching(bool enable) { batching = enable; }
+    bool isBatching() const { return batching; }
+
+    /** Write a command, any batched operations for the buffer are written out first */
+    void writeCommand(size_t buffer, const ArielCommand& command) {
+        if ( batching ) {
+            flushBatch(buffer);
+        }
+        SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>::writeMessage(buffer, command);
+    }
+
+    void writeAccess(size_t buffer, bool isWrite, uint64_t addr, uint32_t size, const uint8_t* payload) {
+        if ( ! batches[buffer].addAccess(isWrite, addr, size, payload) ) {
+            flushBatch(buffer);
+            batches[buffer].addAccess(isWrite, addr, size, payload);
+        }
+        checkFlushRequest(buffer);
+    }
+
+    void writeInstructionStart(size_t buffer, uint32_t instClass, uint32_t simdElemCount) {
+        if ( ! batches[buffer].addInstructionStart(instClass, simdElemCount) ) {
+            flushBatch(buffer);
+            batches[buffer].addInstructionStart(instClass, simdElemCount);
+        }
+        checkFlushRequest(buffer);
+    }
+
+    void flushBatch(size_t buffer) {
+        if ( ! batches[buffer].empty() ) {
+            SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>::writeMessage(buffer, batches[buffer].getCommand());
+            batches[buffer].reset();
+        }
+    }
+
+    void flushAllBatches() {
+        for ( size_t i = 0; i < batches.size(); i++ ) {
+            flushBatch(i);
+        }
+    }
+
+    /**
+     * Reader side: called by a core that found its buffer empty, the writer
+     * sends its pending batch with the next operation it records
+     */
+    void requestFlush(size_t buffer) {
+        ArielFlushRequest& request = sharedData->flushRequest[buffer % ARIEL_FLUSH_REQUEST_SLOTS];
+        if ( 0 == request.requested ) {
+            request.requested = 1;
+        }
+    }
+
     /** Update the current simulation cycle count in the SharedData region */
     void updateTime(uint64_t newTime) {
         sharedData->simTime = newTime;
@@ -266,6 +535,17 @@ public:
         tp->tv_nsec = cTime - (tp->tv_sec * 1e9);
     }
 
+private:
+    void checkFlushRequest(size_t buffer) {
+        ArielFlushRequest& request = sharedData->flushRequest[buffer % ARIEL_FLUSH_REQUEST_SLOTS];
+        if ( request.requested ) {
+            request.requested = 0;
+            flushBatch(buffer);
+        }
+    }
+
+    bool batching;
+    std::vector<ArielBatchEncoder> batches;
 };
 
 #ifdef HAVE_CUDA
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <exception>
 #include <stdexcept>
+#include <cstring>
 
 #ifdef HAVE_CUDA
 #include <../balar/balar_event.h>
@@ -49,6 +50,10 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     output->verbose(CALL_INFO, 2, 0, "Creating core with ID %" PRIu32 ", maximum queue length=%" PRIu32 ", max issue is: %" PRIu32 "\n", thisCoreID, maxQLen, maxIssuePerCyc);
     inst_count = 0;
     coreID = thisCoreID;
+    sampleFastForward = false;
+    sampleDetailedInsts = 0;
+    sampleFastForwardInsts = 0;
+    sampleDetailedCycles = 0;
     maxPendingTransactions = maxPendTrans;
     isHalted = false;
     isStalled = false;
@@ -104,6 +109,12 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     statFPSPOps = registerStatistic<uint64_t>("fp_sp_ops", subID);
     statFPDPOps = registerStatistic<uint64_t>("fp_dp_ops", subID);
 
+    statSampleWindows = registerStatistic<uint64_t>("sample_windows", subID);
+    statSampleDetailedIns = registerStatistic<uint64_t>("sample_detailed_ins", subID);
+    statSampleFastForwardIns = registerStatistic<uint64_t>("sample_fastforward_ins", subID);
+    statExtrapolatedIns = registerStatistic<uint64_t>("extrapolated_instruction_count", subID);
+    statExtrapolatedCycles = registerStatistic<uint64_t>("extrapolated_cycles", subID);
+
     free(subID);
 
     memmgr->registerInterruptHandler(coreID, new ArielMemoryManager::InterruptHandler<ArielCore>(this, &ArielCore::handleInterrupt));
@@ -125,6 +136,23 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    captureWriter = NULL;
+    captureSkipWarned = false;
+
+    std::string capturePrefix = params.find<std::string>("capturetrace", "");
+    if("" != capturePrefix) {
+        const std::string capturePath = capturePrefix + "-" + std::to_string(coreID) + ".arielcap";
+
+        FILE* captureFile = fopen(capturePath.c_str(), "wb");
+        if(NULL == captureFile) {
+            output->fatal(CALL_INFO, -1, "Error: unable to open capture file %s for core %" PRIu32 "\n", capturePath.c_str(), coreID);
+        }
+
+        const uint64_t captureBlockSize = params.find<uint64_t>("captureblocksize", 1024 * 1024);
+        captureWriter = new ArielTraceCaptureWriter(captureFile, coreID, (size_t) captureBlockSize, writePayloads);
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " capturing its command stream to %s\n", coreID, capturePath.c_str());
+    }
+
     currentCycles = 0;
 }
 
@@ -552,6 +580,27 @@ void ArielCore::finishCore() {
         delete traceGen;
         traceGen = NULL;
     }
+
+    // Flushes the remaining capture blocks and waits for the writer thread
+    if(NULL != captureWriter) {
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " captured %" PRIu64 " commands (%" PRIu64 " not replayable)\n",
+            coreID, captureWriter->getRecordsWritten(), captureWriter->getRecordsSkipped());
+        delete captureWriter;
+        captureWriter = NULL;
+    }
+
+    // Scale what was simulated in the detailed windows up to the whole run
+    if(sampleDetailedInsts > 0 && sampleFastForwardInsts > 0) {
+        const double scale = ((double) (sampleDetailedInsts + sampleFastForwardInsts)) / ((double) sampleDetailedInsts);
+        const uint64_t extrapolatedInsts = (uint64_t) (((double) inst_count) * scale);
+        const uint64_t extrapolatedCycles = (uint64_t) (((double) sampleDetailedCycles) * scale);
+
+        statExtrapolatedIns->addData(extrapolatedInsts);
+        statExtrapolatedCycles->addData(extrapolatedCycles);
+
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " sampled %" PRIu64 " of %" PRIu64 " instructions (x%.2f), extrapolated instructions=%" PRIu64 ", cycles=%" PRIu64 "\n",
+                coreID, sampleDetailedInsts, sampleDetailedInsts + sampleFastForwardInsts, scale, extrapolatedInsts, extrapolatedCycles);
+    }
 }
 
 void ArielCore::halt(){
@@ -579,7 +628,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
     uint64_t addr_offset;
     uint64_t current_transfer;
     current_transfer = (getRemainingTransfer() > 64) ? 64 : getRemainingTransfer();
-    phy_addr = memmgr->translateAddress(getCurrentAddress());
+    phy_addr = memmgr->translateAddress(getCurrentAddress(), coreID);
     addr_offset = phy_addr % ((uint64_t) cacheLineSize);
     if((addr_offset + current_transfer <= cacheLineSize)){
         physicalAddresses.push_back(phy_addr);
@@ -589,7 +638,7 @@ void ArielCore::setPhysicalAddresses(SST::Event *ev){
         uint64_t rightAddr = (getCurrentAddress() + ((uint64_t) cacheLineSize)) - addr_offset;
         uint64_t rightSize = current_transfer - leftSize;
         uint64_t physLeftAddr = phy_addr;
-        uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
         physicalAddresses.push_back(physLeftAddr);
     }
 }
@@ -663,6 +712,29 @@ void ArielCore::handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE) {
     memmgr->setDefaultPool(aSPE->getPool());
 }
 
+void ArielCore::handleSamplePhaseEvent(ArielSamplePhaseEvent* sPE) {
+    ARIEL_CORE_VERBOSE(2, output->verbose(CALL_INFO, 2, 0, "Core: %" PRIu32 " leaving %s phase after %" PRIu64 " instructions\n", coreID,
+                        ARIEL_SAMPLE_FAST_FORWARD == sPE->getEndedPhase() ? "fast-forward" : "detailed", sPE->getInstructions()));
+
+    if(ARIEL_SAMPLE_FAST_FORWARD == sPE->getEndedPhase()) {
+        sampleFastForwardInsts += sPE->getInstructions();
+        statSampleFastForwardIns->addData(sPE->getInstructions());
+    } else {
+        sampleDetailedInsts += sPE->getInstructions();
+        statSampleDetailedIns->addData(sPE->getInstructions());
+        statSampleWindows->addData(1);
+    }
+
+    sampleFastForward = (ARIEL_SAMPLE_FAST_FORWARD == sPE->getNextPhase());
+}
+
+void ArielCore::createSamplePhaseEvent(uint32_t endedPhase, uint32_t nextPhase, uint64_t instructions) {
+    ArielSamplePhaseEvent* ev = new ArielSamplePhaseEvent(endedPhase, nextPhase, instructions);
+    coreQ->push(ev);
+
+    ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a sample phase event on core %" PRIu32 "\n", coreID));
+}
+
 void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
     ArielSwitchPoolEvent* ev = new ArielSwitchPoolEvent(newPool);
     coreQ->push(ev);
@@ -846,11 +918,17 @@ bool ArielCore::refillQueue() {
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
+                // ask the frontend not to hold back a partly filled batch while this core waits
+                tunnel->requestFlush(coreID);
                 return false;
         }
 
         ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel reads data on core: %" PRIu32 "\n", coreID));
 
+        if(NULL != captureWriter) {
+            captureCommand(ac);
+        }
+
         // There is data on the pipe
         switch(ac.command) {
             case ARIEL_OUTPUT_STATS:
@@ -859,33 +937,15 @@ bool ArielCore::refillQueue() {
                 break;
 
             case ARIEL_START_INSTRUCTION:
-                if(ARIEL_INST_SP_FP == ac.inst.instClass) {
-                        statFPSPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPSPSIMDIns->addData(1);
-                        } else {
-                            statFPSPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 32)
-                            statFPSPOps->addData(ac.inst.simdElemCount);
-                } else if(ARIEL_INST_DP_FP == ac.inst.instClass) {
-                        statFPDPIns->addData(1);
-
-                        if(ac.inst.simdElemCount > 1) {
-                            statFPDPSIMDIns->addData(1);
-                        } else {
-                            statFPDPScalarIns->addData(1);
-                        }
-
-                        if(ac.inst.simdElemCount < 16)
-                            statFPDPOps->addData(ac.inst.simdElemCount);
-                }
+                recordInstructionStart(ac.inst.instClass, ac.inst.simdElemCount);
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
                         ac = tunnel->readMessage(coreID);
 
+                        if(NULL != captureWriter) {
+                            captureCommand(ac);
+                        }
+
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
                                     createReadEvent(ac.inst.addr, ac.inst.size);
@@ -910,6 +970,10 @@ bool ArielCore::refillQueue() {
 
                 break;
 
+            case ARIEL_PERFORM_BATCH:
+                drainBatch(ac);
+                break;
+
             case ARIEL_NOOP:
                 createNoOpEvent();
                 break;
@@ -938,6 +1002,10 @@ bool ArielCore::refillQueue() {
                 createSwitchPoolEvent(ac.switchPool.pool);
                 break;
 
+            case ARIEL_SAMPLE_PHASE:
+                createSamplePhaseEvent(ac.sample.endedPhase, ac.sample.nextPhase, ac.sample.instructions);
+                break;
+
             case ARIEL_PERFORM_EXIT:
                 createExitEvent();
                 break;
@@ -962,6 +1030,74 @@ bool ArielCore::refillQueue() {
     return true;
 }
 
+void ArielCore::captureCommand(const ArielCommand& ac) {
+    if(!captureWriter->record(ac) && !captureSkipWarned) {
+        output->verbose(CALL_INFO, 1, 0, "Warning: core %" PRIu32 " cannot capture command (%d), it will be missing from the replay\n",
+            coreID, (int) ac.command);
+        captureSkipWarned = true;
+    }
+}
+
+void ArielCore::recordInstructionStart(const uint32_t instClass, const uint32_t simdElemCount) {
+    if(ARIEL_INST_SP_FP == instClass) {
+            statFPSPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPSPSIMDIns->addData(1);
+            } else {
+                statFPSPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 32)
+                statFPSPOps->addData(simdElemCount);
+    } else if(ARIEL_INST_DP_FP == instClass) {
+            statFPDPIns->addData(1);
+
+            if(simdElemCount > 1) {
+                statFPDPSIMDIns->addData(1);
+            } else {
+                statFPDPScalarIns->addData(1);
+            }
+
+            if(simdElemCount < 16)
+                statFPDPOps->addData(simdElemCount);
+    }
+}
+
+void ArielCore::drainBatch(const ArielCommand& ac) {
+    ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Core %" PRIu32 " draining a batch of %" PRIu16 " records (%" PRIu16 " bytes)\n",
+                        coreID, ac.batch.count, ac.batch.length));
+
+    ArielBatchDecoder decoder(ac);
+    ArielBatchRecord rec;
+
+    while(decoder.next(&rec)) {
+        switch(rec.type) {
+            case ARIEL_BATCH_START_INSTRUCTION:
+                recordInstructionStart(rec.instClass, rec.simdElemCount);
+                break;
+
+            case ARIEL_BATCH_READ:
+                createReadEvent(rec.addr, rec.size);
+                break;
+
+            case ARIEL_BATCH_WRITE:
+            case ARIEL_BATCH_WRITE_PAYLOAD:
+                // write events copy the full access size, so stage the (possibly absent or trimmed) payload
+                if(batchPayload.size() < rec.size) {
+                    batchPayload.resize(rec.size, 0);
+                }
+
+                if(rec.payloadLength > 0) {
+                    memcpy(&batchPayload[0], rec.payload, rec.payloadLength);
+                }
+
+                createWriteEvent(rec.addr, rec.size, batchPayload.data());
+                break;
+        }
+    }
+}
+
 void ArielCore::handleFreeEvent(ArielFreeEvent* rFE) {
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " processing a free event (for virtual address=%" PRIu64 ")\n", coreID, rFE->getVirtualAddress()));
 
@@ -985,7 +1121,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
     // There is a chance that the non-alignment causes an undetected bug if an access spans multiple malloc regions that are contiguous in VA space but non-contiguous in PA space.
     // However, a single access spanning multiple malloc'd regions shouldn't happen...
     // Addresses mapped via first touch are always line/page aligned
-    const uint64_t physAddr = memmgr->translateAddress(readAddress);
+    const uint64_t physAddr = memmgr->translateAddress(readAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     if((addr_offset + readLength) <= cacheLineSize) {
@@ -1010,7 +1146,7 @@ void ArielCore::handleReadRequest(ArielReadEvent* rEv) {
         const uint64_t rightSize = readLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address read, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1056,7 +1192,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
     }*/
 
     // See note in handleReadRequest() on alignment issues
-    const uint64_t physAddr = memmgr->translateAddress(writeAddress);
+    const uint64_t physAddr = memmgr->translateAddress(writeAddress, coreID);
     const uint64_t addr_offset  = physAddr % ((uint64_t) cacheLineSize);
 
     // We do not need to perform a split operation
@@ -1093,7 +1229,7 @@ void ArielCore::handleWriteRequest(ArielWriteEvent* wEv) {
         const uint64_t rightSize = writeLength - leftSize;
 
         const uint64_t physLeftAddr = physAddr;
-        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr);
+        const uint64_t physRightAddr = memmgr->translateAddress(rightAddr, coreID);
 
         ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Core %" PRIu32 " issuing split-address write, LeftVAddr=%" PRIu64 ", RightVAddr=%" PRIu64 ", LeftSize=%" PRIu64 ", RightSize=%" PRIu64 ", LeftPhysAddr=%" PRIu64 ", RightPhysAddr=%" PRIu64 "\n",
                             coreID, leftAddr, rightAddr, leftSize, rightSize, physLeftAddr, physRightAddr));
@@ -1148,7 +1284,7 @@ void ArielCore::handleFlushEvent(ArielFlushEvent *flEv) {
     const uint64_t virtualAddress = (uint64_t) flEv->getVirtualAddress();
     const uint64_t readLength = (uint64_t) flEv->getLength();
 
-    const uint64_t physAddr = memmgr->translateAddress(virtualAddress);
+    const uint64_t physAddr = memmgr->translateAddress(virtualAddress, coreID);
     commitFlushEvent(physAddr, virtualAddress, (uint32_t) readLength);
 }
 
@@ -1488,6 +1624,12 @@ bool ArielCore::processNextEvent() {
                 handleSwitchPoolEvent(dynamic_cast<ArielSwitchPoolEvent*>(nextEvent));
                 break;
 
+        case SAMPLE_PHASE:
+                ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a SAMPLE_PHASE\n", coreID));
+                removeEvent = true;
+                handleSamplePhaseEvent(dynamic_cast<ArielSamplePhaseEvent*>(nextEvent));
+                break;
+
         case FREE:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is FREE\n", coreID));
                 removeEvent = true;
@@ -1601,6 +1743,11 @@ void ArielCore::tick() {
         if( updateCycle ) {
                 statActiveCycles->addData(1);
         }
+
+        // cycles spent waiting on a fast-forwarding frontend are not part of any sample
+        if( ! sampleFastForward ) {
+                sampleDetailedCycles++;
+        }
     }
 
     if(inst_count >= max_insts && (max_insts!=0) && (coreID==0))
@@ -33,6 +33,7 @@
 
 #include <string>
 #include <queue>
+#include <vector>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
@@ -46,11 +47,13 @@
 #include "arielflushev.h"
 #include "arielfenceev.h"
 #include "arielswitchpool.h"
+#include "arielsamplephaseev.h"
 #include "arielrtlev.h"
 #include "tb_header.h"
 
 #include "ariel_shmem.h"
 #include "arieltracegen.h"
+#include "arieltracecapture.h"
 
 #ifdef HAVE_CUDA
 #include "arielgpuev.h"
@@ -126,6 +129,7 @@ class ArielCore : public ComponentExtension {
         void createFlushEvent(uint64_t vAddr);
         void createFenceEvent();
         void createSwitchPoolEvent(uint32_t pool);
+        void createSamplePhaseEvent(uint32_t endedPhase, uint32_t nextPhase, uint64_t instructions);
 
         void setFilePath(std::string fp) {
           getcwd(file_path, sizeof(file_path));
@@ -153,6 +157,7 @@ class ArielCore : public ComponentExtension {
         void handleMmapEvent(ArielMmapEvent* aEv);
         void handleFreeEvent(ArielFreeEvent* aFE);
         void handleSwitchPoolEvent(ArielSwitchPoolEvent* aSPE);
+        void handleSamplePhaseEvent(ArielSamplePhaseEvent* sPE);
         void handleFlushEvent(ArielFlushEvent *flEv);
         void handleFenceEvent(ArielFenceEvent *fEv);
         void handleRtlEvent(ArielRtlEvent* RtlEv);
@@ -194,7 +199,10 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        void recordInstructionStart(const uint32_t instClass, const uint32_t simdElemCount);
+        void drainBatch(const ArielCommand& ac);
         bool writePayloads;
+        std::vector<uint8_t> batchPayload;
         uint32_t coreID;
         uint32_t maxPendingTransactions;
 
@@ -253,8 +261,19 @@ class ArielCore : public ComponentExtension {
         // This indicates the max number of instructions before halting the simulation
         uint64_t max_insts;
 
+        // Sampling state reported by the frontend, used to extrapolate to the whole run
+        bool sampleFastForward;
+        uint64_t sampleDetailedInsts;
+        uint64_t sampleFastForwardInsts;
+        uint64_t sampleDetailedCycles;
+
         ArielTraceGenerator* traceGen;
 
+        // Records every command read from the tunnel so the run can be replayed without the frontend
+        ArielTraceCaptureWriter* captureWriter;
+        bool captureSkipWarned;
+        void captureCommand(const ArielCommand& ac);
+
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
         Statistic<uint64_t>* statFlushRequests;
@@ -268,6 +287,12 @@ class ArielCore : public ComponentExtension {
         Statistic<uint64_t>* statCycles;
         Statistic<uint64_t>* statActiveCycles;
 
+        Statistic<uint64_t>* statSampleWindows;
+        Statistic<uint64_t>* statSampleDetailedIns;
+        Statistic<uint64_t>* statSampleFastForwardIns;
+        Statistic<uint64_t>* statExtrapolatedIns;
+        Statistic<uint64_t>* statExtrapolatedCycles;
+
         Statistic<uint64_t>* statFPDPIns;
         Statistic<uint64_t>* statFPDPSIMDIns;
         Statistic<uint64_t>* statFPDPScalarIns;
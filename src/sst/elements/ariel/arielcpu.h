@@ -77,6 +77,8 @@ class ArielCPU : public SST::Component {
         {"tracegen", "Select the trace generator for Ariel (which records traced memory operations", ""},
         {"memmgr", "Memory manager to use for address translation", "ariel.MemoryManagerSimple"},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
+        {"capturetrace", "Capture each core's command stream to <prefix>-<core>.arielcap for replay with ariel.frontend.replay, empty disables capture", ""},
+        {"captureblocksize", "Size in bytes of the blocks the capture is compressed and written in", "1048576"},
         {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
         {"gpu_enabled", "If enabled, gpu links will be set up", "0"})
 
@@ -106,7 +108,12 @@ class ArielCPU : public SST::Component {
         { "fp_sp_scalar_ins",     "Statistic for counting SP-FP Non-SIMD instructons", "instructions", 1 },
         { "fp_sp_ops",            "Statistic for counting SP-FP operations (inst * SIMD width)", "instructions", 1 },
         { "cycles",               "Statistic for counting cycles of the Ariel core.", "cycles", 1 },
-        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 })
+        { "active_cycles",        "Statistic for counting active cycles (cycles not idle) of the Ariel core.", "cycles", 1 },
+        { "sample_windows",       "Statistic for counting detailed windows completed when the frontend samples", "windows", 1 },
+        { "sample_detailed_ins",  "Statistic for counting instructions the frontend executed in detailed windows", "instructions", 1 },
+        { "sample_fastforward_ins", "Statistic for counting instructions the frontend fast-forwarded between windows", "instructions", 1 },
+        { "extrapolated_instruction_count", "Instruction count scaled from the detailed windows to the whole run (sampling only)", "instructions", 1 },
+        { "extrapolated_cycles",  "Cycles in detailed windows scaled to the whole run (sampling only)", "cycles", 1 })
 
     SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
             {"memmgr", "Memory manager to translate virtual addresses to physical, handle malloc/free, etc.", "SST::ArielComponent::ArielMemoryManager"},
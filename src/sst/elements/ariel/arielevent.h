@@ -36,6 +36,7 @@ enum ArielEventType {
     FLUSH,
     FENCE,
     RTL,
+    SAMPLE_PHASE,
 #ifdef HAVE_CUDA
     GPU
 #endif
@@ -57,6 +57,11 @@ class ArielMemoryManager : public SubComponent {
         /** Return the physical address for the request virtual address */
         virtual uint64_t translateAddress(uint64_t virtAddr) = 0;
 
+        /** Return the physical address for a virtual address accessed by a particular core */
+        virtual uint64_t translateAddress(uint64_t virtAddr, uint32_t /* core */) {
+            return translateAddress(virtAddr);
+        }
+
         //Virtual Function to get Page info for RTL handle
         virtual void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&) { }
 
@@ -26,6 +26,7 @@
 #include <unordered_map>
 
 #include "arielmemmgr.h"
+#include "arielpagetable.h"
 
 using namespace SST;
 using namespace SST::RNG;
@@ -39,7 +40,14 @@ enum ArielPageMappingPolicy {
     RANDOMIZED
 };
 
-/* Base class for memory managers that cache translation addresses */
+/*
+ * Base class for memory managers that cache translation addresses
+ *
+ * Each core has a small direct-mapped software TLB in front of the manager's
+ * page tables. An entry holds a whole mapping (base page, huge page or malloc
+ * segment) so one miss serves every later access to the same page. Entries are
+ * tagged with a generation, bumping it invalidates every core's TLB at once.
+ */
 class ArielMemoryManagerCache : public ArielMemoryManager{
 
     public:
@@ -47,13 +55,15 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
     #define ARIEL_ELI_MEMMGR_CACHE_PARAMS {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},\
         {"vtop_translate",  "Set to yes to perform virt-phys translation (TLB) or no to disable", "yes"},\
         {"pagemappolicy",   "Select the page mapping policy for Ariel [LINEAR|RANDOMIZED]", "LINEAR"},\
-        {"translatecacheentries", "Keep a translation cache of this many entries to improve emulated core performance", "4096"}
+        {"translatecacheentries", "Entries in each core's direct-mapped translation cache (TLB), rounded up to a power of two", "4096"}
 
     #define ARIEL_ELI_MEMMGR_CACHE_STATS { "tlb_hits", "Hits in the simple Ariel TLB", "hits", 2 },\
+        { "tlb_misses",           "Misses in the simple Ariel TLB, each one walks the page tables", "misses", 2 },\
         { "tlb_evicts",           "Number of evictions in the simple Ariel TLB", "evictions", 2 },\
         { "tlb_translate_queries","Number of TLB translations performed", "translations", 2 },\
         { "tlb_shootdown",        "Number of TLB clears because of page-frees", "shootdowns", 2 },\
-        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 }
+        { "tlb_page_allocs",      "Number of pages allocated by the memory manager", "pages", 2 },\
+        { "tlb_huge_page_allocs", "Number of huge pages allocated by the memory manager", "pages", 2 }
 
         /* Constructor
             *  Supports multiple memory pools with independent page sizes/counts
@@ -65,10 +75,12 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
 
             /* Common statistics */
             statTranslationCacheHits    = registerStatistic<uint64_t>("tlb_hits");
+            statTranslationCacheMiss    = registerStatistic<uint64_t>("tlb_misses");
             statTranslationCacheEvict   = registerStatistic<uint64_t>("tlb_evicts");
             statTranslationQueries      = registerStatistic<uint64_t>("tlb_translate_queries");
             statTranslationShootdown    = registerStatistic<uint64_t>("tlb_shootdown");
             statPageAllocationCount     = registerStatistic<uint64_t>("tlb_page_allocs");
+            statHugePageAllocationCount = registerStatistic<uint64_t>("tlb_huge_page_allocs");
 
             /* Get page map policy */
             mapPolicy = ArielPageMappingPolicy::LINEAR;
@@ -82,16 +94,71 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             output->fatal(CALL_INFO, -8, "Ariel memory manager - unknown page mapping policy \"%s\"\n", mappingPolicy.c_str());
             }
 
-            // Set up translation cache
-            translationCache = new std::unordered_map<uint64_t, uint64_t>();
+            // Set up translation cache, per-core TLBs are created on first use
             translationCacheEntries = (uint32_t) params.find<uint32_t>("translatecacheentries", 4096);
+            if (translationCacheEntries == 0) {
+                translationCacheEntries = 1;
+            }
+            while ((translationCacheEntries & (translationCacheEntries - 1)) != 0) {
+                translationCacheEntries += translationCacheEntries & (~translationCacheEntries + 1);
+            }
+            translationCacheMask = translationCacheEntries - 1;
+            tlbIndexShift = 12;
+            tlbGeneration = 1;
 
             /* Statistics used by all memory managers; managers may also have their own */
         } // End constructor
 
         ~ArielMemoryManagerCache() {};
+
+        uint64_t translateAddress(uint64_t virtAddr) {
+            return translateAddress(virtAddr, 0);
+        }
+
+        uint64_t translateAddress(uint64_t virtAddr, uint32_t core) {
+            // If translation is disabled, then just return address
+            if( ! translationEnabled ) {
+                return virtAddr;
+            }
+
+            // Keep track of how many translations we are performing
+            statTranslationQueries->addData(1);
+
+            if (core >= tlbs.size()) {
+                tlbs.resize(core + 1);
+            }
+
+            std::vector<TLBEntry>& tlb = tlbs[core];
+            if (tlb.empty()) {
+                tlb.resize(translationCacheEntries);
+            }
+
+            TLBEntry& entry = tlb[(virtAddr >> tlbIndexShift) & translationCacheMask];
+            if (entry.generation == tlbGeneration && (virtAddr - entry.vStart) < entry.length) {
+                statTranslationCacheHits->addData(1);
+                return entry.pStart + (virtAddr - entry.vStart);
+            }
+
+            statTranslationCacheMiss->addData(1);
+
+            uint64_t vStart, pStart, length;
+            translateMiss(virtAddr, &vStart, &pStart, &length);
+
+            if (entry.generation == tlbGeneration) {
+                statTranslationCacheEvict->addData(1);
+            }
+
+            entry.vStart = vStart;
+            entry.pStart = pStart;
+            entry.length = length;
+            entry.generation = tlbGeneration;
+
+            return pStart + (virtAddr - vStart);
+        }
+
         void get_tlb_info(std::unordered_map<uint64_t, uint64_t>* translationcache, uint32_t& translationcacheentries, bool& translationenabled) {
-            memcpy((void*)translationcache, (void*)translationCache, sizeof(*translationCache));
+            // TLB contents are private to the cores, the receiver starts with an empty cache
+            translationcache->clear();
             translationcacheentries = translationCacheEntries;
             translationenabled = translationEnabled;
 
@@ -101,12 +168,25 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
 
     protected:
         Statistic<uint64_t>* statTranslationCacheHits;
+        Statistic<uint64_t>* statTranslationCacheMiss;
         Statistic<uint64_t>* statTranslationCacheEvict;
         Statistic<uint64_t>* statTranslationQueries;
         Statistic<uint64_t>* statTranslationShootdown;
         Statistic<uint64_t>* statPageAllocationCount;
-
-        std::unordered_map<uint64_t, uint64_t>* translationCache;
+        Statistic<uint64_t>* statHugePageAllocationCount;
+
+        struct TLBEntry {
+            uint64_t vStart;
+            uint64_t pStart;
+            uint64_t length;
+            uint64_t generation;
+            TLBEntry() : vStart(0), pStart(0), length(0), generation(0) {}
+        };
+
+        std::vector<std::vector<TLBEntry> > tlbs;
+        uint64_t tlbGeneration;
+        uint32_t tlbIndexShift;
+        uint64_t translationCacheMask;
         uint32_t translationCacheEntries;
         bool translationEnabled;
         ArielPageMappingPolicy mapPolicy;
@@ -153,7 +233,70 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
             }
         }
 
-        void populatePageTable(std::string popFilePath, std::unordered_map<uint64_t, uint64_t> * pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
+        /*
+         * Walk the page tables for an address that missed in the TLB, allocating on first touch.
+         * Returns the mapping containing virtAddr so that the TLB can cache all of it.
+         */
+        virtual void translateMiss(uint64_t virtAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length) = 0;
+
+        /* Invalidate every core's TLB */
+        void flushTLBs() {
+            tlbGeneration++;
+        }
+
+        /* Index the TLB with the smallest page size in use so neighbouring pages use different sets */
+        void setTLBPageSize(uint64_t pageSize) {
+            tlbIndexShift = pageShiftOf(pageSize);
+        }
+
+        uint32_t pageShiftOf(uint64_t pageSize) {
+            if (pageSize < 2 || (pageSize & (pageSize - 1)) != 0) {
+                output->fatal(CALL_INFO, -1, "Ariel memory manager - page size %" PRIu64 " is not a power of two\n", pageSize);
+            }
+
+            uint32_t shift = 0;
+            while ((1ULL << shift) < pageSize) {
+                shift++;
+            }
+            return shift;
+        }
+
+        /*
+         * Reserve hugePageCount huge pages at the (aligned) start of a region of physical memory,
+         * returns the address where base pages can start
+         */
+        uint64_t mapHugePages(uint64_t hugePageCount, uint64_t hugePageSize, uint64_t pageSize, uint64_t startAddr, std::deque<uint64_t>* freeHugePagePool, uint32_t* hugeHeight) {
+            if (hugePageCount == 0) {
+                *hugeHeight = 0;
+                return startAddr;
+            }
+
+            *hugeHeight = 0;
+            uint64_t size = pageSize;
+            while (size < hugePageSize && *hugeHeight < 3) {
+                size <<= ArielPageTable::BitsPerLevel;
+                (*hugeHeight)++;
+            }
+
+            if (size != hugePageSize) {
+                output->fatal(CALL_INFO, -1, "Ariel memory manager - huge page size %" PRIu64 " must be the page size %" PRIu64 " times a power of 512\n",
+                        hugePageSize, pageSize);
+            }
+
+            const uint64_t alignedStart = (startAddr + hugePageSize - 1) & ~(hugePageSize - 1);
+            output->verbose(CALL_INFO, 2, 0, "Reserving %" PRIu64 " huge pages of %" PRIu64 " bytes at physical address %" PRIu64 "\n",
+                    hugePageCount, hugePageSize, alignedStart);
+
+            if (mapPolicy == ArielPageMappingPolicy::LINEAR) {
+                mapPagesLinear(hugePageCount, hugePageSize, alignedStart, freeHugePagePool);
+            } else {
+                mapPagesRandom(hugePageCount, hugePageSize, alignedStart, freeHugePagePool);
+            }
+
+            return alignedStart + hugePageCount * hugePageSize;
+        }
+
+        void populatePageTable(std::string popFilePath, ArielPageTable* pageTable, std::deque<uint64_t>* freePagePool, uint64_t pageSize) {
             FILE * popFile = fopen(popFilePath.c_str(), "rt");
             uint64_t pinAddr = 0;
 
@@ -177,23 +320,14 @@ class ArielMemoryManagerCache : public ArielMemoryManager{
                 output->verbose(CALL_INFO, 4, 0, "Pinning address %" PRIu64 " (physical=%" PRIu64 "\n",
                             pinAddr, freePhysical);
 
-                pageTable->insert( std::pair<uint64_t, uint64_t>( pinAddr, freePhysical ) );
+                if (! pageTable->map(pinAddr, freePhysical)) {
+                    output->fatal(CALL_INFO, -1, "Attempted to pin address %" PRIu64 " but it is already mapped\n", pinAddr);
+                }
             }
 
             fclose(popFile);
         }
 
-        void cacheTranslation(uint64_t virtualA, uint64_t physicalA) {
-            // Remove the oldest entry if we do not have enough slots TODO is begin() really the oldest...?
-            if(translationCache->size() == translationCacheEntries) {
-            statTranslationCacheEvict->addData(1);
-            translationCache->erase(translationCache->begin());
-            }
-
-            // Insert the translated entry into the cache
-            translationCache->insert(std::pair<uint64_t, uint64_t>(virtualA, physicalA));
-        }
-
 };
 
 }
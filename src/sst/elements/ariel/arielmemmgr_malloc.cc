@@ -15,6 +15,7 @@
 
 #include <sst_config.h>
 #include <stdio.h>
+#include <algorithm>
 
 #include "arielmemmgr_malloc.h"
 
@@ -33,12 +34,16 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
 
     // PageAllocation and PageTable structures
     pageAllocations = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
-    pageTables = (std::unordered_map<uint64_t, uint64_t>**) malloc(sizeof(std::unordered_map<uint64_t, uint64_t>*) * memoryLevels);
+    pageTables = (ArielPageTable**) malloc(sizeof(ArielPageTable*) * memoryLevels);
     for (uint32_t i = 0; i <memoryLevels; ++i) {
         pageAllocations[i] = new std::unordered_map<uint64_t, uint64_t>();
-        pageTables[i] = new std::unordered_map<uint64_t, uint64_t>();
     }
 
+    // Huge page pools
+    hugePageSizes = (uint64_t*) malloc(sizeof(uint64_t) * memoryLevels);
+    hugePageHeights = (uint32_t*) malloc(sizeof(uint32_t) * memoryLevels);
+    freeHugePages = (std::deque<uint64_t>**) malloc(sizeof(std::deque<uint64_t>*) * memoryLevels);
+
     // Initialize data structures
     size_t level_buffer_size = sizeof(char) * 256;
     char * level_buffer = (char*) malloc(level_buffer_size);
@@ -54,6 +59,21 @@ ArielMemoryManagerMalloc::ArielMemoryManagerMalloc(ComponentId_t id, Params& par
         uint64_t pageCount = (uint64_t) params.find<uint64_t>(level_buffer, 131072);
         output->verbose(CALL_INFO, 2, 0, "Level %" PRIu32 " page count is %" PRIu64 "\n", i, pageCount);
 
+        pageTables[i] = new ArielPageTable(pageShiftOf(pageSizes[i]));
+        if (0 == i || pageSizes[i] < (1ULL << tlbIndexShift)) {
+            setTLBPageSize(pageSizes[i]);
+        }
+
+        // Huge pages come first in the level so that they are aligned, base pages follow them
+        snprintf(level_buffer, level_buffer_size, "hugepagesize%" PRIu32, i);
+        hugePageSizes[i] = (uint64_t) params.find<uint64_t>(level_buffer, pageSizes[i] << ArielPageTable::BitsPerLevel);
+
+        snprintf(level_buffer, level_buffer_size, "hugepagecount%" PRIu32, i);
+        uint64_t hugePageCount = (uint64_t) params.find<uint64_t>(level_buffer, 0);
+
+        freeHugePages[i] = new std::deque<uint64_t>();
+        nextMemoryAddress = mapHugePages(hugePageCount, hugePageSizes[i], pageSizes[i], nextMemoryAddress, freeHugePages[i], &hugePageHeights[i]);
+
         // Configure page pool
         freePages[i] = new std::deque<uint64_t>();
 
@@ -148,7 +168,7 @@ void ArielMemoryManagerMalloc::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages[level]->front();
         freePages[level]->pop_front();
 
-        pageTables[level]->insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTables[level]->map(nextVirtPage, nextPhysPage);
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -216,6 +236,9 @@ bool ArielMemoryManagerMalloc::allocateMalloc(const uint64_t size, const uint32_
 
     output->verbose(CALL_INFO, 4, 0, "Malloc mapped %" PRIu64 " to [%" PRIu64 ", %" PRIu64 "] (%" PRIu64 " pages).\n", virtualAddress, firstPhysAddr, lastPhysAddr, pageCount);
 
+    // Malloc mappings take priority over the page tables, drop any cached translation they cover
+    flushTLBs();
+
     // Record malloc
     mallocInformation.insert(std::make_pair(virtualAddress, mallocInfo(size, level, virtualPages)));
 
@@ -244,30 +267,16 @@ void ArielMemoryManagerMalloc::freeMalloc(const uint64_t virtualAddress) {
     // Remove mallocInformation entry
     delete myKeys;
     mallocInformation.erase(virtualAddress);
-}
-
-
-uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
-    }
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
+    // The freed pages may be handed out again, shoot down every core's TLB
+    statTranslationShootdown->addData(1);
+    flushTLBs();
+}
 
-    uint64_t physAddr = (uint64_t) -1;
-    bool found = false;
 
+void ArielMemoryManagerMalloc::translateMiss(uint64_t virtAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length) {
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
-    }
-
     // Check malloc mappings
     if (!mallocTranslations.empty()) {
         std::map<uint64_t, uint64_t>::iterator it = mallocTranslations.upper_bound(virtAddr);
@@ -276,75 +285,71 @@ uint64_t ArielMemoryManagerMalloc::translateAddress(uint64_t virtAddr) {
 
         if (it != mallocTranslations.end() && (it->first <= virtAddr)) {
             uint64_t primaryAddr = mallocPrimaryVAMap.find(it->first)->second;
-            if (virtAddr < (primaryAddr + (mallocInformation.find(primaryAddr)->second).size)) {
-                uint64_t offset = virtAddr - it->first;
-                physAddr = offset + it->second;
-                found = true;
+            const mallocInfo& info = mallocInformation.find(primaryAddr)->second;
+            if (virtAddr < (primaryAddr + info.size)) {
+                // The segment is one malloc page, cut short at the end of the malloc
+                *vStart = it->first;
+                *pStart = it->second;
+                *length = std::min(pageSizes[info.level], primaryAddr + info.size - it->first);
+                return;
             }
         }
     }
 
     // We will have to search every memory level to find where the address lies
     for(uint32_t i = 0; i < memoryLevels; ++i) {
-        if (!found) {
-        std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-        const uint64_t pageSize = pageSizes[i];
-            const uint64_t page_offset = virtAddr % pageSize;
-        const uint64_t page_start = virtAddr - page_offset;
+        if (pageTables[i]->lookup(virtAddr, vStart, pStart, length)) {
+            output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 "\n",
+                    virtAddr, i, *vStart, *vStart + *length, *pStart);
+            return;
+        }
+    }
 
-        page_itr = pageTables[i]->find(page_start);
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
 
-            if (page_itr != pageTables[i]->end()) {
-                // Located
-            physAddr = page_itr->second + page_offset;
+    // Use a huge page in the default level if any are left and nothing else has been mapped in its range
+    if (!freeHugePages[defaultLevel]->empty() && pageTables[defaultLevel]->isUnmapped(virtAddr, hugePageHeights[defaultLevel])) {
+        const uint64_t nextPhysPage = freeHugePages[defaultLevel]->front();
+        freeHugePages[defaultLevel]->pop_front();
 
-                output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit in level: %" PRIu32 ", virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                    virtAddr, i, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
+        pageTables[defaultLevel]->map(virtAddr, nextPhysPage, hugePageHeights[defaultLevel]);
+        statHugePageAllocationCount->addData(1);
 
-            found = true;
-            break;
-        }
-        } else {
-            break;
-        }
+        output->verbose(CALL_INFO, 4, 0, "Allocating huge page in level %" PRIu32 ", physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                defaultLevel, nextPhysPage, virtAddr - (virtAddr % hugePageSizes[defaultLevel]));
+
+        pageTables[defaultLevel]->lookup(virtAddr, vStart, pStart, length);
+        return;
     }
 
-    if(found) {
-        cacheTranslation(virtAddr, physAddr);
-        return physAddr;
+    // We did not find the address in memory, that means we should allocate it one from our default pool
+    uint64_t offset = virtAddr % pageSizes[defaultLevel];
+    uint32_t level = defaultLevel;
+
+    output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
+            virtAddr, offset, (virtAddr - offset));
+
+    // Perform an allocation so we can then re-find the address
+    // Attempt defaultLevel but fall through to other levels if needed/available
+    if (canAllocateInLevel(8, defaultLevel)) {
+        allocate(8, defaultLevel, virtAddr - offset);
     } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
-
-        // We did not find the address in memory, that means we should allocate it one from our default pool
-        uint64_t offset = virtAddr % pageSizes[defaultLevel];
-
-        output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
-                virtAddr, offset, (virtAddr - offset));
-
-        // Perform an allocation so we can then re-find the address
-        // Attempt defaultLevel but fall through to other levels if needed/available
-            if (canAllocateInLevel(8, defaultLevel)) {
-                allocate(8, defaultLevel, virtAddr - offset);
-            } else {
-                bool allocated = false;
-                for (uint32_t i = 0; i < memoryLevels; i++) {
-                    if (canAllocateInLevel(8, i)) {
-                        offset = virtAddr % pageSizes[i];
-                        allocate(8, i, virtAddr - offset);
-                        allocated = true;
-                        break;
-                    }
-                }
-                if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+        bool allocated = false;
+        for (uint32_t i = 0; i < memoryLevels; i++) {
+            if (canAllocateInLevel(8, i)) {
+                offset = virtAddr % pageSizes[i];
+                allocate(8, i, virtAddr - offset);
+                level = i;
+                allocated = true;
+                break;
             }
+        }
+        if (!allocated) output->fatal(CALL_INFO, -1, "Attempted to allocate page for address %" PRIu64 " but no free pages are available\n", virtAddr);
+    }
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
-
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    pageTables[level]->lookup(virtAddr, vStart, pStart, length);
 
-        return newPhysAddr;
-    }
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", *pStart + (virtAddr - *vStart));
 }
 
 void ArielMemoryManagerMalloc::printStats() {
@@ -362,6 +367,6 @@ void ArielMemoryManagerMalloc::printStats() {
 
     for(uint32_t i = 0; i < memoryLevels; ++i) {
         output->output("- Demand bytes at level %" PRIu32 "              %" PRIu64 "\n",
-            i, ((uint64_t) pageTables[i]->size()) * ((uint64_t) pageSizes[i]));
+            i, pageTables[i]->getMappedBytes());
     }
 }
@@ -50,6 +50,8 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
             {"defaultlevel",    "Default memory level", "0"},\
             {"pagesize%(memorylevels)d", "Page size for memory Level x", "4096"},\
             {"pagecount%(memorylevels)d", "Page count for memory Level x", "131072"},\
+            {"hugepagesize%(memorylevels)d", "Huge page size for memory level x, the page size times 512 (e.g., 2MiB) or 512*512 (e.g., 1GiB)", "2097152"},\
+            {"hugepagecount%(memorylevels)d", "Huge page count for memory level x, demand allocations use a huge page while any remain. Set to 0 to disable huge pages", "0"},\
             {"page_populate_%(memorylevels)d", "Pre-populate/partially pre-populate a page table for a level in memory, this is the file to read in.", ""}
 #define ARIEL_MEMMGR_MALLOC_ELI_STATS ARIEL_ELI_MEMMGR_CACHE_STATS, \
             { "bytes_allocated_in_pool", "Number of bytes allocated explicitly to memory pool <SubId>. Count is # of allocations", "bytes", 3 }, \
@@ -66,12 +68,14 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
         void setDefaultPool(uint32_t pool);
         uint32_t getDefaultPool();
 
-        uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
 
         void freeMalloc(const uint64_t vAddr);
         bool allocateMalloc(const uint64_t size, const uint32_t level, const uint64_t virtualAddress, const uint64_t instructionPointer, const uint32_t thread);
 
+    protected:
+        void translateMiss(uint64_t virtAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length);
+
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
         bool canAllocateInLevel(const uint64_t size, const uint32_t level);
@@ -93,7 +97,11 @@ class ArielMemoryManagerMalloc : public ArielMemoryManagerCache {
 
         std::deque<uint64_t>** freePages;
         std::unordered_map<uint64_t, uint64_t>** pageAllocations;
-        std::unordered_map<uint64_t, uint64_t>** pageTables;
+        ArielPageTable** pageTables;
+
+        uint64_t* hugePageSizes;
+        uint32_t* hugePageHeights;
+        std::deque<uint64_t>** freeHugePages;
 
         std::vector<Statistic<uint64_t>* > statBytesAlloc;
         std::vector<Statistic<uint64_t>* > statBytesFree;
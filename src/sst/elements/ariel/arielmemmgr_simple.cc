@@ -29,10 +29,18 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     uint64_t pageCount = (uint64_t) params.find<uint64_t>("pagecount0", 131072);
     output->verbose(CALL_INFO, 2, 0, "Page count is %" PRIu64 "\n", pageCount);
 
+    pageTable = new ArielPageTable(pageShiftOf(pageSize));
+    setTLBPageSize(pageSize);
+
+    // Huge pages come first so that they are aligned, base pages follow them
+    hugePageSize = (uint64_t) params.find<uint64_t>("hugepagesize0", pageSize << ArielPageTable::BitsPerLevel);
+    uint64_t hugePageCount = (uint64_t) params.find<uint64_t>("hugepagecount0", 0);
+    uint64_t nextMemoryAddress = mapHugePages(hugePageCount, hugePageSize, pageSize, 0, &freeHugePages, &hugePageHeight);
+
     if (mapPolicy == ArielPageMappingPolicy::LINEAR) {
-        mapPagesLinear(pageCount, pageSize, 0, &freePages);
+        mapPagesLinear(pageCount, pageSize, nextMemoryAddress, &freePages);
     } else {
-        mapPagesRandom(pageCount, pageSize, 0, &freePages);
+        mapPagesRandom(pageCount, pageSize, nextMemoryAddress, &freePages);
     }
 
     output->verbose(CALL_INFO, 2, 0, "Usable (free) page queue contains %" PRIu32 " entries\n", (uint32_t) freePages.size());
@@ -40,12 +48,13 @@ ArielMemoryManagerSimple::ArielMemoryManagerSimple(ComponentId_t id, Params& par
     std::string popFilePath = params.find<std::string>("page_populate_0", "");
     if (popFilePath != "") {
         output->verbose(CALL_INFO, 1, 0, "Populating page table from %s...\n", popFilePath.c_str());
-        populatePageTable(popFilePath, &pageTable, &freePages, pageSize);
+        populatePageTable(popFilePath, pageTable, &freePages, pageSize);
     }
 
 }
 
 ArielMemoryManagerSimple::~ArielMemoryManagerSimple() {
+    delete pageTable;
 }
 
 
@@ -77,7 +86,7 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
         const uint64_t nextPhysPage = freePages.front();
         freePages.pop_front();
 
-        pageTable.insert( std::pair<uint64_t, uint64_t>(nextVirtPage, nextPhysPage) );
+        pageTable->map(nextVirtPage, nextPhysPage);
 
         output->verbose(CALL_INFO, 4, 0, "Allocating memory page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
                 nextPhysPage, nextVirtPage);
@@ -90,63 +99,44 @@ void ArielMemoryManagerSimple::allocate(const uint64_t size, const uint32_t leve
 
 }
 
-uint64_t ArielMemoryManagerSimple::translateAddress(uint64_t virtAddr) {
-    // If translation is disabled, then just return address
-    if( ! translationEnabled ) {
-        return virtAddr;
-    }
-
+void ArielMemoryManagerSimple::translateMiss(uint64_t virtAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length) {
     if( output->getVerboseLevel() > 15 ) {
 	printTable();
     }
 
-    // Keep track of how many translations we are performing
-    statTranslationQueries->addData(1);
-
     output->verbose(CALL_INFO, 4, 0, "Page Table: translate virtual address %" PRIu64 "\n", virtAddr);
 
-    // Check the translation cache otherwise carry on
-    auto checkCache = translationCache->find(virtAddr);
-    if(checkCache != translationCache->end()) {
-        statTranslationCacheHits->addData(1);
-        return checkCache->second;
+    if(pageTable->lookup(virtAddr, vStart, pStart, length)) {
+        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 "\n",
+                virtAddr, *vStart, *vStart + *length, *pStart);
+        return;
     }
 
-    std::unordered_map<uint64_t, uint64_t>::iterator page_itr;
-    const uint64_t page_offset = virtAddr % pageSize;
-    const uint64_t page_start = virtAddr - page_offset;
-
-    page_itr = pageTable.find(page_start);
+    output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
 
-    if(page_itr != pageTable.end()) {
-        // Located
-        uint64_t physAddr = page_itr->second + page_offset;
+    // Use a huge page if any are left and nothing else has been mapped in its range
+    if(! freeHugePages.empty() && pageTable->isUnmapped(virtAddr, hugePageHeight)) {
+        const uint64_t nextPhysPage = freeHugePages.front();
+        freeHugePages.pop_front();
 
-        output->verbose(CALL_INFO, 4, 0, "Page table hit: virtual address=%" PRIu64 " hit, virtual page start=%" PRIu64 ", virtual end=%" PRIu64 ", translates to phys page start=%" PRIu64 " translates to: phys address: %" PRIu64 " (offset added to phys start=%" PRIu64 ")\n",
-                virtAddr, page_itr->first, page_itr->first + pageSize, page_itr->second, physAddr, page_offset);
-
-        cacheTranslation(virtAddr, physAddr);
-        return physAddr;
+        pageTable->map(virtAddr, nextPhysPage, hugePageHeight);
+        statHugePageAllocationCount->addData(1);
 
+        output->verbose(CALL_INFO, 4, 0, "Allocating huge page, physical page=%" PRIu64 ", virtual page=%" PRIu64 "\n",
+                nextPhysPage, virtAddr - (virtAddr % hugePageSize));
     } else {
-        output->verbose(CALL_INFO, 4, 0, "Page table miss for virtual address: %" PRIu64 "\n", virtAddr);
-
         // We did not find the address in memory, that means we should allocate it one from our default pool
         uint64_t offset = virtAddr % pageSize;
 
         output->verbose(CALL_INFO, 4, 0, "Page offset calculation (generating a new page allocation request) for address %" PRIu64 ", offset=%" PRIu64 ", requesting virtual map to address: %" PRIu64 "\n",
                 virtAddr, offset, (virtAddr - offset));
 
-        // Perform an allocation so we can then re-find the address
         allocate(8, 0, virtAddr - offset);
+    }
 
-        // Now attempt to refind it
-        const uint64_t newPhysAddr = translateAddress(virtAddr);
-
-        output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", newPhysAddr );
+    pageTable->lookup(virtAddr, vStart, pStart, length);
 
-        return newPhysAddr;
-    }
+    output->verbose(CALL_INFO, 4, 0, "Page allocation routine mapped to address: %" PRIu64 "\n", *pStart + (virtAddr - *vStart));
 }
 
 void ArielMemoryManagerSimple::printStats() {
@@ -156,12 +146,12 @@ void ArielMemoryManagerSimple::printStats() {
     output->output("Page Table Sizes:\n");
 
     output->output("- Map entries         %" PRIu32 "\n",
-        (uint32_t) pageTable.size());
+        (uint32_t) pageTable->size());
 
     output->output("Page Table Coverages:\n");
 
     output->output("- Bytes               %" PRIu64 "\n",
-        ((uint64_t) pageTable.size()) * ((uint64_t) pageSize));
+        pageTable->getMappedBytes());
 }
 
 void ArielMemoryManagerSimple::printTable() {
@@ -169,18 +159,26 @@ void ArielMemoryManagerSimple::printTable() {
     	output->output("---------------------------------------------------------------------\n");
 	output->verbose(CALL_INFO, 16, 0, "Page Table Map:\n");
 
-	for( auto table_itr : pageTable ) {
-		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 "\n",
-			table_itr.first, table_itr.second);
-	}
+	auto printEntry = [this](uint64_t vStart, uint64_t pStart, uint64_t length) {
+		output->verbose(CALL_INFO, 16, 0, "-> VA: %15" PRIu64 " -> PA: %15" PRIu64 " (%" PRIu64 " bytes)\n",
+			vStart, pStart, length);
+	};
+	pageTable->forEach(printEntry);
 
     	output->output("---------------------------------------------------------------------\n");
 
 }
 
 void ArielMemoryManagerSimple::get_page_info(std::unordered_map<uint64_t, uint64_t>* pagetable, std::deque<uint64_t>* freepages, uint64_t& pagesize) {
-    memcpy((void*)pagetable, (void*)(&pageTable), sizeof(pageTable));
-    memcpy((void*)freepages, (void*)(&freePages), sizeof(freePages)); 
+    // Hand over a flat copy of the page table, huge pages are expanded into base pages
+    pagetable->clear();
+    auto copyEntry = [this, pagetable](uint64_t vStart, uint64_t pStart, uint64_t length) {
+        for (uint64_t offset = 0; offset < length; offset += pageSize) {
+            (*pagetable)[vStart + offset] = pStart + offset;
+        }
+    };
+    pageTable->forEach(copyEntry);
+    *freepages = freePages;
     pagesize = pageSize;
 
     return;
@@ -47,6 +47,8 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
 #define MEMMGR_SIMPLE_ELI_PARAMS ARIEL_ELI_MEMMGR_CACHE_PARAMS,\
             {"pagesize0", "Page size", "4096"},\
             {"pagecount0", "Page count", "131072"},\
+            {"hugepagesize0", "Huge page size, the page size times 512 (e.g., 2MiB) or 512*512 (e.g., 1GiB)", "2097152"},\
+            {"hugepagecount0", "Huge page count, first touches use a huge page while any remain. Set to 0 to disable huge pages", "0"},\
             {"page_populate_0", "Pre-populate/partially pre-populate the page table, this is the file to read in.", ""}
 
         SST_ELI_DOCUMENT_PARAMS( MEMMGR_SIMPLE_ELI_PARAMS )
@@ -56,10 +58,12 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         ArielMemoryManagerSimple(ComponentId_t id, Params& params);
         ~ArielMemoryManagerSimple();
 
-        uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
         void get_page_info(std::unordered_map<uint64_t, uint64_t>*, std::deque<uint64_t>*, uint64_t&); 
 
+    protected:
+        void translateMiss(uint64_t virtAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length);
+
     private:
         void allocate(const uint64_t size, const uint32_t level, const uint64_t virtualAddress);
 	void printTable();
@@ -67,7 +71,11 @@ class ArielMemoryManagerSimple : public ArielMemoryManagerCache {
         uint64_t pageSize;
         std::deque<uint64_t> freePages;
 
-        std::unordered_map<uint64_t, uint64_t> pageTable;
+        uint64_t hugePageSize;
+        uint32_t hugePageHeight;
+        std::deque<uint64_t> freeHugePages;
+
+        ArielPageTable* pageTable;
 };
 
 }
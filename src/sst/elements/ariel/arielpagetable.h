@@ -0,0 +1,191 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ARIEL_PAGE_TABLE
+#define _H_ARIEL_PAGE_TABLE
+
+#include <stdint.h>
+#include <stdlib.h>
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Multi-level radix page table, 512 entries per node like x86-64.
+ * The leaf level holds base pages, a mapping made at height h sits h levels
+ * above the leaves and covers (page size << 9h) bytes, so with 4KiB base pages
+ * height 1 is a 2MiB page and height 2 a 1GiB page.
+ *
+ * An entry is empty (0), a mapping (physical base | 1) or a pointer to the
+ * next level. Physical bases are multiples of the (even) page size so bit 0
+ * is free for the tag, they need not be aligned to the mapping size.
+ */
+class ArielPageTable {
+
+    public:
+        static const uint32_t BitsPerLevel = 9;
+        static const uint32_t EntriesPerNode = 1 << BitsPerLevel;
+
+        ArielPageTable(uint32_t pageShift) : pageShift(pageShift), mappingCount(0), mappedBytes(0) {
+            levels = (64 - pageShift + BitsPerLevel - 1) / BitsPerLevel;
+            root = allocNode();
+        }
+
+        ~ArielPageTable() {
+            freeNode(root, 0);
+        }
+
+        ArielPageTable(const ArielPageTable&) = delete;
+        ArielPageTable& operator=(const ArielPageTable&) = delete;
+
+        uint32_t getPageShift() const { return pageShift; }
+        uint32_t getLevels() const { return levels; }
+        uint64_t size() const { return mappingCount; }
+        uint64_t getMappedBytes() const { return mappedBytes; }
+
+        uint64_t mappingSize(uint32_t height) const { return 1ULL << (pageShift + BitsPerLevel * height); }
+
+        /* Map the page of the given height containing vAddr, returns false if any part of it is already mapped */
+        bool map(uint64_t vAddr, uint64_t pAddr, uint32_t height = 0) {
+            const uint32_t leafLevel = levels - 1 - height;
+            uint64_t* node = root;
+
+            for (uint32_t level = 0; level < leafLevel; level++) {
+                uint64_t& entry = node[index(vAddr, level)];
+
+                if (isMapping(entry)) {
+                    return false;
+                }
+
+                if (0 == entry) {
+                    entry = (uint64_t) (uintptr_t) allocNode();
+                }
+
+                node = (uint64_t*) (uintptr_t) entry;
+            }
+
+            uint64_t& entry = node[index(vAddr, leafLevel)];
+            if (0 != entry) {
+                return false;
+            }
+
+            entry = pAddr | 1;
+            mappingCount++;
+            mappedBytes += mappingSize(height);
+            return true;
+        }
+
+        /* True if nothing is mapped inside the page of the given height containing vAddr */
+        bool isUnmapped(uint64_t vAddr, uint32_t height) const {
+            const uint32_t leafLevel = levels - 1 - height;
+            const uint64_t* node = root;
+
+            for (uint32_t level = 0; level <= leafLevel; level++) {
+                const uint64_t entry = node[index(vAddr, level)];
+
+                if (0 == entry) {
+                    return true;
+                }
+
+                if (isMapping(entry) || level == leafLevel) {
+                    return false;
+                }
+
+                node = (const uint64_t*) (uintptr_t) entry;
+            }
+
+            return false;
+        }
+
+        /* Find the mapping covering vAddr, returns its virtual start, physical start and length */
+        bool lookup(uint64_t vAddr, uint64_t* vStart, uint64_t* pStart, uint64_t* length) const {
+            const uint64_t* node = root;
+
+            for (uint32_t level = 0; level < levels; level++) {
+                const uint64_t entry = node[index(vAddr, level)];
+
+                if (0 == entry) {
+                    return false;
+                }
+
+                if (isMapping(entry)) {
+                    *length = mappingSize(levels - 1 - level);
+                    *vStart = vAddr & ~(*length - 1);
+                    *pStart = entry & ~((uint64_t) 1);
+                    return true;
+                }
+
+                node = (const uint64_t*) (uintptr_t) entry;
+            }
+
+            return false;
+        }
+
+        /* Call visit(vStart, pStart, length) for every mapping in virtual address order */
+        template<typename VisitT>
+        void forEach(VisitT& visit) const {
+            forEachInNode(root, 0, 0, visit);
+        }
+
+    private:
+        uint32_t index(uint64_t vAddr, uint32_t level) const {
+            const uint32_t shift = pageShift + BitsPerLevel * (levels - 1 - level);
+            return (uint32_t) ((vAddr >> shift) & (EntriesPerNode - 1));
+        }
+
+        static bool isMapping(uint64_t entry) { return (entry & 1) != 0; }
+
+        static uint64_t* allocNode() {
+            return (uint64_t*) calloc(EntriesPerNode, sizeof(uint64_t));
+        }
+
+        void freeNode(uint64_t* node, uint32_t level) {
+            for (uint32_t i = 0; i < EntriesPerNode && (level + 1) < levels; i++) {
+                if (0 != node[i] && !isMapping(node[i])) {
+                    freeNode((uint64_t*) (uintptr_t) node[i], level + 1);
+                }
+            }
+            free(node);
+        }
+
+        template<typename VisitT>
+        void forEachInNode(const uint64_t* node, uint32_t level, uint64_t vBase, VisitT& visit) const {
+            const uint32_t shift = pageShift + BitsPerLevel * (levels - 1 - level);
+
+            for (uint64_t i = 0; i < EntriesPerNode; i++) {
+                const uint64_t entry = node[i];
+                const uint64_t vStart = vBase | (i << shift);
+
+                if (0 == entry) {
+                    continue;
+                } else if (isMapping(entry)) {
+                    visit(vStart, entry & ~((uint64_t) 1), mappingSize(levels - 1 - level));
+                } else {
+                    forEachInNode((const uint64_t*) (uintptr_t) entry, level + 1, vStart, visit);
+                }
+            }
+        }
+
+        const uint32_t pageShift;
+        uint32_t levels;
+        uint64_t* root;
+        uint64_t mappingCount;
+        uint64_t mappedBytes;
+};
+
+}
+}
+
+#endif
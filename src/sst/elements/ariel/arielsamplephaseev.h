@@ -0,0 +1,62 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_ARIEL_SAMPLE_PHASE_EVENT
+#define _H_SST_ARIEL_SAMPLE_PHASE_EVENT
+
+#include "arielevent.h"
+
+using namespace SST;
+
+namespace SST {
+namespace ArielComponent {
+
+class ArielSamplePhaseEvent : public ArielEvent {
+
+    public:
+        ArielSamplePhaseEvent(uint32_t endedPhase, uint32_t nextPhase, uint64_t instructions) :
+            endedPhase(endedPhase), nextPhase(nextPhase), instructions(instructions) {
+        }
+
+        ~ArielSamplePhaseEvent() {}
+
+        ArielEventType getEventType() const {
+                return SAMPLE_PHASE;
+        };
+
+        uint32_t getEndedPhase() const {
+                return endedPhase;
+        }
+
+        uint32_t getNextPhase() const {
+                return nextPhase;
+        }
+
+        /* Instructions the frontend executed in the phase that ended */
+        uint64_t getInstructions() const {
+                return instructions;
+        }
+
+    private:
+        const uint32_t endedPhase;
+        const uint32_t nextPhase;
+        const uint64_t instructions;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,571 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_ARIEL_TRACE_CAPTURE
+#define _H_ARIEL_TRACE_CAPTURE
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Captured Ariel command streams, one file per core.
+ *
+ * The file is a header followed by blocks. Each block holds a run of commands
+ * encoded by ArielCommandCodec and is deflated when zlib is available, so a
+ * reader can decompress blocks independently and the writer never holds more
+ * than a few blocks in memory.
+ */
+#define ARIEL_CAPTURE_MAGIC   "ARIELCAP"
+#define ARIEL_CAPTURE_VERSION 1
+
+#define ARIEL_CAPTURE_BLOCK_DEFLATED 1
+
+struct ArielCaptureHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t core;
+    uint64_t reserved;
+};
+
+struct ArielCaptureBlockHeader {
+    uint32_t rawLength;
+    uint32_t storedLength;
+    uint32_t records;
+    uint32_t flags;
+};
+
+/*
+ * Compact encoding of an ArielCommand, one byte of command followed by only the
+ * fields that command uses. RTL and CUDA commands carry pointers into the traced
+ * process and cannot be replayed so they are not encoded.
+ */
+class ArielCommandCodec {
+
+    public:
+        static const size_t MaxEncodedSize = 128;
+
+        /* Returns the encoded length or 0 if the command cannot be captured */
+        static size_t encode(const ArielCommand& ac, bool payloads, uint8_t* out) {
+            uint8_t* p = out;
+            *p++ = (uint8_t) ac.command;
+
+            switch(ac.command) {
+                case ARIEL_PERFORM_READ:
+                    put(p, ac.inst.addr);
+                    put(p, ac.inst.size);
+                    break;
+
+                case ARIEL_PERFORM_WRITE:
+                {
+                    put(p, ac.inst.addr);
+                    put(p, ac.inst.size);
+                    const uint8_t payloadLength = payloads ? (uint8_t) std::min(ac.inst.size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE) : 0;
+                    *p++ = payloadLength;
+                    memcpy(p, ac.inst.payload, payloadLength);
+                    p += payloadLength;
+                } break;
+
+                case ARIEL_START_INSTRUCTION:
+                    put(p, ac.inst.instClass);
+                    put(p, ac.inst.simdElemCount);
+                    break;
+
+                case ARIEL_PERFORM_BATCH:
+                    put(p, ac.batch.count);
+                    put(p, ac.batch.length);
+                    memcpy(p, ac.batch.data, ac.batch.length);
+                    p += ac.batch.length;
+                    break;
+
+                case ARIEL_FLUSHLINE_INSTRUCTION:
+                    put(p, ac.flushline.vaddr);
+                    break;
+
+                case ARIEL_ISSUE_TLM_MAP:
+                    put(p, ac.mlm_map.vaddr);
+                    put(p, ac.mlm_map.alloc_len);
+                    put(p, ac.mlm_map.alloc_level);
+                    put(p, ac.instPtr);
+                    break;
+
+                case ARIEL_ISSUE_TLM_MMAP:
+                    put(p, ac.mlm_mmap.vaddr);
+                    put(p, ac.mlm_mmap.alloc_len);
+                    put(p, ac.mlm_mmap.alloc_level);
+                    put(p, ac.mlm_mmap.fileID);
+                    put(p, ac.instPtr);
+                    break;
+
+                case ARIEL_ISSUE_TLM_FREE:
+                    put(p, ac.mlm_free.vaddr);
+                    break;
+
+                case ARIEL_SWITCH_POOL:
+                    put(p, ac.switchPool.pool);
+                    break;
+
+                case ARIEL_SAMPLE_PHASE:
+                    put(p, ac.sample.instructions);
+                    put(p, ac.sample.endedPhase);
+                    put(p, ac.sample.nextPhase);
+                    break;
+
+                case ARIEL_END_INSTRUCTION:
+                case ARIEL_NOOP:
+                case ARIEL_FENCE_INSTRUCTION:
+                case ARIEL_OUTPUT_STATS:
+                case ARIEL_PERFORM_EXIT:
+                    break;
+
+                default:
+                    return 0;
+            }
+
+            return (size_t) (p - out);
+        }
+
+        /* Returns the number of bytes consumed or 0 if the record is malformed */
+        static size_t decode(const uint8_t* in, size_t avail, ArielCommand* ac) {
+            const uint8_t* p = in;
+            const uint8_t* end = in + avail;
+
+            if(avail < 1) {
+                return 0;
+            }
+
+            ac->command = (ArielShmemCmd_t) *p++;
+            ac->instPtr = 0;
+
+            switch(ac->command) {
+                case ARIEL_PERFORM_READ:
+                    if(!get(p, end, &ac->inst.addr) || !get(p, end, &ac->inst.size)) return 0;
+                    break;
+
+                case ARIEL_PERFORM_WRITE:
+                {
+                    if(!get(p, end, &ac->inst.addr) || !get(p, end, &ac->inst.size)) return 0;
+                    uint8_t payloadLength;
+                    if(!get(p, end, &payloadLength) || payloadLength > ARIEL_MAX_PAYLOAD_SIZE || (size_t) (end - p) < payloadLength) return 0;
+                    memcpy(ac->inst.payload, p, payloadLength);
+                    memset(ac->inst.payload + payloadLength, 0, ARIEL_MAX_PAYLOAD_SIZE - payloadLength);
+                    p += payloadLength;
+                } break;
+
+                case ARIEL_START_INSTRUCTION:
+                    if(!get(p, end, &ac->inst.instClass) || !get(p, end, &ac->inst.simdElemCount)) return 0;
+                    break;
+
+                case ARIEL_PERFORM_BATCH:
+                    if(!get(p, end, &ac->batch.count) || !get(p, end, &ac->batch.length)) return 0;
+                    if(ac->batch.length > ARIEL_BATCH_PAYLOAD_SIZE || (size_t) (end - p) < ac->batch.length) return 0;
+                    memcpy(ac->batch.data, p, ac->batch.length);
+                    p += ac->batch.length;
+                    break;
+
+                case ARIEL_FLUSHLINE_INSTRUCTION:
+                    if(!get(p, end, &ac->flushline.vaddr)) return 0;
+                    break;
+
+                case ARIEL_ISSUE_TLM_MAP:
+                    if(!get(p, end, &ac->mlm_map.vaddr) || !get(p, end, &ac->mlm_map.alloc_len) ||
+                       !get(p, end, &ac->mlm_map.alloc_level) || !get(p, end, &ac->instPtr)) return 0;
+                    break;
+
+                case ARIEL_ISSUE_TLM_MMAP:
+                    if(!get(p, end, &ac->mlm_mmap.vaddr) || !get(p, end, &ac->mlm_mmap.alloc_len) ||
+                       !get(p, end, &ac->mlm_mmap.alloc_level) || !get(p, end, &ac->mlm_mmap.fileID) ||
+                       !get(p, end, &ac->instPtr)) return 0;
+                    break;
+
+                case ARIEL_ISSUE_TLM_FREE:
+                    if(!get(p, end, &ac->mlm_free.vaddr)) return 0;
+                    break;
+
+                case ARIEL_SWITCH_POOL:
+                    if(!get(p, end, &ac->switchPool.pool)) return 0;
+                    break;
+
+                case ARIEL_SAMPLE_PHASE:
+                    if(!get(p, end, &ac->sample.instructions) || !get(p, end, &ac->sample.endedPhase) ||
+                       !get(p, end, &ac->sample.nextPhase)) return 0;
+                    break;
+
+                case ARIEL_END_INSTRUCTION:
+                case ARIEL_NOOP:
+                case ARIEL_FENCE_INSTRUCTION:
+                case ARIEL_OUTPUT_STATS:
+                case ARIEL_PERFORM_EXIT:
+                    break;
+
+                default:
+                    return 0;
+            }
+
+            return (size_t) (p - in);
+        }
+
+    private:
+        template<typename T>
+        static void put(uint8_t*& p, const T& value) {
+            memcpy(p, &value, sizeof(T));
+            p += sizeof(T);
+        }
+
+        template<typename T>
+        static bool get(const uint8_t*& p, const uint8_t* end, T* value) {
+            if((size_t) (end - p) < sizeof(T)) {
+                return false;
+            }
+            memcpy(value, p, sizeof(T));
+            p += sizeof(T);
+            return true;
+        }
+};
+
+/*
+ * Writes the commands one core reads from the tunnel. Commands are encoded into
+ * the active block on the simulation thread, full blocks are compressed and
+ * written by a background thread so capture costs little more than a memcpy.
+ */
+class ArielTraceCaptureWriter {
+
+    public:
+        ArielTraceCaptureWriter(FILE* file, uint32_t core, size_t blockBytes, bool payloads, size_t blockCount = 4) :
+            file(file), payloads(payloads), stopFlush(false),
+            blockBytes(std::max(blockBytes, (size_t) (4 * ArielCommandCodec::MaxEncodedSize))),
+            recordsWritten(0), recordsSkipped(0), bytesStored(0) {
+
+            ArielCaptureHeader header;
+            memset(&header, 0, sizeof(header));
+            memcpy(header.magic, ARIEL_CAPTURE_MAGIC, sizeof(header.magic));
+            header.version = ARIEL_CAPTURE_VERSION;
+            header.core = core;
+            fwrite(&header, sizeof(header), 1, file);
+
+            for(size_t i = 0; i < std::max((size_t) 2, blockCount); i++) {
+                freeBlocks.push_back(new Block());
+                freeBlocks.back()->data.reserve(this->blockBytes);
+            }
+
+            active = freeBlocks.front();
+            freeBlocks.pop_front();
+
+            flushThread = std::thread(&ArielTraceCaptureWriter::flushLoop, this);
+        }
+
+        ~ArielTraceCaptureWriter() {
+            {
+                std::unique_lock<std::mutex> lock(blockLock);
+                if(active->records > 0) {
+                    fullBlocks.push_back(active);
+                } else {
+                    freeBlocks.push_back(active);
+                }
+                active = NULL;
+                stopFlush = true;
+            }
+
+            blockReady.notify_one();
+            flushThread.join();
+
+            for(Block* block : freeBlocks) {
+                delete block;
+            }
+
+            fclose(file);
+        }
+
+        /* Returns false if the command cannot be captured (e.g., it carries host pointers) */
+        bool record(const ArielCommand& ac) {
+            if(active->data.size() + ArielCommandCodec::MaxEncodedSize > blockBytes) {
+                swapBlock();
+            }
+
+            const size_t start = active->data.size();
+            active->data.resize(start + ArielCommandCodec::MaxEncodedSize);
+
+            const size_t length = ArielCommandCodec::encode(ac, payloads, &active->data[start]);
+            active->data.resize(start + length);
+
+            if(0 == length) {
+                recordsSkipped++;
+                return false;
+            }
+
+            active->records++;
+            recordsWritten++;
+            return true;
+        }
+
+        uint64_t getRecordsWritten() const { return recordsWritten; }
+        uint64_t getRecordsSkipped() const { return recordsSkipped; }
+
+    private:
+        struct Block {
+            std::vector<uint8_t> data;
+            uint32_t records;
+            Block() : records(0) {}
+        };
+
+        void swapBlock() {
+            std::unique_lock<std::mutex> lock(blockLock);
+            fullBlocks.push_back(active);
+            blockReady.notify_one();
+
+            // every block is waiting to be written, the simulation has to wait
+            blockFree.wait(lock, [this] { return !freeBlocks.empty(); });
+
+            active = freeBlocks.front();
+            freeBlocks.pop_front();
+        }
+
+        void writeBlock(Block* block, std::vector<uint8_t>& scratch) {
+            ArielCaptureBlockHeader header;
+            header.rawLength = (uint32_t) block->data.size();
+            header.storedLength = header.rawLength;
+            header.records = block->records;
+            header.flags = 0;
+
+            const uint8_t* stored = block->data.data();
+
+#ifdef HAVE_LIBZ
+            uLongf deflatedLength = compressBound(block->data.size());
+            scratch.resize(deflatedLength);
+
+            if(Z_OK == compress2(&scratch[0], &deflatedLength, block->data.data(), block->data.size(), Z_BEST_SPEED) &&
+               deflatedLength < block->data.size()) {
+                header.storedLength = (uint32_t) deflatedLength;
+                header.flags = ARIEL_CAPTURE_BLOCK_DEFLATED;
+                stored = scratch.data();
+            }
+#endif
+
+            fwrite(&header, sizeof(header), 1, file);
+            fwrite(stored, 1, header.storedLength, file);
+            bytesStored += sizeof(header) + header.storedLength;
+        }
+
+        void flushLoop() {
+            std::vector<uint8_t> scratch;
+            std::unique_lock<std::mutex> lock(blockLock);
+
+            while(true) {
+                blockReady.wait(lock, [this] { return stopFlush || !fullBlocks.empty(); });
+
+                if(fullBlocks.empty()) {
+                    // only get here when stopping with nothing left to write
+                    break;
+                }
+
+                Block* block = fullBlocks.front();
+                fullBlocks.pop_front();
+
+                lock.unlock();
+                writeBlock(block, scratch);
+                block->data.clear();
+                block->records = 0;
+                lock.lock();
+
+                freeBlocks.push_back(block);
+                blockFree.notify_one();
+            }
+
+            fflush(file);
+        }
+
+        FILE* file;
+        const bool payloads;
+        std::thread flushThread;
+
+        std::mutex blockLock;
+        std::condition_variable blockReady;
+        std::condition_variable blockFree;
+        bool stopFlush;
+
+        Block* active;
+        std::deque<Block*> fullBlocks;
+        std::deque<Block*> freeBlocks;
+
+        const size_t blockBytes;
+        uint64_t recordsWritten;
+        uint64_t recordsSkipped;
+        uint64_t bytesStored;
+};
+
+/*
+ * Reads a captured command stream through a read-only mapping of the file,
+ * blocks are inflated one at a time into a private buffer.
+ */
+class ArielTraceCaptureReader {
+
+    public:
+        ArielTraceCaptureReader() : mapping(NULL), mappingLength(0), offset(0), blockOffset(0), core(0) {}
+
+        ~ArielTraceCaptureReader() {
+            close();
+        }
+
+        /* Returns an error message, or an empty string on success */
+        std::string open(const std::string& path) {
+            close();
+
+            const int fd = ::open(path.c_str(), O_RDONLY);
+            if(fd < 0) {
+                return "unable to open " + path;
+            }
+
+            struct stat info;
+            if(0 != fstat(fd, &info) || (size_t) info.st_size < sizeof(ArielCaptureHeader)) {
+                ::close(fd);
+                return path + " is too short to be an Ariel capture";
+            }
+
+            mappingLength = (size_t) info.st_size;
+            void* mapped = mmap(NULL, mappingLength, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+
+            if(MAP_FAILED == mapped) {
+                mappingLength = 0;
+                return "unable to map " + path;
+            }
+
+            mapping = (const uint8_t*) mapped;
+            madvise(mapped, mappingLength, MADV_SEQUENTIAL);
+
+            ArielCaptureHeader header;
+            memcpy(&header, mapping, sizeof(header));
+
+            if(0 != memcmp(header.magic, ARIEL_CAPTURE_MAGIC, sizeof(header.magic)) || ARIEL_CAPTURE_VERSION != header.version) {
+                close();
+                return path + " is not an Ariel capture (bad magic or version)";
+            }
+
+            core = header.core;
+            offset = sizeof(header);
+            block.clear();
+            blockOffset = 0;
+            return "";
+        }
+
+        void close() {
+            if(NULL != mapping) {
+                munmap((void*) mapping, mappingLength);
+                mapping = NULL;
+                mappingLength = 0;
+            }
+        }
+
+        uint32_t getCore() const { return core; }
+
+        /* Returns false at the end of the capture, a malformed capture sets the error */
+        bool next(ArielCommand* ac) {
+            while(blockOffset >= block.size()) {
+                if(!loadBlock()) {
+                    return false;
+                }
+            }
+
+            const size_t length = ArielCommandCodec::decode(&block[blockOffset], block.size() - blockOffset, ac);
+            if(0 == length) {
+                error = "malformed record in capture";
+                return false;
+            }
+
+            blockOffset += length;
+            return true;
+        }
+
+        const std::string& getError() const { return error; }
+
+    private:
+        bool loadBlock() {
+            if(NULL == mapping || offset + sizeof(ArielCaptureBlockHeader) > mappingLength) {
+                return false;
+            }
+
+            ArielCaptureBlockHeader header;
+            memcpy(&header, mapping + offset, sizeof(header));
+            offset += sizeof(header);
+
+            if(offset + header.storedLength > mappingLength) {
+                error = "truncated block in capture";
+                return false;
+            }
+
+            const uint8_t* stored = mapping + offset;
+            offset += header.storedLength;
+
+            block.resize(header.rawLength);
+            blockOffset = 0;
+
+            if(header.flags & ARIEL_CAPTURE_BLOCK_DEFLATED) {
+#ifdef HAVE_LIBZ
+                uLongf inflatedLength = header.rawLength;
+                if(Z_OK != uncompress(&block[0], &inflatedLength, stored, header.storedLength) || inflatedLength != header.rawLength) {
+                    error = "unable to inflate block in capture";
+                    return false;
+                }
+#else
+                error = "capture is compressed but zlib support is not available";
+                return false;
+#endif
+            } else {
+                if(header.storedLength != header.rawLength) {
+                    error = "inconsistent block lengths in capture";
+                    return false;
+                }
+                memcpy(&block[0], stored, header.rawLength);
+            }
+
+            return true;
+        }
+
+        const uint8_t* mapping;
+        size_t mappingLength;
+        size_t offset;
+
+        std::vector<uint8_t> block;
+        size_t blockOffset;
+
+        uint32_t core;
+        std::string error;
+};
+
+}
+}
+
+#endif
@@ -93,6 +93,16 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
         break;
     }
 
+    uint64_t sample_window = params.find<uint64_t>("sample_window", 0);
+    uint64_t sample_fastforward = params.find<uint64_t>("sample_fastforward", 0);
+
+    if(sample_window > 0 && sample_fastforward > 0) {
+        output->verbose(CALL_INFO, 1, 0, "Sampling is ENABLED, %" PRIu64 " instruction windows every %" PRIu64 " instructions.\n",
+                sample_window, sample_window + sample_fastforward);
+    } else {
+        output->verbose(CALL_INFO, 1, 0, "Sampling is DISABLED, every instruction is traced.\n");
+    }
+
     uint32_t keep_malloc_stack_trace = (uint32_t) params.find<uint32_t>("arielstack", 0);
     output->verbose(CALL_INFO, 1, 0, "Tracking the stack and dumping on malloc calls is %s.\n",
             keep_malloc_stack_trace == 1 ? "ENABLED" : "DISABLED");
@@ -126,7 +136,7 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     appLauncher = params.find<std::string>("launcher", PINTOOL_EXECUTABLE);
 
     const uint32_t launch_param_count = (uint32_t) params.find<uint32_t>("launchparamcount", 0);
-    const uint32_t pin_arg_count = 37 + launch_param_count;
+    const uint32_t pin_arg_count = 43 + launch_param_count;
 
     execute_args = (char**) malloc(sizeof(char*) * (pin_arg_count + app_argc));
 
@@ -184,9 +194,22 @@ Pin3Frontend::Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uin
     
     size_t buff8size = sizeof(char)*8;
 
+    execute_args[arg++] = const_cast<char*>("-b");
+    execute_args[arg++] = (char*) malloc(buff8size);
+    snprintf(execute_args[arg-1], buff8size, "%d", params.find<int>("batchcommands", 0));
+
     execute_args[arg++] = const_cast<char*>("-E");
     execute_args[arg++] = (char*) malloc(buff8size);
     snprintf(execute_args[arg-1], buff8size, "%d", instrument_instructions);
+
+    size_t buff24size = sizeof(char)*24;
+
+    execute_args[arg++] = const_cast<char*>("-W");
+    execute_args[arg++] = (char*) malloc(buff24size);
+    snprintf(execute_args[arg-1], buff24size, "%" PRIu64, sample_window);
+    execute_args[arg++] = const_cast<char*>("-F");
+    execute_args[arg++] = (char*) malloc(buff24size);
+    snprintf(execute_args[arg-1], buff24size, "%" PRIu64, sample_fastforward);
     execute_args[arg++] = const_cast<char*>("-p");
     execute_args[arg++] = (char*) malloc(sizeof(char) * (shmem_region_name.length() + 1));
     strcpy(execute_args[arg-1], shmem_region_name.c_str());
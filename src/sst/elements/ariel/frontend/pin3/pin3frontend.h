@@ -75,7 +75,10 @@ class Pin3Frontend : public ArielFrontend {
         {"mallocmapfile", "File with valid 'ariel_malloc_flag' ids", ""},
         {"tracePrefix", "Prefix when tracing is enable", ""},
         {"writepayloadtrace", "Trace write payloads and put real memory contents into the memory system", "0"},
-        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"})
+        {"batchcommands", "Pack memory operations into variable-length batched commands in the tunnel, 0 = one command per operation", "0"},
+        {"instrument_instructions", "turn on or off instruction instrumentation in fesimple", "1"},
+        {"sample_window", "Sample the application: instructions per thread in each detailed (instrumented) window, 0 = trace every instruction", "0"},
+        {"sample_fastforward", "Sample the application: instructions per thread to run uninstrumented between detailed windows", "0"})
 
         /* Ariel class */
         Pin3Frontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
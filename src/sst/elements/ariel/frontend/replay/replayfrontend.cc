@@ -0,0 +1,139 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+using namespace SST::ArielComponent;
+
+ArielReplayFrontend::ArielReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool) :
+        ArielFrontend(id, params, cores, qSize, memPool), core_count(cores), activeThreads(0), stopping(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ArielReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    std::string capturePrefix = params.find<std::string>("captureprefix", "");
+    if("" == capturePrefix) {
+        output->fatal(CALL_INFO, -1, "%s, Error: the replay frontend requires a captureprefix\n", getName().c_str());
+    }
+
+    // Both sides of the tunnel are in this process, the child side is driven by the replay threads
+    tunnel = new ArielTunnel(core_count, qSize);
+    tunnelRegion.resize((tunnel->getTunnelSize() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    tunnel->initialize(tunnelRegion.data());
+
+    child_tunnel = new ArielTunnel(tunnelRegion.data());
+    child_tunnel->initialize(tunnelRegion.data());
+
+    for(uint32_t i = 0; i < core_count; i++) {
+        const std::string path = capturePrefix + "-" + std::to_string(i) + ".arielcap";
+
+        readers.push_back(new ArielTraceCaptureReader());
+        const std::string error = readers.back()->open(path);
+
+        if("" != error) {
+            output->fatal(CALL_INFO, -1, "%s, Error: %s\n", getName().c_str(), error.c_str());
+        }
+
+        if(readers.back()->getCore() != i) {
+            output->fatal(CALL_INFO, -1, "%s, Error: %s was captured on core %" PRIu32 " but is named for core %" PRIu32 "\n",
+                getName().c_str(), path.c_str(), readers.back()->getCore(), i);
+        }
+
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " replays %s\n", i, path.c_str());
+    }
+}
+
+ArielReplayFrontend::~ArielReplayFrontend() {
+    stopReplay();
+
+    for(ArielTraceCaptureReader* reader : readers) {
+        delete reader;
+    }
+
+    delete child_tunnel;
+    delete tunnel;
+    delete output;
+}
+
+ArielTunnel* ArielReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+void ArielReplayFrontend::init(unsigned int phase) {
+    if(0 != phase) {
+        return;
+    }
+
+    activeThreads = core_count;
+    for(uint32_t i = 0; i < core_count; i++) {
+        replayThreads.push_back(std::thread(&ArielReplayFrontend::replay, this, i));
+    }
+}
+
+void ArielReplayFrontend::replay(uint32_t core) {
+    ArielTraceCaptureReader* reader = readers[core];
+    ArielCommand ac;
+    bool sawExit = false;
+    uint64_t commands = 0;
+
+    while(!stopping && reader->next(&ac)) {
+        sawExit = sawExit || (ARIEL_PERFORM_EXIT == ac.command);
+        child_tunnel->writeCommand(core, ac);
+        commands++;
+    }
+
+    if("" != reader->getError()) {
+        output->fatal(CALL_INFO, -1, "%s, Error: core %" PRIu32 " replay failed after %" PRIu64 " commands: %s\n",
+            getName().c_str(), core, commands, reader->getError().c_str());
+    }
+
+    // Captures cut short (e.g., by max_insts) still need to end the simulation, the frontend sends exit on core 0
+    if(!stopping && !sawExit && 0 == core) {
+        ac.command = ARIEL_PERFORM_EXIT;
+        ac.instPtr = 0;
+        child_tunnel->writeCommand(core, ac);
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " replayed %" PRIu64 " commands\n", core, commands);
+    activeThreads--;
+}
+
+void ArielReplayFrontend::stopReplay() {
+    stopping = true;
+
+    // Threads may be blocked on a full queue, keep draining until they have all seen the stop flag
+    ArielCommand ac;
+    while(activeThreads > 0) {
+        for(uint32_t i = 0; i < core_count; i++) {
+            while(tunnel->readMessageNB(i, &ac)) { }
+        }
+        std::this_thread::yield();
+    }
+
+    for(std::thread& t : replayThreads) {
+        t.join();
+    }
+    replayThreads.clear();
+}
+
+void ArielReplayFrontend::finish() {
+    stopReplay();
+}
+
+void ArielReplayFrontend::emergencyShutdown() {
+    stopReplay();
+}
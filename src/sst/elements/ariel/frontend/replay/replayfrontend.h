@@ -0,0 +1,82 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "ariel_shmem.h"
+#include "arieltracecapture.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * Replays command streams captured with the core's "capturetrace" parameter.
+ * The tunnel lives in private memory and one thread per core decodes its
+ * capture into the child side, so the cores see exactly what the traced
+ * application sent without Pin or the application being run again.
+ */
+class ArielReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT(ArielReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend that replays a captured command stream", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"captureprefix", "Prefix the capture was written with, core N replays <prefix>-N.arielcap", ""})
+
+    /* ArielReplayFrontend */
+    ArielReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+    ~ArielReplayFrontend();
+
+    virtual void init(unsigned int phase);
+    virtual void finish();
+    virtual void emergencyShutdown();
+    virtual ArielTunnel* getTunnel();
+
+    private:
+        void replay(uint32_t core);
+        void stopReplay();
+
+        SST::Output* output;
+        uint32_t core_count;
+
+        std::vector<uint64_t> tunnelRegion;
+        ArielTunnel* tunnel;
+        ArielTunnel* child_tunnel;
+
+        std::vector<ArielTraceCaptureReader*> readers;
+        std::vector<std::thread> replayThreads;
+        std::atomic<uint32_t> activeThreads;
+        std::atomic<bool> stopping;
+};
+
+}
+}
+
+#endif
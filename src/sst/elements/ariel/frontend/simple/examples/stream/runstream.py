@@ -1,5 +1,16 @@
 import sst
 import os
+import sys
+
+# --capture=<prefix> records the command stream of each core,
+# --replay=<prefix> runs a recorded stream instead of the application
+captureprefix = ""
+replayprefix = ""
+for arg in sys.argv[1:]:
+    if arg.startswith("--capture="):
+        captureprefix = arg[len("--capture="):]
+    elif arg.startswith("--replay="):
+        replayprefix = arg[len("--replay="):]
 
 sst.setProgramOption("timebase", "1ps")
 
@@ -27,6 +38,13 @@ ariel.addParams({
 
 memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
 
+if captureprefix != "":
+    ariel.addParam("capturetrace", captureprefix)
+
+if replayprefix != "":
+    frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+    frontend.addParam("captureprefix", replayprefix)
+
 
 corecount = 1;
 
@@ -72,7 +72,10 @@ KNOB<UINT32> StartupMode(KNOB_MODE_WRITEONCE, "pintool", "s", "1", "Mode for con
 // Instrumentation control
 KNOB<UINT32> InstrumentInstructions(KNOB_MODE_WRITEONCE, "pintool", "E", "1", "Enable instruction instrumentation");
 KNOB<UINT32> PerformWriteTrace(KNOB_MODE_WRITEONCE, "pintool", "w", "0", "Perform write tracing (i.e copy values directly into SST memory operations) (0 = disabled, 1 = enabled)");
+KNOB<UINT32> BatchCommands(KNOB_MODE_WRITEONCE, "pintool", "b", "0", "Pack memory operations into batched tunnel commands (0 = disabled, 1 = enabled)");
 KNOB<UINT32> TrapFunctionProfile(KNOB_MODE_WRITEONCE, "pintool", "t", "0", "Function profiling level (0 = disabled, 1 = enabled)");
+KNOB<UINT64> SampleWindow(KNOB_MODE_WRITEONCE, "pintool", "W", "0", "Instructions per thread in each detailed (instrumented) sample window, 0 = sampling disabled");
+KNOB<UINT64> SampleFastForward(KNOB_MODE_WRITEONCE, "pintool", "F", "0", "Instructions per thread to fast-forward (run uninstrumented) between sample windows");
 // Memory/malloc/etc. tracking
 KNOB<UINT32> InterceptMemAllocations(KNOB_MODE_WRITEONCE, "pintool", "m", "1", "Should intercept multi-level memory allocations, mallocs, and frees, 1 = start enabled, 0 = start disabled");
 KNOB<string> UseMallocMap(KNOB_MODE_WRITEONCE, "pintool", "u", "", "Should intercept ariel_malloc_flag() and interpret using a malloc map: specify filename or leave blank for disabled");
@@ -116,6 +119,27 @@ UINT32 overridePool;
 bool shouldOverride;
 bool writeTrace;
 
+// Sampling
+// Traces are compiled in two versions, fast-forward has only a per-block counter
+// while detailed carries the full instrumentation. The counter returns the version
+// the thread should be running and Pin switches trace versions when it differs.
+#define ARIEL_VERSION_FAST_FORWARD 0
+#define ARIEL_VERSION_DETAILED     1
+
+typedef struct {
+    UINT64  executed;   // instructions run in the current phase
+    UINT64  length;     // length of the current phase
+    ADDRINT version;    // version the thread should be running
+    BOOL    switched;   // set when the next counter call is the re-entry after a version switch
+    UINT8   pad[64 - (2 * sizeof(UINT64)) - sizeof(ADDRINT) - sizeof(BOOL)];
+} ArielSampleState;
+
+bool sampling;
+UINT64 sample_window;
+UINT64 sample_fastforward;
+REG sample_version_reg;
+ArielSampleState* sampleState;
+
 // For gettimeofday/get_clocktime overrides:
 struct timeval offset_tv;
 #if !defined(__APPLE__)
@@ -282,16 +306,43 @@ VOID InstrumentTrace (TRACE trace, VOID* args)
 /******************** END SHADOW STACK **************************/
 /****************************************************************/
 
+VOID WriteSamplePhase(UINT32 thr, UINT32 endedPhase, UINT32 nextPhase, UINT64 instructions)
+{
+    ArielCommand ac;
+    ac.command = ARIEL_SAMPLE_PHASE;
+    ac.instPtr = (uint64_t) 0;
+    ac.sample.instructions = instructions;
+    ac.sample.endedPhase = endedPhase;
+    ac.sample.nextPhase = nextPhase;
+
+    tunnel->writeCommand(thr, ac);
+}
+
 VOID Fini(INT32 code, VOID* v)
 {
     if(SSTVerbosity.Value() > 0) {
         std::cout << "SSTARIEL: Execution completed, shutting down." << std::endl;
     }
 
+    // report the phase each thread was in so the simulator can extrapolate the whole run
+    if(sampling) {
+        for(UINT32 i = 0; i < core_count; i++) {
+            const UINT32 phase = (ARIEL_VERSION_DETAILED == sampleState[i].version) ? ARIEL_SAMPLE_DETAILED : ARIEL_SAMPLE_FAST_FORWARD;
+            if(sampleState[i].executed > 0) {
+                WriteSamplePhase(i, phase, phase, sampleState[i].executed);
+            }
+        }
+    }
+
+    // operations still waiting in a batch must reach the simulator before it is told to exit
+    if(tunnel->isBatching()) {
+        tunnel->flushAllBatches();
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_PERFORM_EXIT;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(0, ac);
+    tunnel->writeCommand(0, ac);
 
     delete tunnelmgr;
 #ifdef HAVE_CUDA
@@ -339,7 +390,7 @@ VOID WriteFlushInstructionMarker(UINT32 thr, ADDRINT ip, ADDRINT vaddr)
     ac.instPtr = (uint64_t) ip;
     ac.flushline.vaddr = (uint32_t) vaddr;
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
@@ -348,7 +399,7 @@ VOID WriteFenceInstructionMarker(UINT32 thr, ADDRINT ip)
     ac.command = ARIEL_FENCE_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRINT ip,
@@ -357,6 +408,11 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
 
     const uint64_t addr64 = (uint64_t) address;
 
+    if(tunnel->isBatching()) {
+        tunnel->writeAccess(thr, false, addr64, readSize, NULL);
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_READ;
@@ -366,7 +422,7 @@ VOID WriteInstructionRead(ADDRINT* address, UINT32 readSize, THREADID thr, ADDRI
     ac.inst.instClass = instClass;
     ac.inst.simdElemCount = simdOpWidth;
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADDRINT ip,
@@ -374,6 +430,18 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
 {
 
     const uint64_t addr64 = (uint64_t) address;
+
+    if(tunnel->isBatching()) {
+        if( writeTrace ) {
+            uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+            PIN_SafeCopy( &payload[0], address, ARIEL_MIN( writeSize, ARIEL_MAX_PAYLOAD_SIZE ) );
+            tunnel->writeAccess(thr, true, addr64, writeSize, &payload[0]);
+        } else {
+            tunnel->writeAccess(thr, true, addr64, writeSize, NULL);
+        }
+        return;
+    }
+
     ArielCommand ac;
 
     ac.command = ARIEL_PERFORM_WRITE;
@@ -398,25 +466,37 @@ VOID WriteInstructionWrite(ADDRINT* address, UINT32 writeSize, THREADID thr, ADD
     }
     printf("\n");
 */
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteStartInstructionMarker(UINT32 thr, ADDRINT ip, UINT32 instClass, UINT32 simdOpWidth)
 {
+    if(tunnel->isBatching()) {
+        // the simulator only uses the instruction markers for the floating point statistics
+        if(ARIEL_INST_SP_FP == instClass || ARIEL_INST_DP_FP == instClass) {
+            tunnel->writeInstructionStart(thr, instClass, simdOpWidth);
+        }
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_START_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
     ac.inst.instClass = instClass;
     ac.inst.simdElemWidth = simdOpWidth;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteEndInstructionMarker(UINT32 thr, ADDRINT ip)
 {
+    if(tunnel->isBatching()) {
+        return;
+    }
+
     ArielCommand ac;
     ac.command = ARIEL_END_INSTRUCTION;
     ac.instPtr = (uint64_t) ip;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 VOID WriteInstructionReadWrite(THREADID thr, ADDRINT* readAddr, UINT32 readSize,
@@ -455,7 +535,7 @@ VOID WriteNoOp(THREADID thr, ADDRINT ip)
             ArielCommand ac;
             ac.command = ARIEL_NOOP;
             ac.instPtr = (uint64_t) ip;
-            tunnel->writeMessage(thr, ac);
+            tunnel->writeCommand(thr, ac);
         }
     }
 }
@@ -606,6 +686,73 @@ VOID InstrumentInstruction(INS ins, VOID *v)
     }
 }
 
+/*
+ * Called at the head of every block in both trace versions, returns the version
+ * the thread should run. A block is counted in the phase that executes it: when
+ * a phase ends the block is not counted here, it is counted when Pin re-enters
+ * the same block in the other version. Threads that are not simulated and
+ * anything before ariel_enable() stay in fast-forward.
+ */
+ADDRINT PIN_FAST_ANALYSIS_CALL SampleCountBlock(THREADID thr, UINT32 blockInsCount)
+{
+    if(thr >= core_count || !enable_output) {
+        return ARIEL_VERSION_FAST_FORWARD;
+    }
+
+    ArielSampleState* state = &sampleState[thr];
+
+    if(state->switched) {
+        state->switched = false;
+        state->executed += blockInsCount;
+        return state->version;
+    }
+
+    if(state->executed >= state->length) {
+        if(ARIEL_VERSION_DETAILED == state->version) {
+            WriteSamplePhase(thr, ARIEL_SAMPLE_DETAILED, ARIEL_SAMPLE_FAST_FORWARD, state->executed);
+            state->version = ARIEL_VERSION_FAST_FORWARD;
+            state->length = sample_fastforward;
+        } else {
+            WriteSamplePhase(thr, ARIEL_SAMPLE_FAST_FORWARD, ARIEL_SAMPLE_DETAILED, state->executed);
+            state->version = ARIEL_VERSION_DETAILED;
+            state->length = sample_window;
+        }
+
+        state->executed = 0;
+        state->switched = true;
+        return state->version;
+    }
+
+    state->executed += blockInsCount;
+    return state->version;
+}
+
+VOID InstrumentSampledTrace(TRACE trace, VOID* args)
+{
+    const ADDRINT version = TRACE_Version(trace);
+
+    for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl)) {
+        INS head = BBL_InsHead(bbl);
+
+        INS_InsertCall(head, IPOINT_BEFORE, (AFUNPTR) SampleCountBlock,
+                IARG_FAST_ANALYSIS_CALL,
+                IARG_THREAD_ID,
+                IARG_UINT32, BBL_NumIns(bbl),
+                IARG_RETURN_REGS, sample_version_reg,
+                IARG_END);
+
+        if (ARIEL_VERSION_FAST_FORWARD == version) {
+            INS_InsertVersionCase(head, sample_version_reg, ARIEL_VERSION_DETAILED, ARIEL_VERSION_DETAILED, IARG_END);
+        } else {
+            INS_InsertVersionCase(head, sample_version_reg, ARIEL_VERSION_FAST_FORWARD, ARIEL_VERSION_FAST_FORWARD, IARG_END);
+
+            for (INS ins = head; INS_Valid(ins); ins = INS_Next(ins)) {
+                InstrumentInstruction(ins, args);
+            }
+        }
+    }
+}
+
 /* Intercept ariel_enable() in application & start simulating instructions */
 void mapped_ariel_enable()
 {
@@ -713,7 +860,7 @@ void mapped_ariel_output_stats()
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) 0;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 // same effect as mapped_ariel_output_stats(), but it also sends a user-defined reference number back
@@ -723,7 +870,7 @@ void mapped_ariel_output_stats_buoy(uint64_t marker)
     ArielCommand ac;
     ac.command = ARIEL_OUTPUT_STATS;
     ac.instPtr = (uint64_t) marker; //user the instruction pointer slot to send the marker number
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 void mapped_ariel_flushline(void *virtualAddress)
@@ -777,7 +924,7 @@ int ariel_mlm_memcpy(void* dest, void* source, size_t size) {
     ac.dma_start.dest = ariel_dest;
     ac.dma_start.len = length;
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "Done with ariel memcpy.\n");
@@ -805,7 +952,7 @@ void ariel_mlm_set_pool(int new_pool)
     ArielCommand ac;
     ac.command = ARIEL_SWITCH_POOL;
     ac.switchPool.pool = newDefaultPool;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     // Keep track of the default pool
     default_pool = (UINT32) new_pool;
@@ -860,7 +1007,7 @@ void* ariel_mmap_mlm(int fileID, size_t size, int level)
     std::cout<<"File ID at FESIMPLE IS : "<<ac.mlm_mmap.fileID<<std::endl;
     std::cout<<"After ******"<<std::endl;
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mmap_mlm call allocates data at address: 0x%llx\n",
@@ -918,7 +1065,7 @@ void* ariel_mlm_malloc(size_t size, int level) {
         ac.mlm_map.alloc_level = allocationLevel;
     }
 
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
 #ifdef ARIEL_DEBUG
     fprintf(stderr, "%u: Ariel mlm_malloc call allocates data at address: 0x%llx\n",
@@ -963,7 +1110,7 @@ void ariel_mlm_free(void* ptr)
         ArielCommand ac;
         ac.command = ARIEL_ISSUE_TLM_FREE;
         ac.mlm_free.vaddr = virtAddr;
-        tunnel->writeMessage(thr, ac);
+        tunnel->writeCommand(thr, ac);
 
     } else {
         fprintf(stderr, "ARIEL: Call to free in Ariel did not find a matching local allocation, this memory will be leaked.\n");
@@ -1015,14 +1162,14 @@ VOID ariel_postmalloc_instrument(ADDRINT allocLocation)
                 if (toFast[thr].count == 0) {
                     toFast[thr].valid = false;
                 }
-                tunnel->writeMessage(thr, ac);
+                tunnel->writeCommand(thr, ac);
             }
         } else if (shouldOverride) {
             ac.mlm_map.alloc_level = overridePool;
-            tunnel->writeMessage(thr, ac);
+            tunnel->writeCommand(thr, ac);
         } else if (InterceptMemAllocations.Value()) {
             ac.mlm_map.alloc_level = allocationLevel;
-            tunnel->writeMessage(thr, ac);
+            tunnel->writeCommand(thr, ac);
         }
 
         /*printf("ARIEL: Created a malloc of size: %" PRIu64 " in Ariel\n",
@@ -1049,7 +1196,7 @@ __host__ cudaError_t CUDARTAPI cudaMalloc(void **devPtr, size_t size){
     ac.API.name = GPU_MALLOC;
     ac.API.CA.cuda_malloc.dev_ptr = devPtr;
     ac.API.CA.cuda_malloc.size = size;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail = false;
@@ -1079,7 +1226,7 @@ void** CUDARTAPI __cudaRegisterFatBinary(void *fatCubin) {
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_REG_FAT_BINARY;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1120,7 +1267,7 @@ void CUDARTAPI __cudaRegisterFunction(
     ac.API.CA.register_function.fat_cubin_handle = (unsigned)(unsigned long long)fatCubinHandle;
     ac.API.CA.register_function.host_fun = reinterpret_cast<uint64_t>(hostFun);
     strncpy(ac.API.CA.register_function.device_fun, deviceFun, 512);
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1185,7 +1332,7 @@ __host__ cudaError_t CUDARTAPI cudaMemcpy(void *dst, const void *src, size_t cou
     ac.API.CA.cuda_memcpy.src = (uint64_t) src;
     ac.API.CA.cuda_memcpy.count = count;
     ac.API.CA.cuda_memcpy.kind = final_kind;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     if(final_kind == cudaMemcpyHostToDevice) {
         if(count <= max_page_size){
@@ -1314,7 +1461,7 @@ __host__ cudaError_t CUDARTAPI cudaConfigureCall(dim3 gridDim, dim3 blockDim, si
     ac.API.CA.cfg_call.bdz = blockDim.z;
     ac.API.CA.cfg_call.sharedMem = sharedMem;
     ac.API.CA.cfg_call.stream = stream;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1362,7 +1509,7 @@ __host__ cudaError_t CUDARTAPI cudaSetupArgument(const void *arg, size_t size, s
     ac.API.CA.set_arg.offset = offset;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_SET_ARG;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1387,7 +1534,7 @@ __host__ cudaError_t CUDARTAPI cudaLaunch(const void *func){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_LAUNCH;
     ac.API.CA.cuda_launch.func = reinterpret_cast<uint64_t>(func);
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1411,7 +1558,7 @@ __host__ cudaError_t CUDARTAPI cudaFree(void *devPtr){
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_FREE;
     ac.API.CA.free_address = (uint64_t)devPtr;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1434,7 +1581,7 @@ __host__ __cudart_builtin__ cudaError_t CUDARTAPI cudaGetLastError(void){
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_CUDA;
     ac.API.name = GPU_GET_LAST_ERROR;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
     GpuCommand gc;
 
     bool avail=false;
@@ -1473,7 +1620,7 @@ void CUDARTAPI __cudaRegisterVar(
     ac.API.CA.register_var.size = size;
     ac.API.CA.register_var.constant = constant;
     ac.API.CA.register_var.global = global;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1509,7 +1656,7 @@ __host__ cudaError_t CUDARTAPI __maxActiveBlock(
     ac.API.CA.max_active_block.blockSize = blockSize;
     ac.API.CA.max_active_block.dynamicSMemSize = dynamicSMemSize;
     ac.API.CA.max_active_block.flags = flags;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 
     GpuCommand gc;
     bool avail=false;
@@ -1537,7 +1684,7 @@ VOID ariel_postfree_instrument(ADDRINT allocLocation)
     ArielCommand ac;
     ac.command = ARIEL_ISSUE_TLM_FREE;
     ac.mlm_free.vaddr = virtAddr;
-    tunnel->writeMessage(thr, ac);
+    tunnel->writeCommand(thr, ac);
 }
 
 void mapped_ariel_malloc_flag_fortran(int* mallocLocId, int* count, int* level)
@@ -1820,8 +1967,34 @@ int main(int argc, char *argv[])
     core_count = MaxCoreCount.Value();
     instrument_instructions = InstrumentInstructions.Value();
 
+    sample_window = SampleWindow.Value();
+    sample_fastforward = SampleFastForward.Value();
+    sampling = (instrument_instructions > 0) && (sample_window > 0) && (sample_fastforward > 0);
+
+    if(sampling) {
+        sample_version_reg = PIN_ClaimToolRegister();
+        if(!REG_valid(sample_version_reg)) {
+            fprintf(stderr, "ARIEL: Unable to claim a Pin tool register for sampling, every instruction will be traced.\n");
+            sampling = false;
+        }
+    }
+
+    if(sampling) {
+        fprintf(stderr, "ARIEL: Sampling %" PRIu64 " instruction windows, fast-forwarding %" PRIu64 " instructions between them.\n",
+                sample_window, sample_fastforward);
+
+        sampleState = (ArielSampleState*) malloc(sizeof(ArielSampleState) * core_count);
+        for(UINT32 i = 0; i < core_count; i++) {
+            sampleState[i].executed = 0;
+            sampleState[i].length = sample_window;
+            sampleState[i].version = ARIEL_VERSION_DETAILED;
+            sampleState[i].switched = false;
+        }
+    }
+
     tunnelmgr = new SST::Core::Interprocess::SHMChild<ArielTunnel>(SSTNamedPipe.Value());
     tunnel = tunnelmgr->getTunnel();
+    tunnel->setBatching(BatchCommands.Value() > 0);
 #ifdef HAVE_CUDA
     tunnelRmgr = new SST::Core::Interprocess::SHMChild<GpuReturnTunnel>(SSTNamedPipe2.Value());
     tunnelDmgr = new SST::Core::Interprocess::SHMChild<GpuDataTunnel>(SSTNamedPipe3.Value());
@@ -1891,7 +2064,9 @@ int main(int argc, char *argv[])
     offset_tp_real.tv_nsec = 0;
 #endif
 
-    if(instrument_instructions){
+    if(sampling) {
+        TRACE_AddInstrumentFunction(InstrumentSampledTrace, 0);
+    } else if(instrument_instructions){
         INS_AddInstrumentFunction(InstrumentInstruction, 0);
     }
 
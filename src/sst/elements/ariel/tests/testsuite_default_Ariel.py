@@ -3,6 +3,7 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os
+import re
 
 
 class testcase_Ariel(SSTTestCase):
@@ -49,6 +50,10 @@ class testcase_Ariel(SSTTestCase):
     @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
     def test_Ariel_test_snb_mlm(self):
         self.ariel_Template("ariel_snb_mlm", app="stream_mlm")
+
+    @unittest.skipIf(not pin_loaded, "Ariel: Requires PIN, but Env Var 'INTEL_PIN_DIRECTORY' is not found or path does not exist.")
+    def test_Ariel_capture_replay(self):
+        self.ariel_capture_replay_Template("runstream")
 #####
 
     def ariel_Template(self, testcase, app="", testtimeout=480):
@@ -132,6 +137,45 @@ class testcase_Ariel(SSTTestCase):
         if line_count_diff > 15:
             self.assertFalse(line_count_diff > 15, "Line count between output file {0} does not match Reference File {1}; They contain {2} different lines".format(outfile, reffile, line_count_diff))
 
+    # Runs the stream app under Pin capturing each core's command stream, then
+    # replays the capture with ariel.frontend.replay, which decodes every
+    # command the app sent. Cycle counts depend on how fast Pin fills the
+    # tunnel and are not compared, every other statistic must match.
+    def ariel_capture_replay_Template(self, testcase, testtimeout=480):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        ArielElementDir = os.path.abspath("{0}/../".format(test_path))
+        ArielElementStreamDir = "{0}/frontend/simple/examples/stream".format(ArielElementDir)
+        os.environ["ARIEL_TEST_STREAM_APP"] = "{0}/stream".format(ArielElementStreamDir)
+
+        sdlfile = "{0}/{1}.py".format(ArielElementStreamDir, testcase)
+        captureprefix = "{0}/test_Ariel_{1}_capture".format(tmpdir, testcase)
+
+        stats = {}
+        for mode, option in (("capture", "--capture"), ("replay", "--replay")):
+            testDataFileName = "test_Ariel_{0}_{1}".format(testcase, mode)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            otherargs = '--model-options=\"{0}={1}\"'.format(option, captureprefix)
+
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=ArielElementStreamDir, other_args=otherargs,
+                         mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+            stats[mode] = {}
+            with open(outfile, 'r') as f:
+                for line in f.readlines():
+                    self.assertFalse("FATAL" in line, "Output file {0} contains the word 'FATAL'...".format(outfile))
+                    found = re.search(r'(\S+)\s*:\s*Accumulator\s*:\s*Sum\.u64\s*=\s*(\d+)', line)
+                    if found and "cycles" not in found.group(1):
+                        stats[mode][found.group(1)] = int(found.group(2))
+
+        self.assertTrue(len(stats["capture"]) > 0, "Ariel capture run reported no statistics")
+        self.assertEqual(stats["capture"], stats["replay"],
+            "Ariel replay statistics {0} do not match the captured run {1}".format(stats["replay"], stats["capture"]))
+
 #######################
 
     def _setup_ariel_test_files(self):
@@ -0,0 +1,206 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Tunnel throughput benchmark, a writer thread plays the part of the Pin
+// frontend and pushes a synthetic stream of reads and writes through an
+// ArielTunnel while the calling thread drains it the way ArielCore does.
+// Both the one-command-per-operation and the batched encodings are timed
+// and reported in memory operations per second.
+
+#include "ariel_shmem.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace SST::ArielComponent;
+
+struct bench_result {
+    uint64_t ops;
+    uint64_t commands;
+    uint64_t checksum;
+    double seconds;
+};
+
+// Three streams interleaved like a simple stencil: two strided loads and one
+// strided store per instruction, every fourth instruction is floating point
+static void
+produce(ArielTunnel* tunnel, uint64_t instructions, bool batched, bool payloads)
+{
+    uint8_t payload[ARIEL_MAX_PAYLOAD_SIZE];
+    memset(payload, 0x5a, sizeof(payload));
+
+    const uint64_t base_a = 0x7f0000000000ULL;
+    const uint64_t base_b = 0x7f0010000000ULL;
+    const uint64_t base_c = 0x7f0020000000ULL;
+
+    tunnel->setBatching(batched);
+
+    for ( uint64_t i = 0; i < instructions; i++ ) {
+        const uint32_t inst_class = (i % 4) == 0 ? ARIEL_INST_DP_FP : ARIEL_INST_INT;
+
+        if ( batched ) {
+            if ( ARIEL_INST_DP_FP == inst_class ) {
+                tunnel->writeInstructionStart(0, inst_class, 1);
+            }
+            tunnel->writeAccess(0, false, base_a + i * 8, 8, NULL);
+            tunnel->writeAccess(0, false, base_b + i * 8, 8, NULL);
+            tunnel->writeAccess(0, true, base_c + i * 8, 8, payloads ? payload : NULL);
+        } else {
+            ArielCommand ac;
+            ac.command = ARIEL_START_INSTRUCTION;
+            ac.instPtr = i;
+            ac.inst.instClass = inst_class;
+            ac.inst.simdElemCount = 1;
+            tunnel->writeCommand(0, ac);
+
+            ac.command = ARIEL_PERFORM_READ;
+            ac.inst.size = 8;
+            ac.inst.addr = base_a + i * 8;
+            tunnel->writeCommand(0, ac);
+
+            ac.inst.addr = base_b + i * 8;
+            tunnel->writeCommand(0, ac);
+
+            ac.command = ARIEL_PERFORM_WRITE;
+            ac.inst.addr = base_c + i * 8;
+            if ( payloads ) {
+                memcpy(ac.inst.payload, payload, 8);
+            }
+            tunnel->writeCommand(0, ac);
+
+            ac.command = ARIEL_END_INSTRUCTION;
+            tunnel->writeCommand(0, ac);
+        }
+    }
+
+    ArielCommand ac;
+    ac.command = ARIEL_PERFORM_EXIT;
+    ac.instPtr = 0;
+    tunnel->writeCommand(0, ac);
+}
+
+static bench_result
+run(uint64_t instructions, size_t queue_len, bool batched, bool payloads)
+{
+    ArielTunnel master(1, queue_len);
+    std::vector<uint64_t> region((master.getTunnelSize() + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+    master.initialize(region.data());
+
+    ArielTunnel child(region.data());
+    child.initialize(region.data());
+
+    bench_result result;
+    result.ops = 0;
+    result.commands = 0;
+    result.checksum = 0;
+
+    const auto start = std::chrono::high_resolution_clock::now();
+    std::thread writer(produce, &child, instructions, batched, payloads);
+
+    bool running = true;
+    ArielCommand ac;
+
+    while ( running ) {
+        if ( ! master.readMessageNB(0, &ac) ) {
+            master.requestFlush(0);
+            std::this_thread::yield();
+            continue;
+        }
+
+        result.commands++;
+
+        switch ( ac.command ) {
+        case ARIEL_PERFORM_READ:
+        case ARIEL_PERFORM_WRITE:
+            result.ops++;
+            result.checksum += ac.inst.addr + ac.inst.size;
+            break;
+        case ARIEL_PERFORM_BATCH:
+        {
+            ArielBatchDecoder decoder(ac);
+            ArielBatchRecord rec;
+
+            while ( decoder.next(&rec) ) {
+                if ( ARIEL_BATCH_START_INSTRUCTION != rec.type ) {
+                    result.ops++;
+                    result.checksum += rec.addr + rec.size;
+                }
+            }
+        } break;
+        case ARIEL_PERFORM_EXIT:
+            running = false;
+            break;
+        default:
+            break;
+        }
+    }
+
+    writer.join();
+    const auto end = std::chrono::high_resolution_clock::now();
+
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+static void
+report(const char* name, const bench_result& result)
+{
+    printf("%-10s ops: %12" PRIu64 " commands: %12" PRIu64 " (%5.2f ops/command) time: %8.3f s %10.2f Mops/s\n", name,
+           result.ops, result.commands, (double) result.ops / (double) result.commands, result.seconds,
+           (double) result.ops / result.seconds / 1.0e6);
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint64_t instructions = 10000000;
+    size_t queue_len = 64;
+    bool payloads = false;
+
+    for ( int i = 1; i < argc; i++ ) {
+        if ( strcmp(argv[i], "--payload") == 0 ) {
+            payloads = true;
+        } else if ( strcmp(argv[i], "--queue") == 0 && (i + 1) < argc ) {
+            queue_len = strtoul(argv[++i], NULL, 0);
+        } else if ( strcmp(argv[i], "--help") == 0 || argv[i][0] == '-' ) {
+            fprintf(stderr, "usage: tunnelbench [--payload] [--queue <slots>] [instructions]\n");
+            return 1;
+        } else {
+            instructions = strtoull(argv[i], NULL, 0);
+        }
+    }
+
+    printf("Ariel tunnel benchmark: %" PRIu64 " instructions (3 memory ops each), %zu slot queue, payloads %s\n",
+           instructions, queue_len, payloads ? "on" : "off");
+
+    const bench_result single = run(instructions, queue_len, false, payloads);
+    report("single", single);
+
+    const bench_result batched = run(instructions, queue_len, true, payloads);
+    report("batched", batched);
+
+    if ( single.checksum != batched.checksum || single.ops != batched.ops ) {
+        fprintf(stderr, "Error: batched stream does not match the single command stream\n");
+        return 1;
+    }
+
+    printf("speedup: %.2fx\n", single.seconds / batched.seconds);
+    return 0;
+}
@@ -31,6 +31,8 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
     Component( id ),
 	currentMotif(0),
 	m_motifDone(false),
+	m_issuedEv(NULL),
+	m_completeFunctor(this),
 	m_detailedCompute(NULL)
 {
 	// Get the level of verbosity the user is asking to print out, default is 1
@@ -38,6 +40,7 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 	uint32_t verbosity = (uint32_t) params.find("verbose", 1);
 	uint32_t mask = (uint32_t) params.find("verboseMask", 0);
 	m_jobId = params.find("jobId", -1);
+	m_timingOnly = params.find<bool>("timingOnly", false);
 
 
 	std::ostringstream prefix;
@@ -57,10 +60,21 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 
     std::string motifLogFile = params.find<std::string>("motifLog", "");
     if("" != motifLogFile) {
-        m_motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId);
+        std::string motifLogFormat = params.find<std::string>("motifLogFormat", "text");
+        if ( motifLogFormat != "text" && motifLogFormat != "binary" ) {
+            output.fatal(CALL_INFO, -1, "unknown motifLogFormat `%s`, expected text or binary\n", motifLogFormat.c_str());
+        }
+        m_motifLogger = loadComponentExtension<EmberMotifLog>(motifLogFile, m_jobId, motifLogFormat == "binary");
     } else {
         m_motifLogger = nullptr;
     }
+
+    std::string motifRecord = params.find<std::string>("motifRecord", "");
+    if("" != motifRecord) {
+        m_recorder = new EmberReplayRecorder( &output, motifRecord );
+    } else {
+        m_recorder = nullptr;
+    }
 	output.verbose(CALL_INFO, 2, ENGINE_MASK, "\n");
 
 	// create a map of all the available API's
@@ -99,6 +113,14 @@ EmberEngine::EmberEngine(SST::ComponentId_t id, SST::Params& params) :
 
 	// Create a time converter for our compute events
 	nanoTimeConverter = getTimeConverter("1ns");
+	picoTimeConverter = getTimeConverter("1ps");
+	coreTimeConverter = getTimeConverter( getCoreTimeBase() );
+	m_selfLinkLatency = picoTimeConverter->getFactor();
+
+	m_inlineLocalEvents = params.find<bool>("inlineLocalEvents", true);
+	m_eventPool.setMaxPerType( params.find<size_t>("eventPoolSize", 1024) );
+	m_motifLookahead = params.find<size_t>("motifLookahead", 0);
+	m_completeCallback = std::bind( &EmberEngine::completeCallback, this, std::placeholders::_1 );
 }
 
 EmberEngine::~EmberEngine() {
@@ -110,6 +132,10 @@ EmberEngine::~EmberEngine() {
 	if(NULL != m_motifLogger) {
 		delete m_motifLogger;
 	}
+
+	if(NULL != m_recorder) {
+		delete m_recorder;
+	}
 }
 
 EmberEngine::ApiMap EmberEngine::createApiMap( OS* os,
@@ -155,6 +181,8 @@ EmberEngine::ApiMap EmberEngine::createApiMap( OS* os,
             assert(lib);
 
             lib->initApi( api );
+            lib->initEventPool( &m_eventPool );
+            lib->initRecorder( m_recorder );
         } else {
             type = api->getName();
 		}
@@ -187,6 +215,7 @@ EmberGenerator* EmberEngine::initMotif( SST::Params params,
 	} else {
 		params.insert("_jobId", std::to_string( jobId ), true);
 		params.insert("_motifNum", std::to_string( motifNum ), true);
+		params.insert("_timingOnly", std::to_string( m_timingOnly ), true);
 		assert( sizeof(this) == sizeof(uint64_t) );
 		params.insert("_enginePtr", std::to_string( reinterpret_cast<uint64_t>( this ) ), true);
 
@@ -220,6 +249,10 @@ void EmberEngine::finish() {
     }
 
 	m_os->finish();
+
+	if (NULL != m_recorder) {
+		m_recorder->close();
+	}
 }
 
 void EmberEngine::setup() {
@@ -243,6 +276,11 @@ void EmberEngine::setup() {
         m_motifLogger->setRank(m_os->getRank());
     }
 
+    if (NULL != m_recorder) {
+        m_recorder->open(m_os->getRank());
+        m_recorder->motif(currentMotif, m_generator->getMotifName());
+    }
+
 	// Prime the event queue
 	issueNextEvent(0);
 }
@@ -278,6 +316,9 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
                 if (NULL != m_motifLogger) {
                     m_motifLogger->logMotifStart(currentMotif);
                 }
+                if (NULL != m_recorder) {
+                    m_recorder->motif(currentMotif, m_generator->getMotifName());
+                }
                 // output.verbose(CALL_INFO, 1, MOTIF_START_STOP_MASK, "Motif starting: %s\n",m_generator->getMotifName().c_str());
 
                 m_motifDone = refillQueue();
@@ -288,17 +329,67 @@ void EmberEngine::issueNextEvent(uint64_t nanoDelay) {
 	EmberEvent* nextEv = evQueue.front();
 	evQueue.pop();
 
+	if ( isLocalEvent( nextEv ) ) {
+		runLocalEvents( nextEv, getCurrentSimCycle() +
+				nanoTimeConverter->convertToCoreTime( nanoDelay ) + m_selfLinkLatency );
+		return;
+	}
+
 	// issue the next event to the engine for deliver later
 	selfEventLink->send(nanoDelay, nanoTimeConverter, nextEv);
 }
 
+/*
+ * Run a sequence of local events starting with ev, which the self link
+ * would have delivered at deliverTime (core time). Each event is issued and
+ * completed at the time the link round trips would have produced, including
+ * the link latency, but without scheduling anything. We stop at the first
+ * point that needs the real simulated time: a queue refill (which may end the
+ * motif or call into the generator) or an event that talks to another
+ * component. The pending event is then sent so that it arrives exactly when
+ * it would have without inlining.
+ */
+void EmberEngine::runLocalEvents( EmberEvent* ev, SimTime_t deliverTime )
+{
+    SimTime_t now = getCurrentSimCycle();
+
+    while ( 1 ) {
+        output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event (inline)\n",
+              ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
+
+        ev->issue( nanoTimeConverter->convertFromCoreTime( deliverTime ) );
+
+        SimTime_t completeTime = deliverTime + m_selfLinkLatency +
+            picoTimeConverter->convertToCoreTime( ev->completeDelayNS() * 1000 );
+
+        if ( evQueue.empty() ) {
+            // the refill has to happen at completeTime, let the link deliver the completion
+            selfEventLink->send( completeTime - now - m_selfLinkLatency, coreTimeConverter, ev );
+            return;
+        }
+
+        if ( ev->complete( nanoTimeConverter->convertFromCoreTime( completeTime ) ) ) {
+            EmberEventPool::release( ev );
+        }
+
+        ev = evQueue.front();
+        evQueue.pop();
+        deliverTime = completeTime + m_selfLinkLatency;
+
+        if ( ! isLocalEvent( ev ) ) {
+            selfEventLink->send( deliverTime - now - m_selfLinkLatency, coreTimeConverter, ev );
+            return;
+        }
+    }
+}
+
 bool EmberEngine::completeFunctor( int retval, EmberEvent* ev )
 {
     output.debug(CALL_INFO, 2, ENGINE_MASK, "%s %s Event\n",
               ev->stateName( ev->state() ).c_str(), ev->getName().c_str());
 
     if ( ev->complete( getCurrentSimTimeNano(), retval ) ) {
-        delete ev;
+        EmberEventPool::release( ev );
     }
 
 	issueNextEvent(0);
@@ -324,27 +415,27 @@ void EmberEngine::handleEvent(Event* ev) {
         break;
 
       case EmberEvent::IssueFunctor:
-        eEv->issue( getCurrentSimTimeNano(),
-                new ArgStatic_Functor< EmberEngine, int, EmberEvent*, bool >(
-                            this, &EmberEngine::completeFunctor, eEv ) );
+        assert( ! m_issuedEv );
+        m_issuedEv = eEv;
+        eEv->issue( getCurrentSimTimeNano(), &m_completeFunctor );
         break;
 
       case EmberEvent::IssueCallback:
-        eEv->issue( getCurrentSimTimeNano(),
-                    std::bind( &EmberEngine::completeCallback, this, eEv, std::placeholders::_1 ) );
+        assert( ! m_issuedEv );
+        m_issuedEv = eEv;
+        eEv->issue( getCurrentSimTimeNano(), m_completeCallback );
         break;
 
       case EmberEvent::IssueCallbackPtr:
-		{
-		    Callback* callback = new Callback;
-		    *callback = std::bind( &EmberEngine::completeCallback, this, eEv, std::placeholders::_1 );
-            eEv->issue( getCurrentSimTimeNano(), callback );
-		}
+        assert( ! m_issuedEv );
+        m_issuedEv = eEv;
+        // the API deletes this one
+        eEv->issue( getCurrentSimTimeNano(), new Callback( m_completeCallback ) );
         break;
 
       case EmberEvent::Complete:
         if ( eEv->complete( getCurrentSimTimeNano() ) ) {
-            delete ev;
+            EmberEventPool::release( eEv );
         }
 	    issueNextEvent(0);
         break;
@@ -352,7 +443,8 @@ void EmberEngine::handleEvent(Event* ev) {
 }
 
 EmberEngine::EmberEngine() :
-    Component(-1)
+    Component(-1),
+    m_completeFunctor(this)
 {
     // for serialization only
 }
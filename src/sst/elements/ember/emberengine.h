@@ -51,9 +51,15 @@ public:
         { "verboseMask", "Sets the output mask of the component", "0" },
         { "jobId", "Sets the job id", "-1"},
         { "motifLog", "Sets a file path to a file where motif execution details are written, empty = no log", "" },
+        { "motifLogFormat", "Sets the format of the motif log. text writes <motifLog>.log, binary writes a shard per SST thread, <motifLog>.<thread>.mlog, that sst-embermotiflog turns into the text log", "text" },
+        { "motifRecord", "Sets a file path prefix, each rank writes the calls its motifs make to <prefix>.<rank> for the Replay motif, empty = no record", "" },
         { "motif_count", "Sets the number of motifs which will be run in this simulation, default is 1", "1"},
         { "rankmapper", "Sets the rank mapping SST module to load to rank translations, default is linear mapping", "ember.LinearMap" },
         { "mapFile", "Sets the name of the input file for custom map", "mapFile.txt" },
+        { "eventPoolSize", "Sets the number of completed events of each type kept for reuse", "1024" },
+        { "motifLookahead", "Keeps calling the motif generator until this many events are queued. Only for motifs whose generate() does not depend on the results of events it has already queued, 0 = refill only when empty", "0" },
+        { "inlineLocalEvents", "Run compute and get-time events in the engine instead of bouncing each one off the self link, simulated times are unchanged", "1" },
+        { "timingOnly", "Motifs only allocate backed buffers when they need the values, firefly skips copies of unbacked data", "0" },
 
         { "motif%(motif_count)d", "Sets the event generator or motif for the engine", "ember.EmberPingPongGenerator" },
     )
@@ -86,6 +92,8 @@ public:
         return m_apiMap[name]->api;
     }
 	Hermes::NodePerf* getNodePerf( ) { return m_nodePerf; }
+	EmberEventPool* getEventPool( ) { return &m_eventPool; }
+	EmberReplayRecorder* getRecorder( ) { return m_recorder; }
 	Thornhill::DetailedCompute* getDetailedCompute() {
 		return m_detailedCompute;
 	}
@@ -103,7 +111,15 @@ public:
 
 private:
 	bool refillQueue() {
-		return m_generator->generate( evQueue );
+		bool done;
+		size_t queued;
+		// a generator that adds nothing is waiting on the events it already
+		// queued, calling it again before they run would spin forever
+		do {
+			queued = evQueue.size();
+			done = m_generator->generate( evQueue );
+		} while ( ! done && evQueue.size() > queued && evQueue.size() < m_motifLookahead );
+		return done;
 	}
 
     std::string getComputeModelName() {
@@ -116,11 +132,37 @@ private:
 	void handleEvent(SST::Event* ev);
 	void issueNextEvent(uint64_t nanoSecDelay);
 
-    void completeCallback( EmberEvent* ev, int retval ) {
-        completeFunctor(retval, ev);
+    // Events that only advance time (state Issue) never wait on another component
+    bool isLocalEvent( EmberEvent* ev ) {
+        return m_inlineLocalEvents && ev->state() == EmberEvent::Issue;
+    }
+    void runLocalEvents( EmberEvent* ev, SimTime_t deliverTime );
+
+    void completeCallback( int retval ) {
+        completeFunctor(retval, takeIssuedEvent() );
     }
     bool completeFunctor( int retval, EmberEvent* ev );
 
+    EmberEvent* takeIssuedEvent() {
+        EmberEvent* ev = m_issuedEv;
+        m_issuedEv = NULL;
+        return ev;
+    }
+
+    // The engine has at most one event outstanding so a single completion
+    // functor is reused for every IssueFunctor event. Returning false tells
+    // the API not to delete it.
+    class CompleteFunctor : public Hermes::MP::Functor {
+      public:
+        CompleteFunctor( EmberEngine* engine ) : m_engine( engine ) {}
+        bool operator()( int retval ) {
+            m_engine->completeFunctor( retval, m_engine->takeIssuedEvent() );
+            return false;
+        }
+      private:
+        EmberEngine* m_engine;
+    };
+
 	Hermes::OS*	m_os;
 
     struct ApiInfo {
@@ -140,13 +182,26 @@ private:
     ApiMap      m_apiMap;
 	Output      output;
 
-	std::queue<EmberEvent*> evQueue;
+	EmberEventQueue evQueue;
+	EmberEventPool  m_eventPool;
+	size_t          m_motifLookahead;
+	bool            m_timingOnly;
 
     Hermes::NodePerf*   m_nodePerf;
 	EmberGenerator*     m_generator;
 	SST::Link*          selfEventLink;
 	SST::TimeConverter* nanoTimeConverter;
+	SST::TimeConverter* picoTimeConverter;
+	SST::TimeConverter* coreTimeConverter;
+    // Core time the self link adds to every send, i.e. its 1ps latency
+    SimTime_t           m_selfLinkLatency;
+
+    bool                m_inlineLocalEvents;
+    EmberEvent*         m_issuedEv;
+    CompleteFunctor     m_completeFunctor;
+    Callback            m_completeCallback;
 	EmberMotifLog*      m_motifLogger;
+	EmberReplayRecorder* m_recorder;
 
 	std::vector<SST::Params> motifParams;
 	Thornhill::DetailedCompute* m_detailedCompute;
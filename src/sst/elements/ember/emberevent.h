@@ -22,6 +22,8 @@
 #include <sst/elements/hermes/msgapi.h>
 #include <sst/elements/hermes/shmemapi.h>
 
+#include "embereventqueue.h"
+
 namespace SST {
 namespace Ember {
 
@@ -43,6 +45,8 @@ typedef Hermes::Callback Callback;
 
 typedef Statistic<uint32_t> EmberEventTimeStatistic;
 
+struct EmberEventFreeList;
+
 class EmberEvent : public SST::Event {
 
 public:
@@ -52,13 +56,13 @@ public:
     } m_state;
 
 	EmberEvent( Output* output, EmberEventTimeStatistic* stat = NULL) :
-        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL)
+        m_state(Issue), m_output(output), m_evStat(stat), m_completeDelayNS(0), m_retvalPtr(NULL), m_freeList(NULL)
 	{}
 	EmberEvent( Output* output, int* retval) :
-        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval)
+        m_state(Issue), m_output(output), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(retval), m_freeList(NULL)
 	{}
 	EmberEvent( ) :
-        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL) {}
+        m_state(Issue), m_output(NULL), m_evStat(NULL), m_completeDelayNS(0), m_retvalPtr(NULL), m_freeList(NULL) {}
 	~EmberEvent() {}
 
 	virtual std::string getName() { return "?????"; };
@@ -66,6 +70,10 @@ public:
     State state() { return m_state; }
     std::string stateName( State i ) { return m_enumName[i]; }
 
+    // Set by EmberEventPool, where the event goes once it has completed
+    void setFreeList( EmberEventFreeList* list ) { m_freeList = list; }
+    EmberEventFreeList* getFreeList() { return m_freeList; }
+
     virtual void issue( uint64_t time, FOO* = NULL ) {
         if ( m_output ) {
             m_output->debug(CALL_INFO, 3, EVENT_MASK, "%s\n",getName().c_str());
@@ -120,6 +128,7 @@ public:
     uint64_t            m_completeDelayNS;
     uint64_t            m_issueTime;
     int*                m_retvalPtr;
+    EmberEventFreeList* m_freeList;
 
     NotSerializable(EmberEvent)
 };
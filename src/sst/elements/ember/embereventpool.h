@@ -0,0 +1,116 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_EMBER_EVENT_POOL
+#define _H_EMBER_EVENT_POOL
+
+#include <atomic>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "emberevent.h"
+
+namespace SST {
+namespace Ember {
+
+struct EmberEventFreeList {
+    EmberEventFreeList( size_t max ) : max( max ) {}
+    std::vector<EmberEvent*> free;
+    size_t max;
+};
+
+/*
+ * Per engine cache of completed motif events, one free list per event type.
+ *
+ * Events in a free list stay constructed: alloc() destroys the cached
+ * object and constructs the new one in the same storage. Storage therefore
+ * always comes from operator new of the event class, so any event, pooled
+ * or not, can still be deleted normally (e.g. by the core if it is in flight
+ * when the simulation ends).
+ */
+class EmberEventPool {
+  public:
+    EmberEventPool( size_t maxPerType = 1024 ) : m_maxPerType( maxPerType ) {}
+
+    ~EmberEventPool() {
+        for ( size_t i = 0; i < m_lists.size(); i++ ) {
+            if ( m_lists[i] ) {
+                for ( size_t j = 0; j < m_lists[i]->free.size(); j++ ) {
+                    delete m_lists[i]->free[j];
+                }
+                delete m_lists[i];
+            }
+        }
+    }
+
+    void setMaxPerType( size_t max ) { m_maxPerType = max; }
+
+    template < class T, class... Args >
+    T* alloc( Args&&... args ) {
+        EmberEventFreeList* list = freeList( typeIndex<T>() );
+        T* ev;
+        if ( list->free.empty() ) {
+            ev = new T( std::forward<Args>(args)... );
+        } else {
+            ev = static_cast<T*>( list->free.back() );
+            list->free.pop_back();
+            ev->~T();
+            ::new ( static_cast<void*>(ev) ) T( std::forward<Args>(args)... );
+        }
+        ev->setFreeList( list );
+        return ev;
+    }
+
+    // Return a completed event, events not from a pool are deleted
+    static void release( EmberEvent* ev ) {
+        EmberEventFreeList* list = ev->getFreeList();
+        if ( list && list->free.size() < list->max ) {
+            list->free.push_back( ev );
+        } else {
+            delete ev;
+        }
+    }
+
+  private:
+    template < class T >
+    static size_t typeIndex() {
+        static const size_t index = nextIndex()++;
+        return index;
+    }
+
+    static std::atomic<size_t>& nextIndex() {
+        static std::atomic<size_t> next( 0 );
+        return next;
+    }
+
+    EmberEventFreeList* freeList( size_t index ) {
+        if ( index >= m_lists.size() ) {
+            m_lists.resize( index + 1, NULL );
+        }
+        if ( NULL == m_lists[index] ) {
+            m_lists[index] = new EmberEventFreeList( m_maxPerType );
+        }
+        return m_lists[index];
+    }
+
+    size_t m_maxPerType;
+    std::vector<EmberEventFreeList*> m_lists;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_EMBER_EVENT_QUEUE
+#define _H_EMBER_EVENT_QUEUE
+
+#include <assert.h>
+#include <vector>
+
+namespace SST {
+namespace Ember {
+
+class EmberEvent;
+
+/*
+ * FIFO of motif events with the std::queue interface the generators use.
+ * Backed by a power of two ring that only grows, so once a motif has
+ * reached its largest burst pushing and popping never allocates.
+ */
+class EmberEventQueue {
+  public:
+    EmberEventQueue( size_t capacity = 64 ) : m_head(0), m_count(0) {
+        size_t size = 1;
+        while ( size < capacity ) {
+            size <<= 1;
+        }
+        m_ring.resize( size );
+    }
+
+    bool empty() const { return 0 == m_count; }
+    size_t size() const { return m_count; }
+    size_t capacity() const { return m_ring.size(); }
+
+    EmberEvent*& front() {
+        assert( m_count );
+        return m_ring[m_head];
+    }
+
+    EmberEvent*& back() {
+        assert( m_count );
+        return m_ring[ ( m_head + m_count - 1 ) & ( m_ring.size() - 1 ) ];
+    }
+
+    void push( EmberEvent* ev ) {
+        if ( m_count == m_ring.size() ) {
+            grow();
+        }
+        m_ring[ ( m_head + m_count ) & ( m_ring.size() - 1 ) ] = ev;
+        ++m_count;
+    }
+
+    void pop() {
+        assert( m_count );
+        m_head = ( m_head + 1 ) & ( m_ring.size() - 1 );
+        --m_count;
+    }
+
+  private:
+    void grow() {
+        std::vector<EmberEvent*> tmp( m_ring.size() * 2 );
+        for ( size_t i = 0; i < m_count; i++ ) {
+            tmp[i] = m_ring[ ( m_head + i ) & ( m_ring.size() - 1 ) ];
+        }
+        m_ring.swap( tmp );
+        m_head = 0;
+    }
+
+    std::vector<EmberEvent*> m_ring;
+    size_t m_head;
+    size_t m_count;
+};
+
+}
+}
+
+#endif
@@ -30,6 +30,7 @@ EmberGenerator::EmberGenerator( ComponentId_t id, Params& params, std::string na
     m_primary = params.find<bool>("primary",true);
     m_motifNum = params.find<int>( "_motifNum", -1 );
     m_jobId = params.find<int>( "_jobId", -1 );
+    m_timingOnly = params.find<bool>( "_timingOnly", false );
     uint64_t parentPtr = params.find<uint64_t>("_enginePtr",0 );
     assert( parentPtr != 0 );
 
@@ -57,6 +58,8 @@ void EmberGenerator::setEngine( EmberEngine* ee ) {
     m_nodePerf = m_ee->getNodePerf();
     m_detailedCompute = m_ee->getDetailedCompute();
 	m_memHeapLink = m_ee->getMemHeapLink();
+	m_eventPool = m_ee->getEventPool();
+	m_recorder = m_ee->getRecorder();
 }
 
 EmberLib* EmberGenerator::getLib(std::string name )
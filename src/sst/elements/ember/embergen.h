@@ -29,6 +29,7 @@
 #include "sst/elements/thornhill/memoryHeapLink.h"
 
 #include "emberevent.h"
+#include "embereventpool.h"
 #include "embermap.h"
 #include "embermemoryev.h"
 #include "emberconstdistrib.h"
@@ -51,7 +52,7 @@ class EmberGenerator : public SubComponent {
 
   public:
 
-    typedef std::queue<EmberEvent*> Queue;
+    typedef EmberEventQueue Queue;
 
 	SST_ELI_REGISTER_SUBCOMPONENT_API(SST::Ember::EmberGenerator)
 
@@ -71,11 +72,11 @@ class EmberGenerator : public SubComponent {
 	~EmberGenerator(){ };
 
     virtual void generate( const SST::Output* output, const uint32_t phase,
-        std::queue<EmberEvent*>* evQ ) {
+        EmberEventQueue* evQ ) {
         assert(0);
     }
 
-    virtual bool generate( std::queue<EmberEvent*>& evQ ) {
+    virtual bool generate( EmberEventQueue& evQ ) {
         assert(0);
     }
 
@@ -121,6 +122,9 @@ class EmberGenerator : public SubComponent {
     virtual void memFree( void* );
     virtual void memSetBacked() { m_dataMode = Backing; }
     virtual void memSetNotBacked() { m_dataMode = NoBacking; }
+    // motifs that only back their buffers to move real data, and not
+    // because they look at it, skip memSetBacked() when this is set
+    bool timingOnly() { return m_timingOnly; }
     bool haveDetailed() { return m_detailedCompute; }
 
     Thornhill::DetailedCompute*   m_detailedCompute;
@@ -142,36 +146,46 @@ class EmberGenerator : public SubComponent {
     int                     m_jobId;
     int                     m_motifNum;
     bool                    m_primary;
+    bool                    m_timingOnly;
     EmberComputeDistribution*           m_computeDistrib;
+    EmberEventPool*                     m_eventPool;
+    EmberReplayRecorder*                m_recorder;
     uint64_t m_curVirtAddr;
 };
 
 void EmberGenerator::enQ_getTime( Queue& q, uint64_t* time ) {
-	q.push( new EmberGetTimeEvent( &getOutput(), time ) );
+    if ( m_recorder ) m_recorder->getTime();
+	q.push( m_eventPool->alloc<EmberGetTimeEvent>( &getOutput(), time ) );
 }
 
 void EmberGenerator::enQ_compute( Queue& q, uint64_t delay )
 {
-    q.push( new EmberComputeEvent( &getOutput(), delay, m_computeDistrib ) );
+    if ( m_recorder ) m_recorder->compute( delay );
+    q.push( m_eventPool->alloc<EmberComputeEvent>( &getOutput(), delay, m_computeDistrib ) );
 }
 
 void EmberGenerator::enQ_compute( Queue& q, std::function<uint64_t()> func )
 {
-    q.push( new EmberComputeEvent( &getOutput(), func, m_computeDistrib ) );
+    if ( m_recorder ) {
+        // the delay is only known when the event issues, after it has been recorded
+        fatal( CALL_INFO, -1, "Error: motif %s computes a delay at issue, it can't be recorded\n",
+                getMotifName().c_str() );
+    }
+    q.push( m_eventPool->alloc<EmberComputeEvent>( &getOutput(), func, m_computeDistrib ) );
 }
 
 void EmberGenerator::enQ_detailedCompute( Queue& q, std::string name,
         Params& params, std::function<int()> fini = NULL )
 {
     assert( m_detailedCompute );
-    q.push( new EmberDetailedComputeEvent( &getOutput(), *m_detailedCompute, name, params, fini ) );
+    q.push( m_eventPool->alloc<EmberDetailedComputeEvent>( &getOutput(), *m_detailedCompute, name, params, fini ) );
 }
 
 void EmberGenerator::enQ_memAlloc( Queue& q, Hermes::MemAddr* addr, size_t length )
 {
     if ( m_memHeapLink ) {
         addr->setBacking( memAlloc(length) );
-        q.push( new EmberMemAllocEvent( *m_memHeapLink, &getOutput(), addr, length  ) );
+        q.push( m_eventPool->alloc<EmberMemAllocEvent>( *m_memHeapLink, &getOutput(), addr, length  ) );
     } else {
         if ( length % 16 ) {
             length += 16;
@@ -179,7 +193,8 @@ void EmberGenerator::enQ_memAlloc( Queue& q, Hermes::MemAddr* addr, size_t lengt
         }
         *addr = Hermes::MemAddr( m_curVirtAddr, memAlloc( length ) );
         m_curVirtAddr += length;
-        q.push( new EmberComputeEvent( &getOutput(), 0, m_computeDistrib ) );
+        if ( m_recorder ) m_recorder->compute( 0 );
+        q.push( m_eventPool->alloc<EmberComputeEvent>( &getOutput(), 0, m_computeDistrib ) );
     }
 }
 
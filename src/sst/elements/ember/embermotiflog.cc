@@ -19,6 +19,7 @@
 #include <mutex>
 #endif
 
+#include <string.h>
 #include <unordered_map>
 #include "embermotiflog.h"
 
@@ -30,12 +31,81 @@ static std::unordered_map<std::string, EmberMotifLogRecord*>* logHandles = NULL;
 static std::mutex mapLock;
 #endif
 
-EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID) :
+// big enough that a shard is written in large pieces
+#define EMBER_MOTIF_LOG_BUFFER_SIZE (1 << 16)
+
+EmberMotifLogRecord::EmberMotifLogRecord(const char* filePath, uint32_t rank, uint32_t thread) :
+	motifCount(0),
+	binary(true)
+{
+	loggerFile = fopen(filePath, "wb");
+	buffer.reserve(EMBER_MOTIF_LOG_BUFFER_SIZE);
+
+	if(NULL != loggerFile) {
+		EmberMotifLogFileHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, EMBER_MOTIF_LOG_MAGIC, sizeof(header.magic));
+		header.version = EMBER_MOTIF_LOG_VERSION;
+		header.rank = rank;
+		header.thread = thread;
+		fwrite(&header, sizeof(header), 1, loggerFile);
+	}
+}
+
+uint32_t EmberMotifLogRecord::nameId(const std::string& name) {
+	auto iter = names.find(name);
+	if(iter != names.end()) {
+		return iter->second;
+	}
+
+	uint32_t id = names.size();
+	uint16_t length = name.size() < UINT16_MAX ? name.size() : UINT16_MAX;
+	names.insert( std::make_pair(name, id) );
+
+	put<uint8_t>( EMBER_MOTIF_LOG_NAME );
+	put<uint32_t>( id );
+	put<uint16_t>( length );
+	for(uint16_t i = 0; i < length; i++) {
+		put<char>( name[i] );
+	}
+	return id;
+}
+
+void EmberMotifLogRecord::writeMotif(int32_t jobID, int32_t rank, int32_t motifNum, uint32_t nameID,
+		uint64_t startPs, uint64_t endPs) {
+	put<uint8_t>( EMBER_MOTIF_LOG_MOTIF );
+	put<int32_t>( jobID );
+	put<int32_t>( rank );
+	put<int32_t>( motifNum );
+	put<uint32_t>( nameID );
+	put<uint64_t>( startPs );
+	put<uint64_t>( endPs );
+}
+
+void EmberMotifLogRecord::flush() {
+	if(NULL != loggerFile && ! buffer.empty()) {
+		fwrite(&buffer[0], 1, buffer.size(), loggerFile);
+	}
+	buffer.clear();
+}
+
+void EmberMotifLogRecord::close() {
+	if(NULL != loggerFile) {
+		flush();
+		fclose(loggerFile);
+		loggerFile = NULL;
+	}
+}
+
+EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID, bool binary) :
     ComponentExtension(cid),
     jobID(jobID),
     rank(-1),
     start_time("0 ns"),
-    currentMotifNum(0)
+    currentMotifNum(0),
+    picoTimeConv(NULL),
+    startPs(0),
+    lastNameID(0)
 {
 
 #ifndef _SST_EMBER_DISABLE_PARALLEL
@@ -48,7 +118,14 @@ EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPr
 		logHandles = new std::unordered_map<std::string, EmberMotifLogRecord*>();
 	}
 
-	auto logHandleFind = logHandles->find(logPathPrefix);
+	// a binary log has a shard per thread, only engines on that thread write to it
+	std::string key = logPathPrefix;
+	if(binary) {
+		key += "." + std::to_string(getRank().thread);
+		picoTimeConv = getTimeConverter("1ps");
+	}
+
+	auto logHandleFind = logHandles->find(key);
 
 
 	if(logHandleFind == logHandles->end()) {
@@ -58,12 +135,17 @@ EmberMotifLog::EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPr
         if ( getNumRanks().rank > 1 ) {
             logFile << "-" << getRank().rank;
         }
-        logFile << ".log";
 
-		logRecord = new EmberMotifLogRecord(logFile.str().c_str());
+        if ( binary ) {
+            logFile << "." << getRank().thread << ".mlog";
+            logRecord = new EmberMotifLogRecord(logFile.str().c_str(), getRank().rank, getRank().thread);
+        } else {
+            logFile << ".log";
+            logRecord = new EmberMotifLogRecord(logFile.str().c_str());
+        }
 		logRecord->increment();
 
-		logHandles->insert( std::pair<std::string, EmberMotifLogRecord*>(logPathPrefix, logRecord) );
+		logHandles->insert( std::pair<std::string, EmberMotifLogRecord*>(key, logRecord) );
 	} else {
 		logRecord = logHandleFind->second;
 		logRecord->increment();
@@ -80,13 +162,16 @@ EmberMotifLog::~EmberMotifLog() {
 	logRecord->decrement();
 
 	if(0 == logRecord->getCount()) {
-		fclose(logRecord->getFile());
-		logRecord->invalidateFile();
+		logRecord->close();
 	}
 }
 
 void EmberMotifLog::logMotifStart(int motifNum) {
-    start_time = getElapsedSimTime().toStringBestSI();
+    if ( logRecord->isBinary() ) {
+        startPs = getCurrentSimTime(picoTimeConv);
+    } else {
+        start_time = getElapsedSimTime().toStringBestSI();
+    }
     currentMotifNum = motifNum;
 }
 
@@ -96,16 +181,26 @@ void EmberMotifLog::logMotifEnd(const std::string& name, const int motifNum) {
         return;
     }
 
-	if(NULL != logRecord->getFile()) {
-		FILE* logFile = logRecord->getFile();
+	if(NULL == logRecord->getFile()) {
+		return;
+	}
+
+	if(logRecord->isBinary()) {
+		if(name != lastName) {
+			lastNameID = logRecord->nameId(name);
+			lastName = name;
+		}
+		logRecord->writeMotif(jobID, rank, motifNum, lastNameID, startPs, getCurrentSimTime(picoTimeConv));
+		return;
+	}
 
-		const char* nameChar = name.c_str();
-        std::string endTime = getElapsedSimTime().toStringBestSI();
-        const char* startTimeChar = start_time.c_str();
+	FILE* logFile = logRecord->getFile();
 
-        // File format:  job rank motifnum motif_name start_time end_time
-		fprintf(logFile, "%d %d %d %s %s %s\n", jobID, rank, motifNum, nameChar, startTimeChar, endTime.c_str());
-		fflush(logFile);
+	const char* nameChar = name.c_str();
+	std::string endTime = getElapsedSimTime().toStringBestSI();
+	const char* startTimeChar = start_time.c_str();
 
-	}
+	// File format:  job rank motifnum motif_name start_time end_time
+	fprintf(logFile, "%d %d %d %s %s %s\n", jobID, rank, motifNum, nameChar, startTimeChar, endTime.c_str());
+	fflush(logFile);
 }
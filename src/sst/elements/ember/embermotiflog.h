@@ -17,21 +17,27 @@
 #define _H_SST_EMBER_MOTIF_LOG
 
 #include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <sst/core/componentExtension.h>
 
+#include "embermotiflogformat.h"
+
 namespace SST {
 namespace Ember {
 
 class EmberMotifLogRecord {
 	public:
-		EmberMotifLogRecord(const char* filePath) {
+		EmberMotifLogRecord(const char* filePath) : motifCount(0), binary(false) {
 			loggerFile = fopen(filePath, "wt");
 		}
 
+		// a binary shard, only used by the engines of one thread
+		EmberMotifLogRecord(const char* filePath, uint32_t rank, uint32_t thread);
+
 		~EmberMotifLogRecord() {
-			if(NULL != loggerFile) {
-				fclose(loggerFile);
-			}
+			close();
 		}
 
 		void increment() {
@@ -58,18 +64,36 @@ class EmberMotifLogRecord {
 			return loggerFile;
 		}
 
-		void invalidateFile() {
-			loggerFile = NULL;
+		bool isBinary() const {
+			return binary;
 		}
 
+		uint32_t nameId(const std::string& name);
+		void writeMotif(int32_t jobID, int32_t rank, int32_t motifNum, uint32_t nameID,
+			uint64_t startPs, uint64_t endPs);
+
+		void close();
+
 	protected:
+		template< class T > void put( T value ) {
+			if ( buffer.size() + sizeof(T) > buffer.capacity() ) {
+				flush();
+			}
+			const uint8_t* bytes = (const uint8_t*) &value;
+			buffer.insert( buffer.end(), bytes, bytes + sizeof(T) );
+		}
+		void flush();
+
 		FILE* loggerFile;
 		uint32_t motifCount;
+		bool binary;
+		std::vector<uint8_t> buffer;
+		std::unordered_map<std::string, uint32_t> names;
 };
 
 class EmberMotifLog : public ComponentExtension {
 	public:
-    EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID);
+    EmberMotifLog(SST::ComponentId_t cid, const std::string logPathPrefix, const uint32_t jobID, bool binary = false);
     ~EmberMotifLog();
     void logMotifStart(int motifNum);
     void logMotifEnd(const std::string& name, const int motifNum);
@@ -81,6 +105,12 @@ class EmberMotifLog : public ComponentExtension {
         int rank;
         std::string start_time;
         int currentMotifNum;
+
+        // binary log
+        TimeConverter* picoTimeConv;
+        uint64_t startPs;
+        std::string lastName;
+        uint32_t lastNameID;
 };
 
 }
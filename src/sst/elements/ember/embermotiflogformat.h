@@ -0,0 +1,102 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_MOTIF_LOG_FORMAT
+#define _H_EMBER_MOTIF_LOG_FORMAT
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <string>
+
+/*
+ * Binary motif log, written by engines with motifLogFormat=binary. Each SST
+ * thread writes its own shard, <prefix>[-<rank>].<thread>.mlog, so engines
+ * never share a file. sst-embermotiflog merges shards into the text log.
+ *
+ *   EmberMotifLogFileHeader
+ *   records, each a one byte EmberMotifLogType followed by its fields
+ *
+ * Fields are packed in host byte order. A motif name is written once per
+ * shard, the first time it is used, and referred to by id after that. Motifs
+ * are written when they end so a shard is in end time order.
+ */
+
+#define EMBER_MOTIF_LOG_MAGIC "EMBERMLG"
+#define EMBER_MOTIF_LOG_VERSION 1
+
+enum EmberMotifLogType {
+    EMBER_MOTIF_LOG_NAME = 1,   // name id (u32), length (u16), name
+    EMBER_MOTIF_LOG_MOTIF       // job (i32), rank (i32), motifNum (i32), name id (u32), start ps (u64), end ps (u64)
+};
+
+struct EmberMotifLogFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t rank;
+    uint32_t thread;
+    uint32_t pad;
+};
+
+/*
+ * The text a text log prints for a time, UnitAlgebra::toStringBestSI() of
+ * the elapsed time: the largest unit that keeps the value at or above 1,
+ * rounded to 6 significant digits with trailing zeros dropped. It is worked
+ * out from the integer ps in decimal so sst-embermotiflog prints the same
+ * strings as a text log.
+ */
+inline std::string emberMotifLogTime( uint64_t ps ) {
+    static const char* units[] = { "ps", "ns", "us", "ms", "s", "ks", "Ms" };
+    static const size_t precision = 6;
+
+    if ( 0 == ps ) {
+        return "0 s";
+    }
+
+    std::string digits = std::to_string( ps );
+    size_t unit = std::min( ( digits.size() - 1 ) / 3, (size_t) 6 );
+    size_t whole = digits.size() - 3 * unit;
+
+    // the unit is picked before rounding, 999.9995 ns prints as 1000 ns
+    if ( digits.size() > precision ) {
+        bool carry = digits[precision] >= '5';
+        digits.resize( precision );
+        for ( size_t i = precision; carry && i > 0; i-- ) {
+            carry = '9' == digits[i - 1];
+            digits[i - 1] = carry ? '0' : digits[i - 1] + 1;
+        }
+        if ( carry ) {
+            digits.insert( 0, "1" );
+            digits.pop_back();
+            whole++;
+        }
+    }
+
+    if ( digits.size() < whole ) {
+        digits.append( whole - digits.size(), '0' );
+    }
+
+    std::string fraction = digits.substr( whole );
+    fraction.erase( fraction.find_last_not_of( '0' ) + 1 );
+
+    std::string text = digits.substr( 0, whole );
+    if ( ! fraction.empty() ) {
+        text += "." + fraction;
+    }
+    return text + " " + units[unit];
+}
+
+#endif
@@ -0,0 +1,167 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_REPLAY_FORMAT
+#define _H_EMBER_REPLAY_FORMAT
+
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * Per-rank stream of the calls a motif made, written by the engine's
+ * motifRecord mode and read back by the Replay motif.
+ *
+ *   EmberReplayFileHeader
+ *   records, each a one byte EmberReplayType followed by its fields
+ *
+ * Fields are packed in host byte order, counts, peers, tags, communicators
+ * and request ids are 32 bit. Arrays (request ids, per-rank counts) follow
+ * their record 4 byte aligned so a reader can use them in place. Requests are
+ * numbered in the order they were posted, a request posted again after a
+ * test completed it keeps its id. This header has no SST
+ * dependencies so tools (e.g. the zodiac trace converter) can share it.
+ */
+
+#define EMBER_REPLAY_MAGIC "EMBERRPL"
+#define EMBER_REPLAY_VERSION 1
+
+// request id recorded for a request that was never posted
+#define EMBER_REPLAY_NO_REQUEST 0xffffffff
+
+enum EmberReplayType {
+    EMBER_REPLAY_MOTIF = 1,     // motifNum, name length (u8), name
+    EMBER_REPLAY_COMPUTE,       // nanoseconds (u64)
+    EMBER_REPLAY_GETTIME,
+    EMBER_REPLAY_INIT,
+    EMBER_REPLAY_FINI,
+    EMBER_REPLAY_RANK,          // comm
+    EMBER_REPLAY_SIZE,          // comm
+    EMBER_REPLAY_MAKE_PROGRESS,
+    EMBER_REPLAY_SEND,          // count, dtype, dest, tag, comm
+    EMBER_REPLAY_ISEND,         // count, dtype, dest, tag, comm, req
+    EMBER_REPLAY_RECV,          // count, dtype, src, tag, comm
+    EMBER_REPLAY_IRECV,         // count, dtype, src, tag, comm, req
+    EMBER_REPLAY_WAIT,          // req
+    EMBER_REPLAY_WAITALL,       // n, req[n]
+    EMBER_REPLAY_WAITANY,       // n, req[n]
+    EMBER_REPLAY_TEST,          // req
+    EMBER_REPLAY_TESTANY,       // n, req[n]
+    EMBER_REPLAY_CANCEL,        // req
+    EMBER_REPLAY_BARRIER,       // comm
+    EMBER_REPLAY_BCAST,         // count, dtype, root, comm
+    EMBER_REPLAY_REDUCE,        // count, dtype, op, root, comm
+    EMBER_REPLAY_ALLREDUCE,     // count, dtype, op, comm
+    EMBER_REPLAY_SCATTER,       // sendCnt, sendType, recvCnt, recvType, root, comm
+    EMBER_REPLAY_SCATTERV,      // sendType, recvCnt, recvType, root, comm, n, sendCnts[n], displs[n]
+    EMBER_REPLAY_ALLGATHER,     // sendCnt, sendType, recvCnt, recvType, comm
+    EMBER_REPLAY_ALLGATHERV,    // sendCnt, sendType, recvType, comm, n, recvCnts[n], recvDsp[n]
+    EMBER_REPLAY_ALLTOALL,      // sendCnt, sendType, recvCnt, recvType, comm
+    EMBER_REPLAY_ALLTOALLV,     // sendType, recvType, comm, n, sendCnts[n], sendDsp[n], recvCnts[n], recvDsp[n]
+    EMBER_REPLAY_COMM_SPLIT,    // comm, color, key
+    EMBER_REPLAY_COMM_CREATE,   // comm, n, ranks[n]
+    EMBER_REPLAY_COMM_DESTROY,  // comm
+    EMBER_REPLAY_NUM_TYPES
+};
+
+// a dtype field is the Hermes PayloadDataType (u8) followed by its size in bytes (u8)
+// an op field is the Hermes ReductionOpType (u8), user functions are recorded as Func
+
+// the Hermes ReductionOpType values, for tools that don't include Hermes
+enum EmberReplayOp {
+    EMBER_REPLAY_OP_NOP,
+    EMBER_REPLAY_OP_SUM,
+    EMBER_REPLAY_OP_MIN,
+    EMBER_REPLAY_OP_MAX,
+    EMBER_REPLAY_OP_FUNC
+};
+
+struct EmberReplayFileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t rank;
+    // largest request array of a waitall, waitany or testany
+    uint32_t maxRequestArray;
+    uint32_t pad;
+    // filled in when the stream is closed, 0 if the run did not finish
+    uint64_t numRecords;
+};
+
+/*
+ * Walks the records of a stream held in memory. Every read is checked against
+ * the end of the stream first. A read that does not fit fails the cursor,
+ * which then stays at the end: get() returns 0 and getString() and
+ * getArray() return NULL, so check ok() before using what they return.
+ */
+class EmberReplayCursor {
+  public:
+    EmberReplayCursor() : m_base( NULL ), m_pos( NULL ), m_end( NULL ), m_failed( false ) {}
+    EmberReplayCursor( const uint8_t* base, uint64_t length ) :
+        m_base( base ), m_pos( base + sizeof(EmberReplayFileHeader) ), m_end( base + length ),
+        m_failed( length < sizeof(EmberReplayFileHeader) )
+    {
+        if ( m_failed ) {
+            m_pos = m_end;
+        }
+    }
+
+    bool atEnd() const { return m_pos >= m_end; }
+    uint64_t offset() const { return m_pos - m_base; }
+
+    // false if a read ran past the end of the stream
+    bool ok() const { return ! m_failed; }
+
+    template< class T > T get() {
+        T value = 0;
+        const uint8_t* data = take( sizeof(T) );
+        if ( data ) {
+            memcpy( &value, data, sizeof(T) );
+        }
+        return value;
+    }
+
+    const char* getString( uint32_t length ) {
+        return (const char*) take( length );
+    }
+
+    // the stream is 8 byte aligned in memory so the array can be used in place
+    template< class T > const T* getArray( uint32_t n ) {
+        uint64_t pad = ( ( offset() + 3 ) & ~(uint64_t) 3 ) - offset();
+        if ( ! take( pad ) ) {
+            return NULL;
+        }
+        return (const T*) take( (uint64_t) n * sizeof(T) );
+    }
+
+  private:
+    // the next length bytes, NULL and the cursor fails if the stream is shorter
+    const uint8_t* take( uint64_t length ) {
+        if ( m_failed || length > (uint64_t) ( m_end - m_pos ) ) {
+            m_failed = true;
+            m_pos = m_end;
+            return NULL;
+        }
+        const uint8_t* data = m_pos;
+        m_pos += length;
+        return data;
+    }
+
+    const uint8_t* m_base;
+    const uint8_t* m_pos;
+    const uint8_t* m_end;
+    bool m_failed;
+};
+
+#endif
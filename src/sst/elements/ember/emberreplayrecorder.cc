@@ -0,0 +1,388 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <climits>
+#include <cstddef>
+#include <sstream>
+
+#include "emberreplayrecorder.h"
+
+using namespace SST::Ember;
+using namespace SST::Hermes::MP;
+
+static_assert( (int) Sum == EMBER_REPLAY_OP_SUM && (int) Max == EMBER_REPLAY_OP_MAX &&
+        (int) Func == EMBER_REPLAY_OP_FUNC, "EmberReplayOp must match ReductionOpType" );
+
+EmberReplayRecorder::EmberReplayRecorder( Output* output, const std::string& prefix ) :
+    m_output( output ),
+    m_prefix( prefix ),
+    m_file( NULL ),
+    m_written( sizeof(EmberReplayFileHeader) ),
+    m_numRecords( 0 ),
+    m_maxRequestArray( 0 ),
+    m_nextRequest( 0 ),
+    m_worldSize( 0 )
+{
+    m_buf.reserve( 1 << 16 );
+}
+
+EmberReplayRecorder::~EmberReplayRecorder()
+{
+    close();
+}
+
+void EmberReplayRecorder::open( int rank )
+{
+    std::ostringstream fileName;
+    fileName << m_prefix << "." << rank;
+
+    m_file = fopen( fileName.str().c_str(), "wb" );
+    if ( NULL == m_file ) {
+        m_output->fatal( CALL_INFO, -1, "Error: unable to open the motif record %s\n", fileName.str().c_str() );
+    }
+
+    EmberReplayFileHeader header;
+    memset( &header, 0, sizeof(header) );
+    memcpy( header.magic, EMBER_REPLAY_MAGIC, sizeof(header.magic) );
+    header.version = EMBER_REPLAY_VERSION;
+    header.rank = rank;
+
+    if ( 1 != fwrite( &header, sizeof(header), 1, m_file ) ) {
+        m_output->fatal( CALL_INFO, -1, "Error: write to the motif record %s failed\n", fileName.str().c_str() );
+    }
+
+    m_output->verbose( CALL_INFO, 1, 0, "recording motifs to %s\n", fileName.str().c_str() );
+}
+
+void EmberReplayRecorder::close()
+{
+    if ( NULL == m_file ) {
+        return;
+    }
+
+    flush();
+
+    if ( 0 != fseek( m_file, offsetof( EmberReplayFileHeader, maxRequestArray ), SEEK_SET ) ||
+            1 != fwrite( &m_maxRequestArray, sizeof(m_maxRequestArray), 1, m_file ) ||
+            0 != fseek( m_file, offsetof( EmberReplayFileHeader, numRecords ), SEEK_SET ) ||
+            1 != fwrite( &m_numRecords, sizeof(m_numRecords), 1, m_file ) ) {
+        m_output->output( "WARNING: could not finish the header of motif record %s\n", m_prefix.c_str() );
+    }
+
+    fclose( m_file );
+    m_file = NULL;
+}
+
+void EmberReplayRecorder::flush()
+{
+    if ( NULL == m_file || m_buf.empty() ) {
+        return;
+    }
+    if ( m_buf.size() != fwrite( &m_buf[0], 1, m_buf.size(), m_file ) ) {
+        m_output->fatal( CALL_INFO, -1, "Error: write to the motif record %s failed\n", m_prefix.c_str() );
+    }
+    m_written += m_buf.size();
+    m_buf.clear();
+}
+
+void EmberReplayRecorder::putArray( const int* array, uint32_t n )
+{
+    while ( ( m_written + m_buf.size() ) & 3 ) {
+        put<uint8_t>( 0 );
+    }
+    for ( uint32_t i = 0; i < n; i++ ) {
+        put<int32_t>( array ? array[i] : 0 );
+    }
+}
+
+void EmberReplayRecorder::motif( int motifNum, const std::string& name )
+{
+    uint8_t length = name.size() > UCHAR_MAX ? UCHAR_MAX : name.size();
+
+    // the requests and communicators of the last motif went with it
+    m_requests.clear();
+    m_newComms.clear();
+
+    put( EMBER_REPLAY_MOTIF );
+    put<uint32_t>( motifNum );
+    put<uint8_t>( length );
+    for ( uint8_t i = 0; i < length; i++ ) {
+        put<char>( name[i] );
+    }
+}
+
+void EmberReplayRecorder::compute( uint64_t nanoSeconds )
+{
+    put( EMBER_REPLAY_COMPUTE );
+    put<uint64_t>( nanoSeconds );
+}
+
+void EmberReplayRecorder::send( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID dest,
+        uint32_t tag, Communicator comm )
+{
+    put( EMBER_REPLAY_SEND );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint32_t>( dest );
+    put<uint32_t>( tag );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::isend( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID dest,
+        uint32_t tag, Communicator comm, MessageRequest* req )
+{
+    put( EMBER_REPLAY_ISEND );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint32_t>( dest );
+    put<uint32_t>( tag );
+    put<uint32_t>( comm );
+    put<uint32_t>( postRequest( req ) );
+}
+
+void EmberReplayRecorder::recv( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID src,
+        uint32_t tag, Communicator comm )
+{
+    put( EMBER_REPLAY_RECV );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint32_t>( src );
+    put<uint32_t>( tag );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::irecv( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID src,
+        uint32_t tag, Communicator comm, MessageRequest* req )
+{
+    put( EMBER_REPLAY_IRECV );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint32_t>( src );
+    put<uint32_t>( tag );
+    put<uint32_t>( comm );
+    put<uint32_t>( postRequest( req ) );
+}
+
+uint32_t EmberReplayRecorder::postRequest( MessageRequest* req )
+{
+    // a motif reposts into the same request once the last use completed, a
+    // request only a test completed keeps its id so the replay reuses its slot
+    auto iter = m_requests.find( req );
+    if ( iter != m_requests.end() ) {
+        return iter->second;
+    }
+    uint32_t id = m_nextRequest++;
+    m_requests[req] = id;
+    return id;
+}
+
+uint32_t EmberReplayRecorder::findRequest( MessageRequest* req, bool complete )
+{
+    auto iter = m_requests.find( req );
+    if ( iter == m_requests.end() ) {
+        return EMBER_REPLAY_NO_REQUEST;
+    }
+    uint32_t id = iter->second;
+    if ( complete ) {
+        m_requests.erase( iter );
+    }
+    return id;
+}
+
+void EmberReplayRecorder::wait( MessageRequest* req )
+{
+    put( EMBER_REPLAY_WAIT );
+    put<uint32_t>( findRequest( req, true ) );
+}
+
+void EmberReplayRecorder::test( MessageRequest* req )
+{
+    put( EMBER_REPLAY_TEST );
+    put<uint32_t>( findRequest( req, false ) );
+}
+
+void EmberReplayRecorder::requests( EmberReplayType type, int count, MessageRequest req[], bool complete )
+{
+    std::vector<int> ids( count );
+    for ( int i = 0; i < count; i++ ) {
+        ids[i] = findRequest( &req[i], complete );
+    }
+    if ( (uint32_t) count > m_maxRequestArray ) {
+        m_maxRequestArray = count;
+    }
+
+    put( type );
+    put<uint32_t>( count );
+    putArray( ids.data(), count );
+}
+
+void EmberReplayRecorder::cancel( MessageRequest req )
+{
+    // cancel takes the request by value, which the post has filled in by now
+    uint32_t id = EMBER_REPLAY_NO_REQUEST;
+    for ( auto iter = m_requests.begin(); iter != m_requests.end(); ++iter ) {
+        if ( NULL != req && *iter->first == req ) {
+            id = iter->second;
+            break;
+        }
+    }
+
+    put( EMBER_REPLAY_CANCEL );
+    put<uint32_t>( id );
+}
+
+void EmberReplayRecorder::bcast( uint32_t count, PayloadDataType dtype, int dtypeSize, int root, Communicator comm )
+{
+    put( EMBER_REPLAY_BCAST );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint32_t>( root );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::reduce( uint32_t count, PayloadDataType dtype, int dtypeSize, ReductionOperation op,
+        int root, Communicator comm )
+{
+    put( EMBER_REPLAY_REDUCE );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint8_t>( op->type );
+    put<uint32_t>( root );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::allreduce( uint32_t count, PayloadDataType dtype, int dtypeSize, ReductionOperation op,
+        Communicator comm )
+{
+    put( EMBER_REPLAY_ALLREDUCE );
+    put<uint32_t>( count );
+    putType( dtype, dtypeSize );
+    put<uint8_t>( op->type );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::collective( EmberReplayType type, uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+        uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, Communicator comm )
+{
+    put( type );
+    put<uint32_t>( sendCnt );
+    putType( sendType, sendTypeSize );
+    put<uint32_t>( recvCnt );
+    putType( recvType, recvTypeSize );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::scatter( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+        uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, int root, Communicator comm )
+{
+    put( EMBER_REPLAY_SCATTER );
+    put<uint32_t>( sendCnt );
+    putType( sendType, sendTypeSize );
+    put<uint32_t>( recvCnt );
+    putType( recvType, recvTypeSize );
+    put<uint32_t>( root );
+    put<uint32_t>( comm );
+}
+
+void EmberReplayRecorder::scatterv( const int* sendCnts, const int* displs, PayloadDataType sendType, int sendTypeSize,
+        uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, int root, Communicator comm )
+{
+    // only the root has counts
+    uint32_t n = sendCnts ? commSize( comm, "Scatterv" ) : 0;
+
+    put( EMBER_REPLAY_SCATTERV );
+    putType( sendType, sendTypeSize );
+    put<uint32_t>( recvCnt );
+    putType( recvType, recvTypeSize );
+    put<uint32_t>( root );
+    put<uint32_t>( comm );
+    put<uint32_t>( n );
+    putArray( sendCnts, n );
+    putArray( displs, n );
+}
+
+void EmberReplayRecorder::allgatherv( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+        const int* recvCnts, const int* recvDsp, PayloadDataType recvType, int recvTypeSize, Communicator comm )
+{
+    uint32_t n = commSize( comm, "Allgatherv" );
+
+    put( EMBER_REPLAY_ALLGATHERV );
+    put<uint32_t>( sendCnt );
+    putType( sendType, sendTypeSize );
+    putType( recvType, recvTypeSize );
+    put<uint32_t>( comm );
+    put<uint32_t>( n );
+    putArray( recvCnts, n );
+    putArray( recvDsp, n );
+}
+
+void EmberReplayRecorder::alltoallv( const int* sendCnts, const int* sendDsp, PayloadDataType sendType, int sendTypeSize,
+        const int* recvCnts, const int* recvDsp, PayloadDataType recvType, int recvTypeSize, Communicator comm )
+{
+    uint32_t n = commSize( comm, "Alltoallv" );
+
+    put( EMBER_REPLAY_ALLTOALLV );
+    putType( sendType, sendTypeSize );
+    putType( recvType, recvTypeSize );
+    put<uint32_t>( comm );
+    put<uint32_t>( n );
+    putArray( sendCnts, n );
+    putArray( sendDsp, n );
+    putArray( recvCnts, n );
+    putArray( recvDsp, n );
+}
+
+void EmberReplayRecorder::commSplit( Communicator comm, int color, int key )
+{
+    put( EMBER_REPLAY_COMM_SPLIT );
+    put<uint32_t>( comm );
+    put<int32_t>( color );
+    put<int32_t>( key );
+}
+
+void EmberReplayRecorder::commCreate( Communicator comm, std::vector<int>& ranks, Communicator* newComm )
+{
+    m_newComms.push_back( std::make_pair( newComm, (uint32_t) ranks.size() ) );
+
+    put( EMBER_REPLAY_COMM_CREATE );
+    put<uint32_t>( comm );
+    put<uint32_t>( ranks.size() );
+    putArray( ranks.data(), ranks.size() );
+}
+
+uint32_t EmberReplayRecorder::commSize( Communicator comm, const char* call )
+{
+    if ( GroupWorld == comm ) {
+        if ( m_worldSize <= 0 ) {
+            m_output->fatal( CALL_INFO, -1, "Error: can't record %s before the motif knows the world size\n", call );
+        }
+        return m_worldSize;
+    }
+
+    // a motif passes the new communicator by value so its create has run,
+    // the latest create that produced this value is the one in use
+    for ( auto iter = m_newComms.rbegin(); iter != m_newComms.rend(); ++iter ) {
+        if ( *iter->first == comm ) {
+            return iter->second;
+        }
+    }
+
+    m_output->fatal( CALL_INFO, -1, "Error: can't record %s on communicator %" PRIu32 ", only GroupWorld and "
+            "communicators from commCreate have a known size\n", call, comm );
+    return 0;
+}
@@ -0,0 +1,151 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_EMBER_REPLAY_RECORDER
+#define _H_EMBER_REPLAY_RECORDER
+
+#include <stdio.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <sst/core/output.h>
+#include <sst/elements/hermes/msgapi.h>
+
+#include "emberreplayformat.h"
+
+namespace SST {
+namespace Ember {
+
+/*
+ * Writes the calls the motifs of one engine enqueue to <prefix>.<rank> in
+ * the format described in emberreplayformat.h. Calls are recorded when they
+ * are enqueued, in order, so the stream holds exactly what the motifs
+ * generated on this run. Requests are identified by the MessageRequest the
+ * motif passed in, communicators by value.
+ */
+class EmberReplayRecorder {
+    typedef Hermes::MP::Communicator Communicator;
+    typedef Hermes::MP::RankID RankID;
+    typedef Hermes::MP::PayloadDataType PayloadDataType;
+    typedef Hermes::MP::MessageRequest MessageRequest;
+    typedef Hermes::MP::ReductionOperation ReductionOperation;
+
+  public:
+    EmberReplayRecorder( Output* output, const std::string& prefix );
+    ~EmberReplayRecorder();
+
+    void open( int rank );
+    void close();
+
+    void motif( int motifNum, const std::string& name );
+    void compute( uint64_t nanoSeconds );
+    void getTime() { put( EMBER_REPLAY_GETTIME ); }
+    void init() { put( EMBER_REPLAY_INIT ); }
+    void fini() { put( EMBER_REPLAY_FINI ); }
+    void rank( Communicator comm ) { put( EMBER_REPLAY_RANK ); put<uint32_t>( comm ); }
+    void size( Communicator comm ) { put( EMBER_REPLAY_SIZE ); put<uint32_t>( comm ); }
+    void makeProgress() { put( EMBER_REPLAY_MAKE_PROGRESS ); }
+
+    void send( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID dest, uint32_t tag, Communicator comm );
+    void isend( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID dest, uint32_t tag, Communicator comm,
+            MessageRequest* req );
+    void recv( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID src, uint32_t tag, Communicator comm );
+    void irecv( uint32_t count, PayloadDataType dtype, int dtypeSize, RankID src, uint32_t tag, Communicator comm,
+            MessageRequest* req );
+
+    void wait( MessageRequest* req );
+    void waitall( int count, MessageRequest req[] ) { requests( EMBER_REPLAY_WAITALL, count, req, true ); }
+    void waitany( int count, MessageRequest req[] ) { requests( EMBER_REPLAY_WAITANY, count, req, false ); }
+    void test( MessageRequest* req );
+    void testany( int count, MessageRequest req[] ) { requests( EMBER_REPLAY_TESTANY, count, req, false ); }
+    void cancel( MessageRequest req );
+
+    void barrier( Communicator comm ) { put( EMBER_REPLAY_BARRIER ); put<uint32_t>( comm ); }
+    void bcast( uint32_t count, PayloadDataType dtype, int dtypeSize, int root, Communicator comm );
+    void reduce( uint32_t count, PayloadDataType dtype, int dtypeSize, ReductionOperation op, int root, Communicator comm );
+    void allreduce( uint32_t count, PayloadDataType dtype, int dtypeSize, ReductionOperation op, Communicator comm );
+    void scatter( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+            uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, int root, Communicator comm );
+    void scatterv( const int* sendCnts, const int* displs, PayloadDataType sendType, int sendTypeSize,
+            uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, int root, Communicator comm );
+    void allgather( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+            uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, Communicator comm ) {
+        collective( EMBER_REPLAY_ALLGATHER, sendCnt, sendType, sendTypeSize, recvCnt, recvType, recvTypeSize, comm );
+    }
+    void allgatherv( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+            const int* recvCnts, const int* recvDsp, PayloadDataType recvType, int recvTypeSize, Communicator comm );
+    void alltoall( uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+            uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, Communicator comm ) {
+        collective( EMBER_REPLAY_ALLTOALL, sendCnt, sendType, sendTypeSize, recvCnt, recvType, recvTypeSize, comm );
+    }
+    void alltoallv( const int* sendCnts, const int* sendDsp, PayloadDataType sendType, int sendTypeSize,
+            const int* recvCnts, const int* recvDsp, PayloadDataType recvType, int recvTypeSize, Communicator comm );
+
+    void commSplit( Communicator comm, int color, int key );
+    void commCreate( Communicator comm, std::vector<int>& ranks, Communicator* newComm );
+    void commDestroy( Communicator comm ) { put( EMBER_REPLAY_COMM_DESTROY ); put<uint32_t>( comm ); }
+
+    // world size, for the per-rank arrays of collectives on GroupWorld
+    void setWorldSize( int size ) { m_worldSize = size; }
+
+  private:
+    template< class T > void put( T value ) {
+        if ( m_buf.size() + sizeof(T) > m_buf.capacity() ) {
+            flush();
+        }
+        const uint8_t* bytes = (const uint8_t*) &value;
+        m_buf.insert( m_buf.end(), bytes, bytes + sizeof(T) );
+    }
+    void put( EmberReplayType type ) {
+        put<uint8_t>( type );
+        ++m_numRecords;
+    }
+    void putType( PayloadDataType dtype, int dtypeSize ) {
+        put<uint8_t>( dtype );
+        put<uint8_t>( dtypeSize );
+    }
+    void putArray( const int* array, uint32_t n );
+    void flush();
+
+    void requests( EmberReplayType type, int count, MessageRequest req[], bool complete );
+    uint32_t postRequest( MessageRequest* req );
+    uint32_t findRequest( MessageRequest* req, bool complete );
+    void collective( EmberReplayType type, uint32_t sendCnt, PayloadDataType sendType, int sendTypeSize,
+            uint32_t recvCnt, PayloadDataType recvType, int recvTypeSize, Communicator comm );
+    uint32_t commSize( Communicator comm, const char* call );
+
+    Output*     m_output;
+    std::string m_prefix;
+    FILE*       m_file;
+    std::vector<uint8_t> m_buf;
+    uint64_t    m_written;
+    uint64_t    m_numRecords;
+    uint32_t    m_maxRequestArray;
+
+    uint32_t    m_nextRequest;
+    std::unordered_map<MessageRequest*, uint32_t> m_requests;
+
+    int         m_worldSize;
+    // created communicators and their sizes, the value is only known once the create has run
+    std::vector< std::pair<Communicator*, uint32_t> > m_newComms;
+};
+
+}
+}
+
+#endif
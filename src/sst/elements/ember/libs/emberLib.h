@@ -19,6 +19,8 @@
 
 #include <sst/core/subcomponent.h>
 #include "sst/elements/hermes/hermes.h"
+#include "embereventpool.h"
+#include "emberreplayrecorder.h"
 
 namespace SST {
 namespace Ember {
@@ -27,14 +29,26 @@ class EmberLib : public SST::Module {
   public:
     SST_ELI_REGISTER_MODULE_API(SST::Ember::EmberLib)
 
-    EmberLib() : m_output(NULL), m_api(NULL) {}
+    EmberLib() : m_output(NULL), m_api(NULL), m_eventPool(NULL), m_recorder(NULL) {}
 
 	void initApi( Hermes::Interface* api ) { m_api = api; }
 	void initOutput( SST::Output* output ) { m_output = output; }
+	void initEventPool( EmberEventPool* pool ) { m_eventPool = pool; }
+	void initRecorder( EmberReplayRecorder* recorder ) { m_recorder = recorder; }
 
   protected:
+    template < class T, class... Args >
+    T* newEvent( Args&&... args ) {
+        if ( m_eventPool ) {
+            return m_eventPool->alloc<T>( std::forward<Args>(args)... );
+        }
+        return new T( std::forward<Args>(args)... );
+    }
+
 	Output* m_output;
 	Hermes::Interface* m_api;
+	EmberEventPool* m_eventPool;
+	EmberReplayRecorder* m_recorder;
 };
 
 }
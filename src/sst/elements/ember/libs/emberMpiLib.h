@@ -135,7 +135,7 @@ class EmberMpiLib : public EmberLib {
 		{ "spyplotmode", "Sets the spyplot generation mode, 0 = none, 1 = spy on sends", "0" },
 	)
 
-    typedef std::queue<EmberEvent*> Queue;
+    typedef EmberEventQueue Queue;
 
 	EmberMpiLib( Params& params );
 	~EmberMpiLib() {
@@ -145,25 +145,32 @@ class EmberMpiLib : public EmberLib {
 	}
 
     void init( Queue& q ) {
-		q.push( new EmberInitEvent( api(), m_output, m_Stats[Init] ) );
+		if ( m_recorder ) m_recorder->init();
+		q.push( newEvent<EmberInitEvent>( api(), m_output, m_Stats[Init] ) );
 	}
     void fini( Queue& q ) {
-		q.push( new EmberFinalizeEvent( api(), m_output, m_Stats[Finalize] ) );
+		if ( m_recorder ) m_recorder->fini();
+		q.push( newEvent<EmberFinalizeEvent>( api(), m_output, m_Stats[Finalize] ) );
 	}
     void rank( Queue& q, Communicator comm, uint32_t* rankPtr) {
-		q.push( new EmberRankEvent( api(), m_output, m_Stats[Rank], comm, rankPtr ) );
+		if ( m_recorder ) m_recorder->rank( comm );
+		q.push( newEvent<EmberRankEvent>( api(), m_output, m_Stats[Rank], comm, rankPtr ) );
 	}
     void size( Queue& q, Communicator comm, int* sizePtr) {
-		q.push( new EmberSizeEvent( api(), m_output, m_Stats[Size], comm, sizePtr ) );
+		if ( m_recorder ) m_recorder->size( comm );
+		q.push( newEvent<EmberSizeEvent>( api(), m_output, m_Stats[Size], comm, sizePtr ) );
 	}
     void makeProgress( Queue& q ) {
-		q.push( new EmberMakeProgressEvent( api(), m_output, m_Stats[Init] ) );
+		if ( m_recorder ) m_recorder->makeProgress();
+		q.push( newEvent<EmberMakeProgressEvent>( api(), m_output, m_Stats[Init] ) );
 	}
     void barrier( Queue& q, Communicator comm ) {
-		q.push( new EmberBarrierEvent( api(), m_output, m_Stats[Barrier], comm ) );
+		if ( m_recorder ) m_recorder->barrier( comm );
+		q.push( newEvent<EmberBarrierEvent>( api(), m_output, m_Stats[Barrier], comm ) );
 	}
     void send(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID dest, uint32_t tag, Communicator group) {
-    	q.push( new EmberSendEvent( api(), m_output, m_Stats[Send], payload, count, dtype, dest, tag, group ) );
+		if ( m_recorder ) m_recorder->send( count, dtype, sizeofDataType(dtype), dest, tag, group );
+    	q.push( newEvent<EmberSendEvent>( api(), m_output, m_Stats[Send], payload, count, dtype, dest, tag, group ) );
 
     	size_t bytes = api().sizeofDataType(dtype);
 
@@ -176,8 +183,9 @@ class EmberMpiLib : public EmberLib {
     void isend( Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID dest, uint32_t tag, Communicator group,
         MessageRequest* req ) {
         if (!req) abort_output.fatal(CALL_INFO, -1, "isend requires nonnull MessageRequest\n");
+		if ( m_recorder ) m_recorder->isend( count, dtype, sizeofDataType(dtype), dest, tag, group, req );
 
-    	q.push( new EmberISendEvent( api(), m_output, m_Stats[Isend], payload, count, dtype, dest, tag, group, req ) );
+    	q.push( newEvent<EmberISendEvent>( api(), m_output, m_Stats[Isend], payload, count, dtype, dest, tag, group, req ) );
 
 		size_t bytes = api().sizeofDataType(dtype);
 
@@ -191,81 +199,100 @@ class EmberMpiLib : public EmberLib {
     void recv(Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID src, uint32_t tag, Communicator group,
 		   	MessageResponse* resp = NULL )
 	{
-		q.push( new EmberRecvEvent( api(), m_output, m_Stats[Recv], payload, count, dtype, src, tag, group, resp ) );
+		if ( m_recorder ) m_recorder->recv( count, dtype, sizeofDataType(dtype), src, tag, group );
+		q.push( newEvent<EmberRecvEvent>( api(), m_output, m_Stats[Recv], payload, count, dtype, src, tag, group, resp ) );
 	}
     void irecv( Queue& q, const Hermes::MemAddr& payload, uint32_t count, PayloadDataType dtype, RankID source, uint32_t tag, Communicator group,
         MessageRequest* req ) {
-		q.push( new EmberIRecvEvent( api(), m_output, m_Stats[Irecv], payload, count, dtype, source, tag, group, req ) );
+		if ( m_recorder ) m_recorder->irecv( count, dtype, sizeofDataType(dtype), source, tag, group, req );
+		q.push( newEvent<EmberIRecvEvent>( api(), m_output, m_Stats[Irecv], payload, count, dtype, source, tag, group, req ) );
 	}
 
     void cancel( Queue& q, MessageRequest req ) {
-		q.push( new EmberCancelEvent( api(), m_output, m_Stats[Waitall], req ) );
+		if ( m_recorder ) m_recorder->cancel( req );
+		q.push( newEvent<EmberCancelEvent>( api(), m_output, m_Stats[Waitall], req ) );
 	}
 
     void test( Queue& q, MessageRequest* req, int* flag, MessageResponse* resp = NULL ) {
 		*flag = 0;
-		q.push( new EmberTestEvent( api(), m_output, m_Stats[Waitall], req, flag, resp ) );
+		if ( m_recorder ) m_recorder->test( req );
+		q.push( newEvent<EmberTestEvent>( api(), m_output, m_Stats[Waitall], req, flag, resp ) );
 	}
     void testany( Queue& q, int count, MessageRequest req[], int* indx, int* flag, MessageResponse* resp = NULL ) {
 		*flag = 0;
-		q.push( new EmberTestanyEvent( api(), m_output, m_Stats[Waitall], count, req, indx, flag, resp ) );
+		if ( m_recorder ) m_recorder->testany( count, req );
+		q.push( newEvent<EmberTestanyEvent>( api(), m_output, m_Stats[Waitall], count, req, indx, flag, resp ) );
 	}
     void wait( Queue& q, MessageRequest* req, MessageResponse* resp = NULL ) {
-		q.push( new EmberWaitEvent( api(), m_output, m_Stats[Wait], req, resp, false ) );
+		if ( m_recorder ) m_recorder->wait( req );
+		q.push( newEvent<EmberWaitEvent>( api(), m_output, m_Stats[Wait], req, resp, false ) );
 	}
     void waitall( Queue& q, int count, MessageRequest req[], MessageResponse* resp[] = NULL ) {
-		q.push( new EmberWaitallEvent( api(), m_output, m_Stats[Waitall], count, req, resp ) );
+		if ( m_recorder ) m_recorder->waitall( count, req );
+		q.push( newEvent<EmberWaitallEvent>( api(), m_output, m_Stats[Waitall], count, req, resp ) );
 	}
 
     void waitany( Queue& q, int count, MessageRequest req[], int *indx, MessageResponse* resp = NULL ) {
-		q.push( new EmberWaitanyEvent( api(), m_output, m_Stats[Waitall],
+		if ( m_recorder ) m_recorder->waitany( count, req );
+		q.push( newEvent<EmberWaitanyEvent>( api(), m_output, m_Stats[Waitall],
         count, req, indx, resp ) );
 	}
 
     void commSplit( Queue& q, Communicator oldcom, int color, int key, Communicator* newCom ) {
-		q.push( new EmberCommSplitEvent( api(), m_output, m_Stats[Commsplit], oldcom, color, key, newCom ) );
+		if ( m_recorder ) m_recorder->commSplit( oldcom, color, key );
+		q.push( newEvent<EmberCommSplitEvent>( api(), m_output, m_Stats[Commsplit], oldcom, color, key, newCom ) );
 	}
     void commCreate( Queue& q, Communicator oldcom, std::vector<int>& ranks, Communicator* newCom ) {
-		q.push( new EmberCommCreateEvent( api(), m_output, m_Stats[Commsplit], oldcom, ranks, newCom ) );
+		if ( m_recorder ) m_recorder->commCreate( oldcom, ranks, newCom );
+		q.push( newEvent<EmberCommCreateEvent>( api(), m_output, m_Stats[Commsplit], oldcom, ranks, newCom ) );
 	}
     void commDestroy( Queue& q, Communicator comm ) {
-		q.push( new EmberCommDestroyEvent( api(), m_output, m_Stats[Commsplit], comm ) );
+		if ( m_recorder ) m_recorder->commDestroy( comm );
+		q.push( newEvent<EmberCommDestroyEvent>( api(), m_output, m_Stats[Commsplit], comm ) );
 	}
 
     void allreduce( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count,
                 PayloadDataType dtype, ReductionOperation op, Communicator group ) {
-		q.push( new EmberAllreduceEvent( api(), m_output, m_Stats[Allreduce], mydata, result, count, dtype, op, group ) );
+		if ( m_recorder ) m_recorder->allreduce( count, dtype, sizeofDataType(dtype), op, group );
+		q.push( newEvent<EmberAllreduceEvent>( api(), m_output, m_Stats[Allreduce], mydata, result, count, dtype, op, group ) );
 	}
 
     void reduce( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count,
                 PayloadDataType dtype, ReductionOperation op, int root, Communicator group ) {
-		q.push( new EmberReduceEvent( api(), m_output, m_Stats[Reduce], mydata, result, count, dtype, op, root, group ) );
+		if ( m_recorder ) m_recorder->reduce( count, dtype, sizeofDataType(dtype), op, root, group );
+		q.push( newEvent<EmberReduceEvent>( api(), m_output, m_Stats[Reduce], mydata, result, count, dtype, op, root, group ) );
 	}
 
     void bcast( Queue& q, const Hermes::MemAddr& mydata, uint32_t count, PayloadDataType dtype, int root, Communicator group ) {
-		q.push( new EmberBcastEvent( api(), m_output, m_Stats[Bcast], mydata, count, dtype, root, group ) );
+		if ( m_recorder ) m_recorder->bcast( count, dtype, sizeofDataType(dtype), root, group );
+		q.push( newEvent<EmberBcastEvent>( api(), m_output, m_Stats[Bcast], mydata, count, dtype, root, group ) );
 	}
 
     void scatter( Queue& q, const Hermes::MemAddr& senddata, uint32_t sendCnt, PayloadDataType sendType,
 			const Hermes::MemAddr& recvdata, uint32_t recvCnt, PayloadDataType recvType, int root, Communicator group ) {
-		q.push( new EmberScatterEvent( api(), m_output, m_Stats[Scatter], senddata, sendCnt, sendType, recvdata, recvCnt, recvType, root, group ) );
+		if ( m_recorder ) m_recorder->scatter( sendCnt, sendType, sizeofDataType(sendType), recvCnt, recvType, sizeofDataType(recvType), root, group );
+		q.push( newEvent<EmberScatterEvent>( api(), m_output, m_Stats[Scatter], senddata, sendCnt, sendType, recvdata, recvCnt, recvType, root, group ) );
 	}
 
     void scatterv( Queue& q, const Hermes::MemAddr& senddata, int* sendCnts, int* displs, PayloadDataType sendType,
 			const Hermes::MemAddr& recvdata, uint32_t recvCnt, PayloadDataType recvType, int root, Communicator group ) {
-		q.push( new EmberScattervEvent( api(), m_output, m_Stats[Scatterv], senddata, sendCnts, displs, sendType, recvdata, recvCnt, recvType, root, group ) );
+		if ( m_recorder ) m_recorder->scatterv( sendCnts, displs, sendType, sizeofDataType(sendType), recvCnt, recvType, sizeofDataType(recvType), root, group );
+		q.push( newEvent<EmberScattervEvent>( api(), m_output, m_Stats[Scatterv], senddata, sendCnts, displs, sendType, recvdata, recvCnt, recvType, root, group ) );
 	}
 
     void allgather( Queue& q, const Hermes::MemAddr& sendData, int sendCnts, PayloadDataType senddtype,
         const Hermes::MemAddr& recvData, int recvCnts, PayloadDataType recvdtype, Communicator group )
 	{
-		q.push( new EmberAllgatherEvent( api(), m_output, m_Stats[Alltoall], sendData, sendCnts, senddtype, recvData, recvCnts, recvdtype, group ) );
+		if ( m_recorder ) m_recorder->allgather( sendCnts, senddtype, sizeofDataType(senddtype), recvCnts, recvdtype, sizeofDataType(recvdtype), group );
+		q.push( newEvent<EmberAllgatherEvent>( api(), m_output, m_Stats[Alltoall], sendData, sendCnts, senddtype, recvData, recvCnts, recvdtype, group ) );
 	}
 
     void allgatherv( Queue& q, const Hermes::MemAddr& sendData, int sendCnts, PayloadDataType senddtype,
         const Hermes::MemAddr& recvData, Addr recvCnts, Addr recvDsp, PayloadDataType recvdtype, Communicator group )
 	{
-		q.push( new EmberAllgathervEvent( api(), m_output, m_Stats[Alltoallv],
+		if ( m_recorder ) m_recorder->allgatherv( sendCnts, senddtype, sizeofDataType(senddtype),
+				(const int*) recvCnts, (const int*) recvDsp, recvdtype, sizeofDataType(recvdtype), group );
+		q.push( newEvent<EmberAllgathervEvent>( api(), m_output, m_Stats[Alltoallv],
 			sendData, sendCnts, senddtype,
 			recvData, recvCnts, recvDsp, recvdtype,
 			group ) );
@@ -274,13 +301,16 @@ class EmberMpiLib : public EmberLib {
     void alltoall( Queue& q, const Hermes::MemAddr& sendData, int sendCnts, PayloadDataType senddtype,
         const Hermes::MemAddr& recvData, int recvCnts, PayloadDataType recvdtype, Communicator group )
 	{
-		q.push( new EmberAlltoallEvent( api(), m_output, m_Stats[Alltoall], sendData, sendCnts, senddtype, recvData, recvCnts, recvdtype, group ) );
+		if ( m_recorder ) m_recorder->alltoall( sendCnts, senddtype, sizeofDataType(senddtype), recvCnts, recvdtype, sizeofDataType(recvdtype), group );
+		q.push( newEvent<EmberAlltoallEvent>( api(), m_output, m_Stats[Alltoall], sendData, sendCnts, senddtype, recvData, recvCnts, recvdtype, group ) );
 	}
 
     void alltoallv( Queue& q, const Hermes::MemAddr& sendData, Addr sendCnts, Addr sendDsp, PayloadDataType senddtype,
         const Hermes::MemAddr& recvData, Addr recvCnts, Addr recvDsp, PayloadDataType recvdtype, Communicator group )
 	{
-    	q.push( new EmberAlltoallvEvent( api(), m_output, m_Stats[Alltoallv],
+		if ( m_recorder ) m_recorder->alltoallv( (const int*) sendCnts, (const int*) sendDsp, senddtype, sizeofDataType(senddtype),
+				(const int*) recvCnts, (const int*) recvDsp, recvdtype, sizeofDataType(recvdtype), group );
+    	q.push( newEvent<EmberAlltoallvEvent>( api(), m_output, m_Stats[Alltoallv],
 			sendData, sendCnts, sendDsp, senddtype,
 			recvData, recvCnts, recvDsp, recvdtype,
 			group ) );
@@ -296,7 +326,8 @@ class EmberMpiLib : public EmberLib {
     	MessageRequest* req = new MessageRequest;
     	irecv(q, recvbuf, recvcnt, recvtype, source, recvtag, group, req );
     	send(q, sendbuf, sendcount, sendtype, dest, sendtag, group );
-    	q.push( new EmberWaitEvent( api(), m_output, m_Stats[Wait], req, resp, true ) );
+		if ( m_recorder ) m_recorder->wait( req );
+    	q.push( newEvent<EmberWaitEvent>( api(), m_output, m_Stats[Wait], req, resp, true ) );
 	}
 
     void allreduce( Queue& q, Addr _mydata, Addr _result, uint32_t count, PayloadDataType dtype, ReductionOperation op, Communicator group ) {
@@ -370,6 +401,7 @@ class EmberMpiLib : public EmberLib {
 
 	void  setSizeCache( int size ) {
 		m_size = size;
+		if ( m_recorder ) m_recorder->setWorldSize( size );
 	}
 	int  getSizeCache() {
 		return m_size;
@@ -75,7 +75,7 @@ class EmberShmemLib : public EmberLib {
     SST_ELI_DOCUMENT_PARAMS(
 	)
 
-    typedef std::queue<EmberEvent*> Queue;
+    typedef EmberEventQueue Queue;
 
 	EmberShmemLib( Params& params ) {}
 
@@ -86,118 +86,118 @@ class EmberShmemLib : public EmberLib {
 	template <class TYPE>
 	void fam_add( Queue& q, Shmem::Fam_Descriptor fd, uint64_t offset, TYPE* value )
 	{
-		q.push( new EmberFamAddEvent( api(), m_output, fd, offset, Hermes::Value(value) ) );
+		q.push( newEvent<EmberFamAddEvent>( api(), m_output, fd, offset, Hermes::Value(value) ) );
 	}
 	template <class TYPE>
 	void fam_compare_swap( Queue& q, TYPE* result, Shmem::Fam_Descriptor fd, uint64_t offset, TYPE* oldValue, TYPE* newValue )
 	{
-		q.push( new EmberFamCswapEvent( api(), m_output, Hermes::Value(result), fd, offset, Hermes::Value(oldValue), Hermes::Value(newValue) ) );
+		q.push( newEvent<EmberFamCswapEvent>( api(), m_output, Hermes::Value(result), fd, offset, Hermes::Value(oldValue), Hermes::Value(newValue) ) );
 	}
 
 	void fam_get_nonblocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t offset, uint64_t nbytes )
 	{
-		q.push( new EmberFamGet_Event( api(), m_output, dest.getSimVAddr(), fd, offset, nbytes, false ) );
+		q.push( newEvent<EmberFamGet_Event>( api(), m_output, dest.getSimVAddr(), fd, offset, nbytes, false ) );
 	}
 
 	void fam_get_blocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t offset, uint64_t nbytes )
 	{
-		q.push( new EmberFamGet_Event( api(), m_output, dest.getSimVAddr(), fd, offset, nbytes, true ) );
+		q.push( newEvent<EmberFamGet_Event>( api(), m_output, dest.getSimVAddr(), fd, offset, nbytes, true ) );
 	}
 
 	void fam_put_nonblocking( Queue& q, Shmem::Fam_Descriptor fd, uint64_t offset,
 		Hermes::MemAddr src, uint64_t nbytes )
 	{
-		q.push( new EmberFamPut_Event( api(), m_output, fd, offset, src.getSimVAddr(), nbytes, false ) );
+		q.push( newEvent<EmberFamPut_Event>( api(), m_output, fd, offset, src.getSimVAddr(), nbytes, false ) );
 	}
 
 	void fam_put_blocking( Queue& q, Shmem::Fam_Descriptor fd, uint64_t offset,
 		Hermes::MemAddr src, uint64_t nbytes )
 	{
-		q.push( new EmberFamPut_Event( api(), m_output, fd, offset, src.getSimVAddr(), nbytes, true ) );
+		q.push( newEvent<EmberFamPut_Event>( api(), m_output, fd, offset, src.getSimVAddr(), nbytes, true ) );
 	}
 
 	void fam_scatterv_blocking( Queue& q, Hermes::MemAddr src, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, std::vector<uint64_t> indexes, uint64_t blockSize )
 	{
-		q.push( new EmberFamScatterv_Event( api(), m_output, src.getSimVAddr(), fd, nblocks, indexes, blockSize, true ) );
+		q.push( newEvent<EmberFamScatterv_Event>( api(), m_output, src.getSimVAddr(), fd, nblocks, indexes, blockSize, true ) );
 	}
 
 	void fam_scatter_blocking( Queue& q, Hermes::MemAddr src, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, uint64_t firstBlock, uint64_t stride, uint64_t blockSize )
 	{
-		q.push( new EmberFamScatter_Event( api(), m_output, src.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, true ) );
+		q.push( newEvent<EmberFamScatter_Event>( api(), m_output, src.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, true ) );
 	}
 
 	void fam_scatterv_nonblocking( Queue& q, Hermes::MemAddr src, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, std::vector<uint64_t> indexes, uint64_t blockSize )
 	{
-		q.push( new EmberFamScatterv_Event( api(), m_output, src.getSimVAddr(), fd, nblocks, indexes, blockSize, false ) );
+		q.push( newEvent<EmberFamScatterv_Event>( api(), m_output, src.getSimVAddr(), fd, nblocks, indexes, blockSize, false ) );
 	}
 
 	void fam_scatter_nonblocking( Queue& q, Hermes::MemAddr src, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, uint64_t firstBlock, uint64_t stride, uint64_t blockSize )
 	{
-		q.push( new EmberFamScatter_Event( api(), m_output, src.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, false ) );
+		q.push( newEvent<EmberFamScatter_Event>( api(), m_output, src.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, false ) );
 	}
 
 	void fam_gatherv_blocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, std::vector<uint64_t> indexes, uint64_t blockSize )
 	{
-		q.push( new EmberFamGatherv_Event( api(), m_output, dest.getSimVAddr(), fd, nblocks, indexes, blockSize, true ) );
+		q.push( newEvent<EmberFamGatherv_Event>( api(), m_output, dest.getSimVAddr(), fd, nblocks, indexes, blockSize, true ) );
 	}
 	void fam_gather_blocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, uint64_t firstBlock, uint64_t stride, uint64_t blockSize )
 	{
-		q.push( new EmberFamGather_Event( api(), m_output, dest.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, true ) );
+		q.push( newEvent<EmberFamGather_Event>( api(), m_output, dest.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, true ) );
 	}
 
 	void fam_gatherv_nonblocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, std::vector<uint64_t> indexes, uint64_t blockSize )
 	{
-		q.push( new EmberFamGatherv_Event( api(), m_output, dest.getSimVAddr(), fd, nblocks, indexes, blockSize, false ) );
+		q.push( newEvent<EmberFamGatherv_Event>( api(), m_output, dest.getSimVAddr(), fd, nblocks, indexes, blockSize, false ) );
 	}
 	void fam_gather_nonblocking( Queue& q, Hermes::MemAddr dest, Shmem::Fam_Descriptor fd,
 		uint64_t nblocks, uint64_t firstBlock, uint64_t stride, uint64_t blockSize )
 	{
-		q.push( new EmberFamGather_Event( api(), m_output, dest.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, false ) );
+		q.push( newEvent<EmberFamGather_Event>( api(), m_output, dest.getSimVAddr(), fd, nblocks, firstBlock, stride, blockSize, false ) );
 	}
 
 	void getTime( Queue& q, uint64_t* time )
 	{
-		q.push( new EmberGetTimeEvent( m_output, time ) );
+		q.push( newEvent<EmberGetTimeEvent>( m_output, time ) );
 	}
 
 	void init( Queue& q )
 	{
-		q.push( new EmberInitShmemEvent( api(), m_output ) );
+		q.push( newEvent<EmberInitShmemEvent>( api(), m_output ) );
 	}
 
 	void fini( Queue& q ) {
-		q.push( new EmberFiniShmemEvent( api(), m_output ) );
+		q.push( newEvent<EmberFiniShmemEvent>( api(), m_output ) );
 	}
 
 	void my_pe( Queue& q, int* val ) {
-		q.push( new EmberMyPeShmemEvent( api(), m_output, val ) );
+		q.push( newEvent<EmberMyPeShmemEvent>( api(), m_output, val ) );
 	}
 
 	void n_pes( Queue& q, int* val ) {
-		q.push( new EmberNPesShmemEvent( api(), m_output, val ) );
+		q.push( newEvent<EmberNPesShmemEvent>( api(), m_output, val ) );
 	}
 
 	void barrier_all( Queue& q ) {
-		q.push( new EmberBarrierAllShmemEvent( api(), m_output ) );
+		q.push( newEvent<EmberBarrierAllShmemEvent>( api(), m_output ) );
 	}
 
 	void barrier( Queue& q, int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync ) {
-		q.push( new EmberBarrierShmemEvent( api(), m_output, PE_start, logPE_stride, PE_size, pSync.getSimVAddr() ) );
+		q.push( newEvent<EmberBarrierShmemEvent>( api(), m_output, PE_start, logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
 
 	void broadcast32( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_root, int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberBroadcastShmemEvent( api(), m_output,
+		q.push( newEvent<EmberBroadcastShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 4, PE_root, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -205,7 +205,7 @@ class EmberShmemLib : public EmberLib {
 	void broadcast64( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_root, int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberBroadcastShmemEvent( api(), m_output,
+		q.push( newEvent<EmberBroadcastShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 8, PE_root, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -213,7 +213,7 @@ class EmberShmemLib : public EmberLib {
 	void fcollect32( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberFcollectShmemEvent( api(), m_output,
+		q.push( newEvent<EmberFcollectShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 4, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -221,7 +221,7 @@ class EmberShmemLib : public EmberLib {
 	void fcollect64( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberFcollectShmemEvent( api(), m_output,
+		q.push( newEvent<EmberFcollectShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 8, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -229,7 +229,7 @@ class EmberShmemLib : public EmberLib {
 	void collect32( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberCollectShmemEvent( api(), m_output,
+		q.push( newEvent<EmberCollectShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 4, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -237,7 +237,7 @@ class EmberShmemLib : public EmberLib {
 	void collect64( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberCollectShmemEvent( api(), m_output,
+		q.push( newEvent<EmberCollectShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 8, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -245,7 +245,7 @@ class EmberShmemLib : public EmberLib {
 	void alltoall32( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberAlltoallShmemEvent( api(), m_output,
+		q.push( newEvent<EmberAlltoallShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 4, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -253,7 +253,7 @@ class EmberShmemLib : public EmberLib {
 	void alltoall64( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t nelems,
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberAlltoallShmemEvent( api(), m_output,
+		q.push( newEvent<EmberAlltoallShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), nelems * 8, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -261,7 +261,7 @@ class EmberShmemLib : public EmberLib {
 	void alltoalls32( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src,
 			int dst, int sst, size_t nelems, int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberAlltoallsShmemEvent( api(), m_output,
+		q.push( newEvent<EmberAlltoallsShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), dst, sst, nelems, 4, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -269,7 +269,7 @@ class EmberShmemLib : public EmberLib {
 	void alltoalls64( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src,
 			int dst, int sst, size_t nelems, int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )
 	{
-		q.push( new EmberAlltoallsShmemEvent( api(), m_output,
+		q.push( newEvent<EmberAlltoallsShmemEvent>( api(), m_output,
 						dest.getSimVAddr(), src.getSimVAddr(), dst, sst, nelems, 8, PE_start,
 							logPE_stride, PE_size, pSync.getSimVAddr() ) );
 	}
@@ -278,7 +278,7 @@ class EmberShmemLib : public EmberLib {
 	void type1##_##op1##_to_all( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, int nelems, \
 				int PE_start, int logPE_stride, int PE_size, Hermes::MemAddr pSync )\
 	{\
-		q.push( new EmberReductionShmemEvent( api(), m_output, \
+		q.push( newEvent<EmberReductionShmemEvent>( api(), m_output, \
 						dest.getSimVAddr(), src.getSimVAddr(), nelems, PE_start, logPE_stride, \
 						PE_size, pSync.getSimVAddr(), Hermes::Shmem::op2, Hermes::Value::type2 ) ); \
 	}
@@ -308,78 +308,78 @@ class EmberShmemLib : public EmberLib {
 	defineMathOp(prod,PROD)
 
 	void fence( Queue& q ) {
-		q.push( new EmberFenceShmemEvent( api(), m_output ) );
+		q.push( newEvent<EmberFenceShmemEvent>( api(), m_output ) );
 	}
 
 	void quiet( Queue& q ) {
-		q.push( new EmberQuietShmemEvent( api(), m_output ) );
+		q.push( newEvent<EmberQuietShmemEvent>( api(), m_output ) );
 	}
 
 	void malloc( Queue& q, Hermes::MemAddr* ptr, size_t num, bool backed = true ) {
-		q.push( new EmberMallocShmemEvent( api(), m_output, ptr, num, backed ) );
+		q.push( newEvent<EmberMallocShmemEvent>( api(), m_output, ptr, num, backed ) );
 	}
 
 	void free( Queue& q, Hermes::MemAddr addr ) {
-		q.push( new EmberFreeShmemEvent( api(), m_output, addr ) );
+		q.push( newEvent<EmberFreeShmemEvent>( api(), m_output, addr ) );
 	}
 
 	void get( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t length, int pe ) {
-		q.push( new EmberGetShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, true ) );
+		q.push( newEvent<EmberGetShmemEvent>( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, true ) );
 	}
 
 	void get_nbi( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t length, int pe ) {
-		q.push( new EmberGetShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, false ) );
+		q.push( newEvent<EmberGetShmemEvent>( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, false ) );
 	}
 
 	template <class TYPE>
 	void getv( Queue& q, TYPE* laddr, Hermes::MemAddr addr, int pe ) {
-		q.push( new EmberGetVShmemEvent( api(), m_output,  Hermes::Value(laddr), addr.getSimVAddr(), pe ) );
+		q.push( newEvent<EmberGetVShmemEvent>( api(), m_output,  Hermes::Value(laddr), addr.getSimVAddr(), pe ) );
 	}
 
 	void put( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t length, int pe ) {
-		q.push( new EmberPutShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, true ) );
+		q.push( newEvent<EmberPutShmemEvent>( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, true ) );
 	}
 
 	void put_nbi( Queue& q, Hermes::MemAddr dest, Hermes::MemAddr src, size_t length, int pe ) {
-		q.push( new EmberPutShmemEvent( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, false ) );
+		q.push( newEvent<EmberPutShmemEvent>( api(), m_output,  dest.getSimVAddr(), src.getSimVAddr(), length, pe, false ) );
 	}
 
 	template <class TYPE>
 	void putv( Queue& q, Hermes::MemAddr addr, TYPE value, int pe ) {
-		q.push( new EmberPutvShmemEvent( api(), m_output,  addr.getSimVAddr(), Hermes::Value( (TYPE) value ), pe ) );
+		q.push( newEvent<EmberPutvShmemEvent>( api(), m_output,  addr.getSimVAddr(), Hermes::Value( (TYPE) value ), pe ) );
 	}
 
 	template <class TYPE>
 	void wait( Queue& q, Hermes::MemAddr addr, TYPE value ) {
-		q.push( new EmberWaitShmemEvent( api(), m_output,  addr.getSimVAddr(), Hermes::Shmem::NE, Hermes::Value( (TYPE) value ) ) );
+		q.push( newEvent<EmberWaitShmemEvent>( api(), m_output,  addr.getSimVAddr(), Hermes::Shmem::NE, Hermes::Value( (TYPE) value ) ) );
 	}
 
 	template <class TYPE>
 	void wait_until( Queue& q, Hermes::MemAddr addr, Hermes::Shmem::WaitOp op, TYPE value ) {
-		q.push( new EmberWaitShmemEvent( api(), m_output,  addr.getSimVAddr(), op, Hermes::Value( (TYPE) value ) ) );
+		q.push( newEvent<EmberWaitShmemEvent>( api(), m_output,  addr.getSimVAddr(), op, Hermes::Value( (TYPE) value ) ) );
 	}
 
 	template <class TYPE>
 	void add( Queue& q, Hermes::MemAddr addr, TYPE* value,  int pe ) {
-		q.push( new EmberAddShmemEvent( api(), m_output,
+		q.push( newEvent<EmberAddShmemEvent>( api(), m_output,
 					addr.getSimVAddr(), Hermes::Value(value), pe ) );
 	}
 
 	template <class TYPE>
 	void fadd( Queue& q, TYPE* result, Hermes::MemAddr addr, TYPE* value,  int pe ) {
-		q.push( new EmberFaddShmemEvent( api(), m_output,
+		q.push( newEvent<EmberFaddShmemEvent>( api(), m_output,
 					Hermes::Value(result), addr.getSimVAddr(), Hermes::Value(value), pe ) );
 	}
 
 	template <class TYPE>
 	void swap( Queue& q, TYPE* result, Hermes::MemAddr addr, TYPE* value,  int pe ) {
-		q.push( new EmberSwapShmemEvent( api(), m_output,
+		q.push( newEvent<EmberSwapShmemEvent>( api(), m_output,
 					Hermes::Value(result), addr.getSimVAddr(), Hermes::Value(value), pe ) );
 	}
 
 	template <class TYPE>
 	void cswap( Queue& q, TYPE* result, Hermes::MemAddr addr, TYPE* cond, TYPE* value,  int pe ) {
-		q.push( new EmberCswapShmemEvent( api(), m_output,
+		q.push( newEvent<EmberCswapShmemEvent>( api(), m_output,
 					Hermes::Value(result), addr.getSimVAddr(), Hermes::Value(cond), Hermes::Value(value), pe ) );
 	}
 
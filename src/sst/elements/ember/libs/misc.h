@@ -46,15 +46,15 @@ class EmberMiscLib : public EmberLib {
     EmberMiscLib( Params& params ) {}
 
     void getNodeNum( EmberGenerator::Queue& q, int* ptr ) {
-        q.push( new EmberGetNodeNumEvent( api(), m_output, ptr ) );
+        q.push( newEvent<EmberGetNodeNumEvent>( api(), m_output, ptr ) );
     }
 
     void getNumNodes( EmberGenerator::Queue& q, int* ptr ) {
-        q.push( new EmberGetNumNodesEvent( api(), m_output, ptr ) );
+        q.push( newEvent<EmberGetNumNodesEvent>( api(), m_output, ptr ) );
     }
 
     void malloc( EmberGenerator::Queue& q, Hermes::MemAddr* addr, size_t length, bool backed = false ) {
-        q.push( new EmberMallocEvent( api(), m_output, addr, length, backed ) );
+        q.push( newEvent<EmberMallocEvent>( api(), m_output, addr, length, backed ) );
     }
 
   private:
@@ -823,7 +823,7 @@ void Ember3DAMRGenerator::configure()
 	out->verbose(CALL_INFO, 2, 0, "Motif configuration is complete.\n");
 }
 
-void Ember3DAMRGenerator::postBlockCommunication(std::queue<EmberEvent*>& evQ, int32_t* blockComm, uint32_t* nextReq, const uint32_t faceSize,
+void Ember3DAMRGenerator::postBlockCommunication(EmberEventQueue& evQ, int32_t* blockComm, uint32_t* nextReq, const uint32_t faceSize,
 	const uint32_t msgTag, const Ember3DAMRBlock* theBlock) {
 
 	const uint32_t maxFaceDim = std::max(blockNx, std::max(blockNy, blockNz));
@@ -932,7 +932,7 @@ void Ember3DAMRGenerator::aggregateBlockCommunication(const std::vector<Ember3DA
 	}
 }
 
-bool Ember3DAMRGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool Ember3DAMRGenerator::generate( EmberEventQueue& evQ)
 {
 	if(iteration < maxIterations) {
 		enQ_compute( evQ, 5 );
@@ -82,7 +82,7 @@ public:
 	Ember3DAMRGenerator(SST::ComponentId_t, Params& params);
 	~Ember3DAMRGenerator();
 	void configure();
-        bool generate( std::queue<EmberEvent*>& evQ );
+        bool generate( EmberEventQueue& evQ );
 	int32_t power3(const uint32_t expon);
 
 	uint32_t power2(uint32_t exponent) const;
@@ -91,7 +91,7 @@ public:
 	uint32_t calcBlockID(const uint32_t posX, const uint32_t posY, const uint32_t posZ, const uint32_t level);
         void calcBlockLocation(const uint32_t blockID, const uint32_t blockLevel, uint32_t* posX, uint32_t* posY, uint32_t* posZ);
         bool isBlockLocal(const uint32_t bID) const;
-	void postBlockCommunication(std::queue<EmberEvent*>& evQ, int32_t* blockComm, uint32_t* nextReq, const uint32_t faceSize, const uint32_t msgTag,
+	void postBlockCommunication(EmberEventQueue& evQ, int32_t* blockComm, uint32_t* nextReq, const uint32_t faceSize, const uint32_t msgTag,
 		const Ember3DAMRBlock* theBlock);
 	void aggregateBlockCommunication(const std::vector<Ember3DAMRBlock*>& blocks, std::map<int32_t, uint32_t>& blockToMessageSize);
 	void aggregateCommBytes(Ember3DAMRBlock* curBlock, std::map<int32_t, uint32_t>& blockToMessageSize);
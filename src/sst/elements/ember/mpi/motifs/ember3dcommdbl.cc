@@ -61,7 +61,7 @@ int32_t Ember3DCommDoublingGenerator::power3(const uint32_t expon) {
 	}
 }
 
-bool Ember3DCommDoublingGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool Ember3DCommDoublingGenerator::generate( EmberEventQueue& evQ)
 {
 	if(0 == rank()) {
 		verbose(CALL_INFO, 1, 0, "Motif executing phase %" PRIu32 "...\n", phase);
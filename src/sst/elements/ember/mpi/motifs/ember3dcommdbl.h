@@ -71,7 +71,7 @@ public:
 	Ember3DCommDoublingGenerator(SST::ComponentId_t, Params& params);
 	~Ember3DCommDoublingGenerator() {}
 	void configure();
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 	int32_t power3(const uint32_t expon);
 
 private:
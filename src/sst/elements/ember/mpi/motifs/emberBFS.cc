@@ -313,7 +313,7 @@ void EmberBFSGenerator::initIter() {
     idx_50 = 0;
 }
 
-bool EmberBFSGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberBFSGenerator::generate( EmberEventQueue& evQ) {
     bool done = 0;
 
     enQ_getTime( evQ, &s_time );
@@ -373,7 +373,7 @@ public:
 public:
     EmberBFSGenerator(SST::ComponentId_t, Params& params);
     ~EmberBFSGenerator();
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     Output out;
@@ -48,7 +48,7 @@ EmberNtoMGenerator::EmberNtoMGenerator(SST::ComponentId_t id, Params& params ) :
 	}
 }
 
-bool EmberNtoMGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberNtoMGenerator::generate( EmberEventQueue& evQ)
 {
 	if ( m_target ) {
 		return target( evQ );
@@ -57,7 +57,7 @@ bool EmberNtoMGenerator::generate( std::queue<EmberEvent*>& evQ)
 	}
 }
 
-bool EmberNtoMGenerator::source( std::queue<EmberEvent*>& evQ) {
+bool EmberNtoMGenerator::source( EmberEventQueue& evQ) {
 	if ( m_phase == Init) { 
 		enQ_barrier( evQ, GroupWorld );
 		m_phase = Run;
@@ -74,7 +74,7 @@ bool EmberNtoMGenerator::source( std::queue<EmberEvent*>& evQ) {
 
 	return false;
 }
-bool EmberNtoMGenerator::target( std::queue<EmberEvent*>& evQ) {
+bool EmberNtoMGenerator::target( EmberEventQueue& evQ) {
 	switch ( m_phase ) { 
 	  case Init:
 		for ( int i = 0; i < m_numRecvBufs; i++ ) {
@@ -66,11 +66,11 @@ public:
 
 public:
 	EmberNtoMGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
-    bool source( std::queue<EmberEvent*>& evQ);
-    bool target( std::queue<EmberEvent*>& evQ);
+    bool source( EmberEventQueue& evQ);
+    bool target( EmberEventQueue& evQ);
     bool findNum( int num, std::string& numList );
 	void getTargetRanks( std::string&, std::vector<uint32_t>& );
 	enum { Init, Run, Fini } m_phase;
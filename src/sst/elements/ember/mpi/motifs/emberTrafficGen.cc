@@ -121,13 +121,13 @@ void EmberTrafficGenGenerator::configure_plusOne()
     }
 }
 
-bool EmberTrafficGenGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberTrafficGenGenerator::generate( EmberEventQueue& evQ)
 {
     if (m_pattern == "plusOne") return generate_plusOne(evQ);
     return generate_random(evQ);
 }
 
-bool EmberTrafficGenGenerator::generate_plusOne( std::queue<EmberEvent*>& evQ)
+bool EmberTrafficGenGenerator::generate_plusOne( EmberEventQueue& evQ)
 {
     double computeTime = m_random->getNextDouble();
 
@@ -147,7 +147,7 @@ bool EmberTrafficGenGenerator::generate_plusOne( std::queue<EmberEvent*>& evQ)
     return false;
 }
 
-bool EmberTrafficGenGenerator::generate_random( std::queue<EmberEvent*>& evQ)
+bool EmberTrafficGenGenerator::generate_random( EmberEventQueue& evQ)
 {
     evQ_ = &evQ;
     m_currentTime = getCurrentSimTimeNano();
@@ -266,7 +266,7 @@ bool EmberTrafficGenGenerator::generate_random( std::queue<EmberEvent*>& evQ)
 }
 
 void EmberTrafficGenGenerator::recv_data() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
     if (m_debug > 2) std::cerr << "rank " << m_rank << " start a datareq recv\n";
     if (m_dataRecvRequest) delete m_dataRecvRequest;
     m_dataRecvRequest = new MessageRequest;
@@ -275,17 +275,17 @@ void EmberTrafficGenGenerator::recv_data() {
 }
 
 void EmberTrafficGenGenerator::recv_stopping() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
     enQ_irecv( evQ, nullptr, 1, CHAR, Hermes::MP::AnySrc, STOPPING, GroupWorld, &m_stopRequest);
 }
 
 void EmberTrafficGenGenerator::recv_allstopped() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
     enQ_irecv( evQ, nullptr, 1, CHAR, 0, ALLSTOPPED, GroupWorld, &m_stopRequest);
 }
 
 void EmberTrafficGenGenerator::send_data() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
 
     // determine rank to send data to
     uint32_t partner = (uint32_t) m_rank;
@@ -314,7 +314,7 @@ void EmberTrafficGenGenerator::send_data() {
 }
 
 void EmberTrafficGenGenerator::wait_for_any() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
     uint64_t size = m_dataSendActive + m_dataRecvActive + 1;
     if (m_debug > 2) std::cerr << "rank " << m_rank <<  " enqueing waitany with size " << size << std::endl;
     if (m_allRequests) delete m_allRequests;
@@ -335,7 +335,7 @@ void EmberTrafficGenGenerator::wait_for_any() {
 }
 
 bool EmberTrafficGenGenerator::check_stop() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
     if (m_numStopped == size() - 1 && (m_currentTime >= m_stopTime || m_currentIteration > m_iterations)){
         if (m_debug > 1) std::cerr << "rank " << m_rank << " all ranks complete, stopping with bytes " << m_rankBytes.at<uint64_t>(0) << std::endl;
         m_stopped = true;
@@ -71,8 +71,8 @@ public:
 
 public:
 	EmberTrafficGenGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
-    bool generate_plusOne( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
+    bool generate_plusOne( EmberEventQueue& evQ);
     bool primary( ) {
         if (m_pattern == "plusOne")
             return false;
@@ -82,7 +82,7 @@ public:
     void configure_plusOne();
 
     // extended patterns
-    bool generate_random( std::queue<EmberEvent*>& evQ);
+    bool generate_random( EmberEventQueue& evQ);
     void recv_data();
     void send_data();
     void wait_for_any();
@@ -108,7 +108,7 @@ private:
 
     // extended patterns
     enum {DATA, STOPPING, ALLSTOPPED};
-    std::queue<EmberEvent*>* evQ_;
+    EmberEventQueue* evQ_;
     bool m_dataSendActive;
     bool m_dataRecvActive;
     bool m_needToWait;
@@ -30,16 +30,18 @@ EmberAllgatherGenerator::EmberAllgatherGenerator(SST::ComponentId_t id,
     m_verify     = params.find<bool>("arg.verify",true);
     jobId        = (int) params.find<int>("_jobId"); //NetworkSim
 
-    memSetBacked();
+    if ( m_verify || ! timingOnly() ) {
+        memSetBacked();
+    }
     m_sendBuf = memAlloc( m_count * sizeofDataType(INT) );
     m_recvBuf = memAlloc( m_count * sizeofDataType(INT)*  size() );
 
-	for ( int i = 0; i < m_count; i++ ) {
+	for ( int i = 0; m_sendBuf && i < m_count; i++ ) {
 		((int*)m_sendBuf)[i] = rank();
 	}
 }
 
-bool EmberAllgatherGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberAllgatherGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
@@ -28,11 +28,13 @@ EmberAllgathervGenerator::EmberAllgathervGenerator(SST::ComponentId_t id,
 	m_count      = (uint32_t) params.find("arg.count", 1);
     m_verify     = params.find<bool>("arg.verify",true);
 
-    memSetBacked();
+    if ( m_verify || ! timingOnly() ) {
+        memSetBacked();
+    }
     m_sendBuf = memAlloc( m_count * sizeofDataType(INT) );
     m_recvBuf = memAlloc( m_count * sizeofDataType(INT)*  size() );
 
-	for ( int i = 0; i < m_count; i++ ) {
+	for ( int i = 0; m_sendBuf && i < m_count; i++ ) {
     	((int*)m_sendBuf)[i] = rank();
 	}
 
@@ -46,7 +48,7 @@ EmberAllgathervGenerator::EmberAllgathervGenerator(SST::ComponentId_t id,
     }
 }
 
-bool EmberAllgathervGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberAllgathervGenerator::generate( EmberEventQueue& evQ) {
 
 	if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
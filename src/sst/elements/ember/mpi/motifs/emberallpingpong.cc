@@ -34,7 +34,7 @@ EmberAllPingPongGenerator::EmberAllPingPongGenerator(SST::ComponentId_t id,
     m_recvBuf = memAlloc(m_messageSize);
 }
 
-bool EmberAllPingPongGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberAllPingPongGenerator::generate( EmberEventQueue& evQ)
 {
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank()) {
@@ -66,7 +66,7 @@ public:
 
 public:
 	EmberAllPingPongGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
 	uint32_t m_loopIndex;
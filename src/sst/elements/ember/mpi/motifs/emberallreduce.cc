@@ -40,7 +40,7 @@ EmberAllreduceGenerator::EmberAllreduceGenerator(SST::ComponentId_t id,
 	}
 }
 
-bool EmberAllreduceGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberAllreduceGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
@@ -52,7 +52,9 @@ bool EmberAllreduceGenerator::generate( std::queue<EmberEvent*>& evQ) {
         return true;
     }
     if ( 0 == m_loopIndex ) {
-		memSetBacked();
+		if ( ! timingOnly() ) {
+			memSetBacked();
+		}
 		m_sendBuf = memAlloc(sizeofDataType(DOUBLE)*m_count);
 		m_recvBuf = memAlloc(sizeofDataType(DOUBLE)*m_count);
         enQ_getTime( evQ, &m_startTime );
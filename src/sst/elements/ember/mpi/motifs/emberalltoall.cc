@@ -32,7 +32,7 @@ EmberAlltoallGenerator::EmberAlltoallGenerator(SST::ComponentId_t id,
     m_recvBuf = NULL;
 }
 
-bool EmberAlltoallGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberAlltoallGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
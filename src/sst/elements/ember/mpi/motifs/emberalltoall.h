@@ -66,7 +66,7 @@ public:
 
 public:
 	EmberAlltoallGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     uint64_t m_startTime;
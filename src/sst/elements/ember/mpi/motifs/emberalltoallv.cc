@@ -41,7 +41,7 @@ EmberAlltoallvGenerator::EmberAlltoallvGenerator(SST::ComponentId_t id,
     }
 }
 
-bool EmberAlltoallvGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberAlltoallvGenerator::generate( EmberEventQueue& evQ) {
 
     if ( 0 == m_loopIndex ) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
@@ -27,7 +27,7 @@ EmberBarrierGenerator::EmberBarrierGenerator(SST::ComponentId_t id, Params& para
     m_compute    = (uint32_t) params.find("arg.compute", 0);
 }
 
-bool EmberBarrierGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberBarrierGenerator::generate( EmberEventQueue& evQ )
 {
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
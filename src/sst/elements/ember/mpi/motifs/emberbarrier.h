@@ -65,7 +65,7 @@ public:
 
 public:
 	EmberBarrierGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
     uint32_t m_loopIndex;
@@ -31,7 +31,7 @@ EmberBcastGenerator::EmberBcastGenerator(SST::ComponentId_t id,
     m_sendBuf = NULL;
 }
 
-bool EmberBcastGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberBcastGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
 printf("%s\n",__func__);
@@ -33,7 +33,7 @@ EmberBiPingPongGenerator::EmberBiPingPongGenerator(SST::ComponentId_t id,
     m_recvBuf = memAlloc(m_messageSize);
 }
 
-bool EmberBiPingPongGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberBiPingPongGenerator::generate( EmberEventQueue& evQ)
 {
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank()) {
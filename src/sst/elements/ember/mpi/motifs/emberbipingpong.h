@@ -65,7 +65,7 @@ public:
 
 public:
 	EmberBiPingPongGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     void*    m_sendBuf;
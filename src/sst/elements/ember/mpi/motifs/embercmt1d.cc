@@ -77,7 +77,7 @@ void EmberCMT1DGenerator::configure()
 }
 
 
-bool EmberCMT1DGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberCMT1DGenerator::generate( EmberEventQueue& evQ)
 {
 
         if ( 0 == m_loopIndex ) {
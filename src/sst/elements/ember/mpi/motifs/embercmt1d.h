@@ -76,7 +76,7 @@ public:
 	EmberCMT1DGenerator(SST::ComponentId_t, Params& params);
 //	~EmberCMT1DGenerator();
     void configure();
-	bool generate( std::queue<EmberEvent*>& evQ);
+	bool generate( EmberEventQueue& evQ);
 
 private:
 
@@ -129,7 +129,7 @@ void EmberCMT2DGenerator::configure()
 
 
 
-bool EmberCMT2DGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberCMT2DGenerator::generate( EmberEventQueue& evQ)
 {
 
         if (m_loopIndex == 0) {
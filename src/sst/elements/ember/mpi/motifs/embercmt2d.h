@@ -80,7 +80,7 @@ public:
 	EmberCMT2DGenerator(SST::ComponentId_t, Params& params);
 //	~EmberCMT2DGenerator();
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ);
+	bool generate( EmberEventQueue& evQ);
 
 private:
 // User parameters - application
@@ -157,7 +157,7 @@ void EmberCMT3DGenerator::configure()
 
 
 
-bool EmberCMT3DGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberCMT3DGenerator::generate( EmberEventQueue& evQ)
 {
         if (m_loopIndex == 0) {
     		verbose(CALL_INFO, 2,0, "rank=%d, size=%d\n", rank(), size());
@@ -101,7 +101,7 @@ void EmberCMTCRGenerator::configure()
 
 
 
-bool EmberCMTCRGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberCMTCRGenerator::generate( EmberEventQueue& evQ)
 {
         if (m_loopIndex == 0) {
             verbose(CALL_INFO, 2, 0, "rank=%" PRIu64 ", size=%d\n", myID, size());
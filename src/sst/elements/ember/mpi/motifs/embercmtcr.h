@@ -80,7 +80,7 @@ public:
 	EmberCMTCRGenerator(SST::ComponentId_t, Params& params);
 //	~EmberCMT3DGenerator();
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ);
+	bool generate( EmberEventQueue& evQ);
 
 private:
 // User parameters - application
@@ -39,7 +39,7 @@ inline long mod( long a, long b )
     return tmp;
 }
 
-bool EmberCommGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberCommGenerator::generate( EmberEventQueue& evQ)
 {
     if ( 0 == m_workPhase ) {
         assert( size() > 7);
@@ -65,7 +65,7 @@ public:
 
 public:
 	EmberCommGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     MessageResponse m_resp;
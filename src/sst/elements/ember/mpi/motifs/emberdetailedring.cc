@@ -46,7 +46,7 @@ inline long mod( long a, long b )
     return tmp;
 }
 
-bool EmberDetailedRingGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberDetailedRingGenerator::generate( EmberEventQueue& evQ)
 {
    if ( m_loopIndex == m_iterations ) {
         if ( m_printRank == rank() || -1 == m_printRank ) {
@@ -135,7 +135,7 @@ bool EmberDetailedRingGenerator::generate( std::queue<EmberEvent*>& evQ)
     return false;
 }
 
-void EmberDetailedRingGenerator::computeSimple( std::queue<EmberEvent*>& evQ)
+void EmberDetailedRingGenerator::computeSimple( EmberEventQueue& evQ)
 {
     verbose( CALL_INFO, 1, 0, "\n");
     while ( m_computeTime ) {
@@ -146,7 +146,7 @@ void EmberDetailedRingGenerator::computeSimple( std::queue<EmberEvent*>& evQ)
     }
 }
 
-void EmberDetailedRingGenerator::computeDetailed( std::queue<EmberEvent*>& evQ)
+void EmberDetailedRingGenerator::computeDetailed( EmberEventQueue& evQ)
 {
     verbose( CALL_INFO, 1, 0, "\n");
 
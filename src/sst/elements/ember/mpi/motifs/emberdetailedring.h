@@ -70,13 +70,13 @@ public:
 
 public:
 	EmberDetailedRingGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 	std::string getComputeModelName();
 
 private:
-    void computeDetailed( std::queue<EmberEvent*>& evQ);
-    void computeSimple( std::queue<EmberEvent*>& evQ);
-    void (EmberDetailedRingGenerator::*m_computeFunc)( std::queue<EmberEvent*>& evQ );
+    void computeDetailed( EmberEventQueue& evQ);
+    void computeSimple( EmberEventQueue& evQ);
+    void (EmberDetailedRingGenerator::*m_computeFunc)( EmberEventQueue& evQ );
     bool findNum( int num, std::string list );
 
     MessageRequest  m_req[2];
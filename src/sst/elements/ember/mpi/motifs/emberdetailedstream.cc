@@ -58,7 +58,7 @@ void EmberDetailedStreamGenerator::print( )
 	}
 }
 
-bool EmberDetailedStreamGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberDetailedStreamGenerator::generate( EmberEventQueue& evQ)
 {
 	if ( m_loopIndex == m_numLoops ) {
 		print( );
@@ -88,7 +88,7 @@ bool EmberDetailedStreamGenerator::generate( std::queue<EmberEvent*>& evQ)
     return false;
 }
 
-void EmberDetailedStreamGenerator::computeDetailedCopy( std::queue<EmberEvent*>& evQ)
+void EmberDetailedStreamGenerator::computeDetailedCopy( EmberEventQueue& evQ)
 {
     verbose( CALL_INFO, 1, 0, "\n");
 
@@ -121,7 +121,7 @@ void EmberDetailedStreamGenerator::computeDetailedCopy( std::queue<EmberEvent*>&
 
   	enQ_detailedCompute( evQ, motif, params );
 }
-void EmberDetailedStreamGenerator::computeDetailedTriad( std::queue<EmberEvent*>& evQ)
+void EmberDetailedStreamGenerator::computeDetailedTriad( EmberEventQueue& evQ)
 {
     verbose( CALL_INFO, 1, 0, "\n");
 
@@ -68,13 +68,13 @@ public:
 
 public:
 	EmberDetailedStreamGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 	std::string getComputeModelName();
 
 private:
 	//enum Bench { COPY, TRIAD, NUM_BENCH }  m_bench;
-    void computeDetailedCopy( std::queue<EmberEvent*>& evQ);
-    void computeDetailedTriad( std::queue<EmberEvent*>& evQ);
+    void computeDetailedCopy( EmberEventQueue& evQ);
+    void computeDetailedTriad( EmberEventQueue& evQ);
 	void print();
 
 	uint32_t m_numLoops;
@@ -284,7 +284,7 @@ void EmberFFT3DGenerator::initTimes( int numPe, int x, int y, int z, float nsPer
     m_bwdTime[2] *= transCostPer[5];
 }
 
-bool EmberFFT3DGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberFFT3DGenerator::generate( EmberEventQueue& evQ )
 {
     verbose(CALL_INFO, 1, 0, "loop=%d\n", m_loopIndex );
 
@@ -77,7 +77,7 @@ public:
 	EmberFFT3DGenerator(SST::ComponentId_t, Params& params);
 	~EmberFFT3DGenerator() {}
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ );
+	bool generate( EmberEventQueue& evQ );
 
 private:
 
@@ -66,7 +66,7 @@ public:
         EmberMessagePassingGenerator(id, params, "Fini")
     { }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
     {
         verbose(CALL_INFO, 2, 0, "\n" );
         enQ_fini( evQ );
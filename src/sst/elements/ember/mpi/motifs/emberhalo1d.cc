@@ -29,7 +29,7 @@ EmberHalo1DGenerator::EmberHalo1DGenerator(SST::ComponentId_t id, Params& params
 	messageSize = (uint32_t) params.find("arg.messagesize", 128);
 }
 
-bool EmberHalo1DGenerator::generate( std::queue<EmberEvent*>& evQ ) {
+bool EmberHalo1DGenerator::generate( EmberEventQueue& evQ ) {
 
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
@@ -26,7 +26,7 @@ class EmberHalo1DGenerator : public EmberMessagePassingGenerator {
 
 public:
 	EmberHalo1DGenerator(SST::ComponentId_t id, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
 	uint32_t m_loopIndex;
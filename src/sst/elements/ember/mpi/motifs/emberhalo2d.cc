@@ -112,7 +112,7 @@ void EmberHalo2DGenerator::completed(const SST::Output* output, uint64_t ) {
     output->verbose(CALL_INFO, 2, 0, "Generator finishing, sent: %" PRIu32 " messages.\n", messageCount);
 }
 
-bool EmberHalo2DGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberHalo2DGenerator::generate( EmberEventQueue& evQ) {
 
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
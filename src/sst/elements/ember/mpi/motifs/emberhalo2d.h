@@ -72,7 +72,7 @@ public:
 public:
 	EmberHalo2DGenerator(SST::ComponentId_t id, Params& params);
 	void configure();
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 	void completed(const SST::Output* output, uint64_t );
 
 private:
@@ -116,7 +116,7 @@ void EmberHalo2DNBRGenerator::configure()
 		(sendNorth ? "Y" : "N"), procNorth);
 }
 
-bool EmberHalo2DNBRGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberHalo2DNBRGenerator::generate( EmberEventQueue& evQ )
 {
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
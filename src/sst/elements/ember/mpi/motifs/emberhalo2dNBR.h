@@ -70,7 +70,7 @@ public:
 public:
 	EmberHalo2DNBRGenerator(SST::ComponentId_t, Params& params);
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ);
+	bool generate( EmberEventQueue& evQ);
     void completed(const SST::Output* output, uint64_t );
 
 private:
@@ -142,7 +142,7 @@ void EmberHalo3DGenerator::configure()
 //	assert( (x_up < worldSize) && (y_up < worldSize) && (z_up < worldSize) );
 }
 
-bool EmberHalo3DGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberHalo3DGenerator::generate( EmberEventQueue& evQ )
 {
     verbose(CALL_INFO, 1, 0, "loop=%d\n", m_loopIndex );
 
@@ -80,7 +80,7 @@ public:
 	EmberHalo3DGenerator(SST::ComponentId_t, Params& params);
 	~EmberHalo3DGenerator() {}
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ );
+	bool generate( EmberEventQueue& evQ );
 
 private:
 	uint32_t m_loopIndex;
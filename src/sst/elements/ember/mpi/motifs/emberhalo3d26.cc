@@ -231,7 +231,7 @@ EmberHalo3D26Generator::EmberHalo3D26Generator(SST::ComponentId_t id, Params& pa
 	requests.resize( requestLength * 2 );
 }
 
-bool EmberHalo3D26Generator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberHalo3D26Generator::generate( EmberEventQueue& evQ) {
 	verbose(CALL_INFO, 1, MOTIF_MASK, "Iteration on rank %" PRId32 "\n", rank());
 
 		enQ_compute( evQ, compute_the_time );
@@ -79,7 +79,7 @@ public:
 public:
 	EmberHalo3D26Generator(SST::ComponentId_t, Params& params);
 	~EmberHalo3D26Generator() {}
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
 	uint64_t compute_the_time;
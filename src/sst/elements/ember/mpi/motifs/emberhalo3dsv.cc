@@ -141,7 +141,7 @@ void EmberHalo3DSVGenerator::configure()
 //	assert( (x_up < worldSize) && (y_up < worldSize) && (z_up < worldSize) );
 }
 
-bool EmberHalo3DSVGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberHalo3DSVGenerator::generate( EmberEventQueue& evQ )
 {
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
@@ -81,7 +81,7 @@ public:
 	EmberHalo3DSVGenerator(SST::ComponentId_t, Params& params);
 	~EmberHalo3DSVGenerator() {}
 	void configure();
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
 	uint32_t m_loopIndex;
@@ -89,7 +89,7 @@ EmberHotSpotsGenerator::EmberHotSpotsGenerator(SST::ComponentId_t id, Params& pa
     }
 }
 
-bool EmberHotSpotsGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberHotSpotsGenerator::generate( EmberEventQueue& evQ)
 {
     evQ_ = &evQ;
     m_currentTime = getCurrentSimTimeNano();
@@ -206,7 +206,7 @@ void EmberHotSpotsGenerator::recv_data() {
 }
 
 void EmberHotSpotsGenerator::send_data() {
-    std::queue<EmberEvent*>& evQ = *evQ_;
+    EmberEventQueue& evQ = *evQ_;
 
     ++m_currentIteration;
     if (m_debug > 2)
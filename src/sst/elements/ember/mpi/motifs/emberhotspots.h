@@ -71,7 +71,7 @@ public:
 
 public:
     EmberHotSpotsGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
     bool primary( ) {
         return true;
     }
@@ -105,7 +105,7 @@ private:
     SSTGaussianDistribution* m_random;
     enum {DATA, STOPPING, ALLSTOPPED};
     enum {STOP_REQUEST, RECV_REQUEST, SEND_REQUEST};
-    std::queue<EmberEvent*>* evQ_;
+    EmberEventQueue* evQ_;
     bool m_dataSendActive;
     bool m_needToWait;
     bool m_finishing;
@@ -39,7 +39,7 @@ EmberIncastGenerator::EmberIncastGenerator(SST::ComponentId_t id, Params& params
 	}
 }
 
-bool EmberIncastGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberIncastGenerator::generate( EmberEventQueue& evQ)
 {
 	if( m_currentItr == m_iterations ) {
 		return true;
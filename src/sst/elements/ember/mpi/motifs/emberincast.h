@@ -65,7 +65,7 @@ public:
 
 public:
 	EmberIncastGenerator(SST::ComponentId_t, Params& params);
-    	bool generate( std::queue<EmberEvent*>& evQ);
+    	bool generate( EmberEventQueue& evQ);
 
 private:
     	MessageRequest*   m_req;
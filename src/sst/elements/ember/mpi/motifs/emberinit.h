@@ -69,7 +69,7 @@ public:
 			m_size(0)
     { }
 
-    bool generate( std::queue<EmberEvent*>& evQ )
+    bool generate( EmberEventQueue& evQ )
     {
 		if ( 0 == m_size ) {
 			verbose(CALL_INFO, 1, MOTIF_MASK, "\n");
@@ -301,7 +301,7 @@ void EmberLQCDGenerator::configure()
 // This code is a simplified representation of Rational Hybrid Monte Carlo (RHMC)
 // in MILC lattice QCD.
 // This is mostly focused on the Conjugate Gradient and Dslash
-bool EmberLQCDGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberLQCDGenerator::generate( EmberEventQueue& evQ )
 {
     verbose(CALL_INFO, 1, 0, "loop=%d\n", m_loopIndex );
 	std::vector<MessageRequest*> pos_requests;
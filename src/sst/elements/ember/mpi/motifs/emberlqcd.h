@@ -104,7 +104,7 @@ public:
 	EmberLQCDGenerator(SST::ComponentId_t, Params& params);
 	~EmberLQCDGenerator() {}
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ );
+	bool generate( EmberEventQueue& evQ );
 
 private:
     int get_node_index(int x, int y, int z, int t);
@@ -39,7 +39,7 @@ EmberMsgRateGenerator::EmberMsgRateGenerator(SST::ComponentId_t id, Params& para
     m_resp.resize( m_numMsgs );
 }
 
-bool EmberMsgRateGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberMsgRateGenerator::generate( EmberEventQueue& evQ)
 {
     assert( 2 == size() );
 
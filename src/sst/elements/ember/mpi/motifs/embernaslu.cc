@@ -75,7 +75,7 @@ void EmberNASLUGenerator::configure()
 		rank(), myX, myY, x_up, x_down, y_up, y_down);
 }
 
-bool EmberNASLUGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberNASLUGenerator::generate( EmberEventQueue& evQ)
 {
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
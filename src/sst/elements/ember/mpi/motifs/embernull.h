@@ -66,7 +66,7 @@ public:
 		EmberMessagePassingGenerator(id, params, "Null" )
 	{ }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
 		return true;
 	}
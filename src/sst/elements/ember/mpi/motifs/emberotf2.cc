@@ -489,7 +489,7 @@ EmberOTF2Generator::EmberOTF2Generator(SST::ComponentId_t id, Params& params) :
 	OTF2_GlobalEvtReader_SetCallbacks( traceGlobalEvtReader, traceGlobalEvtCallbacks, this );
 }
 
-bool EmberOTF2Generator::generate( std::queue<EmberEvent*>& evQ ) {
+bool EmberOTF2Generator::generate( EmberEventQueue& evQ ) {
 	setEventQueue( &evQ );
 
 	uint64_t eventsRead = 0;
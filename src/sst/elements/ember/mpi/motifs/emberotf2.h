@@ -30,7 +30,7 @@ class EmberOTF2Generator : public EmberMessagePassingGenerator {
 public:
 	EmberOTF2Generator(SST::ComponentId_t, Params& params);
 	~EmberOTF2Generator();
-    	bool generate( std::queue<EmberEvent*>& evQ );
+    	bool generate( EmberEventQueue& evQ );
 
 	SST_ELI_REGISTER_SUBCOMPONENT(
         	EmberOTF2Generator,
@@ -79,7 +79,7 @@ public:
 		return currentTime;
 	}
 
-	std::queue<EmberEvent*>* getEventQueue() {
+	EmberEventQueue* getEventQueue() {
 		return eventQ;
 	}
     
@@ -93,7 +93,7 @@ public:
     void allreduce( Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count, PayloadDataType dtype, ReductionOperation op, Communicator group );    
     void reduce(Queue& q, const Hermes::MemAddr& mydata, const Hermes::MemAddr& result, uint32_t count, PayloadDataType dtype, ReductionOperation op, int root,Communicator group );
 	
-    void setEventQueue( std::queue<EmberEvent*>* newQ ) {
+    void setEventQueue( EmberEventQueue* newQ ) {
 		eventQ = newQ;
 	}
 
@@ -136,7 +136,7 @@ private:
 
 	bool traceOpenedDefFiles;
 
-	std::queue<EmberEvent*>* eventQ;
+	EmberEventQueue* eventQ;
 	std::unordered_map<uint64_t, MessageRequest*> requestMap;
 };
 
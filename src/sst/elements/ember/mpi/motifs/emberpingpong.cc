@@ -41,7 +41,7 @@ EmberPingPongGenerator::EmberPingPongGenerator(SST::ComponentId_t id, Params& pa
 
 }
 
-bool EmberPingPongGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberPingPongGenerator::generate( EmberEventQueue& evQ)
 {
     if ( m_loopIndex == m_iterations || ! ( 0 == rank() || m_rank2 == rank() ) ) {
         if ( 0 == rank()) {
@@ -68,7 +68,7 @@ public:
 
 public:
 	EmberPingPongGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     MessageRequest  m_req;
@@ -29,7 +29,7 @@ EmberRandomTrafficGenerator::EmberRandomTrafficGenerator(SST::ComponentId_t id,
 	iteration = 0;
 }
 
-bool EmberRandomTrafficGenerator::generate( std::queue<EmberEvent*>& evQ ) {
+bool EmberRandomTrafficGenerator::generate( EmberEventQueue& evQ ) {
 
 	if(iteration == maxIterations) {
 		return true;
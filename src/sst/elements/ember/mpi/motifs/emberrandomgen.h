@@ -64,7 +64,7 @@ public:
     )
 public:
 	EmberRandomTrafficGenerator(SST::ComponentId_t, Params& params);
-    	bool generate( std::queue<EmberEvent*>& evQ);
+    	bool generate( EmberEventQueue& evQ);
 
 protected:
 	uint32_t maxIterations;
@@ -32,7 +32,7 @@ EmberReduceGenerator::EmberReduceGenerator(SST::ComponentId_t id,
 
 }
 
-bool EmberReduceGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberReduceGenerator::generate( EmberEventQueue& evQ) {
     if ( 0 == m_loopIndex ) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(), size());
     }
@@ -0,0 +1,516 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "emberreplay.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Ember;
+
+EmberReplayGenerator::EmberReplayGenerator(SST::ComponentId_t id,
+                                            Params& params) :
+	EmberMessagePassingGenerator(id, params, "Replay"),
+	m_base(NULL),
+	m_length(0),
+	m_playing(true),
+	m_buf(NULL)
+{
+	std::string prefix = params.find<std::string>("arg.traceprefix", "");
+	m_motif = params.find<int>("arg.motif", -1);
+	m_batch = params.find<uint32_t>("arg.batch", 256);
+
+	if ( "" == prefix ) {
+		fatal(CALL_INFO, -1, "Error: trace prefix is empty, no way to load a recording!\n");
+	}
+	if ( 0 == m_batch ) {
+		m_batch = 1;
+	}
+
+	std::ostringstream fileName;
+	fileName << prefix << "." << rank();
+
+	int fd = open( fileName.str().c_str(), O_RDONLY );
+	if ( fd < 0 ) {
+		fatal(CALL_INFO, -1, "Error: unable to open recording: %s\n", fileName.str().c_str());
+	}
+
+	struct stat info;
+	if ( fstat( fd, &info ) < 0 || info.st_size < (off_t) sizeof(EmberReplayFileHeader) ) {
+		fatal(CALL_INFO, -1, "Error: recording %s is too short\n", fileName.str().c_str());
+	}
+	m_length = info.st_size;
+
+	void* base = mmap( NULL, m_length, PROT_READ, MAP_PRIVATE, fd, 0 );
+	::close( fd );
+	if ( MAP_FAILED == base ) {
+		fatal(CALL_INFO, -1, "Error: unable to map recording: %s\n", fileName.str().c_str());
+	}
+	madvise( base, m_length, MADV_SEQUENTIAL );
+	m_base = (const uint8_t*) base;
+
+	EmberReplayFileHeader header;
+	memcpy( &header, m_base, sizeof(header) );
+
+	if ( memcmp( header.magic, EMBER_REPLAY_MAGIC, sizeof(header.magic) ) ) {
+		fatal(CALL_INFO, -1, "Error: %s is not an ember recording\n", fileName.str().c_str());
+	}
+	if ( EMBER_REPLAY_VERSION != header.version ) {
+		fatal(CALL_INFO, -1, "Error: recording %s has version %" PRIu32 ", expected %d\n",
+				fileName.str().c_str(), header.version, EMBER_REPLAY_VERSION);
+	}
+	if ( header.rank != (uint32_t) rank() ) {
+		fatal(CALL_INFO, -1, "Error: recording %s is for rank %" PRIu32 "\n",
+				fileName.str().c_str(), header.rank);
+	}
+	if ( 0 == header.numRecords ) {
+		output("Warning: recording %s was not closed, replaying what was written\n", fileName.str().c_str());
+	}
+
+	verbose(CALL_INFO, 1, 0, "replaying %s, %" PRIu64 " records\n", fileName.str().c_str(), header.numRecords);
+
+	m_reqArray.resize( std::max( header.maxRequestArray, (uint32_t) 1 ) );
+	m_cursor = EmberReplayCursor( m_base, m_length );
+}
+
+EmberReplayGenerator::~EmberReplayGenerator()
+{
+	if ( m_base ) {
+		munmap( (void*) m_base, m_length );
+	}
+}
+
+bool EmberReplayGenerator::generate( EmberEventQueue& evQ )
+{
+	size_t start = evQ.size();
+
+	// records that add no events (skipped motifs, markers) don't count
+	// against the batch so an empty queue always gets something
+	while ( ! m_cursor.atEnd() && evQ.size() - start < m_batch ) {
+		EmberReplayCursor record = m_cursor;
+		EmberReplayType type = (EmberReplayType) m_cursor.get<uint8_t>();
+
+		if ( ! replay( evQ, type, evQ.empty() ) ) {
+			m_cursor = record;
+			break;
+		}
+		if ( ! m_cursor.ok() ) {
+			fatal(CALL_INFO, -1, "Error: recording is truncated at offset %" PRIu64 "\n", record.offset());
+		}
+	}
+
+	return m_cursor.atEnd();
+}
+
+/*
+ * Turn one record into events, false if the record has to wait for an empty
+ * queue and was not consumed.
+ */
+bool EmberReplayGenerator::replay( EmberEventQueue& evQ, EmberReplayType type, bool empty )
+{
+	switch ( type ) {
+
+	  case EMBER_REPLAY_MOTIF: {
+		int num = m_cursor.get<uint32_t>();
+		uint8_t length = m_cursor.get<uint8_t>();
+		const char* str = m_cursor.getString( length );
+		if ( ! m_cursor.ok() ) {
+			break;
+		}
+		std::string name( str, length );
+
+		if ( -1 == m_motif ) {
+			m_playing = name != "Init" && name != "Fini";
+		} else {
+			m_playing = num == m_motif;
+		}
+		verbose(CALL_INFO, 2, 0, "recorded motif %d %s %s\n", num, name.c_str(),
+				m_playing ? "replayed" : "skipped");
+		break;
+	  }
+
+	  case EMBER_REPLAY_COMPUTE: {
+		uint64_t delay = m_cursor.get<uint64_t>();
+		if ( m_playing ) {
+			enQ_compute( evQ, delay );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_GETTIME:
+		if ( m_playing ) {
+			enQ_getTime( evQ, &m_time );
+		}
+		break;
+
+	  // the Init and Fini motifs of the replaying job do these
+	  case EMBER_REPLAY_INIT:
+	  case EMBER_REPLAY_FINI:
+		break;
+
+	  case EMBER_REPLAY_RANK: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_rank( evQ, comm, &m_rank );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_SIZE: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_size( evQ, comm, &m_size );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_MAKE_PROGRESS:
+		if ( m_playing ) {
+			enQ_makeProgress( evQ );
+		}
+		break;
+
+	  case EMBER_REPLAY_SEND:
+	  case EMBER_REPLAY_ISEND:
+	  case EMBER_REPLAY_RECV:
+	  case EMBER_REPLAY_IRECV: {
+		uint32_t count = m_cursor.get<uint32_t>();
+		PayloadDataType dtype = readDataType();
+		RankID peer = m_cursor.get<uint32_t>();
+		uint32_t tag = m_cursor.get<uint32_t>();
+		Communicator comm = m_cursor.get<uint32_t>();
+		uint32_t id = EMBER_REPLAY_NO_REQUEST;
+		if ( EMBER_REPLAY_ISEND == type || EMBER_REPLAY_IRECV == type ) {
+			id = m_cursor.get<uint32_t>();
+		}
+		if ( ! m_playing ) {
+			break;
+		}
+
+		switch ( type ) {
+		  case EMBER_REPLAY_SEND:
+			enQ_send( evQ, m_buf, count, dtype, peer, tag, comm );
+			break;
+		  case EMBER_REPLAY_ISEND:
+			enQ_isend( evQ, m_buf, count, dtype, peer, tag, comm, postRequest( id ) );
+			break;
+		  case EMBER_REPLAY_RECV:
+			enQ_recv( evQ, m_buf, count, dtype, peer, tag, comm );
+			break;
+		  default:
+			enQ_irecv( evQ, m_buf, count, dtype, peer, tag, comm, postRequest( id ) );
+			break;
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_WAIT:
+	  case EMBER_REPLAY_TEST: {
+		uint32_t id = m_cursor.get<uint32_t>();
+		if ( ! m_playing ) {
+			break;
+		}
+		MessageRequest* req = findRequest( id, EMBER_REPLAY_WAIT == type );
+		if ( NULL == req ) {
+			break;
+		}
+		if ( EMBER_REPLAY_WAIT == type ) {
+			enQ_wait( evQ, req );
+		} else {
+			enQ_test( evQ, req, &m_flag );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_WAITALL:
+	  case EMBER_REPLAY_WAITANY:
+	  case EMBER_REPLAY_TESTANY:
+	  case EMBER_REPLAY_CANCEL:
+		// these take request values, which are only set once the posts
+		// ahead of them have issued
+		if ( m_playing && ! empty ) {
+			return false;
+		}
+		return requestArray( evQ, type );
+
+	  case EMBER_REPLAY_BARRIER: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_barrier( evQ, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_BCAST: {
+		uint32_t count = m_cursor.get<uint32_t>();
+		PayloadDataType dtype = readDataType();
+		int root = m_cursor.get<uint32_t>();
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_bcast( evQ, m_buf, count, dtype, root, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_REDUCE:
+	  case EMBER_REPLAY_ALLREDUCE: {
+		uint32_t count = m_cursor.get<uint32_t>();
+		PayloadDataType dtype = readDataType();
+		ReductionOperation op = readOp();
+		int root = 0;
+		if ( EMBER_REPLAY_REDUCE == type ) {
+			root = m_cursor.get<uint32_t>();
+		}
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( ! m_playing ) {
+			break;
+		}
+		if ( EMBER_REPLAY_REDUCE == type ) {
+			enQ_reduce( evQ, m_buf, m_buf, count, dtype, op, root, comm );
+		} else {
+			enQ_allreduce( evQ, m_buf, m_buf, count, dtype, op, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_SCATTER: {
+		uint32_t sendCnt = m_cursor.get<uint32_t>();
+		PayloadDataType sendType = readDataType();
+		uint32_t recvCnt = m_cursor.get<uint32_t>();
+		PayloadDataType recvType = readDataType();
+		int root = m_cursor.get<uint32_t>();
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_scatter( evQ, m_buf, sendCnt, sendType, m_buf, recvCnt, recvType, root, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_SCATTERV: {
+		PayloadDataType sendType = readDataType();
+		uint32_t recvCnt = m_cursor.get<uint32_t>();
+		PayloadDataType recvType = readDataType();
+		int root = m_cursor.get<uint32_t>();
+		Communicator comm = m_cursor.get<uint32_t>();
+		uint32_t n = m_cursor.get<uint32_t>();
+		int* sendCnts = (int*) m_cursor.getArray<int32_t>( n );
+		int* displs = (int*) m_cursor.getArray<int32_t>( n );
+		if ( m_playing && m_cursor.ok() ) {
+			enQ_scatterv( evQ, m_buf, n ? sendCnts : NULL, n ? displs : NULL, sendType,
+					m_buf, recvCnt, recvType, root, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_ALLGATHER:
+	  case EMBER_REPLAY_ALLTOALL: {
+		uint32_t sendCnt = m_cursor.get<uint32_t>();
+		PayloadDataType sendType = readDataType();
+		uint32_t recvCnt = m_cursor.get<uint32_t>();
+		PayloadDataType recvType = readDataType();
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( ! m_playing ) {
+			break;
+		}
+		if ( EMBER_REPLAY_ALLGATHER == type ) {
+			enQ_allgather( evQ, m_buf, sendCnt, sendType, m_buf, recvCnt, recvType, comm );
+		} else {
+			enQ_alltoall( evQ, m_buf, sendCnt, sendType, m_buf, recvCnt, recvType, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_ALLGATHERV: {
+		uint32_t sendCnt = m_cursor.get<uint32_t>();
+		PayloadDataType sendType = readDataType();
+		PayloadDataType recvType = readDataType();
+		Communicator comm = m_cursor.get<uint32_t>();
+		uint32_t n = m_cursor.get<uint32_t>();
+		Addr recvCnts = (Addr) m_cursor.getArray<int32_t>( n );
+		Addr recvDsp = (Addr) m_cursor.getArray<int32_t>( n );
+		if ( m_playing && m_cursor.ok() ) {
+			enQ_allgatherv( evQ, m_buf, sendCnt, sendType, m_buf, recvCnts, recvDsp, recvType, comm );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_ALLTOALLV: {
+		PayloadDataType sendType = readDataType();
+		PayloadDataType recvType = readDataType();
+		Communicator comm = m_cursor.get<uint32_t>();
+		uint32_t n = m_cursor.get<uint32_t>();
+		Addr sendCnts = (Addr) m_cursor.getArray<int32_t>( n );
+		Addr sendDsp = (Addr) m_cursor.getArray<int32_t>( n );
+		Addr recvCnts = (Addr) m_cursor.getArray<int32_t>( n );
+		Addr recvDsp = (Addr) m_cursor.getArray<int32_t>( n );
+		if ( m_playing && m_cursor.ok() ) {
+			enQ_alltoallv( evQ, m_buf, sendCnts, sendDsp, sendType, m_buf, recvCnts, recvDsp, recvType, comm );
+		}
+		break;
+	  }
+
+	  // communicators are numbered in creation order, the same calls in the
+	  // same order give the ids recorded in the records that use them
+	  case EMBER_REPLAY_COMM_SPLIT: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		int color = m_cursor.get<uint32_t>();
+		int key = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_commSplit( evQ, comm, color, key, newComm() );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_COMM_CREATE: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		uint32_t n = m_cursor.get<uint32_t>();
+		const int32_t* ranks = m_cursor.getArray<int32_t>( n );
+		if ( m_playing && m_cursor.ok() ) {
+			m_commRanks.push_back( std::vector<int>( ranks, ranks + n ) );
+			enQ_commCreate( evQ, comm, m_commRanks.back(), newComm() );
+		}
+		break;
+	  }
+
+	  case EMBER_REPLAY_COMM_DESTROY: {
+		Communicator comm = m_cursor.get<uint32_t>();
+		if ( m_playing ) {
+			enQ_commDestroy( evQ, comm );
+		}
+		break;
+	  }
+
+	  default:
+		fatal(CALL_INFO, -1, "Error: unknown record type %d at offset %" PRIu64 "\n",
+				type, m_cursor.offset() - 1);
+	}
+
+	return true;
+}
+
+bool EmberReplayGenerator::requestArray( EmberEventQueue& evQ, EmberReplayType type )
+{
+	if ( EMBER_REPLAY_CANCEL == type ) {
+		uint32_t id = m_cursor.get<uint32_t>();
+		MessageRequest* req = m_playing ? findRequest( id, false ) : NULL;
+		if ( req ) {
+			enQ_cancel( evQ, *req );
+		}
+		return true;
+	}
+
+	uint32_t n = m_cursor.get<uint32_t>();
+	const uint32_t* ids = m_cursor.getArray<uint32_t>( n );
+	if ( ! m_playing || ! m_cursor.ok() ) {
+		return true;
+	}
+
+	// requests that were never posted are left out, as a null request would be
+	int count = 0;
+	for ( uint32_t i = 0; i < n && i < m_reqArray.size(); i++ ) {
+		MessageRequest* req = findRequest( ids[i], EMBER_REPLAY_WAITALL == type );
+		if ( req ) {
+			m_reqArray[count++] = *req;
+		}
+	}
+	if ( 0 == count ) {
+		return true;
+	}
+
+	switch ( type ) {
+	  case EMBER_REPLAY_WAITALL:
+		enQ_waitall( evQ, count, &m_reqArray[0] );
+		break;
+	  case EMBER_REPLAY_WAITANY:
+		enQ_waitany( evQ, count, &m_reqArray[0], &m_index );
+		break;
+	  default:
+		enQ_testany( evQ, count, &m_reqArray[0], &m_index, &m_flag );
+		break;
+	}
+	return true;
+}
+
+PayloadDataType EmberReplayGenerator::readDataType()
+{
+	PayloadDataType dtype = (PayloadDataType) m_cursor.get<uint8_t>();
+	// the size is there for tools that don't know the Hermes types
+	m_cursor.get<uint8_t>();
+	return dtype;
+}
+
+ReductionOperation EmberReplayGenerator::readOp()
+{
+	switch ( (Hermes::MP::ReductionOpType) m_cursor.get<uint8_t>() ) {
+	  case Hermes::MP::Nop:
+		return Hermes::MP::NOP;
+	  case Hermes::MP::Min:
+		return Hermes::MP::MIN;
+	  case Hermes::MP::Max:
+		return Hermes::MP::MAX;
+	  default:
+		// a user function only costs what a sum does
+		return Hermes::MP::SUM;
+	}
+}
+
+/*
+ * A slot is handed back when the wait that completes its request is queued.
+ * Events issue in order so a later post that reuses the slot writes it after
+ * the wait has read it. A request completed by a test is never waited on,
+ * it is posted again under the same id and keeps its slot.
+ */
+MessageRequest* EmberReplayGenerator::postRequest( uint32_t id )
+{
+	std::unordered_map<uint32_t,uint32_t>::iterator iter = m_reqMap.find( id );
+	if ( iter != m_reqMap.end() ) {
+		return &m_reqSlots[ iter->second ];
+	}
+
+	uint32_t slot;
+	if ( m_freeSlots.empty() ) {
+		slot = m_reqSlots.size();
+		m_reqSlots.push_back( MessageRequest() );
+	} else {
+		slot = m_freeSlots.back();
+		m_freeSlots.pop_back();
+	}
+	m_reqMap[id] = slot;
+	return &m_reqSlots[slot];
+}
+
+MessageRequest* EmberReplayGenerator::findRequest( uint32_t id, bool complete )
+{
+	std::unordered_map<uint32_t,uint32_t>::iterator iter = m_reqMap.find( id );
+	if ( iter == m_reqMap.end() ) {
+		return NULL;
+	}
+	MessageRequest* req = &m_reqSlots[ iter->second ];
+	if ( complete ) {
+		m_freeSlots.push_back( iter->second );
+		m_reqMap.erase( iter );
+	}
+	return req;
+}
+
+Communicator* EmberReplayGenerator::newComm()
+{
+	m_newComms.push_back( Communicator() );
+	return &m_newComms.back();
+}
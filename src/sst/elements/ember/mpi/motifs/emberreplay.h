@@ -0,0 +1,120 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_EMBER_REPLAY_MOTIF
+#define _H_EMBER_REPLAY_MOTIF
+
+#include "mpi/embermpigen.h"
+#include "emberreplayformat.h"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+namespace SST {
+namespace Ember {
+
+/*
+ * Replays the stream written by the engine's motifRecord mode. The file is
+ * mapped read only and walked in place, a batch of records per generate().
+ */
+class EmberReplayGenerator : public EmberMessagePassingGenerator {
+
+public:
+    SST_ELI_REGISTER_SUBCOMPONENT(
+        EmberReplayGenerator,
+        "ember",
+        "ReplayMotif",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Replays the calls recorded with the engine's motifRecord parameter",
+        SST::Ember::EmberGenerator
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {   "arg.traceprefix",  "Sets the prefix of the recorded streams, rank N reads <prefix>.N", "" },
+        {   "arg.motif",        "Replays only the recorded motif with this number, -1 replays all but Init and Fini", "-1" },
+        {   "arg.batch",        "Sets the maximum number of records turned into events per generate call", "256" },
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "time-Init", "Time spent in Init event",          "ns",  0},
+        { "time-Finalize", "Time spent in Finalize event",  "ns", 0},
+        { "time-Rank", "Time spent in Rank event",          "ns", 0},
+        { "time-Size", "Time spent in Size event",          "ns", 0},
+        { "time-Send", "Time spent in Recv event",          "ns", 0},
+        { "time-Recv", "Time spent in Recv event",          "ns", 0},
+        { "time-Irecv", "Time spent in Irecv event",        "ns", 0},
+        { "time-Isend", "Time spent in Isend event",        "ns", 0},
+        { "time-Wait", "Time spent in Wait event",          "ns", 0},
+        { "time-Waitall", "Time spent in Waitall event",    "ns", 0},
+        { "time-Waitany", "Time spent in Waitany event",    "ns", 0},
+        { "time-Compute", "Time spent in Compute event",    "ns", 0},
+        { "time-Barrier", "Time spent in Barrier event",    "ns", 0},
+        { "time-Alltoallv", "Time spent in Alltoallv event", "ns", 0},
+        { "time-Alltoall", "Time spent in Alltoall event",  "ns", 0},
+        { "time-Allreduce", "Time spent in Allreduce event", "ns", 0},
+        { "time-Reduce", "Time spent in Reduce event",      "ns", 0},
+        { "time-Bcast", "Time spent in Bcast event",        "ns", 0},
+        { "time-Gettime", "Time spent in Gettime event",    "ns", 0},
+        { "time-Commsplit", "Time spent in Commsplit event", "ns", 0},
+        { "time-Commcreate", "Time spent in Commcreate event", "ns", 0},
+    )
+
+public:
+	EmberReplayGenerator(SST::ComponentId_t, Params& params);
+	~EmberReplayGenerator();
+	bool generate( EmberEventQueue& evQ );
+
+private:
+	bool replay( EmberEventQueue& evQ, EmberReplayType type, bool first );
+	bool requestArray( EmberEventQueue& evQ, EmberReplayType type );
+
+	PayloadDataType readDataType();
+	ReductionOperation readOp();
+	MessageRequest* postRequest( uint32_t id );
+	MessageRequest* findRequest( uint32_t id, bool complete );
+	Communicator* newComm();
+
+	const uint8_t* m_base;
+	uint64_t m_length;
+	EmberReplayCursor m_cursor;
+
+	int      m_motif;
+	uint32_t m_batch;
+	bool     m_playing;
+
+	// a request lives in a slot from its isend/irecv to its wait
+	std::deque<MessageRequest> m_reqSlots;
+	std::vector<uint32_t> m_freeSlots;
+	std::unordered_map<uint32_t,uint32_t> m_reqMap;
+
+	// request arrays are copied here when the queue is empty
+	std::vector<MessageRequest> m_reqArray;
+
+	std::deque<Communicator> m_newComms;
+	std::deque< std::vector<int> > m_commRanks;
+
+	void*    m_buf;
+	uint64_t m_time;
+	uint32_t m_rank;
+	int      m_size;
+	int      m_index;
+	int      m_flag;
+};
+
+}
+}
+
+#endif
@@ -36,7 +36,7 @@ inline long mod( long a, long b )
     return tmp;
 }
 
-bool EmberRingGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberRingGenerator::generate( EmberEventQueue& evQ)
 {
    if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank()) {
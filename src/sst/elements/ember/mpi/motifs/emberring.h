@@ -66,7 +66,7 @@ public:
 
 public:
 	EmberRingGenerator(SST::ComponentId_t id, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     MessageRequest  m_req[2];
@@ -42,7 +42,7 @@ EmberScatterGenerator::EmberScatterGenerator(SST::ComponentId_t id,
     }
 }
 
-bool EmberScatterGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberScatterGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
         int typeSize = sizeofDataType(INT);
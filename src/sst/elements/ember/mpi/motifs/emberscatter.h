@@ -67,7 +67,7 @@ public:
 
 public:
 	EmberScatterGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ);
+    bool generate( EmberEventQueue& evQ);
 
 private:
     uint64_t m_startTime;
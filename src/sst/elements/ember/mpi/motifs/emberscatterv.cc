@@ -48,7 +48,7 @@ EmberScattervGenerator::EmberScattervGenerator(SST::ComponentId_t id,
 }
 
 
-bool EmberScattervGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberScattervGenerator::generate( EmberEventQueue& evQ) {
 
     if ( m_loopIndex == m_iterations ) {
         int typeSize = sizeofDataType(LONG);
@@ -68,7 +68,7 @@ public:
 			m_messageSize = 1024;
    	}
 
-    bool generate( std::queue<EmberEvent*>& evQ){
+    bool generate( EmberEventQueue& evQ){
 		assert( size() == 2 );
 		switch ( m_phase ) {
 			case Init:
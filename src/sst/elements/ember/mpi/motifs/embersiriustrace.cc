@@ -52,7 +52,7 @@ EmberSIRIUSTraceGenerator::EmberSIRIUSTraceGenerator(SST::ComponentId_t id,
 		fatal(CALL_INFO, -1, "Error: trace does not start with an MPI init event. Correct file?\n");
 	}
 
-	std::queue<EmberEvent*> initQueue;
+	EmberEventQueue initQueue;
 	readMPIInit(initQueue);
 }
 
@@ -62,7 +62,7 @@ EmberSIRIUSTraceGenerator::~EmberSIRIUSTraceGenerator() {
 	}
 }
 
-void EmberSIRIUSTraceGenerator::enqueueCompute( std::queue<EmberEvent*>& evQ,
+void EmberSIRIUSTraceGenerator::enqueueCompute( EmberEventQueue& evQ,
 		const double nextStartTime,
 		const double nextEndTime) {
 
@@ -75,7 +75,7 @@ void EmberSIRIUSTraceGenerator::enqueueCompute( std::queue<EmberEvent*>& evQ,
 	currentTraceTime = std::max(currentTraceTime, nextEndTime);
 }
 
-bool EmberSIRIUSTraceGenerator::generate( std::queue<EmberEvent*>& evQ)
+bool EmberSIRIUSTraceGenerator::generate( EmberEventQueue& evQ)
 {
 	const uint32_t sirius_func_type = readUINT32();
 
@@ -134,7 +134,7 @@ int32_t EmberSIRIUSTraceGenerator::readTag() const {
 	}
 }
 
-void EmberSIRIUSTraceGenerator::readMPIInit( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIInit( EmberEventQueue& evQ ) {
 	const double startTime  = readTime();
 	const double startTime2 = readTime();
 	const int32_t result    = readINT32();
@@ -142,7 +142,7 @@ void EmberSIRIUSTraceGenerator::readMPIInit( std::queue<EmberEvent*>& evQ ) {
 	currentTraceTime = startTime2;
 }
 
-void EmberSIRIUSTraceGenerator::readMPICommDisconnect( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPICommDisconnect( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const Communicator* comm = readCommunicator();
 
@@ -162,7 +162,7 @@ void EmberSIRIUSTraceGenerator::readMPICommDisconnect( std::queue<EmberEvent*>&
 	enQ_commDestroy( evQ, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPICommSplit( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPICommSplit( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const Communicator* comm = readCommunicator();
 	const int32_t color = readINT32();
@@ -185,7 +185,7 @@ void EmberSIRIUSTraceGenerator::readMPICommSplit( std::queue<EmberEvent*>& evQ )
 	enQ_commSplit(evQ, *comm, color, key, newComm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPISend( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPISend( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t readBuffer = readUINT64();
 	const uint32_t count = readUINT32();
@@ -205,7 +205,7 @@ void EmberSIRIUSTraceGenerator::readMPISend( std::queue<EmberEvent*>& evQ ) {
 	enQ_send( evQ, sendBuffer, count, dType, dest, tag, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIIsend( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIIsend( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t buffer  = readUINT64();
 	const uint32_t count   = readUINT32();
@@ -236,7 +236,7 @@ void EmberSIRIUSTraceGenerator::readMPIIsend( std::queue<EmberEvent*>& evQ ) {
 	enQ_isend( evQ, sendBuffer, count, dType, dest, tag, *comm, emberReq );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIRecv( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIRecv( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t readBuffer = readUINT64();
 	const uint32_t count = readUINT32();
@@ -262,7 +262,7 @@ void EmberSIRIUSTraceGenerator::readMPIRecv( std::queue<EmberEvent*>& evQ ) {
 	enQ_recv( evQ, recvBuffer, count, dType, src, tag, *comm, msgResp );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIBarrier( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIBarrier( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const Communicator* comm = readCommunicator();
 	const double endTime = readTime();
@@ -274,7 +274,7 @@ void EmberSIRIUSTraceGenerator::readMPIBarrier( std::queue<EmberEvent*>& evQ ) {
 	enQ_barrier( evQ, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIReduce( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIReduce( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t buffer = readUINT64();
 	const uint64_t recvBuffer = readUINT64();
@@ -296,7 +296,7 @@ void EmberSIRIUSTraceGenerator::readMPIReduce( std::queue<EmberEvent*>& evQ ) {
 	enQ_reduce( evQ, allocLocalBuffer, allocRecvBuffer, count, dType, opType, root, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIAllreduce( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIAllreduce( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t buffer = readUINT64();
 	const uint64_t recvBuffer = readUINT64();
@@ -317,7 +317,7 @@ void EmberSIRIUSTraceGenerator::readMPIAllreduce( std::queue<EmberEvent*>& evQ )
 	enQ_allreduce( evQ, allocLocalBuffer, allocRecvBuffer, count, dType, opType, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIIrecv( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIIrecv( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t buffer = readUINT64();
 	const uint32_t count  = readUINT32();
@@ -353,7 +353,7 @@ void EmberSIRIUSTraceGenerator::readMPIIrecv( std::queue<EmberEvent*>& evQ ) {
 	enQ_irecv( evQ, allocBuffer, count, dType, src, tag, *comm, emberReq );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIWaitall( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIWaitall( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint32_t reqCount = readUINT32();
 
@@ -390,7 +390,7 @@ void EmberSIRIUSTraceGenerator::readMPIWaitall( std::queue<EmberEvent*>& evQ ) {
 	enQ_waitall( evQ, requestAddr.size(), reqs, NULL );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIWait( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIWait( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t request = readUINT64();
 	const uint64_t status  = readUINT64();
@@ -419,7 +419,7 @@ void EmberSIRIUSTraceGenerator::readMPIWait( std::queue<EmberEvent*>& evQ ) {
 	}
 }
 
-void EmberSIRIUSTraceGenerator::readMPIBcast( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIBcast( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const uint64_t buffer = readUINT64();
 	const uint32_t count = readUINT32();
@@ -437,7 +437,7 @@ void EmberSIRIUSTraceGenerator::readMPIBcast( std::queue<EmberEvent*>& evQ ) {
 	enQ_bcast( evQ, realBuffer, count, dType, root, *comm );
 }
 
-void EmberSIRIUSTraceGenerator::readMPIFinalize( std::queue<EmberEvent*>& evQ ) {
+void EmberSIRIUSTraceGenerator::readMPIFinalize( EmberEventQueue& evQ ) {
 	const double startTime = readTime();
 	const double endTime   = readTime();
 	const int32_t result = readINT32();
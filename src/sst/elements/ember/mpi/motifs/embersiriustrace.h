@@ -68,7 +68,7 @@ public:
 public:
 	EmberSIRIUSTraceGenerator(SST::ComponentId_t, Params& params);
 	~EmberSIRIUSTraceGenerator();
-    	bool generate( std::queue<EmberEvent*>& evQ );
+    	bool generate( EmberEventQueue& evQ );
 
 	void printLiveRequestMap() {
 		for(auto itr = liveRequests.begin();
@@ -95,23 +95,23 @@ private:
 	size_t getTypeElementSize(const PayloadDataType dType) const;
 	ReductionOperation readReductionOp() const;
 
-	void enqueueCompute( std::queue<EmberEvent*>& evQ,
+	void enqueueCompute( EmberEventQueue& evQ,
                 const double nextStartTime,
                 const double nextEndTime);
-	void readMPISend( std::queue<EmberEvent*>& evQ );
-	void readMPIIsend( std::queue<EmberEvent*>& evQ );
-	void readMPIRecv( std::queue<EmberEvent*>& evQ );
-	void readMPIIrecv( std::queue<EmberEvent*>& evQ );
-	void readMPIFinalize( std::queue<EmberEvent*>& evQ );
-	void readMPIInit( std::queue<EmberEvent*>& evQ );
-	void readMPIReduce( std::queue<EmberEvent*>& evQ );
-	void readMPIAllreduce( std::queue<EmberEvent*>& evQ );
-	void readMPIBarrier( std::queue<EmberEvent*>& evQ );
-	void readMPIWait( std::queue<EmberEvent*>& evQ );
-	void readMPIWaitall( std::queue<EmberEvent*>& evQ );
-	void readMPIBcast( std::queue<EmberEvent*>& evQ );
-	void readMPICommSplit( std::queue<EmberEvent*>& evQ );
-	void readMPICommDisconnect( std::queue<EmberEvent*>& evQ );
+	void readMPISend( EmberEventQueue& evQ );
+	void readMPIIsend( EmberEventQueue& evQ );
+	void readMPIRecv( EmberEventQueue& evQ );
+	void readMPIIrecv( EmberEventQueue& evQ );
+	void readMPIFinalize( EmberEventQueue& evQ );
+	void readMPIInit( EmberEventQueue& evQ );
+	void readMPIReduce( EmberEventQueue& evQ );
+	void readMPIAllreduce( EmberEventQueue& evQ );
+	void readMPIBarrier( EmberEventQueue& evQ );
+	void readMPIWait( EmberEventQueue& evQ );
+	void readMPIWaitall( EmberEventQueue& evQ );
+	void readMPIBcast( EmberEventQueue& evQ );
+	void readMPICommSplit( EmberEventQueue& evQ );
+	void readMPICommDisconnect( EmberEventQueue& evQ );
 
 };
 
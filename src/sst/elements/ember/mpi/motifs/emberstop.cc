@@ -29,7 +29,7 @@ EmberStopGenerator::EmberStopGenerator(SST::ComponentId_t id,
     jobId        = (int) params.find<int>("_jobId");
 }
 
-bool EmberStopGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberStopGenerator::generate( EmberEventQueue& evQ )
 {
     if ( m_loopIndex == m_iterations ) {
         if ( 0 == rank() ) {
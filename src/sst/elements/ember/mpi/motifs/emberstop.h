@@ -67,7 +67,7 @@ public:
 
 public:
 	EmberStopGenerator(SST::ComponentId_t, Params& params);
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
     uint32_t m_loopIndex;
@@ -56,7 +56,7 @@ void EmberSweep2DGenerator::configure()
 					",X-:%" PRId32 "\n", rank(), x_up, x_down);
 }
 
-bool EmberSweep2DGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberSweep2DGenerator::generate( EmberEventQueue& evQ )
 {
     if( 0 == m_loopIndex) {
         verbose(CALL_INFO, 1, 0, "rank=%d size=%d\n", rank(),size());
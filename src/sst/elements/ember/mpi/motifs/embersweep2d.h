@@ -68,7 +68,7 @@ public:
 public:
 	EmberSweep2DGenerator(SST::ComponentId_t, Params& params);
 	void configure();
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
 	uint32_t m_loopIndex;
@@ -93,7 +93,7 @@ void EmberSweep3DGenerator::configure()
 	*/
 }
 
-bool EmberSweep3DGenerator::generate( std::queue<EmberEvent*>& evQ) {
+bool EmberSweep3DGenerator::generate( EmberEventQueue& evQ) {
 
 	if( 0 == m_loopIndex && 0 == m_InnerLoopIndex ) {
 		configure();
@@ -77,7 +77,7 @@ public:
 public:
 	EmberSweep3DGenerator(SST::ComponentId_t id, Params& params);
 	void configure();
-    bool generate( std::queue<EmberEvent*>& evQ );
+    bool generate( EmberEventQueue& evQ );
 
 private:
     uint32_t m_loopIndex;
@@ -66,7 +66,7 @@ public:
 	{
 		m_rng = new SST::RNG::XORShiftRNG();
 	}
-    bool generate( std::queue<EmberEvent*>& evQ){
+    bool generate( EmberEventQueue& evQ){
 		assert( size() == 2 );
 		switch ( m_phase ) {
 			case Init:
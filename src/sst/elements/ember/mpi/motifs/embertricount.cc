@@ -184,7 +184,7 @@ EmberTriCountGenerator::starts() {
 }
 
 bool
-EmberTriCountGenerator::generate(std::queue<EmberEvent*>& evQ){
+EmberTriCountGenerator::generate(EmberEventQueue& evQ){
   evQ_ = &evQ;
   if (generate_loop_index_ == 0) {
     memSetBacked();
@@ -201,7 +201,7 @@ EmberTriCountGenerator::generate(std::queue<EmberEvent*>& evQ){
 
 bool
 EmberTriCountGenerator::task_server() {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
 
   if (next_task_ < num_tasks_) {
     if (generate_loop_index_ > 0) {
@@ -242,7 +242,7 @@ EmberTriCountGenerator::task_server() {
 
 bool
 EmberTriCountGenerator::task_client() {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
 
   if (debug_ > 1) std::cerr << "rank " << rank_ << " beginning client loop " << generate_loop_index_ << std::endl;
 
@@ -437,7 +437,7 @@ EmberTriCountGenerator::task_client() {
 
 void
 EmberTriCountGenerator::request_task() {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
   // send a request for a task
   enQ_send( evQ, nullptr, 1, UINT64_T, 0, TASK_REQUEST, GroupWorld);
   // fire off a recv for the task request
@@ -448,7 +448,7 @@ EmberTriCountGenerator::request_task() {
 
 void
 EmberTriCountGenerator::recv_datareq() {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
   if (debug_ > 1) std::cerr << "rank " << rank_ << " start a datareq recv\n";
   enQ_irecv( evQ, datareq_recv_memaddr_, 1, UINT64_T, Hermes::MP::AnySrc, DATA_REQUEST, GroupWorld, &datareq_recv_request_);
   datareq_recv_active_ = true;
@@ -456,7 +456,7 @@ EmberTriCountGenerator::recv_datareq() {
 
 void
 EmberTriCountGenerator::wait_for_any() {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
   if (debug_ > 1) std::cerr << "rank " << rank_ <<  " num_data_ranks_ " << num_data_ranks_ << std::endl;
   uint64_t size = num_data_ranks_ - num_data_received_ + task_recv_active_ + datareq_recv_active_;
   if (debug_ > 1) std::cerr << "rank " << rank_ <<  " enqueing waitany with size " << size << std::endl;
@@ -494,7 +494,7 @@ EmberTriCountGenerator::wait_for_any() {
 
 void
 EmberTriCountGenerator::request_edges( uint64_t first_edge, uint64_t last_edge ) {
-  std::queue<EmberEvent*>& evQ = *evQ_;
+  EmberEventQueue& evQ = *evQ_;
 
   // Determine what other ranks have edge data for this vertex
   std::map<uint64_t,uint64_t> rank_to_size;
@@ -570,7 +570,7 @@ EmberTriCountGenerator::edges_to_ranks(uint64_t first_edge, uint64_t last_edge,
 
 void
 EmberTriCountGenerator::test_send_requests() {
-   std::queue<EmberEvent*>& evQ = *evQ_;
+   EmberEventQueue& evQ = *evQ_;
    int size = send_requests_.size();
    if (size == 0) return;
    if (send_request_array_) delete send_request_array_;
@@ -585,7 +585,7 @@ EmberTriCountGenerator::test_send_requests() {
 
 void
 EmberTriCountGenerator::wait_send_requests() {
-   std::queue<EmberEvent*>& evQ = *evQ_;
+   EmberEventQueue& evQ = *evQ_;
    int size = send_requests_.size();
    if (size == 0) return;
    if (send_request_array_) delete send_request_array_;
@@ -48,7 +48,7 @@ public:
   void init_vertices();
   void first_edges();
   void starts();
-  bool generate(std::queue<EmberEvent*>& evQ);
+  bool generate(EmberEventQueue& evQ);
   bool task_server();
   bool task_client();
   void request_task();
@@ -62,7 +62,7 @@ public:
 private:
   enum {TASK_REQUEST, TASK_ASSIGN, TASK_NULL, TASKS_COMPLETE, DATA_REQUEST, DATA};
   Params params_;
-  std::queue<EmberEvent*>* evQ_;
+  EmberEventQueue* evQ_;
   int debug_;
   uint64_t rank_;
   uint64_t NT_;
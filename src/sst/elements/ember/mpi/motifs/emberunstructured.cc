@@ -110,7 +110,7 @@ void EmberUnstructuredGenerator::configure()
 	//output("My rank is: %" PRIu32 "\n", rank()); // NetworkSim
 }
 
-bool EmberUnstructuredGenerator::generate( std::queue<EmberEvent*>& evQ )
+bool EmberUnstructuredGenerator::generate( EmberEventQueue& evQ )
 {
     verbose(CALL_INFO, 1, 0, "loop=%d\n", m_loopIndex );
 
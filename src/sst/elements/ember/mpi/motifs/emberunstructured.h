@@ -69,7 +69,7 @@ public:
 	EmberUnstructuredGenerator(SST::ComponentId_t, Params& params);
 	~EmberUnstructuredGenerator() {}
 	void configure();
-	bool generate( std::queue<EmberEvent*>& evQ );
+	bool generate( EmberEventQueue& evQ );
 
 private:
 	std::string graphFile;
@@ -64,7 +64,7 @@ public:
 	{
 		m_rng = new SST::RNG::XORShiftRNG();
 	}
-    bool generate( std::queue<EmberEvent*>& evQ){
+    bool generate( EmberEventQueue& evQ){
 		switch ( m_phase ) {
 			case Init:
 				m_rng->seed( rank() + getSeed() );
@@ -23,7 +23,7 @@ from sst.firefly import *
 class EmberJob(Job):
     def __init__(self, job_id, num_nodes, apis, numCores = 1, nicsPerNode = 1):
         Job.__init__(self,job_id,num_nodes * nicsPerNode)
-        self._declareClassVariables(["_motifNum","_motifs","_numCores","_nicsPerNode","nic","_loopBackDict","_logfilePrefix","_logfileNids","os","_apis"])
+        self._declareClassVariables(["_motifNum","_motifs","_numCores","_nicsPerNode","nic","_loopBackDict","_logfilePrefix","_logfileNids","_logfileFormat","os","_apis"])
 
         # Not needed - the subclasses will set the nic to the correct type:
         #x = self._createPrefixedParams("nic")
@@ -85,9 +85,10 @@ class EmberJob(Job):
         self._motifs["motif_count"] = self._motifNum
 
 
-    def enableMotifLog(self,logfilePrefix, nids = None):
+    def enableMotifLog(self,logfilePrefix, nids = None, logFormat = None):
         self._logfilePrefix = logfilePrefix;
         self._logfileNids = nids
+        self._logfileFormat = logFormat
 
 
     def build(self, nodeID, extraKeys):
@@ -150,6 +151,8 @@ class EmberJob(Job):
             if self._logfilePrefix:
                 if ( self._logfileNids is None or logical_id in self._logfileNids):
                     ep.addParam("motifLog",self._logfilePrefix)
+                    if self._logfileFormat:
+                        ep.addParam("motifLogFormat",self._logfileFormat)
 
 
             # Create the links to the OS layer
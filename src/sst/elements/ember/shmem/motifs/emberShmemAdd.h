@@ -39,7 +39,7 @@ public:
 		free( tmp );
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
         switch ( m_phase ) {
@@ -57,7 +57,7 @@ public:
 		return tmp;
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
         switch ( m_phase ) {
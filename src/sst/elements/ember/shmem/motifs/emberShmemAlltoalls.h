@@ -45,7 +45,7 @@ public:
         assert( 4 == sizeof(TYPE) || 8 == sizeof(TYPE) );
     }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
         switch ( m_phase ) {
@@ -70,7 +70,7 @@ public:
 #endif
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
 		if ( -3 == m_phase ) {
@@ -72,7 +72,7 @@ public:
 	//	return m_detailed;
 	//}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
 		switch( m_phase ) {
@@ -209,8 +209,8 @@ public:
 	}
   private:
 
-	//bool detailedLocalPE( std::queue<EmberEvent*>& evQ ) {
-	void detailedLocalPE( std::queue<EmberEvent*>& evQ ) {
+	//bool detailedLocalPE( EmberEventQueue& evQ ) {
+	void detailedLocalPE( EmberEventQueue& evQ ) {
 		//printf("%s()\n",__func__);
        	verbose( CALL_INFO, 1, 0, "\n");
 
@@ -251,7 +251,7 @@ public:
 		//return true;
 	}
 
-	bool work( std::queue<EmberEvent*>& evQ ) {
+	bool work( EmberEventQueue& evQ ) {
 		//printf("%s()\n",__func__);
 		int dest = calcDestPe();
 
@@ -45,7 +45,7 @@ public:
         m_count = (uint32_t) params.find("arg.iterations", 1);
     }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         if ( m_phase == -2 ) {
             enQ_init( evQ );
@@ -57,7 +57,7 @@ public:
 	}
 
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
 		if ( -3 == m_phase ) {
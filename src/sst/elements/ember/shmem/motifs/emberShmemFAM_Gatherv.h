@@ -67,7 +67,7 @@ public:
 		}
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         switch ( m_phase ) {
         case Init:
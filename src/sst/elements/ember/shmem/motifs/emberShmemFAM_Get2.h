@@ -86,7 +86,7 @@ public:
 		}
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         switch ( m_phase ) {
         case Init:
@@ -157,7 +157,7 @@ public:
 
   private:
 
-	bool work(  std::queue<EmberEvent*>& evQ ) {
+	bool work(  EmberEventQueue& evQ ) {
 
 		for ( int i = 0; i < m_getLoop && m_curBlock < m_numBlocks; i++ ) {
 
@@ -200,7 +200,7 @@ public:
 	}
 
 
-    void computeDetailed( std::queue<EmberEvent*>& evQ)
+    void computeDetailed( EmberEventQueue& evQ)
     {
         verbose( CALL_INFO, 1, 0, "\n");
 
@@ -68,7 +68,7 @@ public:
 		}
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         switch ( m_phase ) {
         case Init:
@@ -43,7 +43,7 @@ public:
 		free( tmp );
     }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
 		if ( -2 == m_phase ) {
@@ -35,7 +35,7 @@ public:
 		m_count = (uint32_t) params.find("arg.count", 1) - 1;
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         if ( -2 == m_phase ) {
             enQ_init( evQ );
@@ -35,7 +35,7 @@ public:
 		m_putv = params.find<bool>("arg.putv", true);
 	}
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         if ( -2 == m_phase ) {
             enQ_init( evQ );
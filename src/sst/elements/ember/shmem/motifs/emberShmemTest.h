@@ -66,7 +66,7 @@ public:
 		EmberShmemGenerator(id, params, "ShmemTest" ), m_phase(0)
 	{ }
 
-    bool generate( std::queue<EmberEvent*>& evQ)
+    bool generate( EmberEventQueue& evQ)
 	{
         bool ret = false;
         switch ( m_phase ) {
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+# Fit the LogGP parameters used by firefly's analytic collectives
+# (hermesParams.functionSM.analyticCollectives) to timings taken from
+# detailed runs of the same collectives on a few small rank counts.
+#
+# Input is a CSV file with one measurement per line:
+#
+#   collective,ranks,bytes,time_ns
+#
+# collective is allreduce, reduce, bcast, barrier or alltoall, bytes is the
+# message size of one call (count * sizeof(dtype), per peer for alltoall) and
+# time_ns the average time of one call as reported by the motif. Lines
+# starting with # are ignored.
+#
+# L and o only appear as L + 2o in the model so o is given (--overhead) and L
+# is what is left over.
+
+import sys, getopt
+
+DEGREE = 2
+
+def treeDepth( size, degree ):
+    depth = 0
+    covered = 1
+    width = 1
+    while covered < size:
+        width *= degree
+        covered += width
+        depth += 1
+    return depth
+
+# coefficients of [L+2o, g, G, gamma] in the model of one measurement,
+# smallGap says whether g or bytes*G is the larger term of a fan out
+def features( collective, ranks, nbytes, smallGap ):
+    if collective == 'alltoall':
+        return [ ranks - 1, 0, ( ranks - 1 ) * nbytes, 0 ]
+
+    if collective == 'barrier':
+        nbytes = 0
+
+    up = collective in ( 'allreduce', 'reduce', 'barrier' )
+    down = collective in ( 'allreduce', 'bcast', 'barrier' )
+
+    fan = [ 1, 0, nbytes, 0 ]
+    if smallGap:
+        fan[2] += ( DEGREE - 1 ) * nbytes
+    else:
+        fan[1] += DEGREE - 1
+
+    level = [ 0, 0, 0, 0 ]
+    if up:
+        level = [ a + b for a, b in zip( level, fan ) ]
+        level[3] += DEGREE * nbytes
+    if down:
+        level = [ a + b for a, b in zip( level, fan ) ]
+
+    depth = treeDepth( ranks, DEGREE )
+    return [ depth * x for x in level ]
+
+def solve( A, b ):
+    n = len( b )
+    M = [ row[:] + [ b[i] ] for i, row in enumerate( A ) ]
+    for col in range( n ):
+        pivot = max( range( col, n ), key = lambda r: abs( M[r][col] ) )
+        M[col], M[pivot] = M[pivot], M[col]
+        for r in range( n ):
+            if r != col and M[col][col] != 0:
+                f = M[r][col] / M[col][col]
+                M[r] = [ x - f * y for x, y in zip( M[r], M[col] ) ]
+    return [ M[i][n] / M[i][i] if M[i][i] != 0 else 0.0 for i in range( n ) ]
+
+def fit( samples, iterations = 10 ):
+    x = [ 1000.0, 100.0, 0.1, 0.25 ]
+    for it in range( iterations ):
+        rows = []
+        for collective, ranks, nbytes, time in samples:
+            smallGap = x[1] < nbytes * x[2]
+            rows.append( ( features( collective, ranks, nbytes, smallGap ), time ) )
+
+        # normal equations with a little ridge so unused terms stay at 0
+        AtA = [ [ 0.0 ] * 4 for i in range( 4 ) ]
+        Atb = [ 0.0 ] * 4
+        for f, t in rows:
+            for i in range( 4 ):
+                Atb[i] += f[i] * t
+                for j in range( 4 ):
+                    AtA[i][j] += f[i] * f[j]
+        for i in range( 4 ):
+            AtA[i][i] += 1e-9 * ( AtA[i][i] + 1 )
+
+        x = [ max( 0.0, v ) for v in solve( AtA, Atb ) ]
+    return x
+
+def usage():
+    print( 'usage: collectiveModelFit.py [--overhead=ns] [--subtract=ns] timings.csv' )
+
+def main():
+    overhead = 500.0
+    subtract = 0.0
+    try:
+        opts, args = getopt.getopt( sys.argv[1:], 'h', [ 'overhead=', 'subtract=', 'help' ] )
+    except getopt.GetoptError as err:
+        print( str( err ) )
+        usage()
+        sys.exit( 2 )
+
+    for o, a in opts:
+        if o == '--overhead':
+            overhead = float( a )
+        elif o == '--subtract':
+            subtract = float( a )
+        else:
+            usage()
+            sys.exit( 0 )
+
+    if len( args ) != 1:
+        usage()
+        sys.exit( 2 )
+
+    samples = []
+    with open( args[0] ) as fp:
+        for line in fp:
+            line = line.strip()
+            if not line or line.startswith( '#' ) or line.startswith( 'collective' ):
+                continue
+            collective, ranks, nbytes, time = [ v.strip() for v in line.split( ',' ) ]
+            samples.append( ( collective.lower(), int( ranks ), int( nbytes ), float( time ) - subtract ) )
+
+    if not samples:
+        sys.exit( 'no samples in ' + args[0] )
+
+    Lo, g, G, gamma = fit( samples )
+    L = max( 0.0, Lo - 2 * overhead )
+
+    print( '"hermesParams.functionSM.analyticCollectives" : 1,' )
+    print( '"hermesParams.functionSM.loggp.L" : %.3f,' % L )
+    print( '"hermesParams.functionSM.loggp.o" : %.3f,' % overhead )
+    print( '"hermesParams.functionSM.loggp.g" : %.3f,' % g )
+    print( '"hermesParams.functionSM.loggp.G" : %.6f,' % G )
+    print( '"hermesParams.functionSM.loggp.gamma" : %.6f,' % gamma )
+
+    worst = 0.0
+    for collective, ranks, nbytes, time in samples:
+        model = sum( a * b for a, b in zip( features( collective, ranks, nbytes, g < nbytes * G ), [ Lo, g, G, gamma ] ) )
+        if time > 0:
+            worst = max( worst, abs( model - time ) / time )
+    print( '# worst relative error over %d samples: %.1f%%' % ( len( samples ), worst * 100 ), file = sys.stderr )
+
+if __name__ == '__main__':
+    main()
@@ -13,9 +13,11 @@ from paramUtils import *
 debug    = 0
 emberVerbose = 0
 embermotifLog = ''
+embermotifLogFormat = ''
 emberrankmapper = ''
 
 useSimpleMemoryModel=False
+timingOnly=False
 
 statNodeList = []
 jobid = 0
@@ -77,10 +79,10 @@ try:
                  "simConfig=","platParams=","debug=","platform=","numNodes=",
                  "numCores=","loadFile=","loadFileVar=","cmdLine=","printStats=","randomPlacement=",
                  "emberVerbose=","netBW=","netPktSize=","netFlitSize=",
-                 "rtrArb=","embermotifLog=","rankmapper=", "motifAPI=",
+                 "rtrArb=","embermotifLog=","embermotifLogFormat=","rankmapper=", "motifAPI=",
                  "bgPercentage=","bgMean=","bgStddev=","bgMsgSize=","netInspect=",
                  "detailedModelName=","detailedModelParams=","detailedModelNodes=",
-                 "useSimpleMemoryModel","param=","paramDir=","statsModule=","statsFile="])
+                 "useSimpleMemoryModel","timingOnly","param=","paramDir=","statsModule=","statsFile="])
 
 except getopt.GetoptError as err:
     print (str(err))
@@ -118,6 +120,8 @@ for o, a in opts:
         emberVerbose = a
     elif o in ("--embermotifLog"):
         embermotifLog = a
+    elif o in ("--embermotifLogFormat"):
+        embermotifLogFormat = a
     elif o in ("--rankmapper"):
         emberrankmapper = a
     elif o in ("--netBW"):
@@ -156,6 +160,8 @@ for o, a in opts:
         params[key] += [value]
     elif o in ("--useSimpleMemoryModel"):
         useSimpleMemoryModel=True
+    elif o in ("--timingOnly"):
+        timingOnly=True
     elif o in ("--paramDir"):
         paramDir = a
     elif o in ("--statsModule"):
@@ -386,8 +392,12 @@ hermesParams[ emberParams['os.name'] + '.numNodes'] = topoInfo.getNumNodes()
 
 if embermotifLog:
     emberParams['motifLog'] = embermotifLog
+if embermotifLogFormat:
+    emberParams['motifLogFormat'] = embermotifLogFormat
 if emberrankmapper:
     emberParams['rankmapper'] = emberrankmapper
+if timingOnly:
+    emberParams['timingOnly'] = 1
 
 for a in params['network']:
     key, value = a.split("=")
@@ -0,0 +1,13 @@
+import sst
+
+def init( outputFile ):
+
+	sst.setStatisticLoadLevel(9)
+
+	sst.setStatisticOutput("sst.statOutputCSV");
+	sst.setStatisticOutputOptions({
+		"filepath" : outputFile,
+		"separator" : ", "
+	})
+
+	sst.enableStatisticForComponentType("firefly.nic",'shmemPutBatchSize',{"type":"sst.AccumulatorStatistic","rate":"0ns"})
@@ -0,0 +1,79 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import decimal
+import os
+import re
+import shutil
+
+################################################################################
+# NOTES:
+# Helpers for the ember testsuites that run test/emberLoad.py with their own
+# model options and compare the simulated times of the runs. This is not a
+# testsuite, the testsuites add this directory to sys.path and import it.
+################################################################################
+
+def setup_ember_test_folder(testcase, name):
+    """Create a clean <tmpdir>/<name>_folder holding a link to each python file
+    in the ember/test directory and return its path"""
+    log_debug("setup_ember_test_folder({0}) Running".format(name))
+    test_path = testcase.get_testsuite_dir()
+    tmpdir = testcase.get_test_output_tmp_dir()
+
+    folder = "{0}/{1}_folder".format(tmpdir, name)
+    emberelement_testdir = "{0}/../test/".format(test_path)
+
+    # Create a clean version of the folder
+    if os.path.isdir(folder):
+        shutil.rmtree(folder, True)
+    os.makedirs(folder)
+
+    # Create a simlink of each file in the ember/test directory
+    for f in os.listdir(emberelement_testdir):
+        filename, ext = os.path.splitext(f)
+        if ext == ".py":
+            os_symlink_file(emberelement_testdir, folder, f)
+
+    return folder
+
+def ember_cmd_lines(*motifs):
+    """Return the --cmdLine options that run the motifs in order"""
+    return " ".join("--cmdLine=\\\"{0}\\\"".format(motif) for motif in motifs)
+
+def run_ember_model(testcase, folder, testDataFileName, options, num_threads=None):
+    """Run emberLoad.py in folder with the given model options and return the
+    simulated time in ps. The output goes to <rundir>/<testDataFileName>.out"""
+    test_path = testcase.get_testsuite_dir()
+    outdir = testcase.get_test_output_run_dir()
+
+    outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+    errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+    mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+    sdlfile = "{0}/../test/emberLoad.py".format(test_path)
+
+    otherargs = '--model-options=\"{0} \"'.format(options)
+
+    # Run SST
+    testcase.run_sst(sdlfile, outfile, errfile, other_args=otherargs, set_cwd=folder, mpi_out_files=mpioutfiles, num_threads=num_threads)
+
+    if os_test_file(errfile, "-s"):
+        log_testing_note("ember test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+    simtime = None
+    with open(outfile, 'r') as f:
+        for line in f.readlines():
+            found = re.search(r'Simulation is complete, simulated time: ([0-9.]+) (\w+)', line)
+            if found:
+                simtime = to_ps(testcase, found.group(1), found.group(2))
+
+    testcase.assertTrue(simtime is not None, "ember test {0} - Cannot find simulated time in output file {1}".format(testDataFileName, outfile))
+    return simtime
+
+def to_ps(testcase, value, units):
+    """Convert a time printed by SST to ps without rounding, so runs that
+    finish at the same time compare equal"""
+    scale = { 'ps' : 1, 'ns' : 10**3, 'us' : 10**6, 'ms' : 10**9, 's' : 10**12 }
+    testcase.assertTrue(units in scale, "ember test: unknown time units {0}".format(units))
+    return decimal.Decimal(value) * scale[units]
@@ -0,0 +1,72 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import decimal
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs the same collectives with the detailed state machines and with
+# hermesParams.functionSM.analyticCollectives, which charges the LogGP time
+# instead of sending the messages, and checks the simulated times agree
+# within a tolerance. The LogGP parameters are estimates for the default
+# network and NIC parameters of emberLoad.py, the buffers are unbacked
+# (--timingOnly) so the detailed runs do not charge the reduction either.
+# Only tree collectives are compared, the pairwise alltoall is sensitive to
+# link contention that the model does not capture.
+################################################################################
+
+# Relative difference allowed between the analytic and the detailed times
+TOLERANCE = decimal.Decimal("0.2")
+
+LOGGP_PARAMS = {
+    "L" : "1000",
+    "o" : "500",
+    "g" : "100",
+    "G" : "0.25",
+    "gamma" : "0",
+}
+
+class testcase_EmberAnalyticCollectives(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.analyticCollectives_Folder = setup_ember_test_folder(self, "analyticCollectives")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_analyticCollectives_allreduce(self):
+        self.analyticCollectives_test_template("allreduce", "Allreduce iterations=4 count=65536")
+
+    def test_analyticCollectives_bcast(self):
+        self.analyticCollectives_test_template("bcast", "Bcast iterations=4 count=65536")
+
+#####
+
+    def analyticCollectives_test_template(self, testcase, motif):
+        detailed = self._run_model(testcase, motif, "detailed", "")
+
+        params = ["--param=hermes:hermesParams.functionSM.analyticCollectives=1"]
+        params += ["--param=hermes:hermesParams.functionSM.loggp.{0}={1}".format(k, v) for k, v in sorted(LOGGP_PARAMS.items())]
+        analytic = self._run_model(testcase, motif, "analytic", " ".join(params))
+
+        log_debug("analyticCollectives {0}: detailed={1} ps analytic={2} ps".format(testcase, detailed, analytic))
+        self.assertTrue(detailed > 0, "analyticCollectives {0}: detailed run took no time".format(testcase))
+        error = abs(analytic - detailed) / detailed
+        self.assertTrue(error <= TOLERANCE,
+            "analyticCollectives {0}: analytic time {1} ps is {2:.3f} off the detailed {3} ps, more than {4}".format(testcase, analytic, error, detailed, TOLERANCE))
+
+    def _run_model(self, testcase, motif, mode, extra):
+        options = "--topo=torus --shape=4x4 --timingOnly {0} {1}".format(extra, ember_cmd_lines("Init", motif, "Fini"))
+        return run_ember_model(self, self.analyticCollectives_Folder, "test_analyticCollectives_{0}_{1}".format(testcase, mode), options)
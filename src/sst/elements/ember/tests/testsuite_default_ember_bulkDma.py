@@ -0,0 +1,57 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs the same motif with firefly's simple memory model costing NIC DMA
+# through the memory units and with the closed form bulk model
+# (simpleMemoryModel.nicDmaModel=bulk) and checks the simulated times agree
+# to within bulk_dma_tolerance.
+################################################################################
+
+bulk_dma_tolerance = 0.09
+
+class testcase_EmberBulkDma(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.bulkDma_Folder = setup_ember_test_folder(self, "bulkDma")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_bulkDma_pingpong(self):
+        self.bulkDma_test_template("pingpong", "PingPong iterations=10 messageSize=1048576")
+
+    def test_bulkDma_allpingpong(self):
+        self.bulkDma_test_template("allpingpong", "AllPingPong iterations=10 messageSize=20000")
+
+    def test_bulkDma_allreduce(self):
+        self.bulkDma_test_template("allreduce", "Allreduce iterations=10 count=65536")
+
+#####
+
+    def bulkDma_test_template(self, testcase, motif):
+        units = self._run_model(testcase, motif, "units")
+        bulk = self._run_model(testcase, motif, "bulk")
+
+        error = float(abs(bulk - units) / units)
+        log_debug("bulkDma {0}: units={1} ps bulk={2} ps error={3:.3f}".format(testcase, units, bulk, error))
+        self.assertTrue(error <= bulk_dma_tolerance,
+            "bulkDma {0}: bulk time {1} ps is not within {2} of units time {3} ps".format(testcase, bulk, bulk_dma_tolerance, units))
+
+    def _run_model(self, testcase, motif, model):
+        options = "--topo=torus --shape=4 --useSimpleMemoryModel --param=nic:simpleMemoryModel.nicDmaModel={0} {1}".format(model, ember_cmd_lines("Init", motif, "Fini"))
+        return run_ember_model(self, self.bulkDma_Folder, "test_bulkDma_{0}_{1}".format(testcase, model), options)
@@ -0,0 +1,99 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import glob
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs the same motifs writing the motif log as text and as binary shards
+# (ember:motifLogFormat=binary), turns the shards into text with
+# sst-embermotiflog and checks the two logs hold the same lines, with one and
+# with two SST threads.
+################################################################################
+
+MOTIFS = ember_cmd_lines("Init", "Allreduce iterations=4 count=100", "Barrier",
+                         "AllPingPong iterations=2 messageSize=1000", "Fini")
+
+class testcase_EmberMotifLog(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.motifLog_Folder = setup_ember_test_folder(self, "motifLog")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_motifLog_binary(self):
+        textlog = self._run_text_log()
+        outfile, shards = self._run_binary_log("binary", None)
+
+        cmp_result = testing_compare_diff("test_motifLog_binary", outfile, textlog)
+        self.assertTrue(cmp_result, "Output file {0} does not match the text log {1}".format(outfile, textlog))
+
+    # Two SST threads write a shard each, which sst-embermotiflog merges by end
+    # time. Motifs that end at the same time may be ordered differently from
+    # the single threaded text log, so compare the sorted lines and check the
+    # merge order separately.
+    def test_motifLog_binary_threads(self):
+        textlog = self._run_text_log()
+        outfile, shards = self._run_binary_log("binary_threads", 2)
+        self.assertTrue(len(shards) == 2, "motifLog test - Expected a shard per thread, found {0}".format(shards))
+
+        with open(outfile, 'r') as f:
+            merged = f.read().splitlines()
+        with open(textlog, 'r') as f:
+            text = f.read().splitlines()
+
+        self.assertEqual(sorted(merged), sorted(text),
+            "Output file {0} does not hold the lines of the text log {1}".format(outfile, textlog))
+
+        # File format:  job rank motifnum motif_name start_time end_time
+        endTimes = [to_ps(self, *line.split()[6:8]) for line in merged]
+        self.assertTrue(endTimes == sorted(endTimes), "Output file {0} is not in end time order".format(outfile))
+
+#####
+
+    def _run_text_log(self):
+        textprefix = "{0}/text".format(self.motifLog_Folder)
+        self._run_model("text", "--embermotifLog={0} {1}".format(textprefix, MOTIFS), None)
+
+        # the log is written by one engine, a parallel run adds -<rank>
+        textlogs = glob.glob("{0}*.log".format(textprefix))
+        self.assertTrue(len(textlogs) == 1, "motifLog test - Expected one text log, found {0}".format(textlogs))
+        return textlogs[0]
+
+    def _run_binary_log(self, mode, num_threads):
+        outdir = self.get_test_output_run_dir()
+
+        # Make sure we have access to the sst-embermotiflog binary
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        motiflog_app = "{0}/sst-embermotiflog".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(motiflog_app), "motifLog test - Cannot find {0}".format(motiflog_app))
+
+        binaryprefix = "{0}/{1}".format(self.motifLog_Folder, mode)
+        self._run_model(mode, "--embermotifLog={0} --embermotifLogFormat=binary {1}".format(binaryprefix, MOTIFS), num_threads)
+
+        shards = glob.glob("{0}*.mlog".format(binaryprefix))
+        self.assertTrue(len(shards) > 0, "motifLog test - Cannot find the binary log shards {0}*.mlog".format(binaryprefix))
+
+        outfile = "{0}/test_motifLog_{1}.log".format(outdir, mode)
+        cmd = "{0} -o {1} {2}".format(motiflog_app, outfile, " ".join(shards))
+        rtn = OSCommand(cmd, set_cwd=self.motifLog_Folder).run()
+        log_debug("sst-embermotiflog result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-embermotiflog failed on {0}".format(shards))
+        return outfile, shards
+
+    def _run_model(self, mode, extra, num_threads):
+        options = "--topo=torus --shape=4 {0}".format(extra)
+        return run_ember_model(self, self.motifLog_Folder, "test_motifLog_{0}".format(mode), options, num_threads=num_threads)
@@ -0,0 +1,60 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs a motif with the engine recording the calls it makes
+# (ember:motifRecord) and then replays the recording with the Replay motif,
+# the two runs must finish at the same simulated time.
+################################################################################
+
+class testcase_EmberReplay(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.replay_Folder = setup_ember_test_folder(self, "replay")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_replay_allpingpong(self):
+        self.replay_test_template("allpingpong", "AllPingPong iterations=10 messageSize=20000")
+
+    def test_replay_allreduce(self):
+        self.replay_test_template("allreduce", "Allreduce iterations=10 count=1024")
+
+    def test_replay_alltoallv(self):
+        self.replay_test_template("alltoallv", "Alltoallv iterations=4")
+
+    # Replay holds each waitall back until its queue drains, so with a
+    # lookahead the engine sees generate() calls that add nothing
+    def test_replay_lookahead(self):
+        self.replay_test_template("lookahead", "MessageRate iterations=4", "--param=ember:motifLookahead=64")
+
+#####
+
+    def replay_test_template(self, testcase, motif, replayargs = ""):
+        prefix = "{0}/{1}.rec".format(self.replay_Folder, testcase)
+
+        recorded = self._run_model(testcase, "record", motif, "--param=ember:motifRecord={0}".format(prefix))
+        replayed = self._run_model(testcase, "replay", "Replay traceprefix={0}".format(prefix), replayargs)
+
+        log_debug("replay {0}: recorded={1} ps replayed={2} ps".format(testcase, recorded, replayed))
+        self.assertEqual(recorded, replayed,
+            "replay {0}: replayed time {1} ps differs from the recorded time {2} ps".format(testcase, replayed, recorded))
+
+    def _run_model(self, testcase, mode, motif, extra):
+        options = "--topo=torus --shape=4 {0} {1}".format(extra, ember_cmd_lines("Init", motif, "Fini"))
+        return run_ember_model(self, self.replay_Folder, "test_replay_{0}_{1}".format(testcase, mode), options)
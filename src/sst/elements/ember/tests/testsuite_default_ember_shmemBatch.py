@@ -0,0 +1,80 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import glob
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs self checking SHMEM motifs with firefly's batching of small puts turned
+# on (nic:shmem.putBatchMaxBytes) and off. A put that is lost or applied twice
+# fails the motif's check. The batched run must carry more than one put in a
+# batch (the nic shmemPutBatchSize statistic) and finish no later than the
+# run without batching.
+################################################################################
+
+class testcase_EmberShmemBatch(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.shmemBatch_Folder = setup_ember_test_folder(self, "shmemBatch")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_shmemBatch_alltoalls32(self):
+        self.shmemBatch_test_template("alltoalls32", "ShmemAlltoalls32 nelems=99 dst=2 sst=2")
+
+    def test_shmemBatch_alltoalls64(self):
+        self.shmemBatch_test_template("alltoalls64", "ShmemAlltoalls64 nelems=99")
+
+#####
+
+    def shmemBatch_test_template(self, testcase, motif):
+        batched = self._run_model(testcase, motif, "batched", 512)
+        unbatched = self._run_model(testcase, motif, "unbatched", 0)
+        maxBatch = self._max_batch_size(testcase, "batched")
+
+        log_debug("shmemBatch {0}: batched={1} ps unbatched={2} ps max batch={3}".format(testcase, batched, unbatched, maxBatch))
+        self.assertTrue(maxBatch > 1,
+            "shmemBatch {0}: no batch carried more than one put, the largest was {1}".format(testcase, maxBatch))
+        self.assertTrue(batched <= unbatched,
+            "shmemBatch {0}: batched time {1} ps is later than the unbatched time {2} ps".format(testcase, batched, unbatched))
+
+    def _run_model(self, testcase, motif, mode, putBatchMaxBytes):
+        testDataFileName = "test_shmemBatch_{0}_{1}".format(testcase, mode)
+        statsfile = "{0}/{1}.csv".format(self.get_test_output_run_dir(), testDataFileName)
+
+        options = "--useSimpleMemoryModel --topo=torus --shape=4x4x4 --numCores=2 --motifAPI=HadesSHMEM " \
+                  "--param=nic:shmem.putBatchMaxBytes={0} --statsModule=shmemBatchStats --statsFile={1} {2}".format(
+                  putBatchMaxBytes, statsfile, ember_cmd_lines(motif))
+        return run_ember_model(self, self.shmemBatch_Folder, testDataFileName, options)
+
+    # the largest shmemPutBatchSize any nic recorded, each rank of a parallel
+    # run writes its own file
+    def _max_batch_size(self, testcase, mode):
+        testDataFileName = "test_shmemBatch_{0}_{1}".format(testcase, mode)
+        statsfiles = glob.glob("{0}/{1}*.csv".format(self.get_test_output_run_dir(), testDataFileName))
+        self.assertTrue(len(statsfiles) > 0, "shmemBatch test {0} - Cannot find its statistics file".format(testDataFileName))
+
+        maxBatch = 0
+        for statsfile in statsfiles:
+            with open(statsfile, 'r') as f:
+                header = [field.strip() for field in f.readline().split(',')]
+                name = header.index("StatisticName")
+                maximum = [i for i, field in enumerate(header) if field.startswith("Max.")][0]
+                for line in f.readlines():
+                    fields = [field.strip() for field in line.split(',')]
+                    if len(fields) == len(header) and fields[name] == "shmemPutBatchSize":
+                        maxBatch = max(maxBatch, int(fields[maximum]))
+        return maxBatch
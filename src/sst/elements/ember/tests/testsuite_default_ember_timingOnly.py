@@ -0,0 +1,50 @@
+# -*- coding: utf-8 -*-
+
+from sst_unittest import *
+from sst_unittest_support import *
+
+import os
+import sys
+
+dirpath = os.path.dirname(sys.modules[__name__].__file__)
+sys.path.insert(1, dirpath)
+from ember_unittest_support import *
+
+################################################################################
+# NOTES:
+# Runs the same motif with and without --timingOnly and checks the simulated
+# times are identical. Allgather verifies its result so it keeps its buffers
+# backed in both runs, its short messages must still use the eager protocol.
+################################################################################
+
+class testcase_EmberTimingOnly(SSTTestCase):
+
+    def setUp(self):
+        super(type(self), self).setUp()
+        self.timingOnly_Folder = setup_ember_test_folder(self, "timingOnly")
+
+    def tearDown(self):
+        # Put test based teardown code here. it is called once after every test
+        super(type(self), self).tearDown()
+
+#####
+
+    def test_timingOnly_allgather(self):
+        self.timingOnly_test_template("allgather", "Allgather iterations=10 count=16 verify=1")
+
+    def test_timingOnly_allreduce(self):
+        self.timingOnly_test_template("allreduce", "Allreduce iterations=10 count=16")
+
+#####
+
+    def timingOnly_test_template(self, testcase, motif):
+        default = self._run_model(testcase, motif, "default", "")
+        timingOnly = self._run_model(testcase, motif, "timingOnly", "--timingOnly")
+
+        log_debug("timingOnly {0}: default={1} ps timingOnly={2} ps".format(testcase, default, timingOnly))
+        self.assertEqual(default, timingOnly,
+            "timingOnly {0}: simulated time {1} ps differs from the default {2} ps".format(testcase, timingOnly, default))
+
+    def _run_model(self, testcase, motif, mode, extra):
+        options = "--topo=torus --shape=4 {0} {1}".format(extra, ember_cmd_lines("Init", motif, "Fini"))
+        return run_ember_model(self, self.timingOnly_Folder, "test_timingOnly_{0}_{1}".format(testcase, mode), options)
@@ -0,0 +1,181 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+/*
+ * Turns the shards of a binary motif log (the engine's motifLogFormat=binary)
+ * back into the text log, merging them in end time order:
+ *
+ *   job rank motifnum motif_name start_time end_time
+ */
+
+#include <sst_config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "sst/elements/ember/embermotiflogformat.h"
+
+void usage() {
+	printf("Usage: sst-embermotiflog [-o <file out>] <shard> [<shard> ...]\n");
+	printf("<shard>          Is a <prefix>[-<rank>].<thread>.mlog file written by the motif log\n");
+	printf("-o <file out>    Writes the text log to a file instead of stdout\n");
+	exit(-1);
+}
+
+struct Motif {
+	int32_t  job;
+	int32_t  rank;
+	int32_t  motifNum;
+	uint32_t nameID;
+	uint64_t startPs;
+	uint64_t endPs;
+};
+
+struct Shard {
+	const char* path;
+	FILE* input;
+	std::vector<std::string> names;
+	Motif next;
+};
+
+template< class T > bool readField(Shard& shard, T* value) {
+	return 1 == fread(value, sizeof(T), 1, shard.input);
+}
+
+void corrupt(Shard& shard) {
+	fprintf(stderr, "Error: %s is truncated or corrupt at offset %ld\n", shard.path, ftell(shard.input));
+	exit(-1);
+}
+
+// reads up to the next motif, false at the end of the shard
+bool readNext(Shard& shard) {
+	uint8_t type;
+
+	while(readField(shard, &type)) {
+		if(EMBER_MOTIF_LOG_NAME == type) {
+			uint32_t id;
+			uint16_t length;
+			if(! readField(shard, &id) || ! readField(shard, &length)) {
+				corrupt(shard);
+			}
+
+			std::string name(length, ' ');
+			if(length > 0 && 1 != fread(&name[0], length, 1, shard.input)) {
+				corrupt(shard);
+			}
+			if(id >= shard.names.size()) {
+				shard.names.resize(id + 1);
+			}
+			shard.names[id] = name;
+
+		} else if(EMBER_MOTIF_LOG_MOTIF == type) {
+			Motif& m = shard.next;
+			if(! readField(shard, &m.job) || ! readField(shard, &m.rank) ||
+				! readField(shard, &m.motifNum) || ! readField(shard, &m.nameID) ||
+				! readField(shard, &m.startPs) || ! readField(shard, &m.endPs) ||
+				m.nameID >= shard.names.size()) {
+				corrupt(shard);
+			}
+			return true;
+
+		} else {
+			corrupt(shard);
+		}
+	}
+	return false;
+}
+
+int main(int argc, char* argv[]) {
+	FILE* output = stdout;
+	std::vector<Shard> shards;
+
+	for(int i = 1; i < argc; i++) {
+		if(0 == strcmp(argv[i], "-o")) {
+			if(i + 1 == argc) {
+				usage();
+			}
+			output = fopen(argv[++i], "wt");
+			if(NULL == output) {
+				fprintf(stderr, "Error: unable to open %s for writing\n", argv[i]);
+				exit(-1);
+			}
+			continue;
+		}
+
+		Shard shard;
+		shard.path = argv[i];
+		shard.input = fopen(argv[i], "rb");
+		if(NULL == shard.input) {
+			fprintf(stderr, "Error: unable to open %s\n", argv[i]);
+			exit(-1);
+		}
+
+		EmberMotifLogFileHeader header;
+		if(1 != fread(&header, sizeof(header), 1, shard.input) ||
+			0 != memcmp(header.magic, EMBER_MOTIF_LOG_MAGIC, sizeof(header.magic))) {
+			fprintf(stderr, "Error: %s is not a binary motif log\n", argv[i]);
+			exit(-1);
+		}
+		if(EMBER_MOTIF_LOG_VERSION != header.version) {
+			fprintf(stderr, "Error: %s is version %" PRIu32 ", expected %d\n", argv[i], header.version, EMBER_MOTIF_LOG_VERSION);
+			exit(-1);
+		}
+
+		shards.push_back(shard);
+	}
+
+	if(shards.empty()) {
+		usage();
+	}
+
+	// earliest end time first, ties keep the order the shards were given in
+	typedef std::pair<uint64_t, size_t> Key;
+	std::priority_queue< Key, std::vector<Key>, std::greater<Key> > ready;
+
+	for(size_t i = 0; i < shards.size(); i++) {
+		if(readNext(shards[i])) {
+			ready.push(Key(shards[i].next.endPs, i));
+		}
+	}
+
+	while(! ready.empty()) {
+		size_t i = ready.top().second;
+		ready.pop();
+
+		Shard& shard = shards[i];
+		const Motif& m = shard.next;
+
+		fprintf(output, "%" PRId32 " %" PRId32 " %" PRId32 " %s %s %s\n", m.job, m.rank, m.motifNum,
+			shard.names[m.nameID].c_str(), emberMotifLogTime(m.startPs).c_str(), emberMotifLogTime(m.endPs).c_str());
+
+		if(readNext(shard)) {
+			ready.push(Key(shard.next.endPs, i));
+		}
+	}
+
+	for(size_t i = 0; i < shards.size(); i++) {
+		fclose(shards[i].input);
+	}
+	if(stdout != output) {
+		fclose(output);
+	}
+
+	return 0;
+}
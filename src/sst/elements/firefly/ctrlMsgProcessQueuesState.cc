@@ -1052,23 +1052,29 @@ void ProcessQueuesState::copyIoVec(
     size_t rV = 0,rP =0;
     for ( unsigned int i=0; i < src.size() && copied < len; i++ )
     {
-        assert( rV < dst.size() );
         dbg().debug(CALL_INFO,3,DBG_MSK_PQS_Q,"src[%d].len %lu\n", i, src[i].len);
 
-        for ( unsigned int j=0; j < src[i].len && copied < len ; j++ ) {
+        size_t sP = 0;
+        while ( sP < src[i].len && copied < len ) {
+            assert( rV < dst.size() );
+            if ( rP == dst[rV].len ) {
+                rP = 0;
+                ++rV;
+                continue;
+            }
             dbg().debug(CALL_INFO,3,DBG_MSK_PQS_Q,"copied=%lu rV=%lu rP=%lu\n",
                                                         copied,rV,rP);
 
+            size_t n = std::min( std::min( src[i].len - sP, dst[rV].len - rP ), len - copied );
+
+            // unbacked segments only account for the length
             if ( dst[rV].addr.getBacking() && src[i].addr.getBacking() ) {
-                ((char*)dst[rV].addr.getBacking())[rP] =
-                            ((char*)src[i].addr.getBacking())[j];
-            }
-            ++copied;
-            ++rP;
-            if ( rP == dst[rV].len ) {
-                rP = 0;
-                ++rV;
+                memcpy( (char*)dst[rV].addr.getBacking() + rP,
+                            (char*)src[i].addr.getBacking() + sP, n );
             }
+            copied += n;
+            sP += n;
+            rP += n;
         }
     }
     assert( copied == len );
@@ -52,6 +52,19 @@ void AlltoallvFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
         memcpy( recv, send, recvChunkSize(m_rank));
     }
 
+    if ( m_model.enabled() && ! m_event->sendbuf.getBacking() && ! m_event->recvbuf.getBacking() ) {
+        uint64_t delay = m_model.alltoallTime( m_size, m_rank,
+                [=]( MP::RankID rank ) { return sendChunkSize( rank ); },
+                [=]( MP::RankID rank ) { return recvChunkSize( rank ); } );
+
+        m_dbg.debug(CALL_INFO,1,0,"analytic, %" PRIu64 " ns\n", delay );
+
+        // PostRecv sees nothing left to do and exits
+        m_count = m_size;
+        retval.setDelay( delay );
+        return;
+    }
+
     retval.setDelay( 0 );
 }
 
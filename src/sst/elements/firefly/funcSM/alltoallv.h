@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveModel.h"
 #include "info.h"
 #include "ctrlMsg.h"
 
@@ -49,6 +50,11 @@ class AlltoallvFuncSM :  public FunctionSMInterface
 	SST_ELI_DOCUMENT_PARAMS(
 		{"smallCollectiveVN","Sets the VN to use for small collectives","0"},
 		{"smallCollectiveSize","Sets the size of small collectives","0"},
+		{"analyticCollectives","Replace the pairwise exchange with the LogGP estimate, calls with backing data stay detailed","0"},
+		{"loggp.L","LogGP latency (ns)","1000"},
+		{"loggp.o","LogGP per message overhead (ns)","500"},
+		{"loggp.g","LogGP gap between messages (ns)","100"},
+		{"loggp.G","LogGP time per byte (ns)","0.1"},
 	)
   private:
 
@@ -66,7 +72,8 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     AlltoallvFuncSM( SST::Params& params ) :
         FunctionSMInterface( params ),
         m_event( NULL ),
-        m_seq( 0 )
+        m_seq( 0 ),
+        m_model( params )
     {
        m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
@@ -149,6 +156,7 @@ class AlltoallvFuncSM :  public FunctionSMInterface
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
 
+    CollectiveModel m_model;
 };
 
 }
@@ -0,0 +1,121 @@
+// Copyright 2013-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2013-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEMODEL_H
+#define COMPONENTS_FIREFLY_FUNCSM_COLLECTIVEMODEL_H
+
+#include <stdint.h>
+#include <algorithm>
+
+#include <sst/core/params.h>
+
+namespace SST {
+namespace Firefly {
+
+/*
+ * LogGP estimate of how long a collective takes, used when
+ * "analyticCollectives" is set to skip the point to point messages the
+ * collective state machines would otherwise generate.
+ *
+ *   L      network latency (ns)
+ *   o      per message send/recv overhead (ns)
+ *   g      gap between consecutive messages from one NIC (ns)
+ *   G      time per byte (ns/byte)
+ *   gamma  time per byte to apply the reduction op to one input (ns/byte)
+ *
+ * The parameters depend on the topology and NIC configuration and should be
+ * fitted against detailed runs of the same collectives on a few small rank
+ * counts of the target machine (see ember/test/collectiveModelFit.py).
+ *
+ * Every rank charges the same time from when it enters, ranks do not wait
+ * for each other, so imbalance going into a collective is not propagated
+ * out of it.
+ */
+class CollectiveModel {
+  public:
+    CollectiveModel( SST::Params& params ) :
+        m_enabled( params.find<bool>( "analyticCollectives", false ) ),
+        m_L( params.find<double>( "loggp.L", 1000.0 ) ),
+        m_o( params.find<double>( "loggp.o", 500.0 ) ),
+        m_g( params.find<double>( "loggp.g", 100.0 ) ),
+        m_G( params.find<double>( "loggp.G", 0.1 ) ),
+        m_gamma( params.find<double>( "loggp.gamma", 0.25 ) )
+    { }
+
+    bool enabled() const { return m_enabled; }
+
+    // one message of the given size, start of send to end of recv
+    double msgTime( uint64_t bytes ) const {
+        return m_L + 2 * m_o + bytes * m_G;
+    }
+
+    // a node exchanging one message of the given size with each of count peers
+    double fanTime( unsigned count, uint64_t bytes ) const {
+        if ( 0 == count ) return 0;
+        return msgTime( bytes ) + ( count - 1 ) * std::max( m_g, bytes * m_G );
+    }
+
+    // number of levels below the root of a tree of the given degree
+    static unsigned treeDepth( unsigned size, unsigned degree ) {
+        unsigned depth = 0;
+        uint64_t covered = 1;
+        uint64_t width = 1;
+        while ( covered < size ) {
+            width *= degree;
+            covered += width;
+            ++depth;
+        }
+        return depth;
+    }
+
+    // reduce up and/or broadcast down a tree, as CollectiveTreeFuncSM does,
+    // one fan in and/or fan out per level, log2(size) levels for degree 2
+    uint64_t treeTime( unsigned size, unsigned degree, uint64_t bytes, bool up, bool down ) const {
+        unsigned depth = treeDepth( size, degree );
+        double level = 0;
+        if ( up ) {
+            level += fanTime( degree, bytes ) + degree * bytes * m_gamma;
+        }
+        if ( down ) {
+            level += fanTime( degree, bytes );
+        }
+        return (uint64_t) ( depth * level );
+    }
+
+    // pairwise exchange, step i sends to rank+i and receives from rank-i
+    template < class SendSize, class RecvSize >
+    uint64_t alltoallTime( unsigned size, unsigned rank, SendSize sendSize, RecvSize recvSize ) const {
+        double time = 0;
+        for ( unsigned i = 1; i < size; i++ ) {
+            uint64_t bytes = std::max( sendSize( ( rank + i ) % size ),
+                                    recvSize( ( rank + size - i ) % size ) );
+            time += msgTime( bytes );
+        }
+        return (uint64_t) time;
+    }
+
+  private:
+    bool    m_enabled;
+    double  m_L;
+    double  m_o;
+    double  m_g;
+    double  m_G;
+    double  m_gamma;
+};
+
+}
+}
+
+#endif
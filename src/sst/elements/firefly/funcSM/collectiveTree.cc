@@ -77,6 +77,19 @@ void CollectiveTreeFuncSM::handleStartEvent( SST::Event *e, Retval& retval )
         }
     }
 
+    if ( m_model.enabled() && ! m_event->mydata.getBacking() ) {
+        bool up = m_event->type != CollectiveStartEvent::Bcast;
+        bool down = m_event->type != CollectiveStartEvent::Reduce;
+        uint64_t delay = m_model.treeTime( m_yyy->size(), 2, m_bufLen, up, down );
+
+        m_dbg.debug(CALL_INFO,1,0,"analytic %s, %" PRIu64 " ns\n", m_event->typeName(), delay );
+
+        // no messages, just wait out the estimate and clean up
+        m_state = Exit;
+        retval.setDelay( delay );
+        return;
+    }
+
     m_waitUpState.init();
     m_sendDownState.init();
     if ( m_event->type == CollectiveStartEvent::Bcast ) {
@@ -18,6 +18,7 @@
 
 #include "funcSM/api.h"
 #include "funcSM/event.h"
+#include "funcSM/collectiveModel.h"
 #include "ctrlMsg.h"
 
 namespace SST {
@@ -109,6 +110,17 @@ class CollectiveTreeFuncSM :  public FunctionSMInterface
 public:
     SST_ELI_REGISTER_MODULE_DERIVED_API(SST::Firefly::CollectiveTreeFuncSM, SST::Firefly::FunctionSMInterface)
 
+    SST_ELI_DOCUMENT_PARAMS(
+        {"smallCollectiveVN","Sets the VN to use for small collectives","0"},
+        {"smallCollectiveSize","Sets the size of small collectives","0"},
+        {"analyticCollectives","Replace the tree of messages with the LogGP estimate, collectives with backing data stay detailed","0"},
+        {"loggp.L","LogGP latency (ns)","1000"},
+        {"loggp.o","LogGP per message overhead (ns)","500"},
+        {"loggp.g","LogGP gap between messages (ns)","100"},
+        {"loggp.G","LogGP time per byte (ns)","0.1"},
+        {"loggp.gamma","Time per byte per input to apply the reduction op (ns)","0.25"},
+    )
+
 private:
     enum StateEnum {
         FOREACH_ENUM(GENERATE_ENUM)
@@ -139,7 +151,8 @@ private:
         FunctionSMInterface( params ),
         m_event( NULL ),
         m_seq( 0 ),
-        m_vn( 0 )
+        m_vn( 0 ),
+        m_model( params )
     {
         m_smallCollectiveVN = params.find<int>( "smallCollectiveVN", 0);
         m_smallCollectiveSize = params.find<int>( "smallCollectiveSize", 0);
@@ -172,6 +185,8 @@ private:
     int m_vn;
     int m_smallCollectiveVN;
     int m_smallCollectiveSize;
+
+    CollectiveModel m_model;
 };
 
 }
@@ -29,6 +29,11 @@ const char* FunctionSM::m_functionName[] = {
     FOREACH_FUNCTION(GENERATE_STRING)
 };
 
+// collective model params that can be set once for all functions
+static const char* collectiveModelParams[] = {
+    "analyticCollectives", "loggp.L", "loggp.o", "loggp.g", "loggp.G", "loggp.gamma", NULL
+};
+
 class DriverEvent : public SST::Event {
   public:
     DriverEvent( MP::Functor* _retFunc, int _retval ) :
@@ -101,6 +106,12 @@ void FunctionSM::setup( Info* info )
     defaultParams.insert( "smallCollectiveSize",
                         m_params.find<std::string>("smallCollectiveSize","0"), true );
     defaultParams.insert( "verboseLevel", m_params.find<std::string>("verboseLevel","0"), true );
+    for ( int i = 0; collectiveModelParams[i]; i++ ) {
+        std::string value = m_params.find<std::string>( collectiveModelParams[i] );
+        if ( ! value.empty() ) {
+            defaultParams.insert( collectiveModelParams[i], value, true );
+        }
+    }
     std::ostringstream tmp;
     tmp <<  nodeId;
     defaultParams.insert( "nodeId", tmp.str(), true );
@@ -147,6 +158,12 @@ void FunctionSM::initFunction( Info* info,
     if ( params.find<std::string>("smallCollectiveSize").empty() ) {
         params.insert( "smallCollectiveSize", defaultParams.find<std::string>( "smallCollectiveSize" ), true );
     }
+    for ( int i = 0; collectiveModelParams[i]; i++ ) {
+        if ( params.find<std::string>( collectiveModelParams[i] ).empty() &&
+                ! defaultParams.find<std::string>( collectiveModelParams[i] ).empty() ) {
+            params.insert( collectiveModelParams[i], defaultParams.find<std::string>( collectiveModelParams[i] ), true );
+        }
+    }
 
     params.insert( "nodeId", defaultParams.find<std::string>( "nodeId" ), true );
 
@@ -86,6 +86,12 @@ class FunctionSM : public SubComponent {
 		{"defaultReturnLatency","Sets the default latency to return from a function","0"},
 		{"smallCollectiveVN","Sets the VN to use for small collectives","0"},
 		{"smallCollectiveSize","Sets the size of small collectives","0"},
+		{"analyticCollectives","Resolve Allreduce, Reduce, Bcast, Barrier and Alltoall(v) with a LogGP model instead of messages","0"},
+		{"loggp.L","LogGP latency (ns) for analytic collectives","1000"},
+		{"loggp.o","LogGP per message overhead (ns) for analytic collectives","500"},
+		{"loggp.g","LogGP gap between messages (ns) for analytic collectives","100"},
+		{"loggp.G","LogGP time per byte (ns) for analytic collectives","0.1"},
+		{"loggp.gamma","Reduction time per byte per input (ns) for analytic collectives","0.25"},
 		{"nodeId","Sets the node ID",""},
 	)
 	/* PARAMS
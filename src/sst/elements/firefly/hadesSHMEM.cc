@@ -102,7 +102,12 @@ void HadesSHMEM::memcpy( Hermes::Vaddr dest, Hermes::Vaddr src, size_t length, S
 {
     dbg().debug(CALL_INFO,1,SHMEM_BASE,"dest=%#" PRIx64 " src=%#" PRIx64 " length=%zu\n",dest,src,length);
     if ( dest != src ) {
-    	::memcpy( m_heap->findBacking(dest), m_heap->findBacking(src), length );
+        void* destPtr = m_heap->findBacking(dest);
+        void* srcPtr = m_heap->findBacking(src);
+        // unbacked regions only carry timing
+        if ( destPtr && srcPtr ) {
+    	    ::memcpy( destPtr, srcPtr, length );
+        }
 	}
     m_selfLink->send( 0, new HadesSHMEM::DelayEvent( callback, 0 ) );
 }
@@ -0,0 +1,292 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Closed form cost of the NIC DMA path ( load/store unit, bus bridge, host
+// cache and memory ) used instead of pushing every MTU sized access through
+// the units. Each resource keeps the intervals it is busy, a Work is costed
+// one MTU chunk at a time and completes with a single callback. Host traffic
+// still goes through the units and does not see the bulk NIC traffic.
+    class BulkDma {
+
+        // Busy intervals of a resource. Responses are booked ahead of the
+        // requests that follow them so a request takes the first gap it fits
+        // in rather than queueing behind everything booked so far. DLL packets
+        // go ahead of whatever is queued on the bus so they are not booked,
+        // they are added to the next reservation.
+        class Timeline {
+          public:
+            Timeline() : m_owed(0) {}
+            void owe( double length ) {
+                m_owed += length;
+            }
+            double reserve( double when, double length ) {
+                length += m_owed;
+                m_owed = 0;
+                double start = when;
+                std::map<double,double>::iterator iter = m_busy.upper_bound( when );
+                if ( iter != m_busy.begin() ) {
+                    --iter;
+                }
+                for ( ; iter != m_busy.end(); ++iter ) {
+                    if ( iter->first >= start + length ) {
+                        break;
+                    }
+                    start = std::max( start, iter->second );
+                }
+                if ( length > 0 ) {
+                    m_busy[start] = start + length;
+                }
+                return start;
+            }
+            void retire( double now ) {
+                while ( ! m_busy.empty() && m_busy.begin()->second <= now ) {
+                    m_busy.erase( m_busy.begin() );
+                }
+            }
+          private:
+            std::map<double,double> m_busy;
+            double m_owed;
+        };
+
+        struct UnitState {
+            UnitState() : issue(0), done(0) {}
+            double issue;
+            double done;
+            std::deque<double> loads;
+        };
+
+      public:
+        BulkDma( Output& dbg, int id, int numUnits, int mtu, double busBandwidth, int busNumLinks, int busLatency,
+                int TLP_overhead, int DLL_bytes, bool useBusBridge, int cacheLineSize, bool useHostCache, int numMSHR,
+                int memReadLat_ns, int memWriteLat_ns, int memNumSlots, int numLoadSlots, int tlbSize, int tlbPageSize,
+                int tlbMissLat_ns ) :
+            m_dbg(dbg), m_units(numUnits), m_mtu(mtu), m_busBandwidth(busBandwidth), m_busNumLinks(busNumLinks),
+            m_busLatency(busLatency), m_TLP_overhead(TLP_overhead), m_DLL_bytes(DLL_bytes), m_useBusBridge(useBusBridge),
+            m_cacheLineSize(cacheLineSize), m_numLoadSlots(numLoadSlots), m_tlbPageSize(tlbSize ? tlbPageSize : 0),
+            m_tlbMissLat_ns(tlbMissLat_ns), m_tlb(tlbSize)
+        {
+            m_prefix = "@t:" + std::to_string(id) + ":SimpleMemoryModel::BulkDma::@p():@l ";
+
+            m_memReadLat = memReadLat_ns;
+            if ( useHostCache ) {
+                // every access misses, the fill holds an MSHR for the read
+                // and the victim is written back through a memory slot
+                m_loadPerLine = std::max( (double) memReadLat_ns / numMSHR,
+                                (double) ( memReadLat_ns + memWriteLat_ns ) / memNumSlots );
+                m_storePerLine = m_loadPerLine;
+            } else {
+                m_loadPerLine = (double) memReadLat_ns / memNumSlots;
+                m_storePerLine = (double) memWriteLat_ns / memNumSlots;
+            }
+        }
+
+        // Works that only hold DMA and NIC local ops, everything else takes
+        // the unit path. Op is a MemOp or a DmaRange, only addr, length and
+        // getOp() are used. An op with a callback (shmem receives) needs the
+        // units to call it when the op is done.
+        template < class Op >
+        static bool canModel( const Op* ops, size_t numOps ) {
+            for ( size_t i = 0; i < numOps; i++ ) {
+                if ( hasCallback( ops[i] ) ) {
+                    return false;
+                }
+                switch ( ops[i].getOp() ) {
+                  case MemOp::NoOp:
+                  case MemOp::LocalLoad:
+                  case MemOp::LocalStore:
+                  case MemOp::BusLoad:
+                  case MemOp::BusDmaFromHost:
+                  case MemOp::BusStore:
+                  case MemOp::BusDmaToHost:
+                    break;
+                  default:
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool hasCallback( const MemOp& op ) { return op.callback != NULL; }
+        static bool hasCallback( const DmaRange& ) { return false; }
+
+        // returns the time, in ns, the Work retires
+        template < class Op >
+        SimTime_t calc( int unit, int pid, const Op* ops, size_t numOps, SimTime_t now ) {
+            UnitState& state = m_units[unit];
+            m_reqBus.retire( now );
+            m_respBus.retire( now );
+            m_mem.retire( now );
+
+            double t = std::max( (double) now, state.issue );
+            double workDone = t;
+            double opDone = t;
+            int lastOp = MemOp::NotInit;
+
+            for ( size_t i = 0; i < numOps; i++ ) {
+                const Op& op = ops[i];
+                int type = op.getOp();
+
+                // the thread does not issue an op until an op of another type has retired
+                if ( lastOp != MemOp::NotInit && lastOp != type ) {
+                    t = std::max( t, opDone );
+                }
+                lastOp = type;
+
+                if ( MemOp::NoOp == type || MemOp::LocalLoad == type || MemOp::LocalStore == type ) {
+                    opDone = std::max( opDone, t );
+                    continue;
+                }
+
+                bool isLoad = ( MemOp::BusLoad == type || MemOp::BusDmaFromHost == type );
+                size_t offset = 0;
+                do {
+                    Hermes::Vaddr addr = op.addr + offset;
+                    size_t length = std::min( op.length - offset, (size_t) m_mtu );
+                    offset += length;
+
+                    t += tlbDelay( addr, pid );
+
+                    double done = isLoad ? load( state, t, addr, length ) : store( t, addr, length );
+                    opDone = std::max( opDone, done );
+                } while ( offset < op.length );
+
+                workDone = std::max( workDone, opDone );
+            }
+            workDone = std::max( workDone, opDone );
+
+            state.issue = t;
+            // Works retire in order
+            state.done = std::max( state.done, workDone );
+
+            m_dbg.verbosePrefix(prefix(),CALL_INFO,1,BULK_DMA_MASK,"unit=%d numOps=%zu now=%" PRIu64 " done=%.1f\n",
+                    unit, numOps, now, state.done );
+
+            return ceil( state.done );
+        }
+
+      private:
+
+        double load( UnitState& state, double& t, Hermes::Vaddr addr, size_t length ) {
+
+            // no more than numLoadSlots chunks outstanding per unit
+            while ( state.loads.size() >= m_numLoadSlots ) {
+                t = std::max( t, state.loads.front() );
+                state.loads.pop_front();
+            }
+            while ( ! state.loads.empty() && state.loads.front() <= t ) {
+                state.loads.pop_front();
+            }
+
+            double reqDone = busSend( m_reqBus, t, byteDelay( m_TLP_overhead ) );
+            // the bus bridge takes the next request once this one is across
+            t = reqDone;
+            busDLL( m_respBus );
+
+            double arrive = reqDone + m_busLatency;
+            double memDone = memAccess( arrive, numLines( addr, length ), m_loadPerLine, m_memReadLat );
+
+            double respDone = busSend( m_respBus, memDone, byteDelay( length + m_TLP_overhead - 4 ) );
+            busDLL( m_reqBus );
+
+            double done = respDone + m_busLatency;
+            state.loads.push_back( done );
+            return done;
+        }
+
+        // stores are posted, the op is done once the bus bridge has taken it
+        double store( double& t, Hermes::Vaddr addr, size_t length ) {
+            double delay = byteDelay( length + m_TLP_overhead );
+            double reqDone = busSend( m_reqBus, t, delay );
+            double issue = reqDone - delay;
+            t = issue;
+            busDLL( m_respBus );
+            memAccess( reqDone + m_busLatency, numLines( addr, length ), m_storePerLine, 0 );
+            return issue;
+        }
+
+        double busSend( Timeline& bus, double when, double delay ) {
+            if ( ! m_useBusBridge ) {
+                return when;
+            }
+            return bus.reserve( when, delay ) + delay;
+        }
+
+        void busDLL( Timeline& bus ) {
+            if ( m_useBusBridge ) {
+                bus.owe( byteDelay( m_DLL_bytes ) );
+            }
+        }
+
+        double memAccess( double when, int lines, double perLine, double latency ) {
+            double start = m_mem.reserve( when, lines * perLine );
+            return start + ( lines - 1 ) * perLine + latency;
+        }
+
+        // LRU of tlbSize pages shared by the units, keyed like SharedTlb
+        double tlbDelay( Hermes::Vaddr addr, int pid ) {
+            if ( 0 == m_tlbPageSize ) {
+                return 0;
+            }
+            uint64_t page = ( addr & ~( m_tlbPageSize - 1 ) ) | (uint64_t) pid << 56;
+            if ( m_tlb.isValid( page ) ) {
+                m_tlb.updateAge( page );
+                return 0;
+            }
+            m_tlb.evict();
+            m_tlb.insert( page );
+            return m_tlbMissLat_ns;
+        }
+
+        // same as the bus widget
+        int numLines( Hermes::Vaddr addr, size_t length ) {
+            int num = length / m_cacheLineSize;
+            if ( ( addr & ( m_cacheLineSize - 1 ) ) || length < m_cacheLineSize ) {
+                ++num;
+            }
+            return num;
+        }
+
+        // same as BusBridgeUnit::calcByteDelay()
+        double byteDelay( size_t numBytes ) {
+            return round( (numBytes/(m_busNumLinks/8))/m_busBandwidth );
+        }
+
+        const char* prefix() { return m_prefix.c_str(); }
+
+        Output&     m_dbg;
+        std::string m_prefix;
+        std::vector<UnitState> m_units;
+
+        int         m_mtu;
+        double      m_busBandwidth;
+        int         m_busNumLinks;
+        int         m_busLatency;
+        int         m_TLP_overhead;
+        int         m_DLL_bytes;
+        bool        m_useBusBridge;
+        int         m_cacheLineSize;
+        size_t      m_numLoadSlots;
+        uint64_t    m_tlbPageSize;
+        int         m_tlbMissLat_ns;
+        Cache       m_tlb;
+
+        double      m_memReadLat;
+        double      m_loadPerLine;
+        double      m_storePerLine;
+
+        Timeline    m_reqBus;
+        Timeline    m_respBus;
+        Timeline    m_mem;
+    };
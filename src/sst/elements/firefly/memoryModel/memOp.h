@@ -97,7 +97,7 @@
 		bool isDone() {
 			return offset == length;
 		}
-		Op getOp( ) {
+		Op getOp( ) const {
 
 			if ( HostCopy == type ) {
 				if ( 1 == chunk %2 ) {
@@ -144,3 +144,14 @@
      private:
         Op type;
     };
+
+    // A contiguous range a NIC DMA touches, all a closed form model needs
+    // of a MemOp. Packets pass these instead of a heap allocated op list.
+    struct DmaRange {
+        DmaRange( Hermes::Vaddr addr, size_t length, MemOp::Op op ) : addr(addr), length(length), op(op) {}
+        MemOp::Op getOp( ) const { return op; }
+
+        Hermes::Vaddr addr;
+        size_t length;
+        MemOp::Op op;
+    };
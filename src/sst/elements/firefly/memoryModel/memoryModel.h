@@ -34,6 +34,11 @@ public:
     virtual void printStatus( Output& out, int id ) { }
 	virtual void schedHostCallback( int core, std::vector< MemOp >* ops, Callback callback ) = 0;
 	virtual void schedNicCallback( int unit, int pid, std::vector< MemOp >* ops, Callback callback ) = 0;
+	// true if schedNicDma() may cost NIC DMA, otherwise callers don't build ranges
+	virtual bool hasNicDmaModel() { return false; }
+	// costs the ranges without building a Work, false if the model can't
+	// and the caller has to use schedNicCallback()
+	virtual bool schedNicDma( int unit, int pid, const DmaRange* ranges, size_t numRanges, Callback callback ) { return false; }
 };
 
 } // namespace Firefly
@@ -23,6 +23,8 @@
 #include "memReq.h"
 
 #include <queue>
+#include <deque>
+#include <map>
 #include "../thingHeap.h"
 
 #define CALL_INFO_LAMBDA     __LINE__, __FILE__
@@ -74,6 +76,7 @@ public:
 		{"useDetailedModel",    "Sets whether or not a detailed memory model is used","no"},
 		{"useBusBridge",        "Sets whether or not a bus is used between the NIC and host","yes"},
 		{"printConfig",         "Print the config","no"},
+		{"nicDmaModel",         "Sets how NIC DMA is costed, units pushes every access through the memory units, bulk uses a closed form per Work","units"},
     )
 
     SST_ELI_DOCUMENT_STATISTICS(
@@ -115,6 +118,7 @@ public:
 #define SM_MASK        1<<10
 #define SHARED_TLB_MASK 1<<11
 #define DETAILED_MASK   1<<12
+#define BULK_DMA_MASK   1<<13
 
 #include "cache.h"
 #include "sharedTlb.h"
@@ -129,6 +133,7 @@ public:
 #include "memUnit.h"
 #include "cacheUnit.h"
 #include "detailedUnit.h"
+#include "bulkDma.h"
 
 
     class SelfEvent : public SST::Event {
@@ -150,7 +155,7 @@ public:
 	enum NIC_Thread { Send, Recv };
 
     SimpleMemoryModel( ComponentId_t compId, Params& params ) :
-		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL)
+		MemoryModel( compId ), m_hostCacheUnit(NULL), m_busBridgeUnit(NULL), m_bulkDma(NULL)
 	{
 		int id = params.find<int32_t>( "id", -1 );
 		assert( id > -1 );
@@ -216,6 +221,18 @@ public:
 			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter useBusBridge '%s'\n",tmp.c_str());
 		}
 
+		tmp = params.find<std::string>( "nicDmaModel", "units" );
+		if ( 0 == tmp.compare("bulk") ) {
+			if ( m_detailedUnit ) {
+				m_dbg.fatal(CALL_INFO,0,"nicDmaModel bulk can not be used with useDetailedModel\n");
+			}
+			m_bulkDma = new BulkDma( m_dbg, id, m_numNicThreads, nicToHostMTU, busBandwidth, busNumLinks, busLatency,
+						TLP_overhead, DLL_bytes, useBusBridge, hostCacheLineSize, useHostCache, hostCacheNumMSHR,
+						memReadLat_ns, memWriteLat_ns, memNumSlots, nicNumLoadSlots, tlbSize, tlbPageSize, tlbMissLat_ns );
+		} else if ( 0 != tmp.compare("units") ) {
+			m_dbg.fatal(CALL_INFO,0,"unknown value for parameter nicDmaModel '%s'\n",tmp.c_str());
+		}
+
 		if ( 0 == params.find<std::string>( "printConfig", "no" ).compare("yes" ) ) {
 			m_dbg.output("Node id=%d is using SimpleMemoryModel, useBusBridge=%d, useHostCache=%d\n", id, useBusBridge, useHostCache);
 		}
@@ -290,6 +307,7 @@ public:
         }
 		delete m_sharedTlb;
 		delete m_nicUnit;
+		delete m_bulkDma;
     }
 
 	ThingHeap<SelfEvent> m_eventHeap;
@@ -359,9 +377,29 @@ public:
 		m_dbg.debug(CALL_INFO,3,SM_MASK,"now=%" PRIu64 " unit=%d\n", now, unit );
 		assert( unit >=0 );
 
+		if ( m_bulkDma && BulkDma::canModel( ops->data(), ops->size() ) ) {
+			SimTime_t done = m_bulkDma->calc( unit, pid, ops->data(), ops->size(), now );
+			delete ops;
+			schedCallback( done - now, new Callback( callback ) );
+			return;
+		}
+
 		addWork( unit, new Work( pid, ops, callback, now ) );
 	}
 
+	virtual bool hasNicDmaModel() { return NULL != m_bulkDma; }
+
+	virtual bool schedNicDma( int unit, int pid, const DmaRange* ranges, size_t numRanges, Callback callback ) {
+		if ( ! m_bulkDma || ! BulkDma::canModel( ranges, numRanges ) ) {
+			return false;
+		}
+		SimTime_t now = getCurrentSimTimeNano();
+		m_dbg.debug(CALL_INFO,3,SM_MASK,"now=%" PRIu64 " unit=%d\n", now, unit );
+		SimTime_t done = m_bulkDma->calc( unit, pid, ranges, numRanges, now );
+		schedCallback( done - now, new Callback( callback ) );
+		return true;
+	}
+
 	NicUnit& nicUnit() { return *m_nicUnit; }
 
 	bool busUnitWrite( UnitBase* src, MemReq* req, Callback* callback ) {
@@ -398,6 +436,7 @@ public:
 	BusBridgeUnit*  m_busBridgeUnit;
 	NicUnit* 		m_nicUnit;
 	CacheUnit* 		m_nicCacheUnit;
+	BulkDma*		m_bulkDma;
     SharedTlb*      m_sharedTlb;
 
 	std::vector<Thread*> m_threads;
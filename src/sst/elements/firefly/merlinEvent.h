@@ -30,13 +30,13 @@ class FireflyNetworkEvent : public Event {
 
   public:
 
-    FireflyNetworkEvent( ) : offset(0), bufLen(0), m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(0) {
+    FireflyNetworkEvent( ) : offset(0), bufLen(0), m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(0), m_next(NULL) {
         buf.reserve( 1000 );
         assert( 0 == buf.size() );
     }
 
     FireflyNetworkEvent( int pktOverhead, size_t reserve = 1000 ) : offset(0), bufLen(0),
-            m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(pktOverhead) {
+            m_isHdr(false), m_isTail(false), m_isCtrl(false), pktOverhead(pktOverhead), m_next(NULL) {
         buf.reserve( reserve );
         assert( 0 == buf.size() );
     }
@@ -73,6 +73,10 @@ class FireflyNetworkEvent : public Event {
     int getSrcStream() { return srcStream; }
     int getDestPid() { return destPid; }
 
+    // link used by the receiver to queue the packet, it is not serialized
+    void setNext( FireflyNetworkEvent* ev ) { m_next = ev; }
+    FireflyNetworkEvent* getNext() { return m_next; }
+
     size_t bufSize() {
         return bufLen - offset;
     }
@@ -116,6 +120,7 @@ class FireflyNetworkEvent : public Event {
         m_isCtrl = me->m_isCtrl;
         offset = me->offset;
         pktOverhead = me->pktOverhead;
+        m_next = NULL;
     }
 
     FireflyNetworkEvent(const FireflyNetworkEvent &me) :
@@ -132,6 +137,7 @@ class FireflyNetworkEvent : public Event {
         m_isCtrl = me.m_isCtrl;
         offset = me.offset;
         pktOverhead = me.pktOverhead;
+        m_next = NULL;
     }
 
     virtual Event* clone(void) override
@@ -165,6 +171,7 @@ class FireflyNetworkEvent : public Event {
     size_t          offset;
     size_t          bufLen;
     std::vector<unsigned char>     buf;
+    FireflyNetworkEvent* m_next;
 
   public:
     void serialize_order(SST::Core::Serialization::serializer &ser)  override {
@@ -39,6 +39,7 @@ Nic::Nic(ComponentId_t id, Params &params) :
     m_useDetailedCompute(false),
     m_getKey(10),
     m_memoryModel(NULL),
+    m_nicDmaRanges(false),
     m_respKey(1),
 	m_predNetIdleTime(0),
     m_linkBytesPerSec(0),
@@ -256,6 +257,8 @@ Nic::Nic(ComponentId_t id, Params &params) :
             ComponentInfo::SHARE_PORTS | ComponentInfo::SHARE_STATS | ComponentInfo::INSERT_STATS, smmParams );
     }
 
+    m_nicDmaRanges = m_memoryModel && m_memoryModel->hasNicDmaModel();
+
     for ( int i = 0; i < m_numVN; i++ ) {
         m_recvMachine.push_back( new RecvMachine( *this, i, m_vNicV.size(), m_myNodeId,
                 params.find<uint32_t>("verboseLevel",0),
@@ -318,6 +321,7 @@ Nic::Nic(ComponentId_t id, Params &params) :
 
 	m_recvStreamPending = registerStatistic<uint64_t>("recvStreamPending");
 	m_sendStreamPending = registerStatistic<uint64_t>("sendStreamPending");
+	m_shmemPutBatchSize = registerStatistic<uint64_t>("shmemPutBatchSize");
 
     Statistic<uint64_t>* m_sentByteCount;
     Statistic<uint64_t>* m_rcvdByteCount;
@@ -772,6 +776,40 @@ void Nic::dmaWrite( int unit, int pid, std::vector<MemOp>* vec, Callback callbac
 	}
 }
 
+// Packets fill an op list the caller reuses. If the memory model costs it
+// as ranges no Work is built, otherwise the ops move to the heap list the
+// Work takes ownership of and the caller's list is left empty.
+void Nic::dmaRead( int unit, int pid, std::vector<MemOp>& ops, Callback callback )
+{
+    if ( ! m_nicDmaRanges || ! schedNicDma( unit, pid, ops, callback ) ) {
+        std::vector<MemOp>* vec = new std::vector<MemOp>;
+        vec->swap( ops );
+        dmaRead( unit, pid, vec, callback );
+    }
+}
+
+void Nic::dmaWrite( int unit, int pid, std::vector<MemOp>& ops, Callback callback )
+{
+    if ( ! m_nicDmaRanges || ! schedNicDma( unit, pid, ops, callback ) ) {
+        std::vector<MemOp>* vec = new std::vector<MemOp>;
+        vec->swap( ops );
+        dmaWrite( unit, pid, vec, callback );
+    }
+}
+
+// ops with a callback (shmem receives) take the unit path, which calls them
+bool Nic::schedNicDma( int unit, int pid, std::vector<MemOp>& ops, Callback callback )
+{
+    m_dmaRanges.clear();
+    for ( unsigned i = 0; i < ops.size(); i++ ) {
+        if ( ops[i].callback != NULL ) {
+            return false;
+        }
+        m_dmaRanges.push_back( MemoryModel::DmaRange( ops[i].addr, ops[i].length, ops[i].getOp() ) );
+    }
+    return m_memoryModel->schedNicDma( unit, pid, m_dmaRanges.data(), m_dmaRanges.size(), callback );
+}
+
 Hermes::MemAddr Nic::findShmem(  int core, Hermes::Vaddr addr, size_t length )
 {
     std::pair<Hermes::MemAddr, size_t> region = m_shmem->findRegion( core, addr);
@@ -20,6 +20,7 @@
 #include <math.h>
 #include <sstream>
 #include <queue>
+#include <map>
 #include <sst/core/module.h>
 #include <sst/core/component.h>
 #include <sst/core/output.h>
@@ -32,6 +33,7 @@
 //#include "memoryModel/trivialMemoryModel.h"
 #include "memoryModel/simpleMemoryModel.h"
 #include "memoryModel/detailedInterface.h"
+#include "thingHeap.h"
 
 #define CALL_INFO_LAMBDA     __LINE__, __FILE__
 
@@ -109,6 +111,8 @@ public:
 
         { "shmem.nicCmdLatency", "Latency for posting shmem command on NIC", "10"},
         { "shmem.hostCmdLatency", "Host latency for posting shmem command", "10"},
+        { "shmem.putBatchMaxBytes", "Sets the largest body of a message carrying several small puts to one core, 0 sends every put on its own", "0"},
+        { "shmem.putBatchThreshold", "Sets the length of the largest put, putv or add that is batched", "64"},
 
         { "FAM_memsize", "", "0"},
         { "FAM_backed", "Controls whether FAM memory is backed in the simlation", "yes"},
@@ -141,6 +145,7 @@ public:
 
         { "recvStreamPending",   "number of pending receive stream memory operations", "depth", 1},
         { "sendStreamPending",   "number of pending send stream memory operations", "depth", 1},
+        { "shmemPutBatchSize",   "number of puts carried by each batched put message, the mean is the aggregation ratio", "puts", 1},
 
         { "detailed_num_reads",                "total number of loads", "count", 1},
         { "detailed_num_writes",               "total number of stores", "count", 1},
@@ -214,13 +219,17 @@ private:
     };
 
     struct __attribute__ ((packed)) ShmemMsgHdr {
-        ShmemMsgHdr() : op2(0) {}
+        ShmemMsgHdr() : op2(0), batch(0) {}
         uint64_t vaddr;
         uint32_t length;
         enum Op { Ack, Put, Get, GetResp, Add, Fadd, Swap, Cswap };
         unsigned short op : 3;
         unsigned short op2 : 3;
         unsigned short dataType : 3;
+        // a Put carrying several puts, vaddr is the number of puts and the
+        // body a ShmemBatchSegHdr plus data for each. Its Ack has the number
+        // of puts in length.
+        unsigned short batch : 1;
         uint32_t respKey : 24;
 
         std::string getOpStr( ) {
@@ -247,6 +256,15 @@ private:
         }
     };
 
+    struct __attribute__ ((packed)) ShmemBatchSegHdr {
+        enum Op { Move, Add };
+        uint64_t vaddr;
+        uint32_t length;
+        uint8_t  op;
+        uint8_t  dataType;
+        uint16_t pad;
+    };
+
     struct RdmaMsgHdr {
         enum { Put, Get, GetResp } op;
         uint16_t    rgnNum;
@@ -363,12 +381,16 @@ public:
 	Statistic<uint64_t>* m_hostStall;
 	Statistic<uint64_t>* m_recvStreamPending;
 	Statistic<uint64_t>* m_sendStreamPending;
+	Statistic<uint64_t>* m_shmemPutBatchSize;
 
     void detailedMemOp( Thornhill::DetailedCompute* detailed,
             std::vector<MemOp>& vec, std::string op, Callback callback );
 
     void dmaRead( int unit, int pid, std::vector<MemOp>* vec, Callback callback );
     void dmaWrite( int unit, int pid, std::vector<MemOp>* vec, Callback callback );
+    void dmaRead( int unit, int pid, std::vector<MemOp>& ops, Callback callback );
+    void dmaWrite( int unit, int pid, std::vector<MemOp>& ops, Callback callback );
+    bool schedNicDma( int unit, int pid, std::vector<MemOp>& ops, Callback callback );
 
     void schedCallback( Callback callback, uint64_t delay = 0 ) {
         schedEvent( new SelfEvent( callback ), delay);
@@ -636,6 +658,9 @@ struct X {
     std::unordered_map<RespKey_t,void*> m_respKeyMap;
 
     MemoryModel*  m_memoryModel;
+    // only built when the memory model costs NIC DMA as ranges
+    bool m_nicDmaRanges;
+    std::vector<MemoryModel::DmaRange> m_dmaRanges;
     std::queue<int> m_availNicUnits;
     uint16_t m_getKey;
     int m_txDelay;
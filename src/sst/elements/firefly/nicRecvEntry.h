@@ -77,6 +77,13 @@ class ShmemRecvEntry : public RecvEntryBase {
     {
         m_shmemMove = new ShmemRecvMoveMemOp( addr.getBacking(), length, shmem, core, addr.getSimVAddr(), op, dataType );
     }
+    // a batch of puts
+    ShmemRecvEntry( Shmem* shmem, int core, size_t length ) :
+        RecvEntryBase()
+    {
+        m_shmemMove = new ShmemRecvMoveBatch( shmem, core, length );
+    }
+
     ~ShmemRecvEntry() {
         delete m_shmemMove;
     }
@@ -20,7 +20,7 @@
 using namespace SST;
 using namespace SST::Firefly;
 
-void Nic::RecvMachine::processPkt( FireflyNetworkEvent* ev ) {
+void Nic::RecvMachine::processPkt( PairTable::Slot& slot, FireflyNetworkEvent* ev ) {
 
 	m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE," got a network pkt from node=%d pid=%d for pid=%d stream=%d size=%zu\n",
                         ev->getSrcNode(),ev->getSrcPid(), ev->getDestPid(), ev->getSrcStream(), ev->bufSize() );
@@ -29,20 +29,20 @@ void Nic::RecvMachine::processPkt( FireflyNetworkEvent* ev ) {
 		m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"got a control message\n");
 		m_ctxMap[ ev->getDestPid() ]->newStream( ev );
     } else {
-        processStdPkt( ev );
+        processStdPkt( slot, ev );
     }
 }
 
-void Nic::RecvMachine::processStdPkt( FireflyNetworkEvent* ev ) {
+void Nic::RecvMachine::processStdPkt( PairTable::Slot& slot, FireflyNetworkEvent* ev ) {
     bool blocked = false;
-    StreamKey id = getStreamKey( ev );
+    int id = ev->getSrcStream();
 
     StreamBase* stream;
     int pid = ev->getDestPid();
 
     if ( ev->isHdr() ) {
 
-        if ( m_streamMap.find( id ) != m_streamMap.end() ) {
+        if ( slot.findStream( id ) ) {
             m_dbg.fatal(CALL_INFO,-1,"no stream for cnode=%d pid=%d for pid=%d\n",ev->getSrcNode(),ev->getSrcPid(), ev->getDestPid());
         }
         stream = m_ctxMap[pid]->newStream( ev );
@@ -50,18 +50,17 @@ void Nic::RecvMachine::processStdPkt( FireflyNetworkEvent* ev ) {
                ev->getSrcNode(),ev->getSrcPid(), pid );
 
         if ( ! ev->isTail() ) {
-            m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"multi packet stream, set streamMap PPI=0x%" PRIx64 "\n",id );
-            m_streamMap[id] = stream;
+            m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"multi packet stream, set pair stream=%d\n",id );
+            slot.setStream( id, stream );
         }
 
     } else {
-        assert ( m_streamMap.find( id ) != m_streamMap.end() );
-
-        stream = m_streamMap[id];
+        stream = slot.findStream( id );
+        assert( stream );
 
         if ( ev->isTail() ) {
-            m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"tail pkt, clear streamMap PPI=0x%" PRIx64 "\n",id );
-            m_streamMap.erase(id);
+            m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"tail pkt, clear pair stream=%d\n",id );
+            slot.clearStream( id );
         } else {
             m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE,"body packet stream=%p\n",stream );
         }
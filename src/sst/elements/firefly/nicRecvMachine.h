@@ -29,20 +29,12 @@ class RecvMachine {
 		return value;
 	}
 
-    typedef uint64_t StreamKey;
-    static StreamKey getStreamKey( FireflyNetworkEvent* ev) {
-        StreamKey value = ev->getDestPid();
-		value |= ev->getSrcPid() << NUM_PID_BITS;
-		value |= (uint64_t) ev->getSrcNode() << (NUM_PID_BITS * 2);
-        value += (uint64_t) ev->getSrcStream() << ( (NUM_PID_BITS * 2) + NUM_NODE_BITS );
-		return value;
-	}
-
     #include "nicRecvStream.h"
     #include "nicRecvCtx.h"
     #include "nicMsgStream.h"
     #include "nicRdmaStream.h"
     #include "nicShmemStream.h"
+    #include "nicRecvPairTable.h"
 
       public:
 
@@ -101,8 +93,8 @@ class RecvMachine {
         std::vector< Ctx* >   m_ctxMap;
 
 	private:
-        void processPkt( FireflyNetworkEvent* ev );
-        void processStdPkt( FireflyNetworkEvent* ev );
+        void processPkt( PairTable::Slot& slot, FireflyNetworkEvent* ev );
+        void processStdPkt( PairTable::Slot& slot, FireflyNetworkEvent* ev );
 
         void setNotify( ) {
             m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "\n");
@@ -126,15 +118,16 @@ class RecvMachine {
                 if ( ev ) {
                     ++m_numPendingPkts;
                     m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "got packet numPendingPkts=%d\n", m_numPendingPkts );
-                    m_pktBuf[ getPPI(ev) ].push( ev );
+                    m_pktBuf.push( ev );
                 }
             } else {
                 m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "reached max buffered packets, numPendingPkts=%d\n", m_numPendingPkts );
 			}
 
-			auto iter = m_pktBuf.begin();
+			PairTable::iterator iter = m_pktBuf.begin();
 			while ( iter != m_pktBuf.end() ) {
-				FireflyNetworkEvent* ev = iter->second.front();
+				PairTable::Slot& slot = *iter;
+				FireflyNetworkEvent* ev = slot.front();
 
 				m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "packet from node=%d pid=%d for pid=%d %s %s PPI=0x%" PRIx64 " stream=%d\n",
 						ev->getSrcNode(),ev->getSrcPid(),ev->getDestPid(),ev->isHdr() ? "hdr":"",ev->isTail() ? "tail":"",getPPI(ev),ev->getSrcStream());
@@ -142,30 +135,30 @@ class RecvMachine {
 				if ( ev->isCtrl() ) {
 					++m_numActiveStreams;
 					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "ctrl packet numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
-					processPkt( ev );
+					slot.pop();
+					processPkt( slot, ev );
 					--m_numPendingPkts;
-					iter->second.pop();
-				} else if ( m_streamMap.find( getStreamKey( ev ) ) == m_streamMap.end() ) {
+				} else if ( NULL == slot.findStream( ev->getSrcStream() ) ) {
 					if ( m_numActiveStreams < m_maxActiveStreams ) {
 						++m_numActiveStreams;
 						m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "new stream numActiveStreams=%d m_numPendingPkts=%d\n",m_numActiveStreams,m_numPendingPkts-1);
-						processPkt( ev );
+						slot.pop();
+						processPkt( slot, ev );
 						--m_numPendingPkts;
-						iter->second.pop();
 					} else {
 						m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "can't start new stream numActiveStreams=%d\n",m_numActiveStreams);
 					}
 				} else {
-                    if ( ! m_streamMap[getStreamKey(ev)]->isBlocked( ) ) {
-						processPkt( ev );
+                    if ( ! slot.findStream( ev->getSrcStream() )->isBlocked( ) ) {
+						slot.pop();
+						processPkt( slot, ev );
 						--m_numPendingPkts;
 						m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "stream consumed packet, m_numPendingPkts=%d\n",m_numPendingPkts);
-						iter->second.pop();
 					} else {
 						m_dbg.debug(CALL_INFO,2,NIC_DBG_RECV_MACHINE, "stream blocked\n");
 					}
 				}
-				if ( iter->second.empty() ) {
+				if ( slot.empty() ) {
 					m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_MACHINE, "queue is empty clear pktBuf slot\n");
 					iter = m_pktBuf.erase( iter );
 				} else {
@@ -224,6 +217,5 @@ class RecvMachine {
         SimTime_t   m_clockLat;
         bool        m_clocking;
 
-        std::unordered_map<ProcessPairId, std::queue<FireflyNetworkEvent*> > m_pktBuf;
-        std::unordered_map<StreamKey, StreamBase* >  m_streamMap;
+        PairTable   m_pktBuf;
 };
@@ -0,0 +1,181 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+// Packets waiting to be processed, one slot per process pair. Slots are
+// never freed, they live in a vector found through a flat open addressed
+// index, packets are linked through the event and the slots holding packets
+// are kept on a list in the order they became active. The streams a pair has
+// in progress live in its slot.
+class PairTable {
+  public:
+    class Slot {
+      public:
+        Slot( ProcessPairId key ) : key(key), head(NULL), tail(NULL), nextActive(-1), active(false) {}
+
+        bool empty() { return NULL == head; }
+        FireflyNetworkEvent* front() { return head; }
+
+        void push( FireflyNetworkEvent* ev ) {
+            ev->setNext( NULL );
+            if ( tail ) {
+                tail->setNext( ev );
+            } else {
+                head = ev;
+            }
+            tail = ev;
+        }
+
+        void pop() {
+            FireflyNetworkEvent* ev = head;
+            head = ev->getNext();
+            if ( NULL == head ) {
+                tail = NULL;
+            }
+            ev->setNext( NULL );
+        }
+
+        StreamBase* findStream( int srcStream ) {
+            for ( unsigned i = 0; i < streams.size(); i++ ) {
+                if ( streams[i].first == srcStream ) {
+                    return streams[i].second;
+                }
+            }
+            return NULL;
+        }
+
+        void setStream( int srcStream, StreamBase* stream ) {
+            streams.push_back( std::make_pair( srcStream, stream ) );
+        }
+
+        void clearStream( int srcStream ) {
+            for ( unsigned i = 0; i < streams.size(); i++ ) {
+                if ( streams[i].first == srcStream ) {
+                    streams[i] = streams.back();
+                    streams.pop_back();
+                    return;
+                }
+            }
+        }
+
+      private:
+        friend class PairTable;
+        ProcessPairId           key;
+        FireflyNetworkEvent*    head;
+        FireflyNetworkEvent*    tail;
+        int                     nextActive;
+        bool                    active;
+        std::vector< std::pair< int, StreamBase* > > streams;
+    };
+
+    PairTable() : m_index( 1 << 6, -1 ), m_indexBits( 6 ), m_activeHead(-1), m_activeTail(-1) {}
+
+    void push( FireflyNetworkEvent* ev ) {
+        int idx = lookup( getPPI( ev ) );
+        Slot& slot = m_slots[idx];
+        slot.push( ev );
+        if ( ! slot.active ) {
+            slot.active = true;
+            slot.nextActive = -1;
+            if ( -1 == m_activeTail ) {
+                m_activeHead = idx;
+            } else {
+                m_slots[m_activeTail].nextActive = idx;
+            }
+            m_activeTail = idx;
+        }
+    }
+
+    bool empty() { return -1 == m_activeHead; }
+
+    // walks the slots holding packets
+    class iterator {
+      public:
+        iterator( PairTable* table, int prev, int idx ) : table(table), prev(prev), idx(idx) {}
+        Slot& operator*() { return table->m_slots[idx]; }
+        Slot* operator->() { return &table->m_slots[idx]; }
+        iterator& operator++() {
+            prev = idx;
+            idx = table->m_slots[idx].nextActive;
+            return *this;
+        }
+        bool operator!=( const iterator& other ) const { return idx != other.idx; }
+      private:
+        friend class PairTable;
+        PairTable*  table;
+        int         prev;
+        int         idx;
+    };
+
+    iterator begin() { return iterator( this, -1, m_activeHead ); }
+    iterator end() { return iterator( this, -1, -1 ); }
+
+    // takes a slot with no packets off the active list, the slot stays in the table
+    iterator erase( iterator iter ) {
+        Slot& slot = m_slots[iter.idx];
+        assert( slot.empty() );
+        int next = slot.nextActive;
+        slot.active = false;
+        if ( -1 == iter.prev ) {
+            m_activeHead = next;
+        } else {
+            m_slots[iter.prev].nextActive = next;
+        }
+        if ( iter.idx == m_activeTail ) {
+            m_activeTail = iter.prev;
+        }
+        return iterator( this, iter.prev, next );
+    }
+
+  private:
+    size_t hash( ProcessPairId key ) {
+        return ( key * 0x9E3779B97F4A7C15ULL ) >> ( 64 - m_indexBits );
+    }
+
+    int lookup( ProcessPairId key ) {
+        size_t pos = hash( key );
+        while ( -1 != m_index[pos] ) {
+            if ( m_slots[ m_index[pos] ].key == key ) {
+                return m_index[pos];
+            }
+            pos = ( pos + 1 ) & ( m_index.size() - 1 );
+        }
+        m_index[pos] = m_slots.size();
+        m_slots.push_back( Slot( key ) );
+
+        if ( m_slots.size() * 2 > m_index.size() ) {
+            grow();
+        }
+        return m_slots.size() - 1;
+    }
+
+    void grow() {
+        ++m_indexBits;
+        m_index.assign( (size_t) 1 << m_indexBits, -1 );
+        for ( unsigned i = 0; i < m_slots.size(); i++ ) {
+            size_t pos = hash( m_slots[i].key );
+            while ( -1 != m_index[pos] ) {
+                pos = ( pos + 1 ) & ( m_index.size() - 1 );
+            }
+            m_index[pos] = i;
+        }
+    }
+
+    std::vector< int >  m_index;
+    int                 m_indexBits;
+    std::vector< Slot > m_slots;
+    int                 m_activeHead;
+    int                 m_activeTail;
+};
@@ -57,8 +57,8 @@ void Nic::RecvMachine::StreamBase::processPktBody( FireflyNetworkEvent* ev  ) {
 
 	m_ctx->nic().m_recvStreamPending->addData( m_numPending );
 
-    std::vector< MemOp >* vec = new std::vector< MemOp >;
-    bool ret = getRecvEntry()->copyIn( m_dbg, *ev, *vec );
+    m_memOps.clear();
+    bool ret = getRecvEntry()->copyIn( m_dbg, *ev, m_memOps );
 
     if ( 0 == ev->bufSize() ) {
         m_dbg.verbosePrefix(prefix(),CALL_INFO,2,NIC_DBG_RECV_STREAM, "network event is done\n");
@@ -68,7 +68,7 @@ void Nic::RecvMachine::StreamBase::processPktBody( FireflyNetworkEvent* ev  ) {
     Callback callback = NULL;
     bool finished = ret || length() == getRecvEntry()->currentLen();
 
-    m_ctx->nic().dmaWrite( m_unit, m_myPid, vec,
+    m_ctx->nic().dmaWrite( m_unit, m_myPid, m_memOps,
             std::bind( &Nic::RecvMachine::StreamBase::ready, this, finished, m_pktNum++ ) );
 }
 
@@ -74,4 +74,6 @@ class StreamBase {
             int             m_maxQsize;
             uint64_t        m_pktNum;
             uint64_t        m_expectedPkt;
+            // reused for every packet, see Nic::dmaWrite()
+            std::vector< MemOp > m_memOps;
         };
@@ -58,14 +58,14 @@ void Nic::SendMachine::getPayload( SendEntryBase* entry, FireflyNetworkEvent* ev
     ev->setSrcPid( pid );
     ev->setSrcStream( entry->streamNum() );
     if ( ! m_inQ->isFull() ) {
-	    std::vector< MemOp >* vec = new std::vector< MemOp >;
-        entry->copyOut( m_dbg, m_packetSizeInBytes, *ev, *vec );
+        m_memOps.clear();
+        entry->copyOut( m_dbg, m_packetSizeInBytes, *ev, m_memOps );
         m_dbg.debug(CALL_INFO,2,NIC_DBG_SEND_MACHINE, "enque load from host, %lu bytes\n",ev->bufSize());
         if ( entry->isDone() ) {
             ev->setTail();
-            m_inQ->enque( m_unit, pid, vec, ev, entry->vn(), entry->dest(), std::bind( &Nic::SendMachine::streamFini, this, entry ) );
+            m_inQ->enque( m_unit, pid, m_memOps, ev, entry->vn(), entry->dest(), std::bind( &Nic::SendMachine::streamFini, this, entry ) );
         } else {
-            m_inQ->enque( m_unit, pid, vec, ev, entry->vn(), entry->dest() );
+            m_inQ->enque( m_unit, pid, m_memOps, ev, entry->vn(), entry->dest() );
             m_nic.schedCallback( std::bind( &Nic::SendMachine::getPayload, this, entry, new FireflyNetworkEvent(m_pktOverhead) ), 0);
         }
 
@@ -96,7 +96,7 @@ void Nic::SendMachine::streamFini( SendEntryBase* entry )
     }
 }
 
-void  Nic::SendMachine::InQ::enque( int unit, int pid, std::vector< MemOp >* vec,
+void  Nic::SendMachine::InQ::enque( int unit, int pid, std::vector< MemOp >& ops,
             FireflyNetworkEvent* ev, int vn, int dest, Callback callback )
 {
     ++m_numPending;
@@ -105,7 +105,7 @@ void  Nic::SendMachine::InQ::enque( int unit, int pid, std::vector< MemOp >* vec
     m_dbg.verbosePrefix(prefix(), CALL_INFO,2,NIC_DBG_SEND_MACHINE, "get timing for packet %" PRIu64 " size=%lu numPending=%d\n",
                  m_pktNum,ev->bufSize(), m_numPending);
 
-    m_nic.dmaRead( unit, pid, vec,
+    m_nic.dmaRead( unit, pid, ops,
 		std::bind( &Nic::SendMachine::InQ::ready, this,  ev, vn, dest, callback, m_pktNum++ )
     );
 	// don't put code after this, the callback may be called serially
@@ -98,7 +98,7 @@ class SendMachine {
                 return m_numPending == m_maxQsize;
             }
 
-            void  enque( int unit, int pid, std::vector< MemOp >* vec, FireflyNetworkEvent* ev, int vn, int dest, Callback callback = NULL );
+            void  enque( int unit, int pid, std::vector< MemOp >& ops, FireflyNetworkEvent* ev, int vn, int dest, Callback callback = NULL );
 
             void wakeMeUp( Callback  callback) {
                 assert(!m_callback);
@@ -188,6 +188,8 @@ class SendMachine {
         InQ*    m_inQ;
         int     m_packetSizeInBytes;
         int     m_unit;
+        // reused for every packet, see Nic::dmaRead()
+        std::vector< MemOp > m_memOps;
         int     m_pktOverhead;
         bool    m_I_manage;
         SendEntryBase* m_activeEntry;
@@ -183,6 +183,16 @@ void Nic::Shmem::handleNicEvent3( NicShmemCmdEvent* event, int id )
 {
 
     m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d %s\n",id,event->getTypeStr().c_str());
+
+    if ( m_putBatchMaxBytes ) {
+        if ( canBatch( event ) ) {
+            batchPut( static_cast<NicShmemSendCmdEvent*>(event), id );
+            return;
+        }
+        // keep the order of a core's commands
+        flushPutBatches();
+    }
+
     switch (event->type) {
 
     case NicShmemCmdEvent::Init:
@@ -267,7 +277,7 @@ void Nic::Shmem::regMem( NicShmemRegMemCmdEvent* event, int id )
     m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d simVAddr=%" PRIx64 " backing=%p len=%lu\n",
             id, event->addr.getSimVAddr(), event->addr.getBacking(), event->len );
 
-    m_regMem[id].push_back( RegionEntry( event->addr, event->realAddr, event->len) );
+    addRegion( id, RegionEntry( event->addr, event->realAddr, event->len) );
 
     m_nic.getVirtNic(id)->notifyShmem( getNic2HostDelay_ns(), event->callback );
 
@@ -275,6 +285,130 @@ void Nic::Shmem::regMem( NicShmemRegMemCmdEvent* event, int id )
 }
 
 
+bool Nic::Shmem::canBatch( NicShmemCmdEvent* event )
+{
+    switch ( event->type ) {
+      case NicShmemCmdEvent::Put:
+        if ( static_cast<NicShmemPutCmdEvent*>(event)->getOp() != Hermes::Shmem::MOVE ) {
+            return false;
+        }
+        // fall through
+      case NicShmemCmdEvent::Putv:
+      case NicShmemCmdEvent::Add:
+        return static_cast<NicShmemSendCmdEvent*>(event)->getLength() <= m_putBatchThreshold;
+      default:
+        return false;
+    }
+}
+
+void Nic::Shmem::batchPut( NicShmemSendCmdEvent* event, int id )
+{
+    PutBatch& batch = m_putBatches[id][ std::make_pair( event->getNode(), event->getVnic() ) ];
+    size_t bytes = sizeof( ShmemBatchSegHdr ) + event->getLength();
+
+    if ( batch.bytes + bytes > m_putBatchMaxBytes ) {
+        flushPutBatch( batch, id, event->getNode(), event->getVnic() );
+    }
+
+    batch.cmds.push_back( event );
+    batch.bytes += bytes;
+
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d targetNode=%d targetCore=%d numPuts=%zu bytes=%zu\n",
+                            id, event->getNode(), event->getVnic(), batch.cmds.size(), batch.bytes );
+
+    // a batch only waits while the engine has other commands queued, the
+    // command being handled is still at the front of m_cmdQ if it came from there
+    size_t queued = m_cmdQ.size();
+    if ( queued && m_cmdQ.front().first == event ) {
+        --queued;
+    }
+    if ( 0 == queued ) {
+        flushPutBatches();
+    }
+}
+
+void Nic::Shmem::flushPutBatches()
+{
+    for ( int id = 0; id < m_putBatches.size(); id++ ) {
+        PutBatchMap::iterator iter = m_putBatches[id].begin();
+        for ( ; iter != m_putBatches[id].end(); ++iter ) {
+            flushPutBatch( iter->second, id, iter->first.first, iter->first.second );
+        }
+        m_putBatches[id].clear();
+    }
+}
+
+void Nic::Shmem::flushPutBatch( PutBatch& batch, int id, int node, int vnic )
+{
+    if ( batch.cmds.empty() ) {
+        return;
+    }
+
+    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d targetNode=%d targetCore=%d numPuts=%zu bytes=%zu\n",
+                            id, node, vnic, batch.cmds.size(), batch.bytes );
+
+    m_nic.m_shmemPutBatchSize->addData( batch.cmds.size() );
+
+    if ( 1 == batch.cmds.size() ) {
+        sendPut( batch.cmds.front(), id );
+    } else {
+        int vn = m_nic.m_shmemPutSmallVN;
+        if ( batch.bytes > m_nic.m_shmemPutThresholdLength ) {
+            vn = m_nic.m_shmemPutLargeVN;
+        }
+
+        ShmemPutBatchSendEntry* entry = new ShmemPutBatchSendEntry( id, m_nic.getSendStreamNum(id), node, vnic, vn );
+
+        for ( int i = 0; i < batch.cmds.size(); i++ ) {
+            NicShmemSendCmdEvent* event = batch.cmds[i];
+            if ( event->type == NicShmemCmdEvent::Put ) {
+                entry->append( event, getBacking( id, event->getMyAddr(), event->getLength() ),
+                                event->getMyAddr(), putDone( event, id ) );
+            } else {
+                entry->append( event, event->getBacking(), 0, putDone( event, id ) );
+            }
+        }
+
+        m_nic.qSendEntry( entry );
+    }
+
+    batch.cmds.clear();
+    batch.bytes = 0;
+}
+
+void Nic::Shmem::sendPut( NicShmemSendCmdEvent* event, int id )
+{
+    switch ( event->type ) {
+      case NicShmemCmdEvent::Put:
+        put( static_cast<NicShmemPutCmdEvent*>(event), id );
+        break;
+      case NicShmemCmdEvent::Putv:
+        putv( static_cast<NicShmemPutvCmdEvent*>(event), id );
+        break;
+      case NicShmemCmdEvent::Add:
+        add( static_cast<NicShmemAddCmdEvent*>(event), id );
+        break;
+      default:
+        assert(0);
+    }
+}
+
+// the same notification put(), putv() and add() give the host
+std::function<void()> Nic::Shmem::putDone( NicShmemSendCmdEvent* event, int id )
+{
+    if ( event->type == NicShmemCmdEvent::Put ) {
+        NicShmemRespEvent::Callback callback = static_cast<NicShmemPutCmdEvent*>(event)->getCallback();
+        return [=]() {
+            m_nic.getVirtNic(id)->notifyShmem( 0, callback );
+            decActivePuts(id);
+        };
+    }
+    return [=]() {
+        m_nic.getVirtNic(id)->notifyShmem( getNic2HostDelay_ns() );
+        decActivePuts(id);
+    };
+}
+
 void Nic::Shmem::put( NicShmemPutCmdEvent* event, int id )
 {
     m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d targetNode=%d farAddr=%" PRIx64" len=%lu\n",
@@ -452,7 +586,8 @@ void Nic::Shmem::hostWait( NicShmemOpCmdEvent* event, int id )
 
 	Hermes::Vaddr addr = event->addr;
 	Callback callback = event->callback;
-    Op* op = new WaitOp( event, getBacking( id, event->addr, event->value.getLength() ),
+    WaitOp* op = m_waitOpHeap.alloc();
+    op->init( event, getBacking( id, event->addr, event->value.getLength() ),
             [=]() {
                 m_dbg.verbosePrefix( prefix(),CALL_INFO_LAMBDA,"hostWait",1,NIC_DBG_SHMEM,"core=%d addr=%" PRIx64 " finished\n",id,addr);
                 m_nic.getVirtNic(id)->notifyShmem( 0, callback );
@@ -464,7 +599,7 @@ void Nic::Shmem::hostWait( NicShmemOpCmdEvent* event, int id )
     } else {
         m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d wait satisfied\n",id);
 		m_nic.schedCallback( op->callback() );
-        delete op;
+        freeOp( op );
     }
 }
 
@@ -752,7 +887,7 @@ void Nic::Shmem::checkWaitOps( int core, Hermes::Vaddr addr, size_t length )
 
         	m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"op valid, notify\n");
 			m_nic.schedCallback( op->callback(), m_nic2HostDelay_ns );
-            delete op;
+            freeOp( op );
             iter = m_pendingOps[core].erase(iter);
         } else {
             ++iter;
@@ -21,10 +21,19 @@ class Shmem {
       public:
         typedef std::function<void()> Callback;
         enum Type { Wait } m_type;
-        Op( Type type, NicShmemOpCmdEvent* cmd, Callback callback ) : m_type(type), m_cmd(cmd), m_callback(callback) {}
+        Op( Type type ) : m_type(type), m_cmd(NULL) {}
         virtual ~Op() {
 			delete m_cmd;
         }
+        void init( NicShmemOpCmdEvent* cmd, Callback callback ) {
+            m_cmd = cmd;
+            m_callback = callback;
+        }
+        void fini() {
+            delete m_cmd;
+            m_cmd = NULL;
+            m_callback = NULL;
+        }
         Callback&  callback() { return m_callback; }
         virtual bool checkOp( Output&, int core ) = 0;
         bool inRange( Hermes::Vaddr addr, size_t length ) {
@@ -35,38 +44,42 @@ class Shmem {
       protected:
         NicShmemOpCmdEvent* m_cmd;
         Callback            m_callback;
-        Hermes::Value       m_value;
     };
 
+    // WaitOps come from m_waitOpHeap, init() and fini() take the place of the
+    // constructor and destructor
     class WaitOp : public Op {
       public:
-        WaitOp( NicShmemOpCmdEvent* cmd, void* backing, Callback callback ) :
-            Op( Wait, cmd, callback ),
-            m_value( cmd->value.getType(), backing )
-        {}
+        WaitOp() : Op( Wait ), m_backing(NULL) {}
+
+        void init( NicShmemOpCmdEvent* cmd, void* backing, Callback callback ) {
+            Op::init( cmd, callback );
+            m_backing = backing;
+        }
 
         bool checkOp( Output& dbg, int core ) {
+            Hermes::Value value( m_cmd->value.getType(), m_backing );
             std::stringstream tmp;
-            tmp << "op=" << WaitOpName(m_cmd->op) << " testValue=" << m_cmd->value << " memValue=" << m_value;
+            tmp << "op=" << WaitOpName(m_cmd->op) << " testValue=" << m_cmd->value << " memValue=" << value;
             dbg.debug( CALL_INFO,1,NIC_DBG_SHMEM,"%s core=%d %s\n",__func__,core,tmp.str().c_str());
             switch ( m_cmd->op ) {
               case Hermes::Shmem::NE:
-                return m_value != m_cmd->value;
+                return value != m_cmd->value;
                 break;
               case Hermes::Shmem::GTE:
-                return m_value >= m_cmd->value;
+                return value >= m_cmd->value;
                 break;
               case Hermes::Shmem::GT:
-                return m_value > m_cmd->value;
+                return value > m_cmd->value;
                 break;
               case Hermes::Shmem::EQ:
-                return m_value == m_cmd->value;
+                return value == m_cmd->value;
                 break;
               case Hermes::Shmem::LT:
-                return m_value < m_cmd->value;
+                return value < m_cmd->value;
                 break;
               case Hermes::Shmem::LTE:
-                return m_value <= m_cmd->value;
+                return value <= m_cmd->value;
                 break;
               default:
                 assert(0);
@@ -74,16 +87,30 @@ class Shmem {
             return false;
         }
       private:
-        Hermes::Value m_value;
+        void* m_backing;
     };
 
 	struct RegionEntry {
 		RegionEntry( Hermes::MemAddr addr, Hermes::Vaddr realAddr, size_t length ) : addr(addr), realAddr(addr.getSimVAddr(),addr.getBacking() ), length(length) { }
+		bool contains( uint64_t vaddr ) const {
+			return vaddr >= addr.getSimVAddr() && vaddr < addr.getSimVAddr() + length;
+		}
 		Hermes::MemAddr addr;
 		Hermes::MemAddr realAddr;
 		size_t length;
 	};
 
+	// regions of a core keyed by their start address
+	typedef std::map< Hermes::Vaddr, RegionEntry > RegionMap;
+
+	// small puts to one core that wait to go out as a single message
+	struct PutBatch {
+		PutBatch() : bytes(0) {}
+		std::vector< NicShmemSendCmdEvent* > cmds;
+		size_t bytes;
+	};
+	typedef std::map< std::pair<int,int>, PutBatch > PutBatchMap;
+
 	std::string m_prefix;
 
 	const char* prefix() { return m_prefix.c_str(); }
@@ -97,11 +124,15 @@ class Shmem {
 
 		m_activePuts.resize( numVnics );
 		m_regMem.resize( numVnics );
+		m_regCache.resize( numVnics, NULL );
+		m_putBatches.resize( numVnics );
 		m_pendingOps.resize( numVnics );
 		m_pendingPuts.resize( numVnics );
 		m_pendingGets.resize( numVnics );
 		m_nicCmdLatency =    params.find<int>( "nicCmdLatency", 10 );
 		m_hostCmdLatency =   params.find<int>( "hostCmdLatency", 10 );
+		m_putBatchMaxBytes = params.find<size_t>( "putBatchMaxBytes", 0 );
+		m_putBatchThreshold = params.find<size_t>( "putBatchThreshold", 64 );
 	}
     ~Shmem() {
         m_regMem.clear();
@@ -149,15 +180,16 @@ class Shmem {
 	}
 
     std::pair<Hermes::MemAddr, size_t> findRegion( int core, uint64_t addr ) {
-        for ( int i = 0; i < m_regMem[core].size(); i++ ) {
-            if ( addr >= m_regMem[core][i].addr.getSimVAddr() &&
-                addr < m_regMem[core][i].addr.getSimVAddr() + m_regMem[core][i].length ) {
-                return std::make_pair( m_regMem[core][i].realAddr, m_regMem[core][i].length );
-            }
+        const RegionEntry* entry = m_regCache[core];
+        if ( NULL == entry || ! entry->contains( addr ) ) {
+            entry = lookupRegion( core, addr );
+            m_regCache[core] = entry;
         }
-		m_dbg.fatal(CALL_INFO,0," core %d Unable to find for for addr %" PRIx64 "\n", core, addr);
-		// quiet compiler warning
-		assert(0);
+        return std::make_pair( entry->realAddr, entry->length );
+    }
+
+    Hermes::MemAddr findShmem( int core, Hermes::Vaddr addr, size_t length ) {
+        return m_nic.findShmem( core, addr, length );
     }
 
 	void regMem( int id, uint64_t simAddr, size_t length, void* backing ) {
@@ -166,7 +198,7 @@ class Shmem {
 	    m_dbg.verbosePrefix( prefix(),CALL_INFO,1,NIC_DBG_SHMEM,"core=%d simVAddr=%" PRIx64 " backing=%p len=%lu\n",
             id, addr.getSimVAddr(), addr.getBacking(), length );
 
-    	m_regMem[id].push_back( RegionEntry( addr, simAddr, length)  );
+    	addRegion( id, RegionEntry( addr, simAddr, length ) );
 	}
 
     void checkWaitOps( int core, Hermes::Vaddr addr, size_t length );
@@ -198,6 +230,41 @@ private:
     void cswap( NicShmemCswapCmdEvent*, int id );
     void swap( NicShmemSwapCmdEvent*, int id );
 
+    const RegionEntry* lookupRegion( int core, uint64_t addr ) {
+        RegionMap& regions = m_regMem[core];
+        RegionMap::iterator iter = regions.upper_bound( addr );
+        if ( iter != regions.begin() && (--iter)->second.contains( addr ) ) {
+            return &iter->second;
+        }
+        // an enclosing region that starts below the closest one
+        for ( iter = regions.begin(); iter != regions.end() && iter->first <= addr; ++iter ) {
+            if ( iter->second.contains( addr ) ) {
+                return &iter->second;
+            }
+        }
+		m_dbg.fatal(CALL_INFO,0," core %d Unable to find for for addr %" PRIx64 "\n", core, addr);
+		// quiet compiler warning
+		assert(0);
+		return NULL;
+    }
+
+    void addRegion( int core, const RegionEntry& entry ) {
+        // the first registration of an address wins, as it did for lookups
+        m_regMem[core].insert( std::make_pair( entry.addr.getSimVAddr(), entry ) );
+    }
+
+    void freeOp( Op* op ) {
+        op->fini();
+        m_waitOpHeap.free( static_cast<WaitOp*>(op) );
+    }
+
+    bool canBatch( NicShmemCmdEvent* );
+    void batchPut( NicShmemSendCmdEvent*, int id );
+    void flushPutBatch( PutBatch&, int id, int node, int vnic );
+    void flushPutBatches();
+    void sendPut( NicShmemSendCmdEvent*, int id );
+    std::function<void()> putDone( NicShmemSendCmdEvent*, int id );
+
     void* getBacking( int core, Hermes::Vaddr addr, size_t length ) {
         m_dbg.verbosePrefix( prefix(), CALL_INFO,1,NIC_DBG_SHMEM,"core=%d addr=%#" PRIx64 "\n", core, addr );
         return  m_nic.findShmem( core, addr, length ).getBacking();
@@ -212,8 +279,14 @@ private:
     Nic& m_nic;
     Output& m_dbg;
     std::vector< std::list<Op*> > m_pendingOps;
+    ThingHeap<WaitOp> m_waitOpHeap;
+
+    std::vector< RegionMap > m_regMem;
+    std::vector< const RegionEntry* > m_regCache;
 
-    std::vector<std::vector< RegionEntry > > m_regMem;
+    std::vector< PutBatchMap > m_putBatches;
+    size_t m_putBatchMaxBytes;
+    size_t m_putBatchThreshold;
 	SimTime_t m_nic2HostDelay_ns;
 	SimTime_t m_host2NicDelay_ns;
 
@@ -192,6 +192,71 @@ bool Nic::ShmemRecvMoveMemOp::copyIn( Output& dbg, FireflyNetworkEvent& event, s
     return m_offset == m_length;
 }
 
+bool Nic::ShmemRecvMoveBatch::copyIn( Output& dbg, FireflyNetworkEvent& event, std::vector<MemOp>& vec )
+{
+    size_t length = event.bufSize();
+    dbg.debug(CALL_INFO,3,NIC_DBG_RECV_MOVE,"event.bufSize()=%lu offset=%lu length=%lu\n",length, m_offset, m_length );
+
+    assert( length <= m_length - m_offset );
+
+    m_buf.insert( m_buf.end(), (uint8_t*) event.bufPtr(), (uint8_t*) event.bufPtr() + length );
+    event.bufPop(length);
+    m_offset += length;
+
+    size_t pos = 0;
+    while ( m_buf.size() - pos >= sizeof(ShmemBatchSegHdr) ) {
+        ShmemBatchSegHdr seg;
+        memcpy( &seg, &m_buf[pos], sizeof(seg) );
+        if ( m_buf.size() - pos - sizeof(seg) < seg.length ) {
+            break;
+        }
+        apply( dbg, seg, &m_buf[pos + sizeof(seg)], vec );
+        pos += sizeof(seg) + seg.length;
+    }
+    m_buf.erase( m_buf.begin(), m_buf.begin() + pos );
+
+    return m_offset == m_length;
+}
+
+void Nic::ShmemRecvMoveBatch::apply( Output& dbg, ShmemBatchSegHdr& seg, uint8_t* data, std::vector<MemOp>& vec )
+{
+    Hermes::MemAddr addr = m_shmem->findShmem( m_core, seg.vaddr, seg.length );
+    Hermes::Vaddr simAddr = addr.getSimVAddr();
+    size_t length = seg.length;
+    int core = m_core;
+    Shmem* shmem = m_shmem;
+
+    dbg.debug(CALL_INFO,3,NIC_DBG_RECV_MOVE,"op=%d addr=%#" PRIx64 " length=%lu\n", seg.op, simAddr, length );
+
+    if ( seg.op == ShmemBatchSegHdr::Add ) {
+        Hermes::Value::Type type = (Hermes::Value::Type) seg.dataType;
+        assert( length == Hermes::Value::getLength( type ) );
+
+        if ( addr.getBacking() ) {
+            Hermes::Value local( type, addr.getBacking() );
+            Hermes::Value got( type, data );
+            local += got;
+        }
+
+        vec.push_back( MemOp( simAddr, length, MemOp::Op::BusLoad ));
+        vec.push_back( MemOp( simAddr, length, MemOp::Op::BusStore,
+            [=]() {
+                shmem->checkWaitOps( core, simAddr, length );
+            }
+        ));
+    } else {
+        if ( addr.getBacking() ) {
+            memcpy( addr.getBacking(), data, length );
+        }
+
+        vec.push_back( MemOp( simAddr, length, MemOp::Op::BusDmaToHost,
+            [=]() {
+                shmem->checkWaitOps( core, simAddr, length );
+            }
+        ));
+    }
+}
+
 bool Nic::ShmemRecvMoveValue::copyIn( Output& dbg, FireflyNetworkEvent& event, std::vector<MemOp>& vec )
 {
     size_t length = event.bufSize();
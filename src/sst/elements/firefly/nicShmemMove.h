@@ -55,6 +55,28 @@ class ShmemRecvMoveMemOp : public ShmemRecvMoveMem {
     Hermes::Value::Type m_dataType;
 };
 
+// the body of a batched put, a ShmemBatchSegHdr and the data of each put
+class ShmemRecvMoveBatch : public ShmemRecvMove {
+
+  public:
+    ShmemRecvMoveBatch( Shmem* shmem, int core, size_t length ) :
+        m_shmem(shmem), m_core(core), m_length( length ), m_offset(0)  {}
+
+    bool copyIn( Output& dbg, FireflyNetworkEvent&, std::vector<MemOp>& );
+    bool isDone() { return m_offset == m_length; }
+    size_t totalBytes() { return m_length; }
+
+  private:
+    void apply( Output& dbg, ShmemBatchSegHdr&, uint8_t* data, std::vector<MemOp>& );
+
+    Shmem*  m_shmem;
+    int     m_core;
+    size_t  m_length;
+    size_t  m_offset;
+    // holds a put that is split across packets
+    std::vector<uint8_t> m_buf;
+};
+
 class ShmemRecvMoveValue : public ShmemRecvMove {
 
   public:
@@ -40,10 +40,14 @@ class ShmemCmdSendEntry: public ShmemSendEntryBase {
 
 class ShmemAckSendEntry: public ShmemSendEntryBase {
   public:
-    ShmemAckSendEntry( int local_vNic, int streamNum, int dest_node, int dest_vNic, int vn  ) :
+    ShmemAckSendEntry( int local_vNic, int streamNum, int dest_node, int dest_vNic, int vn, uint32_t numPuts = 1 ) :
         ShmemSendEntryBase( local_vNic, streamNum, vn ), m_dest_node(dest_node), m_dest_vNic(dest_vNic)
     {
         m_hdr.op = ShmemMsgHdr::Ack;
+        if ( numPuts > 1 ) {
+            m_hdr.batch = 1;
+            m_hdr.length = numPuts;
+        }
         m_isAck = true;
     }
     int dst_vNic() { return m_dest_vNic; }
@@ -246,6 +250,113 @@ class ShmemAddSendEntry: public ShmemPutvSendEntry {
     }
 };
 
+// several small puts to one core, each goes out as a ShmemBatchSegHdr followed
+// by its data
+class ShmemPutBatchSendEntry: public ShmemSendEntryBase  {
+  public:
+    typedef std::function<void()> Callback;
+
+    ShmemPutBatchSendEntry( int local_vNic, int streamNum, int destNode, int dest_vNic, int vn ) :
+        ShmemSendEntryBase( local_vNic, streamNum, vn ),
+        m_node( destNode ),
+        m_vnic( dest_vNic ),
+        m_offset( 0 ),
+        m_next( 0 )
+    {
+        m_hdr.op = ShmemMsgHdr::Put;
+        m_hdr.batch = 1;
+        m_hdr.vaddr = 0;
+        m_hdr.length = 0;
+        m_hdr.respKey = 0;
+    }
+
+    ~ShmemPutBatchSendEntry() {
+        for ( size_t i = 0; i < m_puts.size(); i++ ) {
+            m_puts[i].callback();
+            delete m_puts[i].event;
+        }
+    }
+
+    // the data of a Put is read from host memory at addr, Putv and Add carry a value
+    void append( NicShmemSendCmdEvent* event, void* backing, Hermes::Vaddr addr, Callback callback ) {
+        ShmemBatchSegHdr seg;
+        seg.vaddr = event->getFarAddr();
+        seg.length = event->getLength();
+        seg.op = event->type == NicShmemCmdEvent::Add ? ShmemBatchSegHdr::Add : ShmemBatchSegHdr::Move;
+        seg.dataType = event->getDataType();
+        seg.pad = 0;
+
+        size_t pos = m_buf.size();
+        m_buf.resize( pos + sizeof(seg) + seg.length );
+        memcpy( &m_buf[pos], &seg, sizeof(seg) );
+        if ( backing ) {
+            memcpy( &m_buf[pos + sizeof(seg)], backing, seg.length );
+        }
+
+        m_puts.push_back( Put( event, callback, pos + sizeof(seg), seg.length, addr,
+                            event->type == NicShmemCmdEvent::Put ) );
+
+        ++m_hdr.vaddr;
+        m_hdr.length = m_buf.size();
+    }
+
+    int dst_vNic() { return m_vnic; }
+    int dest() { return m_node; }
+
+    size_t totalBytes() { return m_buf.size(); }
+    bool isDone() { return m_offset == m_buf.size(); }
+
+    void copyOut( Output& dbg, int numBytes,
+            FireflyNetworkEvent& ev, std::vector<MemOp>& vec ) {
+        size_t space = numBytes - ev.bufSize();
+        size_t len = m_buf.size() - m_offset > space ? space : m_buf.size() - m_offset;
+        size_t end = m_offset + len;
+
+        dbg.debug(CALL_INFO,3,NIC_DBG_SEND_MACHINE,"numPuts=%zu space=%zu offset=%zu len=%zu\n",
+                m_puts.size(), space, m_offset, len );
+
+        // the segment headers are built by the NIC, only the data is costed
+        for ( ; m_next < m_puts.size() && m_puts[m_next].offset < end; ++m_next ) {
+            Put& put = m_puts[m_next];
+            size_t start = put.offset > m_offset ? put.offset : m_offset;
+            size_t stop = put.offset + put.length < end ? put.offset + put.length : end;
+
+            if ( stop > start ) {
+                if ( put.fromHost ) {
+                    vec.push_back( MemOp( put.addr + start - put.offset, stop - start, MemOp::Op::BusDmaFromHost ));
+                } else {
+                    vec.push_back( MemOp( 0, stop - start, MemOp::Op::LocalLoad ));
+                }
+            }
+            if ( stop < put.offset + put.length ) {
+                break;
+            }
+        }
+
+        ev.bufAppend( &m_buf[m_offset], len );
+        m_offset += len;
+    }
+
+  private:
+    struct Put {
+        Put( NicShmemSendCmdEvent* event, Callback callback, size_t offset, size_t length, Hermes::Vaddr addr, bool fromHost ) :
+            event(event), callback(callback), offset(offset), length(length), addr(addr), fromHost(fromHost) {}
+        NicShmemSendCmdEvent* event;
+        Callback callback;
+        size_t offset;
+        size_t length;
+        Hermes::Vaddr addr;
+        bool fromHost;
+    };
+
+    std::vector<Put> m_puts;
+    std::vector<uint8_t> m_buf;
+    int m_node;
+    int m_vnic;
+    size_t m_offset;
+    size_t m_next;
+};
+
 class ShmemPut2SendEntry: public ShmemSendEntryBase  {
   public:
     ShmemPut2SendEntry( int local_vNic, int streamNum, int destNode, int dest_vNic,
@@ -53,7 +53,9 @@ void Nic::RecvMachine::ShmemStream::processOp( FireflyNetworkEvent* ev )
     switch ( m_shmemHdr.op ) {
 
       case ShmemMsgHdr::Put:
-    	if ( ! m_shmemHdr.respKey ) {
+    	if ( m_shmemHdr.batch ) {
+        	processPutBatch( m_shmemHdr, ev, m_myPid, m_srcPid );
+		} else if ( ! m_shmemHdr.respKey ) {
         	processPut( m_shmemHdr, ev, m_myPid, m_srcPid );
 		} else {
         	processGetResp( m_shmemHdr, ev, m_myPid, m_srcPid );
@@ -92,7 +94,10 @@ void Nic::RecvMachine::ShmemStream::processOp( FireflyNetworkEvent* ev )
 
 void Nic::RecvMachine::ShmemStream::processAck( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int pid, int srcPid  )
 {
-    m_ctx->nic().shmemDecPendingPuts( pid );
+    uint32_t numPuts = hdr.batch ? hdr.length : 1;
+    for ( uint32_t i = 0; i < numPuts; i++ ) {
+        m_ctx->nic().shmemDecPendingPuts( pid );
+    }
     m_ctx->deleteStream(this);
 
     delete ev;
@@ -120,6 +125,21 @@ void Nic::RecvMachine::ShmemStream::processPut( ShmemMsgHdr& hdr, FireflyNetwork
     processPktBody( ev );
 }
 
+void Nic::RecvMachine::ShmemStream::processPutBatch( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
+{
+    m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_STREAM,"numPuts=%" PRIu64 " length=%u\n", m_shmemHdr.vaddr, m_shmemHdr.length);
+
+    m_recvEntry = new ShmemRecvEntry( m_ctx->getShmem(), local_pid, hdr.length );
+
+	m_sendEntry = new ShmemAckSendEntry( local_pid, m_ctx->nic().getSendStreamNum(local_pid), ev->getSrcNode(), dest_pid,
+                        m_ctx->nic().m_shmemAckVN, hdr.vaddr );
+
+	m_matched_len = hdr.length;
+
+    ev->clearHdr();
+    processPktBody( ev );
+}
+
 void Nic::RecvMachine::ShmemStream::processGetResp( ShmemMsgHdr& hdr, FireflyNetworkEvent* ev, int local_pid, int dest_pid )
 {
     m_dbg.debug(CALL_INFO,1,NIC_DBG_RECV_STREAM,"respKey=%d\n", m_shmemHdr.respKey);
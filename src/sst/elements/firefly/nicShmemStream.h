@@ -35,6 +35,7 @@ class ShmemStream : public StreamBase {
     void processOp( FireflyNetworkEvent* ev );
     void processAck( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processPut( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
+    void processPutBatch( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processGetResp( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processGet( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
     void processFadd( ShmemMsgHdr&, FireflyNetworkEvent*, int, int );
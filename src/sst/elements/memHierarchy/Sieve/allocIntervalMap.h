@@ -0,0 +1,206 @@
+// Copyright 2016-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2016-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/*
+ * File:   allocIntervalMap.h
+ */
+
+#ifndef _MEMH_SIEVE_ALLOCINTERVALMAP_H
+#define _MEMH_SIEVE_ALLOCINTERVALMAP_H
+
+#include <stdint.h>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Maps virtual addresses to the allocation (malloc) that covers them and
+ * keeps per-allocation read/write miss counts.
+ *
+ * Active regions are held in a vector sorted by start address and searched
+ * with a binary search; the last matching region is cached since consecutive
+ * misses usually land in the same allocation. Allocate/free notifications are
+ * queued and merged into the vector in one pass the next time an address is
+ * looked up (or when the queue reaches batchLimit), so a burst of
+ * allocations costs one merge rather than one vector insert each.
+ *
+ * Lookup semantics match a map keyed by start address: an address belongs to
+ * the region with the greatest start <= address if it is inside that region.
+ * A later allocation at the same start replaces the earlier one and a free
+ * only matches a region with exactly that start.
+ *
+ * Counts are kept per allocation ID (the allocating instruction pointer
+ * reported by Ariel) in a dense table; regions hold an index into it so a
+ * miss never hashes the ID.
+ */
+class AllocIntervalMap {
+public:
+    struct Profile {
+        uint64_t id;            // ID assigned by ariel
+        uint64_t reads;         // Read misses attributed to this ID
+        uint64_t writes;        // Write misses attributed to this ID
+        uint64_t allocations;   // Number of allocations made with this ID
+        uint64_t bytes;         // Total bytes allocated with this ID
+    };
+
+    AllocIntervalMap(size_t batchLimit = 1024) : batchLimit_(batchLimit ? batchLimit : 1), lastHit_(0) { }
+
+    void allocate(uint64_t start, uint64_t size, uint64_t id) {
+        Update u = { start, size, id, seq_++, true };
+        queue(u);
+    }
+
+    void free(uint64_t start) {
+        Update u = { start, 0, 0, seq_++, false };
+        queue(u);
+    }
+
+    /* Record a miss at addr, returns false if no active allocation covers it */
+    bool recordMiss(uint64_t addr, bool isRead) {
+        Profile* prof = find(addr);
+        if (!prof) return false;
+        if (isRead) prof->reads++;
+        else prof->writes++;
+        return true;
+    }
+
+    /* Return the profile of the allocation covering addr, or nullptr */
+    Profile* find(uint64_t addr) {
+        if (!pending_.empty()) applyPending();
+
+        if (lastHit_ < regions_.size() && regions_[lastHit_].contains(addr)) {
+            // Still the right answer only if no later region starts at or below addr
+            if (lastHit_ + 1 == regions_.size() || regions_[lastHit_ + 1].start > addr)
+                return &profiles_[regions_[lastHit_].profile];
+        }
+
+        std::vector<Region>::iterator it = std::upper_bound(regions_.begin(), regions_.end(), addr,
+                [](uint64_t a, const Region& r) { return a < r.start; });
+        if (it == regions_.begin()) return nullptr;
+        --it;
+        if (!it->contains(addr)) return nullptr;
+
+        lastHit_ = it - regions_.begin();
+        return &profiles_[it->profile];
+    }
+
+    /* Apply any queued allocate/free notifications */
+    void flush() {
+        if (!pending_.empty()) applyPending();
+    }
+
+    /* Profiles indexed in order of first allocation */
+    std::vector<Profile>& getProfiles() { return profiles_; }
+
+    size_t activeRegions() {
+        flush();
+        return regions_.size();
+    }
+
+    void resetCounts() {
+        for (std::vector<Profile>::iterator it = profiles_.begin(); it != profiles_.end(); it++) {
+            it->reads = 0;
+            it->writes = 0;
+        }
+    }
+
+private:
+    struct Region {
+        uint64_t start;
+        uint64_t end;       // Exclusive
+        uint32_t profile;   // Index into profiles_
+
+        bool contains(uint64_t addr) const { return addr >= start && addr < end; }
+    };
+
+    struct Update {
+        uint64_t start;
+        uint64_t size;
+        uint64_t id;
+        uint64_t seq;
+        bool alloc;
+    };
+
+    void queue(const Update& u) {
+        pending_.push_back(u);
+        if (pending_.size() >= batchLimit_) applyPending();
+    }
+
+    uint32_t profileIndex(uint64_t id) {
+        std::unordered_map<uint64_t, uint32_t>::iterator it = profileIndex_.find(id);
+        if (it != profileIndex_.end()) return it->second;
+
+        uint32_t index = profiles_.size();
+        Profile prof = { id, 0, 0, 0, 0 };
+        profiles_.push_back(prof);
+        profileIndex_[id] = index;
+        return index;
+    }
+
+    /* Merge queued updates into the sorted region vector. Only the last update
+     * to a start address matters: an allocate replaces whatever was there and
+     * a free removes it. */
+    void applyPending() {
+        std::sort(pending_.begin(), pending_.end(), [](const Update& a, const Update& b) {
+                return a.start < b.start || (a.start == b.start && a.seq < b.seq); });
+
+        // Allocation statistics count every allocate, even ones later freed in the batch
+        for (std::vector<Update>::iterator it = pending_.begin(); it != pending_.end(); it++) {
+            if (!it->alloc) continue;
+            Profile& prof = profiles_[profileIndex(it->id)];
+            prof.allocations++;
+            prof.bytes += it->size;
+        }
+
+        merged_.clear();
+        merged_.reserve(regions_.size() + pending_.size());
+
+        std::vector<Region>::const_iterator rIt = regions_.begin();
+        std::vector<Update>::const_iterator uIt = pending_.begin();
+        while (uIt != pending_.end()) {
+            uint64_t start = uIt->start;
+            while (rIt != regions_.end() && rIt->start < start) merged_.push_back(*rIt++);
+            if (rIt != regions_.end() && rIt->start == start) rIt++; // Replaced or freed
+
+            // Skip to the last update for this address
+            while ((uIt + 1) != pending_.end() && (uIt + 1)->start == start) uIt++;
+            if (uIt->alloc) {
+                Region r = { start, start + uIt->size, profileIndex_[uIt->id] };
+                merged_.push_back(r);
+            }
+            uIt++;
+        }
+        merged_.insert(merged_.end(), rIt, std::vector<Region>::const_iterator(regions_.end()));
+
+        regions_.swap(merged_);
+        pending_.clear();
+        lastHit_ = 0;
+    }
+
+    size_t batchLimit_;
+    size_t lastHit_;
+    uint64_t seq_ = 0;
+    std::vector<Region> regions_;
+    std::vector<Region> merged_;
+    std::vector<Update> pending_;
+    std::vector<Profile> profiles_;
+    std::unordered_map<uint64_t, uint32_t> profileIndex_;
+};
+
+}}
+
+#endif
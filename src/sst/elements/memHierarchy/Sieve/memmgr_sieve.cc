@@ -65,6 +65,10 @@ uint64_t MemoryManagerSieve::translateAddress(uint64_t virtAddr) {
     return memmgr->translateAddress(virtAddr);
 }
 
+uint64_t MemoryManagerSieve::translateAddress(uint64_t virtAddr, uint32_t core) {
+    return memmgr->translateAddress(virtAddr, core);
+}
+
 
 bool MemoryManagerSieve::allocateMalloc(const uint64_t size, const uint32_t level, const uint64_t addr, const uint64_t ip, const uint32_t thread) {
     output->verbose(CALL_INFO, 4, 0, "Allocate malloc received. VA: %" PRIu64 ". Size: %" PRIu64 ".\n", addr, size);
@@ -48,6 +48,7 @@ class MemoryManagerSieve : public ArielComponent::ArielMemoryManager {
         ~MemoryManagerSieve();
 
         uint64_t translateAddress(uint64_t virtAddr);
+        uint64_t translateAddress(uint64_t virtAddr, uint32_t core);
         void printStats();
 
         void freeMalloc(const uint64_t vAddr);
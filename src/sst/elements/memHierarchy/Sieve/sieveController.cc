@@ -21,6 +21,8 @@
 #include <sst_config.h>
 #include <sst/core/interfaces/stringEvent.h>
 
+#include <stdio.h>
+
 #include "sieveController.h"
 #include "../memEvent.h"
 
@@ -28,43 +30,13 @@ using namespace SST;
 using namespace SST::MemHierarchy;
 
 void Sieve::recordMiss(Addr addr, bool isRead) {
-    allocMap_t::iterator allocI = activeAllocMap.lower_bound(addr);
-
-    // lower_bound returns iterator to address just above or equal to addr
-    if (allocI->first != addr) {
-        if (allocI == activeAllocMap.begin()) {
-            allocI = activeAllocMap.end(); // Not found
-        } else {
-            allocI--; // Actually want the address just below the one we got
-        }
-    }
-    if (allocI != activeAllocMap.end()) {
-        // is it in range
-        if (addr < (allocI->first +  allocI->second.size)) {
-            uint64_t allocID = allocI->second.id;
-            allocCountMap_t::iterator evI = allocMap.find(allocID);
-            if (evI == allocMap.end()) {
-                allocMap[allocID] = rwCount_t();
-                evI = allocMap.find(allocID);
-            }
-            if (isRead) {
-                evI->second.first++;
-                statReadMisses->addData(1);
-            } else {
-                evI->second.second++;
-                statWriteMisses->addData(1);
-            }
-            return;
-        }
-    }
+    if (isRead) statReadMisses->addData(1);
+    else statWriteMisses->addData(1);
 
-    if (isRead) {
-        statUnassocReadMisses->addData(1);
-        statReadMisses->addData(1);
-    } else {
-        statUnassocWriteMisses->addData(1);
-        statWriteMisses->addData(1);
-    }
+    if (allocMap.recordMiss(addr, isRead)) return;
+
+    if (isRead) statUnassocReadMisses->addData(1);
+    else statUnassocWriteMisses->addData(1);
 }
 
 void Sieve::processAllocEvent(SST::Event* event) {
@@ -72,36 +44,13 @@ void Sieve::processAllocEvent(SST::Event* event) {
     AllocTrackEvent* ev = static_cast<AllocTrackEvent*>(event);
 
     if (ev->getType() == AllocTrackEvent::ALLOC) {
-        // add to the list of active allocations (i.e. not FREEd)
-        mallocEntry entry = {ev->getInstructionPointer(), ev->getAllocateLength()};
-        activeAllocMap[ev->getVirtualAddress()] = entry;
-
-#ifdef __SST_DEBUG_OUTPUT__
-        if (activeAllocMap.find(ev->getVirtualAddress()) != activeAllocMap.end()) {
-            // sometimes ariel replaces both malloc() and _malloc(), so we get two reports. Just ignore the first.
-            output_->debug(_INFO_, "Trying to add allocation event at an address (%p %" PRIx64") with an active allocation. %" PRIu64 "\n", ev, ev->getVirtualAddress(), (uint64_t)activeAllocMap.size());
-        }
-#endif
+        // Queue the new active allocation (i.e. not FREEd). Sometimes ariel replaces both
+        // malloc() and _malloc(), so we get two reports; the later one replaces the earlier.
+        allocMap.allocate(ev->getVirtualAddress(), ev->getAllocateLength(), ev->getInstructionPointer());
         delete ev;
     } else if (ev->getType() == AllocTrackEvent::FREE) {
-        allocMap_t::iterator targ = activeAllocMap.find(ev->getVirtualAddress());
-        if (targ != activeAllocMap.end()) {
-            uint64_t allocID = targ->second.id;
-            allocCountMap_t::iterator mapIt = allocMap.find(allocID);
-
-            // In this case ALWAYS delete the entry from active alloc & delete the event
-            activeAllocMap.erase(targ);
-
-            // If the entry in the count map is 0, remove it as well
-            if (mapIt != allocMap.end() && (mapIt->second.first == 0 && mapIt->second.second == 0)) {
-                allocMap.erase(mapIt);
-            }
-
-#ifdef __SST_DEBUG_OUTPUT__
-        } else {
-            output_->debug(_INFO_,"FREEing an address that was never ALLOCd\n");
-#endif
-        }
+        // FREEs of addresses that were never ALLOCd are ignored when the batch is applied
+        allocMap.free(ev->getVirtualAddress());
         delete ev;
     } else if (ev->getType() == AllocTrackEvent::BUOY) {
         // output stats
@@ -202,41 +151,100 @@ void Sieve::outputStats(int marker) {
     if (-1 != marker)  {
         fileName << "-" << marker;
     }
-    fileName << ".txt";
 
-    // create new file
-    Output* output_file = new Output("",0,0,SST::Output::FILE, fileName.str());
+    allocMap.flush();
 
-    // have the listener (if any) output stats
-    if (listener_) {
-        listener_->printStats(*output_file);
-    }
+    if (outFormat == TEXT || listener_) {
+        // create new file
+        Output* output_file = new Output("",0,0,SST::Output::FILE, fileName.str() + ".txt");
 
-    // print out all the allocations and how often they were touched
-    output_file->output(CALL_INFO, "#Printing allocation memory accesses (mallocID, reads, writes):\n");
-    vector<uint64_t> entriesToErase;
-    for (allocCountMap_t::iterator i = allocMap.begin(); i != allocMap.end(); i++) {
-	rwCount_t &counts = i->second;
-
-        if (counts.first == 0 && counts.second == 0) {
-            entriesToErase.push_back(i->first);
-            continue;
+        // have the listener (if any) output stats
+        if (listener_) {
+            listener_->printStats(*output_file);
         }
-        output_file->output(CALL_INFO, "%" PRIu64 " %" PRId64 " %" PRId64 "\n",
-                            i->first, counts.first, counts.second);
-
-        // clear the counts
-        if (resetStatsOnOutput) {
-            counts.first = 0;
-            counts.second = 0;
-            entriesToErase.push_back(i->first);
+
+        if (outFormat == TEXT) {
+            outputProfileText(output_file);
         }
+
+        // clean up
+        delete output_file;
+    }
+
+    if (outFormat == CSV) {
+        outputProfileCSV(fileName.str() + ".csv");
+    } else if (outFormat == BINARY) {
+        outputProfileBinary(fileName.str() + ".bin");
     }
-    for (vector<uint64_t>::iterator it = entriesToErase.begin(); it != entriesToErase.end(); it++) {
-        allocMap.erase(*it); // remove entry from allocMap
+
+    // clear the counts
+    if (resetStatsOnOutput) {
+        allocMap.resetCounts();
+    }
+}
+
+void Sieve::outputProfileText(Output* out) {
+    // print out all the allocations and how often they were touched
+    out->output(CALL_INFO, "#Printing allocation memory accesses (mallocID, reads, writes):\n");
+    vector<AllocIntervalMap::Profile>& profiles = allocMap.getProfiles();
+    for (vector<AllocIntervalMap::Profile>::iterator i = profiles.begin(); i != profiles.end(); i++) {
+        if (i->reads == 0 && i->writes == 0) continue;
+        out->output(CALL_INFO, "%" PRIu64 " %" PRId64 " %" PRId64 "\n", i->id, i->reads, i->writes);
     }
-    // clean up
-    delete output_file;
+}
+
+void Sieve::outputProfileCSV(const string& fileName) {
+    FILE* fp = fopen(fileName.c_str(), "w");
+    if (!fp) output_->fatal(CALL_INFO, -1, "%s, Error: unable to open profile file '%s'\n", getName().c_str(), fileName.c_str());
+
+    // Rows are built in one buffer and written with a single call
+    string buffer("mallocID,reads,writes,allocations,bytes\n");
+    char line[128];
+    vector<AllocIntervalMap::Profile>& profiles = allocMap.getProfiles();
+    for (vector<AllocIntervalMap::Profile>::iterator i = profiles.begin(); i != profiles.end(); i++) {
+        if (i->reads == 0 && i->writes == 0) continue;
+        int len = snprintf(line, sizeof(line), "%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                i->id, i->reads, i->writes, i->allocations, i->bytes);
+        buffer.append(line, len);
+    }
+    fwrite(buffer.data(), 1, buffer.size(), fp);
+    fclose(fp);
+}
+
+/*
+ * Binary profile layout (host byte order):
+ *   char[8]  "SIEVEPRF"
+ *   uint32   version (1)
+ *   uint32   fields per record (5)
+ *   uint64   record count
+ *   records: uint64 mallocID, reads, writes, allocations, bytes
+ */
+void Sieve::outputProfileBinary(const string& fileName) {
+    FILE* fp = fopen(fileName.c_str(), "wb");
+    if (!fp) output_->fatal(CALL_INFO, -1, "%s, Error: unable to open profile file '%s'\n", getName().c_str(), fileName.c_str());
+
+    vector<uint64_t> records;
+    vector<AllocIntervalMap::Profile>& profiles = allocMap.getProfiles();
+    records.reserve(profiles.size() * 5);
+    for (vector<AllocIntervalMap::Profile>::iterator i = profiles.begin(); i != profiles.end(); i++) {
+        if (i->reads == 0 && i->writes == 0) continue;
+        records.push_back(i->id);
+        records.push_back(i->reads);
+        records.push_back(i->writes);
+        records.push_back(i->allocations);
+        records.push_back(i->bytes);
+    }
+
+    const char magic[8] = { 'S', 'I', 'E', 'V', 'E', 'P', 'R', 'F' };
+    uint32_t version = 1;
+    uint32_t fields = 5;
+    uint64_t count = records.size() / 5;
+    fwrite(magic, 1, sizeof(magic), fp);
+    fwrite(&version, sizeof(version), 1, fp);
+    fwrite(&fields, sizeof(fields), 1, fp);
+    fwrite(&count, sizeof(count), 1, fp);
+    if (!records.empty()) fwrite(records.data(), sizeof(uint64_t), records.size(), fp);
+    fclose(fp);
 }
 
 void Sieve::finish(){
@@ -26,14 +26,13 @@
 #include <sst/core/link.h>
 #include <sst/core/output.h>
 
-#include <unordered_map>
-
 #include "sst/elements/memHierarchy/lineTypes.h"
 #include "sst/elements/memHierarchy/cacheArray.h"
 #include "sst/elements/memHierarchy/cacheListener.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "alloctrackev.h"
+#include "allocIntervalMap.h"
 
 
 namespace SST { namespace MemHierarchy {
@@ -55,7 +54,9 @@ public:
             {"debug",                   "(uint) Print debug information. Options: 0[no output], 1[stdout], 2[stderr], 3[file]", "0"},
             {"debug_level",             "(uint) Debugging/verbosity level. Between 0 and 10", "0"},
             {"output_file",             "(string) Name of file to output malloc information to. Will have sequence number (and optional marker number) and .txt appended to it. E.g. sieveMallocRank-3.txt", "sieveMallocRank"},
-            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true." "0"} )
+            {"output_format",           "(string) Format of the per-allocation profile. 'text' writes <output_file>...txt as before, 'csv' writes mallocID,reads,writes,allocations,bytes rows to .csv and 'binary' writes a 'SIEVEPRF' header followed by five uint64 fields per allocation to .bin. Profiler stats always go to the .txt file.", "text"},
+            {"alloc_batch_size",        "(uint) Maximum number of allocation/free notifications to queue before merging them into the allocation map. Queued updates are always merged before the next miss is attributed.", "1024"},
+            {"reset_stats_at_buoy",     "(bool) Whether to reset allocation hit/miss stats when a buoy is found (i.e., when a new output file is dumped). Any value other than 0 is true.", "0"} )
 
     SST_ELI_DOCUMENT_PORTS(
             {"cpu_link_%(port)d", "Ports connected to the CPUs", {"memHierarchy.MemEventBase"}},
@@ -89,27 +90,16 @@ public:
     }
 
 private:
-    struct mallocEntry {
-        uint64_t id;    // ID assigned by ariel
-        uint64_t size;  // Number of bytes
-    };
-
-
-    typedef map<Addr, mallocEntry> allocMap_t;
-    typedef pair<uint64_t, uint64_t> rwCount_t;
-    typedef std::unordered_map<uint64_t, rwCount_t > allocCountMap_t;
-
+    enum OutputFormat { TEXT, CSV, BINARY };
 
     /** Name of the output file */
     string outFileName;
     /** output file counter */
     uint64_t outCount;
-    /** All Allocations */
-    allocCountMap_t allocMap;
-     /** All allocations in list form */
-    /** Active Allocations */
-    allocMap_t activeAllocMap;
-    /** misses not associated with an alloc'd region */
+    /** Format of the per-allocation profile */
+    OutputFormat outFormat;
+    /** Active allocations and per-allocation miss counts */
+    AllocIntervalMap allocMap;
 
     void recordMiss(Addr addr, bool isRead);
 
@@ -129,6 +119,9 @@ private:
 
     /** output and clear stats to file  */
     void outputStats(int marker);
+    void outputProfileText(Output* out);
+    void outputProfileCSV(const string& fileName);
+    void outputProfileBinary(const string& fileName);
     bool resetStatsOnOutput;
 
     CacheArray<SharedCacheLine>* cacheArray_;
@@ -73,6 +73,14 @@ Sieve::Sieve(ComponentId_t id, Params &params) : Component(id) {
     }
     outCount = 0;
 
+    std::string format = params.find<std::string>("output_format", "text");
+    if (format == "text") outFormat = TEXT;
+    else if (format == "csv") outFormat = CSV;
+    else if (format == "binary") outFormat = BINARY;
+    else output_->fatal(CALL_INFO, -1, "Invalid param: output_format - must be 'text', 'csv' or 'binary'. Got '%s'\n", format.c_str());
+
+    allocMap = AllocIntervalMap(params.find<size_t>("alloc_batch_size", 1024));
+
     resetStatsOnOutput = params.find<bool>("reset_stats_at_buoy", 0) != 0;
 
     // optional link for allocation / free tracking
@@ -53,26 +53,27 @@ GUPSGenerator::~GUPSGenerator() {
     delete rng;
 }
 
-void GUPSGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+uint32_t GUPSGenerator::generateBatch(GeneratorBatch* batch, const uint32_t maxSteps) {
+    uint32_t steps = 0;
 
-    const uint64_t rand_addr = rng->generateNextUInt64();
-    // Ensure we have a reqLength aligned request
+    for(; steps < maxSteps && issueCount > 0; ++steps) {
+        const uint64_t rand_addr = rng->generateNextUInt64();
+        // Ensure we have a reqLength aligned request
 
-    uint64_t addr = (rand_addr % ( memLength / reqLength ) );
-    addr *= reqLength;
-    addr += memStart;
+        uint64_t addr = (rand_addr % ( memLength / reqLength ) );
+        addr *= reqLength;
+        addr += memStart;
 
-    out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 " at address %" PRIu64 "\n", issueCount, addr);
+        out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 " at address %" PRIu64 "\n", issueCount, addr);
 
-    MemoryOpRequest* readAddr = new MemoryOpRequest(addr, reqLength, READ);
-    MemoryOpRequest* writeAddr = new MemoryOpRequest(addr, reqLength, WRITE);
+        // Read-modify-write, the write waits for the read
+        batch->push(addr, reqLength, READ);
+        batch->push(addr, reqLength, WRITE, 1);
 
-    writeAddr->addDependency(readAddr->getRequestID());
+        issueCount--;
+    }
 
-    q->push_back(readAddr);
-    q->push_back(writeAddr);
-
-    issueCount--;
+    return steps;
 }
 
 bool GUPSGenerator::isFinished() {
@@ -34,7 +34,8 @@ public:
 	GUPSGenerator( ComponentId_t id, Params& params );
         void build(Params &params);
 	~GUPSGenerator();
-	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool supportsBatch() const { return true; }
+	uint32_t generateBatch(GeneratorBatch* batch, const uint32_t maxSteps);
 	bool isFinished();
 	void completed();
 
@@ -0,0 +1,54 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_TRACE_FORMAT
+#define _H_SST_MIRANDA_TRACE_FORMAT
+
+#include <stdint.h>
+
+/*
+ * Compact binary address trace replayed by miranda.TraceGenerator and written
+ * by sst-miranda-traceconvert. A header is followed by fixed size records,
+ * all fields in host byte order.
+ */
+
+#define MIRANDA_TRACE_MAGIC "MIRTRACE"
+#define MIRANDA_TRACE_VERSION 1
+
+#define MIRANDA_TRACE_OP_READ  0
+#define MIRANDA_TRACE_OP_WRITE 1
+#define MIRANDA_TRACE_OP_FENCE 2
+
+typedef struct {
+	char     magic[8];
+	uint32_t version;
+	uint32_t recordSize;
+	uint64_t recordCount;
+} MirandaTraceHeader;
+
+typedef struct {
+	uint64_t addr;
+	uint32_t gap;          // nanoseconds since the previous record was generated
+	uint16_t length;
+	uint8_t  op;
+	uint8_t  depBack;      // depends on the record this many records earlier, 0 for none
+} MirandaTraceRecord;
+
+// depBack is 8 bits so a record can depend on one at most 255 records earlier,
+// sst-miranda-traceconvert caps --rmw-window there
+#define MIRANDA_TRACE_MAX_DEP_BACK 255
+
+#endif
@@ -51,25 +51,31 @@ RandomGenerator::~RandomGenerator() {
 	delete rng;
 }
 
-void RandomGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
-	out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 "\n", issueCount);
+uint32_t RandomGenerator::generateBatch(GeneratorBatch* batch, const uint32_t maxSteps) {
+	uint32_t steps = 0;
 
-	const uint64_t rand_addr = rng->generateNextUInt64();
-	// Ensure we have a reqLength aligned request
-	const uint64_t addr_under_limit = (rand_addr % maxAddr);
-	const uint64_t addr = (addr_under_limit < reqLength) ? addr_under_limit :
-		(rand_addr % maxAddr) - (rand_addr % reqLength);
+	for(; steps < maxSteps && issueCount > 0; ++steps) {
+		out->verbose(CALL_INFO, 4, 0, "Generating next request number: %" PRIu64 "\n", issueCount);
 
-	const double op_decide = rng->nextUniform();
+		const uint64_t rand_addr = rng->generateNextUInt64();
+		// Ensure we have a reqLength aligned request
+		const uint64_t addr_under_limit = (rand_addr % maxAddr);
+		const uint64_t addr = (addr_under_limit < reqLength) ? addr_under_limit :
+			(rand_addr % maxAddr) - (rand_addr % reqLength);
 
-	// Populate request
-	q->push_back(new MemoryOpRequest(addr, reqLength, (op_decide < 0.5) ? READ : WRITE));
+		const double op_decide = rng->nextUniform();
 
-	if (issueOpFences) {
-	    q->push_back(new FenceOpRequest());
+		// Populate request
+		batch->push(addr, reqLength, (op_decide < 0.5) ? READ : WRITE);
+
+		if (issueOpFences) {
+			batch->pushFence();
+		}
+
+		issueCount--;
 	}
 
-	issueCount--;
+	return steps;
 }
 
 bool RandomGenerator::isFinished() {
@@ -34,7 +34,8 @@ public:
 	RandomGenerator( ComponentId_t id, Params& params );
         void build(Params& params);
 	~RandomGenerator();
-	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool supportsBatch() const { return true; }
+	uint32_t generateBatch(GeneratorBatch* batch, const uint32_t maxSteps);
 	bool isFinished();
 	void completed();
 
@@ -31,7 +31,8 @@ public:
 	Stencil3DBenchGenerator( ComponentId_t id, Params& params );
         void build(Params& params);
 	~Stencil3DBenchGenerator();
-	void generate(MirandaRequestQueue<GeneratorRequest*>* q);
+	bool supportsBatch() const { return true; }
+	uint32_t generateBatch(GeneratorBatch* batch, const uint32_t maxSteps);
 	bool isFinished();
 	void completed();
 
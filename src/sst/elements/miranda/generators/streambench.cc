@@ -60,33 +60,33 @@ STREAMBenchGenerator::~STREAMBenchGenerator() {
 	delete out;
 }
 
-void STREAMBenchGenerator::generate(MirandaRequestQueue<GeneratorRequest*>* q) {
-	for(uint64_t j = 0; j < n_per_call; ++j) {
-		out->verbose(CALL_INFO, 4, 0, "Array index: %" PRIu64 "\n", i);
+uint32_t STREAMBenchGenerator::generateBatch(GeneratorBatch* batch, const uint32_t maxSteps) {
+	uint32_t steps = 0;
 
-		// If we reached our limit then step out of the generation
-		if(i == n) {
-			break;
-		}
-
-                MemoryOpRequest* read_b  = new MemoryOpRequest(start_b + (i * reqLength), reqLength, READ);
-                MemoryOpRequest* read_c  = new MemoryOpRequest(start_c + (i * reqLength), reqLength, READ);
-                MemoryOpRequest* write_a = new MemoryOpRequest(start_a + (i * reqLength), reqLength, WRITE);
+	for(; steps < maxSteps && i < n; ++steps) {
+		for(uint64_t j = 0; j < n_per_call; ++j) {
+			out->verbose(CALL_INFO, 4, 0, "Array index: %" PRIu64 "\n", i);
 
-		write_a->addDependency(read_b->getRequestID());
-		write_a->addDependency(read_c->getRequestID());
+			// If we reached our limit then step out of the generation
+			if(i == n) {
+				break;
+			}
 
-		out->verbose(CALL_INFO, 8, 0, "Issuing READ request for address %" PRIu64 "\n", (start_b + (i * reqLength)));
-		q->push_back(read_b);
+			out->verbose(CALL_INFO, 8, 0, "Issuing READ request for address %" PRIu64 "\n", (start_b + (i * reqLength)));
+			batch->push(start_b + (i * reqLength), reqLength, READ);
 
-		out->verbose(CALL_INFO, 8, 0, "Issuing READ request for address %" PRIu64 "\n", (start_c + (i * reqLength)));
-		q->push_back(read_c);
+			out->verbose(CALL_INFO, 8, 0, "Issuing READ request for address %" PRIu64 "\n", (start_c + (i * reqLength)));
+			batch->push(start_c + (i * reqLength), reqLength, READ);
 
-		out->verbose(CALL_INFO, 8, 0, "Issuing WRITE request for address %" PRIu64 "\n", (start_a + (i * reqLength)));
-		q->push_back(write_a);
+			// a[i] is written once both reads have completed
+			out->verbose(CALL_INFO, 8, 0, "Issuing WRITE request for address %" PRIu64 "\n", (start_a + (i * reqLength)));
+			batch->push(start_a + (i * reqLength), reqLength, WRITE, 2);
 
-		i++;
+			i++;
+		}
 	}
+
+	return steps;
 }
 
 bool STREAMBenchGenerator::isFinished() {
@@ -0,0 +1,261 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+#include <sst/core/params.h>
+#include <sst/core/unitAlgebra.h>
+#include <sst/elements/miranda/generators/tracegen.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Miranda;
+
+// Prospero binary record: instruction count, 'R' or 'W', address, size
+#define PROSPERO_TRACE_RECORD_SIZE (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
+// The CPU remembers the requests of the last MIRANDA_DEP_HISTORY records, which
+// covers every producer a trace record can name
+static_assert(MIRANDA_TRACE_MAX_DEP_BACK <= MIRANDA_DEP_HISTORY, "trace dependencies reach past the CPU's history");
+
+TraceGenerator::TraceGenerator( ComponentId_t id, Params& params ) :
+	RequestGenerator(id, params) {
+
+	const uint32_t verbose = params.find<uint32_t>("verbose", 0);
+	out = new Output("TraceGenerator[@p:@l]: ", verbose, 0, Output::STDOUT);
+
+	const std::string file = params.find<std::string>("file", "");
+	if("" == file) {
+		out->fatal(CALL_INFO, -1, "Error: TraceGenerator requires a trace file\n");
+	}
+
+	blockSize = UnitAlgebra(params.find<std::string>("blocksize", "64MiB")).getRoundedValue();
+	recordsPerStep = std::max(params.find<uint32_t>("records_per_step", 16), (uint32_t) 1);
+	timing = params.find<std::string>("timing", "yes") == "yes";
+	timeScale = params.find<double>("timescale", 1.0);
+	instructionTime = params.find<double>("instruction_time", 0.0);
+	maxRequests = params.find<uint64_t>("max_requests", 0);
+	addressLimit = params.find<uint64_t>("address_limit", 0);
+
+	pageSize = (uint64_t) sysconf(_SC_PAGESIZE);
+	blockSize = std::max(blockSize - (blockSize % pageSize), pageSize);
+
+	fd = open(file.c_str(), O_RDONLY);
+	if(fd < 0) {
+		out->fatal(CALL_INFO, -1, "Error: unable to open trace file %s\n", file.c_str());
+	}
+
+	struct stat fileInfo;
+	if(0 != fstat(fd, &fileInfo)) {
+		out->fatal(CALL_INFO, -1, "Error: unable to stat trace file %s\n", file.c_str());
+	}
+
+	mapLength = (uint64_t) fileInfo.st_size;
+	mapBase = NULL;
+
+	if(mapLength > 0) {
+		void* mapping = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(MAP_FAILED == mapping) {
+			out->fatal(CALL_INFO, -1, "Error: unable to map trace file %s\n", file.c_str());
+		}
+
+		mapBase = (const uint8_t*) mapping;
+		madvise(mapping, mapLength, MADV_SEQUENTIAL);
+	}
+
+	const std::string formatName = params.find<std::string>("format", "auto");
+	const bool hasHeader = mapLength >= sizeof(MirandaTraceHeader) &&
+		0 == memcmp(mapBase, MIRANDA_TRACE_MAGIC, 8);
+
+	if(formatName == "miranda" || (formatName == "auto" && hasHeader)) {
+		if(!hasHeader) {
+			out->fatal(CALL_INFO, -1, "Error: %s is not a Miranda trace\n", file.c_str());
+		}
+
+		MirandaTraceHeader header;
+		memcpy(&header, mapBase, sizeof(header));
+
+		if(MIRANDA_TRACE_VERSION != header.version || sizeof(MirandaTraceRecord) != header.recordSize) {
+			out->fatal(CALL_INFO, -1, "Error: %s has unsupported version %" PRIu32 " or record size %" PRIu32 "\n",
+				file.c_str(), header.version, header.recordSize);
+		}
+
+		format = MIRANDA_TRACE;
+		recordSize = sizeof(MirandaTraceRecord);
+		cursor = sizeof(MirandaTraceHeader);
+	} else if(formatName == "prospero" || formatName == "auto") {
+		format = PROSPERO_TRACE;
+		recordSize = PROSPERO_TRACE_RECORD_SIZE;
+		cursor = 0;
+	} else {
+		out->fatal(CALL_INFO, -1, "Error: unknown trace format \'%s\'\n", formatName.c_str());
+	}
+
+	// Ignore a trailing partial record
+	mapLength -= (mapLength - cursor) % recordSize;
+
+	prefetchedTo = 0;
+	releasedTo = 0;
+	advanceWindow();
+
+	replayed = 0;
+	started = false;
+	lastRelease = 0;
+	lastInstruction = 0;
+
+	statReplayed = registerStatistic<uint64_t>("records_replayed");
+	statDepsDropped = registerStatistic<uint64_t>("dependencies_dropped");
+	statStalls = registerStatistic<uint64_t>("think_time_stalls");
+
+	out->verbose(CALL_INFO, 1, 0, "Trace file:        %s (%s)\n", file.c_str(), (format == MIRANDA_TRACE) ? "miranda" : "prospero");
+	out->verbose(CALL_INFO, 1, 0, "Trace records:     %" PRIu64 "\n", (mapLength - cursor) / recordSize);
+	out->verbose(CALL_INFO, 1, 0, "Prefetch block:    %" PRIu64 " bytes\n", blockSize);
+	out->verbose(CALL_INFO, 1, 0, "Think time:        %s\n", timing ? "yes" : "no");
+}
+
+TraceGenerator::~TraceGenerator() {
+	if(NULL != mapBase) {
+		munmap((void*) mapBase, mapLength);
+	}
+
+	if(fd >= 0) {
+		close(fd);
+	}
+
+	delete out;
+}
+
+// Keep the next block of the trace on its way in and drop what has been replayed
+void TraceGenerator::advanceWindow() {
+	if(NULL == mapBase) {
+		return;
+	}
+
+	while(prefetchedTo < mapLength && prefetchedTo < cursor + blockSize) {
+		const uint64_t length = std::min(blockSize, mapLength - prefetchedTo);
+		madvise((void*) (mapBase + prefetchedTo), length, MADV_WILLNEED);
+		prefetchedTo += length;
+	}
+
+	const uint64_t behind = cursor - (cursor % pageSize);
+	if(behind >= releasedTo + blockSize) {
+		madvise((void*) (mapBase + releasedTo), behind - releasedTo, MADV_DONTNEED);
+		releasedTo = behind;
+	}
+}
+
+// Decode the record at the cursor without consuming it
+bool TraceGenerator::nextRecord(MirandaTraceRecord* rec) {
+	if(cursor + recordSize > mapLength) {
+		return false;
+	}
+
+	const uint8_t* entry = mapBase + cursor;
+
+	if(MIRANDA_TRACE == format) {
+		memcpy(rec, entry, sizeof(MirandaTraceRecord));
+	} else {
+		uint64_t instruction;
+		char op;
+		uint32_t size;
+
+		memcpy(&instruction, entry, sizeof(uint64_t));
+		memcpy(&op, entry + sizeof(uint64_t), sizeof(char));
+		memcpy(&(rec->addr), entry + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&size, entry + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		const uint64_t elapsed = (replayed > 0 && instruction > lastInstruction) ? (instruction - lastInstruction) : 0;
+		rec->gap = (uint32_t) std::min((double) UINT32_MAX, elapsed * instructionTime);
+		rec->length = (uint16_t) size;
+		rec->op = ('W' == op) ? MIRANDA_TRACE_OP_WRITE : MIRANDA_TRACE_OP_READ;
+		rec->depBack = 0;
+	}
+
+	return true;
+}
+
+uint32_t TraceGenerator::generateBatch(GeneratorBatch* batch, const uint32_t maxSteps) {
+	const double now = (double) getCurrentSimTimeNano();
+	uint32_t steps = 0;
+
+	if(!started) {
+		lastRelease = now;
+		started = true;
+	}
+
+	for(; steps < maxSteps && !isFinished(); ++steps) {
+		for(uint32_t r = 0; r < recordsPerStep && !isFinished(); ++r) {
+			MirandaTraceRecord rec;
+			nextRecord(&rec);
+
+			// Think time runs from when the previous record was generated
+			const double release = lastRelease + (rec.gap * timeScale);
+			if(timing && release > now) {
+				out->verbose(CALL_INFO, 8, 0, "Record %" PRIu64 " due at %.2fns, now %.2fns\n", replayed, release, now);
+				statStalls->addData(1);
+				return (r > 0) ? (steps + 1) : steps;
+			}
+
+			lastRelease = std::max(release, now);
+
+			// Virtual addresses from a traced process are usually far above Miranda's page map
+			if(addressLimit > 0) {
+				rec.addr %= addressLimit;
+			}
+
+			if(MIRANDA_TRACE_OP_FENCE == rec.op) {
+				batch->pushFence();
+			} else {
+				const ReqOperation op = (MIRANDA_TRACE_OP_WRITE == rec.op) ? WRITE : READ;
+
+				// Producers before the start of the replay can no longer be named
+				if(rec.depBack > 0 && rec.depBack <= replayed) {
+					batch->push(rec.addr, rec.length, op, 1, rec.depBack - 1);
+				} else {
+					if(rec.depBack > 0) {
+						statDepsDropped->addData(1);
+					}
+
+					batch->push(rec.addr, rec.length, op);
+				}
+			}
+
+			if(PROSPERO_TRACE == format) {
+				memcpy(&lastInstruction, mapBase + cursor, sizeof(uint64_t));
+			}
+
+			cursor += recordSize;
+			replayed++;
+			statReplayed->addData(1);
+		}
+
+		advanceWindow();
+	}
+
+	return steps;
+}
+
+bool TraceGenerator::isFinished() {
+	return (cursor + recordSize > mapLength) || (maxRequests > 0 && replayed >= maxRequests);
+}
+
+void TraceGenerator::completed() {
+	out->verbose(CALL_INFO, 1, 0, "Replayed %" PRIu64 " trace records\n", replayed);
+}
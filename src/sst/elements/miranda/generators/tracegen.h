@@ -0,0 +1,114 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_MIRANDA_TRACE_GEN
+#define _H_SST_MIRANDA_TRACE_GEN
+
+#include <sst/elements/miranda/mirandaGenerator.h>
+#include <sst/elements/miranda/generators/mirandatrace.h>
+#include <sst/core/output.h>
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Replays an address trace from a memory mapped file. Native traces carry a
+ * think time and an optional producer for each record, Prospero binary traces
+ * are replayed directly with think time derived from the instruction counts.
+ * The mapping is read through a sliding window so only a few blocks of a
+ * large trace are resident at once.
+ */
+class TraceGenerator : public RequestGenerator {
+
+public:
+	TraceGenerator( ComponentId_t id, Params& params );
+	~TraceGenerator();
+	bool supportsBatch() const { return true; }
+	uint32_t generateBatch(GeneratorBatch* batch, const uint32_t maxSteps);
+	bool isFinished();
+	void completed();
+
+	SST_ELI_REGISTER_SUBCOMPONENT(
+        TraceGenerator,
+        "miranda",
+        "TraceGenerator",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+		"Replays a compact binary address trace",
+        SST::Miranda::RequestGenerator
+    )
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "verbose",          "Sets the verbosity output of the generator", "0" },
+        { "file",             "Trace file to replay", "" },
+        { "format",           "Trace format: auto, miranda (sst-miranda-traceconvert output) or prospero (Prospero binary)", "auto" },
+        { "blocksize",        "Bytes of the trace prefetched ahead of the replay position", "64MiB" },
+        { "records_per_step", "Records generated per generator step", "16" },
+        { "timing",           "Honor the think time between records, \"yes\" or \"no\"", "yes" },
+        { "timescale",        "Multiplier applied to think times", "1.0" },
+        { "instruction_time", "Nanoseconds per instruction used as think time for Prospero traces", "0" },
+        { "max_requests",     "Stop after this many records, 0 replays the whole trace", "0" },
+        { "address_limit",    "Fold addresses into [0, address_limit), 0 replays them unchanged", "0" }
+    )
+
+	SST_ELI_DOCUMENT_STATISTICS(
+        { "records_replayed",     "Number of trace records generated",                                  "records", 1 },
+        { "dependencies_dropped", "Dependencies on records before the start of the trace, which cannot be tracked", "records", 1 },
+        { "think_time_stalls",    "Generator calls which stopped early to honor think time",            "calls",   1 }
+    )
+
+private:
+	typedef enum {
+		MIRANDA_TRACE,
+		PROSPERO_TRACE
+	} TraceFormat;
+
+	bool nextRecord(MirandaTraceRecord* rec);
+	void advanceWindow();
+
+	Output* out;
+	TraceFormat format;
+
+	int fd;
+	const uint8_t* mapBase;
+	uint64_t mapLength;
+	uint64_t cursor;
+	uint64_t recordSize;
+	uint64_t prefetchedTo;
+	uint64_t releasedTo;
+	uint64_t blockSize;
+	uint64_t pageSize;
+
+	uint64_t replayed;
+	uint64_t maxRequests;
+	uint64_t addressLimit;
+	uint32_t recordsPerStep;
+
+	bool timing;
+	bool started;
+	double timeScale;
+	double instructionTime;
+	double lastRelease;
+	uint64_t lastInstruction;
+
+	Statistic<uint64_t>* statReplayed;
+	Statistic<uint64_t>* statDepsDropped;
+	Statistic<uint64_t>* statStalls;
+};
+
+}
+}
+
+#endif
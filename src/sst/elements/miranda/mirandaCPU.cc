@@ -39,6 +39,7 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 	maxRequestsPending[CUSTOM] = params.find<uint32_t>("maxcustommemreqpending", 16);
 
         requestsPending[READ] = requestsPending[WRITE] = requestsPending[CUSTOM] = 0;
+	registeredRequests = readyRequests = pendingFences = 0;
 
 	out->verbose(CALL_INFO, 1, 0, "Configured CPU to allow %" PRIu32 " maximum Load requests to be memory to be outstanding.\n",
 		maxRequestsPending[READ]);
@@ -168,6 +169,14 @@ RequestGenCPU::RequestGenCPU(SST::ComponentId_t id, SST::Params& params) :
 }
 
 RequestGenCPU::~RequestGenCPU() {
+	for(MemoryOpRequest* req : memOpPool) {
+		delete req;
+	}
+
+	for(FenceOpRequest* req : fencePool) {
+		delete req;
+	}
+
 	delete out;
 }
 
@@ -178,6 +187,93 @@ void RequestGenCPU::init(unsigned int phase) {
     cache_link->init(phase);
 }
 
+// Add requests the generator has queued since the last call to the dependency graph
+void RequestGenCPU::registerRequests() {
+	for(; registeredRequests < pendingRequests.size(); ++registeredRequests) {
+		GeneratorRequest* req = pendingRequests.at(registeredRequests);
+
+		if(REQ_FENCE == req->getOperation()) {
+			pendingFences++;
+			continue;
+		}
+
+		for(const uint64_t producer : req->getDependencies()) {
+			dependents[producer].push_back(req);
+		}
+
+		if(req->canIssue()) {
+			readyRequests++;
+		}
+	}
+}
+
+// Append the generator's batch to the window using pooled request objects
+void RequestGenCPU::queueBatch() {
+	GeneratorHistory& history = genBatch.getHistory();
+
+	for(uint32_t i = 0; i < genBatch.size(); ++i) {
+		const GeneratorRecord& rec = genBatch.at(i);
+		GeneratorRequest* req;
+
+		if(REQ_FENCE == rec.op) {
+			FenceOpRequest* fence;
+
+			if(fencePool.empty()) {
+				fence = new FenceOpRequest();
+			} else {
+				fence = fencePool.back();
+				fencePool.pop_back();
+				fence->reset();
+			}
+
+			req = fence;
+		} else {
+			MemoryOpRequest* memOp;
+
+			if(memOpPool.empty()) {
+				memOp = new MemoryOpRequest(rec.addr, rec.length, (ReqOperation) rec.op);
+			} else {
+				memOp = memOpPool.back();
+				memOpPool.pop_back();
+				memOp->reset(rec.addr, rec.length, (ReqOperation) rec.op);
+			}
+
+			// A producer from an earlier batch which has already completed is satisfied
+			for(uint64_t back = (uint64_t) rec.depOffset + rec.depCount; back > rec.depOffset; --back) {
+				if(history.holds(back)) {
+					const uint64_t producer = history.lookup(back);
+
+					if(liveRequests.count(producer) > 0) {
+						memOp->addDependency(producer);
+					}
+				}
+			}
+
+			liveRequests.insert(memOp->getRequestID());
+			req = memOp;
+		}
+
+		history.append(req->getRequestID());
+		pendingRequests.push_back(req);
+	}
+}
+
+// Requests leaving the window go back to the pools, custom requests are not pooled
+void RequestGenCPU::retireRequest(GeneratorRequest* req) {
+	switch(req->getOperation()) {
+	case READ:
+	case WRITE:
+		memOpPool.push_back(static_cast<MemoryOpRequest*>(req));
+		break;
+	case REQ_FENCE:
+		fencePool.push_back(static_cast<FenceOpRequest*>(req));
+		break;
+	default:
+		delete req;
+		break;
+	}
+}
+
 void RequestGenCPU::handleSrcEvent( Event* ev ) {
 
 	MirandaReqEvent* event = static_cast<MirandaReqEvent*>(ev);
@@ -241,9 +337,19 @@ void RequestGenCPU::handleEvent( Interfaces::StandardMem::Request* ev) {
 			out->verbose(CALL_INFO, 4, 0, "-> Entry has all parts satisfied, removing ID=%" PRIu64 ", total processing time: %" PRIu64 "ns\n",
 				cpuReq->getOriginalReqID(), (getCurrentSimTimeNano() - cpuReq->getIssueTime()));
 
-			// Notify every pending request that there may be a satisfied dependency
-			for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
-				pendingRequests.at(i)->satisfyDependency(cpuReq->getOriginalReqID());
+			// Wake only the requests which wait on this one
+			registerRequests();
+			liveRequests.erase(cpuReq->getOriginalReqID());
+
+			std::unordered_map<uint64_t, std::vector<GeneratorRequest*>>::iterator waiting = dependents.find(cpuReq->getOriginalReqID());
+			if(waiting != dependents.end()) {
+				for(GeneratorRequest* consumer : waiting->second) {
+					if(consumer->satisfyEdge()) {
+						readyRequests++;
+					}
+				}
+
+				dependents.erase(waiting);
 			}
 
 			delete cpuReq;
@@ -437,18 +543,33 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     bool issued = false;
     uint32_t reqsIssuedThisCycle = 0;
-    std::vector<uint32_t> delReqs;
+    delReqs.clear();
 
     // We need to generate at least as many requests as can be looked up in the OoO window
     // otherwise the issue will have starvation.
-    for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
-        if( reqGen->isFinished()) {
-            break;
-    	} else {
-            reqGen->generate(&pendingRequests);
-    	}
+    if(reqGen->supportsBatch()) {
+        // One call generates everything the per-request loop below would
+        if(pendingRequests.size() < maxOpLookup && !reqGen->isFinished()) {
+            genBatch.clear();
+            reqGen->generateBatch(&genBatch, maxOpLookup - pendingRequests.size());
+            queueBatch();
+        }
+    } else {
+        for(int i = pendingRequests.size(); i < maxOpLookup; ++i) {
+            if( reqGen->isFinished()) {
+                break;
+            } else {
+                reqGen->generate(&pendingRequests);
+            }
+        }
     }
 
+    registerRequests();
+
+    // Entries not yet passed in this cycle's scan which could issue or stop the scan
+    uint32_t readyAhead = readyRequests;
+    uint32_t fencesAhead = pendingFences;
+
     for(uint32_t i = 0; i < pendingRequests.size(); ++i) {
         if(reqsIssuedThisCycle == reqMaxPerCycle) {
             statMaxIssuePerCycle->addData(1);
@@ -463,18 +584,37 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
             break;
     	}
 
+        // Everything left is waiting on a dependency and no load/store slot is full, so the
+        // rest of the scan would issue nothing; only the reorder limit may still be reached
+        if(0 == readyAhead && 0 == fencesAhead &&
+                (requestsPending[READ] < maxRequestsPending[READ]) &&
+                (requestsPending[WRITE] < maxRequestsPending[WRITE])) {
+            if(pendingRequests.size() > maxOpLookup) {
+                out->verbose(CALL_INFO, 2, 0, "Hit maximum reorder limit this cycle, no further operations will issue.\n");
+                statCyclesHitReorderLimit->addData(1);
+            }
+            break;
+        }
+
         MemoryOpRequest* memOpReq;
 	GeneratorRequest* nxtRq = pendingRequests.at(i);
 
+        if(nxtRq->getOperation() == REQ_FENCE) {
+            fencesAhead--;
+        } else if(nxtRq->canIssue()) {
+            readyAhead--;
+        }
+
 	if(nxtRq->getOperation() == REQ_FENCE) {
             if(0 == requestsInFlight.size()) {
 		out->verbose(CALL_INFO, 4, 0, "Fence operation completed, no pending requests, will be retired.\n");
 
                 // Keep record we will delete fence at i
     		delReqs.push_back(i);
+                pendingFences--;
 
-                // Delete the fence
-    		delete nxtRq;
+                // Retire the fence
+    		retireRequest(nxtRq);
             } else {
                 out->verbose(CALL_INFO, 4, 0, "Fence operation in flight (>0 pending requests), stall.\n");
             }
@@ -495,10 +635,11 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     		    // Keep record we will delete at index i
                     delReqs.push_back(i);
+                    readyRequests--;
 
                     issueCustomRequest(static_cast<CustomOpRequest*>(nxtRq));
 
-                    delete nxtRq;
+                    retireRequest(nxtRq);
                 }
             }
         } else if ( ( memOpReq = dynamic_cast<MemoryOpRequest*>(nxtRq) ) ) {
@@ -516,10 +657,11 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
 
     		    // Keep record we will delete at index i
                     delReqs.push_back(i);
+                    readyRequests--;
 
                     issueRequest(memOpReq);
 
-                    delete nxtRq;
+                    retireRequest(nxtRq);
 		} else {
                     out->verbose(CALL_INFO, 4, 0, "Request %" PRIu64 " in queue, has dependencies which are not satisfied, wait.\n",
                             nxtRq->getRequestID());
@@ -534,6 +676,7 @@ bool RequestGenCPU::clockTick(SST::Cycle_t cycle) {
     }
 
     pendingRequests.erase(delReqs);
+    registeredRequests -= delReqs.size();
 
     if(issued) {
 	statCyclesWithIssue->addData(1);
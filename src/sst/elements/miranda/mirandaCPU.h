@@ -20,6 +20,9 @@
 #include <sst/core/interfaces/stdMem.h>
 #include <sst/core/statapi/stataccumulator.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 #include "mirandaGenerator.h"
 #include "mirandaEvent.h"
 #include "mirandaMemMgr.h"
@@ -135,6 +138,9 @@ private:
     void issueRequest(MemoryOpRequest* req);
     void issueCustomRequest(CustomOpRequest* req);
     void handleSrcEvent( SST::Event* );
+    void registerRequests();
+    void queueBatch();
+    void retireRequest(GeneratorRequest* req);
 
     Output* out;
 
@@ -148,6 +154,26 @@ private:
     StdMemHandler* stdMemHandlers;
 
     MirandaRequestQueue<GeneratorRequest*> pendingRequests;
+
+    // Dependency graph over the request window: reverse edges from each producer's
+    // request ID to the requests waiting on it, plus counts of the window's entries
+    // that can issue now and of fences, so issue can stop scanning once nothing
+    // further back could change the outcome of the cycle.
+    std::unordered_map<uint64_t, std::vector<GeneratorRequest*>> dependents;
+    uint32_t registeredRequests;
+    uint32_t readyRequests;
+    uint32_t pendingFences;
+    std::vector<uint32_t> delReqs;
+
+    // Batched generation: records are turned into requests recycled from these
+    // pools once issued, so steady-state generation does not allocate
+    GeneratorBatch genBatch;
+    std::vector<MemoryOpRequest*> memOpPool;
+    std::vector<FenceOpRequest*> fencePool;
+
+    // Request IDs of batched requests which have not completed, a dependency on
+    // an earlier batch's record is only added while its producer is in here
+    std::unordered_set<uint64_t> liveRequests;
     MirandaMemoryManager* memMgr;
 
     uint32_t maxRequestsPending[OPCOUNT];
@@ -0,0 +1,176 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "mirandaGenBench.h"
+
+using namespace SST::Miranda;
+
+GeneratorBenchmark::GeneratorBenchmark(SST::ComponentId_t id, SST::Params& params) :
+	Component(id) {
+
+	const int verbose = params.find<int>("verbose", 0);
+	out = new Output("GeneratorBenchmark[@p:@l]: ", verbose, 0, SST::Output::STDOUT);
+
+	genName = params.find<std::string>("generator", "miranda.SingleStreamGenerator");
+	genParams = params.get_scoped_params("generatorParams");
+	batchSteps = params.find<uint32_t>("batchsteps", 16);
+
+	if(0 == batchSteps) {
+		out->fatal(CALL_INFO, -1, "Error: batchsteps must be at least 1\n");
+	}
+
+	// Two instances with identical parameters so each interface sees the same stream
+	singleGen = loadAnonymousSubComponent<RequestGenerator>(genName, "generator", 0,
+		ComponentInfo::SHARE_NONE, genParams);
+	batchGen = loadAnonymousSubComponent<RequestGenerator>(genName, "generator", 1,
+		ComponentInfo::SHARE_NONE, genParams);
+
+	if(NULL == singleGen || NULL == batchGen) {
+		out->fatal(CALL_INFO, -1, "Failed to load generator: %s\n", genName.c_str());
+	}
+}
+
+GeneratorBenchmark::~GeneratorBenchmark() {
+	delete singleGen;
+	delete batchGen;
+	delete out;
+}
+
+// Mix an operation into the checksum so both interfaces can be compared
+static inline uint64_t mixRequest(const uint64_t sum, const uint64_t addr, const uint64_t length, const uint32_t op,
+		const uint32_t depCount) {
+	return (sum * 31) + addr + (length << 2) + op + ((uint64_t) depCount << 40);
+}
+
+// Dependencies are mixed in as the distance back in the stream to the producer,
+// request IDs differ between the two generator instances but distances do not
+static inline uint64_t mixDependency(const uint64_t sum, const uint64_t distance) {
+	return (sum * 31) + distance;
+}
+
+// Number of most recent request IDs kept to resolve the per-request interface's
+// dependencies to distances
+#define BENCH_ID_HISTORY 4096
+
+// Distance back from the next request to the request with ID id, 0 if it is not
+// among the most recent requests
+static uint64_t distanceTo(const std::vector<uint64_t>& recentIDs, const uint64_t produced, const uint64_t id) {
+	const uint64_t limit = std::min(produced, (uint64_t) recentIDs.size());
+
+	for(uint64_t back = 1; back <= limit; ++back) {
+		if(recentIDs[(produced - back) % recentIDs.size()] == id) {
+			return back;
+		}
+	}
+
+	return 0;
+}
+
+GeneratorBenchmark::BenchResult GeneratorBenchmark::runSingle(RequestGenerator* gen) {
+	MirandaRequestQueue<GeneratorRequest*> q;
+	BenchResult result = { 0, 0, 0.0 };
+	std::vector<uint64_t> recentIDs(BENCH_ID_HISTORY, 0);
+
+	const auto start = std::chrono::steady_clock::now();
+
+	while(!gen->isFinished()) {
+		gen->generate(&q);
+
+		for(uint32_t i = 0; i < q.size(); ++i) {
+			GeneratorRequest* req = q.at(i);
+			MemoryOpRequest* memOp = dynamic_cast<MemoryOpRequest*>(req);
+
+			const std::vector<uint64_t>& deps = req->getDependencies();
+
+			if(NULL != memOp) {
+				result.checksum = mixRequest(result.checksum, memOp->getAddress(), memOp->getLength(), req->getOperation(), deps.size());
+			} else {
+				result.checksum = mixRequest(result.checksum, 0, 0, req->getOperation(), deps.size());
+			}
+
+			for(const uint64_t producer : deps) {
+				result.checksum = mixDependency(result.checksum, distanceTo(recentIDs, result.requests + i, producer));
+			}
+
+			recentIDs[(result.requests + i) % recentIDs.size()] = req->getRequestID();
+			delete req;
+		}
+
+		result.requests += q.size();
+		q.clear();
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+GeneratorBenchmark::BenchResult GeneratorBenchmark::runBatch(RequestGenerator* gen) {
+	GeneratorBatch batch;
+	BenchResult result = { 0, 0, 0.0 };
+
+	const auto start = std::chrono::steady_clock::now();
+
+	while(!gen->isFinished()) {
+		batch.clear();
+		gen->generateBatch(&batch, batchSteps);
+
+		for(uint32_t i = 0; i < batch.size(); ++i) {
+			const GeneratorRecord& rec = batch.at(i);
+			result.checksum = mixRequest(result.checksum, rec.addr, rec.length, rec.op, rec.depCount);
+
+			// the same order as the producers appear in the request's dependency list
+			for(uint32_t d = 0; d < rec.depCount; ++d) {
+				result.checksum = mixDependency(result.checksum, rec.depOffset + rec.depCount - d);
+			}
+		}
+
+		result.requests += batch.size();
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+void GeneratorBenchmark::report(const char* mode, const BenchResult& result) {
+	const double rate = (result.seconds > 0.0) ? ((double) result.requests / result.seconds) : 0.0;
+
+	out->output("%s %-8s requests: %12" PRIu64 " time: %10.6f s rate: %10.3f Mreq/s\n",
+		genName.c_str(), mode, result.requests, result.seconds, rate / 1.0e6);
+}
+
+void GeneratorBenchmark::setup() {
+	const BenchResult single = runSingle(singleGen);
+	report("single", single);
+
+	if(batchGen->supportsBatch()) {
+		const BenchResult batched = runBatch(batchGen);
+		report("batched", batched);
+
+		if(single.requests != batched.requests || single.checksum != batched.checksum) {
+			out->fatal(CALL_INFO, -1, "Error: %s batched stream does not match the per-request stream\n", genName.c_str());
+		}
+
+		if(batched.seconds > 0.0) {
+			out->output("%s speedup: %.2fx\n", genName.c_str(), single.seconds / batched.seconds);
+		}
+	} else {
+		out->output("%s does not support batched generation\n", genName.c_str());
+	}
+}
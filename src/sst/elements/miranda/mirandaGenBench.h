@@ -0,0 +1,82 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SST_MIRANDA_GEN_BENCH
+#define _H_SST_MIRANDA_GEN_BENCH
+
+#include <sst/core/component.h>
+#include <sst/core/output.h>
+
+#include "mirandaGenerator.h"
+
+namespace SST {
+namespace Miranda {
+
+/*
+ * Drives a generator as fast as possible with no memory system attached and
+ * reports the request rate through the per-request generate() interface and,
+ * if the generator supports it, the batched generateBatch() interface. The
+ * measurement runs in setup so the simulation itself is empty.
+ */
+class GeneratorBenchmark : public SST::Component {
+public:
+	GeneratorBenchmark(SST::ComponentId_t id, SST::Params& params);
+	~GeneratorBenchmark();
+
+	void setup();
+
+	SST_ELI_REGISTER_COMPONENT(
+        GeneratorBenchmark,
+        "miranda",
+        "GeneratorBenchmark",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Measures requests per second produced by a Miranda generator",
+        COMPONENT_CATEGORY_PROCESSOR
+    )
+
+	SST_ELI_DOCUMENT_PARAMS(
+        { "verbose",      "Sets the verbosity of output produced by the benchmark", "0" },
+        { "generator",    "The generator to measure", "miranda.SingleStreamGenerator" },
+        { "generatorParams", "Parameters passed to the generator (prefix)", "" },
+        { "batchsteps",   "Generator steps requested per batched call", "16" }
+    )
+
+	SST_ELI_DOCUMENT_SUBCOMPONENT_SLOTS(
+        { "generator", "Generator instances, one for each interface measured", "SST::Miranda::RequestGenerator" }
+    )
+
+private:
+	typedef struct {
+		uint64_t requests;
+		uint64_t checksum;
+		double seconds;
+	} BenchResult;
+
+	BenchResult runSingle(RequestGenerator* gen);
+	BenchResult runBatch(RequestGenerator* gen);
+	void report(const char* mode, const BenchResult& result);
+
+	Output* out;
+	RequestGenerator* singleGen;
+	RequestGenerator* batchGen;
+	std::string genName;
+	Params genParams;
+	uint32_t batchSteps;
+};
+
+}
+}
+
+#endif
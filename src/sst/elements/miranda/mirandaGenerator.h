@@ -24,6 +24,7 @@
 #include <sst/core/interfaces/stdMem.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Miranda {
@@ -41,6 +42,7 @@ class GeneratorRequest {
 public:
 	GeneratorRequest() {
 		reqID = nextGeneratorRequestID++;
+		outstandingDeps = 0;
 	}
 
 	virtual ~GeneratorRequest() {}
@@ -49,6 +51,11 @@ public:
 
 	void addDependency(uint64_t depReq) {
 		dependsOn.push_back(depReq);
+		outstandingDeps++;
+	}
+
+	const std::vector<uint64_t>& getDependencies() const {
+		return dependsOn;
 	}
 
 	void satisfyDependency(const GeneratorRequest* req) {
@@ -61,13 +68,21 @@ public:
 		for(searchDeps = dependsOn.begin(); searchDeps != dependsOn.end(); searchDeps++) {
 			if( req == (*searchDeps) ) {
 				dependsOn.erase(searchDeps);
+				outstandingDeps--;
 				break;
 			}
 		}
 	}
 
-	bool canIssue() {
-		return dependsOn.empty();
+	// Used with reverse edges held by the CPU, the producer has already been
+	// matched so only the count changes. Returns true when the last one clears.
+	bool satisfyEdge() {
+		outstandingDeps--;
+		return 0 == outstandingDeps;
+	}
+
+	bool canIssue() const {
+		return 0 == outstandingDeps;
 	}
 
 	uint64_t getIssueTime() const {
@@ -78,19 +93,33 @@ public:
 		issueTime = now;
 	}
 protected:
+	// Give a recycled request a fresh identity
+	void resetRequest() {
+		reqID = nextGeneratorRequestID++;
+		dependsOn.clear();
+		outstandingDeps = 0;
+	}
+
 	uint64_t reqID;
 	uint64_t issueTime;
 	std::vector<uint64_t> dependsOn;
+	uint32_t outstandingDeps;
 private:
 	static std::atomic<uint64_t> nextGeneratorRequestID;
 };
 
+/*
+ * Request window as a ring buffer. Capacity is a power of two and only grows,
+ * erase compacts in place so retiring requests from the front of the window
+ * moves only the entries ahead of the last one removed.
+ */
 template<typename QueueType>
 class MirandaRequestQueue {
 public:
        	MirandaRequestQueue() {
                         theQ = (QueueType*) malloc(sizeof(QueueType) * 16);
                         maxCapacity = 16;
+                        head = 0;
                         curSize = 0;
                 }
         ~MirandaRequestQueue() {
@@ -102,75 +131,81 @@ public:
         }
 
         void resize(const uint32_t newSize) {
-//		printf("Resizing MirandaQueue from: %" PRIu32 " to %" PRIu32 "\n",
-//			curSize, newSize);
+                uint32_t newCapacity = 16;
+                while(newCapacity < newSize) {
+                        newCapacity *= 2;
+                }
+
+               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newCapacity);
+                curSize = std::min(curSize, newCapacity);
 
-               	QueueType * newQ = (QueueType *) malloc(sizeof(QueueType) * newSize);
                	for(uint32_t i = 0; i < curSize; ++i) {
-                       	newQ[i] = theQ[i];
+                       	newQ[i] = at(i);
                 }
 
                 free(theQ);
                	theQ = newQ;
-               	maxCapacity = newSize;
-               	curSize = std::min(curSize, newSize);
+               	maxCapacity = newCapacity;
+                head = 0;
         }
 
 	uint32_t size() const {
 		return curSize;
 	}
 
+	// Drops the entries without freeing them
+	void clear() {
+		head = 0;
+		curSize = 0;
+	}
+
 	uint32_t capacity() const {
 		return maxCapacity;
 	}
 
-       	QueueType at(const uint32_t index) {
-               	return theQ[index];
+       	QueueType at(const uint32_t index) const {
+               	return theQ[(head + index) & (maxCapacity - 1)];
        	}
 
-       	void erase(const std::vector<uint32_t> eraseList) {
+        // eraseList must be in increasing order
+       	void erase(const std::vector<uint32_t>& eraseList) {
 		if(0 == eraseList.size()) {
 			return;
 		}
 
-               	QueueType* newQ = (QueueType*) malloc(sizeof(QueueType) * maxCapacity);
-
-               	uint32_t nextSkipIndex = 0;
-               	uint32_t nextSkip = eraseList.at(nextSkipIndex);
-                uint32_t nextNewQIndex = 0;
-
-               	for(uint32_t i = 0; i < curSize; ++i) {
-                       	if(nextSkip == i) {
-                                nextSkipIndex++;
-
-                                if(nextSkipIndex >= eraseList.size()) {
-                                       	nextSkip = curSize;
-                               	} else {
-                                       	nextSkip = eraseList.at(nextSkipIndex);
-                                }
-                       	} else {
-                               	newQ[nextNewQIndex] = theQ[i];
-                                nextNewQIndex++;
-                       	}
-               	}
-
-                free(theQ);
+                // Walk back from the last erased index sliding kept entries towards it
+                uint32_t nextErase = eraseList.size();
+                uint32_t dest = eraseList.back();
+
+                for(uint32_t i = eraseList.back() + 1; i-- > 0; ) {
+                        if(nextErase > 0 && eraseList[nextErase - 1] == i) {
+                                nextErase--;
+                        } else {
+                                slot(dest) = slot(i);
+                                dest--;
+                        }
+                }
 
-               	theQ = newQ;
-		curSize = nextNewQIndex;
+                head = (head + eraseList.size()) & (maxCapacity - 1);
+		curSize -= eraseList.size();
         }
 
 	void push_back(QueueType t) {
                 if(curSize == maxCapacity) {
-                        resize(maxCapacity + 16);
+                        resize(maxCapacity * 2);
                 }
 
-                theQ[curSize] = t;
+                slot(curSize) = t;
                 curSize++;
         }
 private:
+        QueueType& slot(const uint32_t index) {
+                return theQ[(head + index) & (maxCapacity - 1)];
+        }
+
         QueueType* theQ;
         uint32_t maxCapacity;
+        uint32_t head;
         uint32_t curSize;
 };
 
@@ -182,6 +217,12 @@ public:
 		GeneratorRequest(),
 		addr(cAddr), length(cLength), op(cOpType) {}
 	~MemoryOpRequest() {}
+	void reset(const uint64_t cAddr, const uint64_t cLength, const ReqOperation cOpType) {
+		resetRequest();
+		addr = cAddr;
+		length = cLength;
+		op = cOpType;
+	}
 	ReqOperation getOperation() const { return op; }
 	bool isRead() const { return op == READ; }
 	bool isWrite() const { return op == WRITE; }
@@ -212,9 +253,126 @@ class FenceOpRequest : public GeneratorRequest {
 public:
 	FenceOpRequest() : GeneratorRequest() {}
 	~FenceOpRequest() {}
+	void reset() { resetRequest(); }
 	ReqOperation getOperation() const { return REQ_FENCE; }
 };
 
+/*
+ * Number of most recent records whose request IDs are remembered so that a
+ * record can depend on a record generated in an earlier batch, a power of two.
+ */
+#define MIRANDA_DEP_HISTORY 4096
+
+/*
+ * Compact form of a generated operation. Rather than holding request IDs a
+ * record depends on depCount consecutive records, the last of which sits
+ * depOffset records before it (0 being the record immediately before), which
+ * covers the read-then-write groups the generators emit. The producers may be
+ * in an earlier batch but must be within the last MIRANDA_DEP_HISTORY records.
+ */
+typedef struct {
+	uint64_t addr;
+	uint32_t length;
+	uint16_t op;
+	uint16_t depCount;
+	uint32_t depOffset;
+} GeneratorRecord;
+
+/*
+ * Request IDs of the most recently generated records, kept across batches so
+ * that dependencies can name producers handed out in an earlier batch.
+ */
+class GeneratorHistory {
+public:
+	GeneratorHistory() : ids(MIRANDA_DEP_HISTORY, 0), appended(0) {}
+
+	// True if the record back records before the next one is still remembered
+	bool holds(const uint64_t back) const {
+		return back > 0 && back <= MIRANDA_DEP_HISTORY && back <= appended;
+	}
+
+	// Request ID of the record back records before the next one, 1 being the last
+	uint64_t lookup(const uint64_t back) const {
+		return ids[(appended - back) & (MIRANDA_DEP_HISTORY - 1)];
+	}
+
+	void append(const uint64_t id) {
+		ids[appended & (MIRANDA_DEP_HISTORY - 1)] = id;
+		appended++;
+	}
+
+private:
+	std::vector<uint64_t> ids;
+	uint64_t appended;
+};
+
+/*
+ * Record array filled by RequestGenerator::generateBatch. The storage is kept
+ * between batches so steady-state generation does not allocate.
+ */
+class GeneratorBatch {
+public:
+	GeneratorBatch() : count(0) {
+		records.resize(256);
+	}
+
+	void clear() { count = 0; }
+	uint32_t size() const { return count; }
+	const GeneratorRecord& at(const uint32_t index) const { return records[index]; }
+
+	void push(const uint64_t addr, const uint32_t length, const ReqOperation op,
+			const uint16_t depCount = 0, const uint32_t depOffset = 0) {
+		if(count == records.size()) {
+			records.resize(records.size() * 2);
+		}
+
+		GeneratorRecord& rec = records[count++];
+		rec.addr = addr;
+		rec.length = length;
+		rec.op = (uint16_t) op;
+		rec.depCount = depCount;
+		rec.depOffset = depOffset;
+	}
+
+	void pushFence() {
+		push(0, 0, REQ_FENCE);
+	}
+
+	// Request IDs given to the records of earlier batches, the consumer of the
+	// batch appends the ID of every record it turns into a request
+	GeneratorHistory& getHistory() { return history; }
+
+	// Convert to heap allocated requests for callers of the per-request interface.
+	// A producer from an earlier batch may already have completed, the caller
+	// must treat a dependency on a completed request as satisfied.
+	void queueRequests(MirandaRequestQueue<GeneratorRequest*>* q) {
+		for(uint32_t i = 0; i < count; ++i) {
+			const GeneratorRecord& rec = records[i];
+			GeneratorRequest* req;
+
+			if(REQ_FENCE == rec.op) {
+				req = new FenceOpRequest();
+			} else {
+				req = new MemoryOpRequest(rec.addr, rec.length, (ReqOperation) rec.op);
+
+				for(uint64_t back = (uint64_t) rec.depOffset + rec.depCount; back > rec.depOffset; --back) {
+					if(history.holds(back)) {
+						req->addDependency(history.lookup(back));
+					}
+				}
+			}
+
+			history.append(req->getRequestID());
+			q->push_back(req);
+		}
+	}
+
+private:
+	std::vector<GeneratorRecord> records;
+	uint32_t count;
+	GeneratorHistory history;
+};
+
 class RequestGenerator : public SubComponent {
 
 public:
@@ -222,10 +380,26 @@ public:
 
 	RequestGenerator( ComponentId_t id, Params& params) : SubComponent(id) {}
 	~RequestGenerator() {}
-	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* q) { }
 	virtual bool isFinished() { return true; }
 	virtual void completed() { }
 
+	// Batched interface. A generator which supports it appends the records of
+	// up to maxSteps steps (a step being what one generate() call queues) to
+	// batch, stopping early once finished, and returns the steps performed.
+	virtual bool supportsBatch() const { return false; }
+	virtual uint32_t generateBatch(GeneratorBatch* batch, const uint32_t maxSteps) { return 0; }
+
+	virtual void generate(MirandaRequestQueue<GeneratorRequest*>* q) {
+		if(supportsBatch()) {
+			legacyBatch.clear();
+			generateBatch(&legacyBatch, 1);
+			legacyBatch.queueRequests(q);
+		}
+	}
+
+private:
+	GeneratorBatch legacyBatch;
+
 };
 
 }
@@ -26,3 +26,4 @@
 #include "generators/stencil3dbench.h"
 #include "generators/streambench.h"
 #include "generators/streambench_customcmd.h"
+#include "generators/tracegen.h"
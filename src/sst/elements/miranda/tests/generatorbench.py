@@ -0,0 +1,47 @@
+import sst
+import sys
+
+# Requests per second for each generator through the per-request and batched
+# interfaces. No memory system is attached, the measurement runs during setup.
+# The benchmark fails if the two interfaces produce different streams, a
+# --scale=N argument divides the request counts by N for a quick check.
+#
+#   sst generatorbench.py [-- --scale=N]
+
+scale = 1
+for arg in sys.argv[1:]:
+	if arg.startswith("--scale="):
+		scale = max(1, int(arg[len("--scale="):]))
+
+sst.setProgramOption("timebase", "1ps")
+
+benchmarks = {
+	"miranda.STREAMBenchGenerator" : {
+		"n" : 2000000 // scale,
+		"n_per_call" : 1,
+	},
+	"miranda.Stencil3DBenchGenerator" : {
+		"nx" : 64,
+		"ny" : 64,
+		"nz" : 64,
+		"startz" : 0,
+		"endz" : 64,
+		"iterations" : max(1, 2 // scale),
+	},
+	"miranda.GUPSGenerator" : {
+		"count" : 2000000 // scale,
+		"max_address" : 512 * 1024 * 1024,
+	},
+	"miranda.RandomGenerator" : {
+		"count" : 2000000 // scale,
+		"max_address" : 512 * 1024 * 1024,
+	},
+}
+
+for name, genParams in benchmarks.items():
+	bench = sst.Component("bench_" + name.split(".")[1], "miranda.GeneratorBenchmark")
+	bench.addParams({
+		"generator" : name,
+		"batchsteps" : 16,
+	})
+	bench.addParams(dict(("generatorParams." + k, v) for k, v in genParams.items()))
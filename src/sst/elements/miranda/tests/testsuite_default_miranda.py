@@ -3,6 +3,10 @@
 from sst_unittest import *
 from sst_unittest_support import *
 
+import os
+import re
+import struct
+
 
 class testcase_miranda_Component(SSTTestCase):
 
@@ -44,6 +48,12 @@ class testcase_miranda_Component(SSTTestCase):
     def test_miranda_gupsgen(self):
         self.miranda_test_template("gupsgen")
 
+    def test_miranda_generatorbench(self):
+        self.miranda_generatorbench_template(scale=20)
+
+    def test_miranda_tracegen(self):
+        self.miranda_tracegen_template()
+
 #####
 
     def miranda_test_template(self, testcase, testtimeout=240):
@@ -79,4 +89,84 @@ class testcase_miranda_Component(SSTTestCase):
         if (cmp_result == False):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
-        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
\ No newline at end of file
+        self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    # generatorbench.py drives each generator through the per-request and the
+    # batched interface, GeneratorBenchmark stops the simulation with an error
+    # if the two streams differ. The rates vary from run to run so instead of a
+    # reference file check every generator reported both streams with the same
+    # number of requests.
+    def miranda_generatorbench_template(self, scale, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_miranda_generatorbench"
+
+        sdlfile = "{0}/generatorbench.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        otherargs = '--model-options=\"--scale={0}\"'.format(scale)
+
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+
+        requests = {}
+        with open(outfile, 'r') as f:
+            for line in f.readlines():
+                self.assertFalse("does not match" in line, "miranda generatorbench: {0}".format(line.strip()))
+                found = re.search(r'(miranda\.\w+) (single|batched)\s+requests:\s+(\d+)', line)
+                if found:
+                    requests.setdefault(found.group(1), {})[found.group(2)] = int(found.group(3))
+
+        self.assertTrue(len(requests) > 0, "miranda generatorbench: no results in {0}".format(outfile))
+        for gen, counts in requests.items():
+            self.assertTrue(counts.get("single", 0) > 0, "miranda generatorbench: {0} generated no requests".format(gen))
+            self.assertTrue("batched" in counts, "miranda generatorbench: {0} has no batched stream".format(gen))
+            self.assertEqual(counts["single"], counts["batched"],
+                "miranda generatorbench: {0} batched {1} requests, per-request {2}".format(gen, counts["batched"], counts["single"]))
+
+    # tracegen.py replays a Prospero binary trace written here directly, and
+    # again after sst-miranda-traceconvert has turned it into a miranda trace.
+    # Without read-modify-write dependencies and think time the two replays
+    # must produce the same statistics.
+    def miranda_tracegen_template(self, testtimeout=240):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        # Make sure we have access to the sst-miranda-traceconvert binary
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        traceconvert_app = "{0}/sst-miranda-traceconvert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(traceconvert_app), "miranda tracegen - Cannot find {0}".format(traceconvert_app))
+
+        # Prospero binary record: instruction count, 'R' or 'W', address, size
+        prosperotrace = "{0}/test_miranda_tracegen.trace".format(tmpdir)
+        with open(prosperotrace, 'wb') as f:
+            for i in range(20000):
+                op = b'W' if (i % 4) == 3 else b'R'
+                f.write(struct.pack('=QcQI', i * 10, op, (i * 64) % (4 * 1024 * 1024), 8))
+
+        mirandatrace = "{0}/test_miranda_tracegen.mtr".format(tmpdir)
+        cmd = "{0} --rmw-window 0 {1} {2}".format(traceconvert_app, prosperotrace, mirandatrace)
+        rtn = OSCommand(cmd, set_cwd=tmpdir).run()
+        log_debug("sst-miranda-traceconvert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-miranda-traceconvert failed on {0}".format(prosperotrace))
+
+        sdlfile = "{0}/tracegen.py".format(test_path)
+        outfiles = []
+        for mode, trace in (("prospero", prosperotrace), ("miranda", mirandatrace)):
+            testDataFileName = "test_miranda_tracegen_{0}".format(mode)
+            outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+            errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+            otherargs = '--model-options=\"{0}\"'.format(trace)
+
+            self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+            testing_remove_component_warning_from_file(outfile)
+            outfiles.append(outfile)
+
+        cmp_result = testing_compare_sorted_diff("tracegen", outfiles[1], outfiles[0])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data("tracegen")
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Converted trace output {0} does not match the Prospero trace output {1}".format(outfiles[1], outfiles[0]))
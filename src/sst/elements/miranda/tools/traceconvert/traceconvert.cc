@@ -0,0 +1,250 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Converts address traces to the compact format replayed by
+// miranda.TraceGenerator (see generators/mirandatrace.h). Inputs are Prospero
+// binary or text traces, where think time comes from the instruction counts,
+// and cacheTracer logs, where it comes from the event timestamps. A write to
+// an address read shortly before can be made to depend on that read.
+
+#include "sst_config.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#include "generators/mirandatrace.h"
+
+typedef enum {
+    PROSPERO_BINARY,
+    PROSPERO_TEXT,
+    CACHE_TRACER
+} input_format;
+
+typedef struct {
+    uint64_t time;      // instruction count or nanoseconds
+    uint64_t addr;
+    uint32_t length;
+    uint8_t op;
+} input_record;
+
+static void
+usage()
+{
+    fprintf(stderr, "usage: sst-miranda-traceconvert [options] <input> <output>\n");
+    fprintf(stderr, "  --format <fmt>            prospero (binary, default), prospero-text or cachetracer\n");
+    fprintf(stderr, "  --instruction-time <ns>   think time per instruction for Prospero traces (default 0)\n");
+    fprintf(stderr, "  --line-size <bytes>       request length for cacheTracer events (default 64)\n");
+    fprintf(stderr, "  --rmw-window <records>    make a write depend on a read of the same address at most\n");
+    fprintf(stderr, "                            this many records earlier, 0 disables (default 32, max 255)\n");
+}
+
+// Returns 1 for a record, 0 to skip the input and -1 at the end
+static int
+read_record(FILE* in, input_format format, uint32_t line_size, input_record* rec)
+{
+    if ( PROSPERO_BINARY == format ) {
+        uint8_t buffer[sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t)];
+
+        if ( sizeof(buffer) != fread(buffer, 1, sizeof(buffer), in) ) return -1;
+
+        char op;
+        memcpy(&rec->time, buffer, sizeof(uint64_t));
+        memcpy(&op, buffer + sizeof(uint64_t), sizeof(char));
+        memcpy(&rec->addr, buffer + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+        memcpy(&rec->length, buffer + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+        rec->op = ('W' == op) ? MIRANDA_TRACE_OP_WRITE : MIRANDA_TRACE_OP_READ;
+        return 1;
+    }
+
+    char line[512];
+    if ( NULL == fgets(line, sizeof(line), in) ) return -1;
+
+    if ( PROSPERO_TEXT == format ) {
+        unsigned long long time, addr;
+        char op;
+        unsigned int length;
+
+        if ( 4 != sscanf(line, "%llu %c %llu %u", &time, &op, &addr, &length) ) return 0;
+
+        rec->time = time;
+        rec->addr = addr;
+        rec->length = length;
+        rec->op = ('W' == op) ? MIRANDA_TRACE_OP_WRITE : MIRANDA_TRACE_OP_READ;
+        return 1;
+    }
+
+    // cacheTracer: "NB: Addr: 0x<decimal> timestamp: <n> Cmd: <n> ... @<n> ns", only the
+    // requests arriving from above are replayed
+    unsigned long long addr, timestamp;
+    unsigned int cmd;
+
+    if ( 3 != sscanf(line, "NB: Addr: 0x%llu timestamp: %llu Cmd: %u", &addr, &timestamp, &cmd) ) return 0;
+
+    const char* at = strrchr(line, '@');
+    if ( NULL == at ) return 0;
+
+    // memHierarchy command numbering: GetS = 1, GetX = 2, GetSX = 3, Write = 4
+    if ( 1 == cmd || 3 == cmd ) {
+        rec->op = MIRANDA_TRACE_OP_READ;
+    } else if ( 2 == cmd || 4 == cmd ) {
+        rec->op = MIRANDA_TRACE_OP_WRITE;
+    } else {
+        return 0;
+    }
+
+    rec->time = strtoull(at + 1, NULL, 10);
+    rec->addr = addr;
+    rec->length = line_size;
+    return 1;
+}
+
+int
+main(int argc, char* argv[])
+{
+    input_format format = PROSPERO_BINARY;
+    double instruction_time = 0.0;
+    uint32_t line_size = 64;
+    uint32_t rmw_window = 32;
+    const char* input_path = NULL;
+    const char* output_path = NULL;
+
+    for ( int i = 1; i < argc; i++ ) {
+        if ( strcmp(argv[i], "--format") == 0 && (i + 1) < argc ) {
+            const char* name = argv[++i];
+
+            if ( strcmp(name, "prospero") == 0 ) {
+                format = PROSPERO_BINARY;
+            } else if ( strcmp(name, "prospero-text") == 0 ) {
+                format = PROSPERO_TEXT;
+            } else if ( strcmp(name, "cachetracer") == 0 ) {
+                format = CACHE_TRACER;
+            } else {
+                fprintf(stderr, "Error: unknown input format %s\n", name);
+                return 1;
+            }
+        } else if ( strcmp(argv[i], "--instruction-time") == 0 && (i + 1) < argc ) {
+            instruction_time = strtod(argv[++i], NULL);
+        } else if ( strcmp(argv[i], "--line-size") == 0 && (i + 1) < argc ) {
+            line_size = (uint32_t) strtoul(argv[++i], NULL, 0);
+        } else if ( strcmp(argv[i], "--rmw-window") == 0 && (i + 1) < argc ) {
+            rmw_window = (uint32_t) strtoul(argv[++i], NULL, 0);
+            if ( rmw_window > MIRANDA_TRACE_MAX_DEP_BACK ) rmw_window = MIRANDA_TRACE_MAX_DEP_BACK;
+        } else if ( argv[i][0] == '-' && argv[i][1] != '\0' ) {
+            usage();
+            return 1;
+        } else if ( NULL == input_path ) {
+            input_path = argv[i];
+        } else if ( NULL == output_path ) {
+            output_path = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if ( NULL == input_path || NULL == output_path ) {
+        usage();
+        return 1;
+    }
+
+    FILE* in = fopen(input_path, (PROSPERO_BINARY == format) ? "rb" : "r");
+    if ( NULL == in ) {
+        fprintf(stderr, "Error: unable to open %s\n", input_path);
+        return 1;
+    }
+
+    FILE* out = fopen(output_path, "wb");
+    if ( NULL == out ) {
+        fprintf(stderr, "Error: unable to create %s\n", output_path);
+        fclose(in);
+        return 1;
+    }
+
+    MirandaTraceHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MIRANDA_TRACE_MAGIC, 8);
+    header.version = MIRANDA_TRACE_VERSION;
+    header.recordSize = sizeof(MirandaTraceRecord);
+    fwrite(&header, sizeof(header), 1, out);
+
+    // Most recent read of each address, dropped lazily once out of the window
+    std::unordered_map<uint64_t, uint64_t> last_read;
+    uint64_t count = 0;
+    uint64_t dependencies = 0;
+    uint64_t previous_time = 0;
+    input_record rec;
+    int status;
+
+    while ( (status = read_record(in, format, line_size, &rec)) >= 0 ) {
+        if ( 0 == status ) continue;
+
+        MirandaTraceRecord entry;
+        memset(&entry, 0, sizeof(entry));
+
+        const uint64_t elapsed = (count > 0 && rec.time > previous_time) ? (rec.time - previous_time) : 0;
+        const double gap = (CACHE_TRACER == format) ? (double) elapsed : elapsed * instruction_time;
+
+        entry.addr = rec.addr;
+        entry.gap = (gap > UINT32_MAX) ? UINT32_MAX : (uint32_t) gap;
+        entry.length = (rec.length > UINT16_MAX) ? UINT16_MAX : (uint16_t) rec.length;
+        entry.op = rec.op;
+        entry.depBack = 0;
+
+        if ( rmw_window > 0 ) {
+            if ( MIRANDA_TRACE_OP_READ == rec.op ) {
+                last_read[rec.addr] = count;
+            } else {
+                std::unordered_map<uint64_t, uint64_t>::iterator producer = last_read.find(rec.addr);
+
+                if ( producer != last_read.end() ) {
+                    if ( count - producer->second <= rmw_window ) {
+                        entry.depBack = (uint8_t) (count - producer->second);
+                        dependencies++;
+                    }
+                    last_read.erase(producer);
+                }
+            }
+
+            // Keep the table bounded on traces that rarely write
+            if ( last_read.size() > (size_t) rmw_window * 1024 ) {
+                for ( std::unordered_map<uint64_t, uint64_t>::iterator it = last_read.begin(); it != last_read.end(); ) {
+                    it = (count - it->second > rmw_window) ? last_read.erase(it) : std::next(it);
+                }
+            }
+        }
+
+        if ( 1 != fwrite(&entry, sizeof(entry), 1, out) ) {
+            fprintf(stderr, "Error: failed writing %s\n", output_path);
+            return 1;
+        }
+
+        previous_time = rec.time;
+        count++;
+    }
+
+    header.recordCount = count;
+    fseek(out, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, out);
+
+    fclose(in);
+    fclose(out);
+
+    printf("Converted %" PRIu64 " records (%" PRIu64 " with a dependency) into %s\n", count, dependencies, output_path);
+    return 0;
+}
@@ -66,6 +66,7 @@ class MemoryManagerOpal : public ArielComponent::ArielMemoryManager {
         void setDefaultPool(uint32_t pool);
         uint32_t getDefaultPool();
 
+        using ArielMemoryManager::translateAddress;
         uint64_t translateAddress(uint64_t virtAddr);
         void printStats();
 
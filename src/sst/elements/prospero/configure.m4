@@ -5,7 +5,9 @@ AC_DEFUN([SST_prospero_CONFIG], [
   prospero_happy="yes"
 
   SST_CHECK_LIBZ()
+  SST_CHECK_ZSTD()
   SST_CHECK_PINTOOL([have_pin=1],[have_pin=0],[])
+  SST_CHECK_PIN_LIBZ([],[],[AC_MSG_ERROR([libz built against the Pin CRT requested but not found])])
   SST_CHECK_SHM()
 
   AS_IF([test "$prospero_happy" = "yes"], [$1], [$2])
@@ -86,7 +86,8 @@ ProsperoComponent::ProsperoComponent(ComponentId_t id, Params& params) :
 	output->verbose(CALL_INFO, 1, 0, "Configuration of memory interface completed.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Reading first entry from the trace reader...\n");
-	currentEntry = reader->readNextEntry();
+	entryBatchIndex = 0;
+	currentEntry = nextEntry();
 	output->verbose(CALL_INFO, 1, 0, "Read of first entry complete.\n");
 
 	output->verbose(CALL_INFO, 1, 0, "Creating memory manager with page size %" PRIu64 "...\n", pageSize);
@@ -223,7 +224,7 @@ bool ProsperoComponent::tick(SST::Cycle_t currentCycle) {
 				issueRequest(currentEntry);
 
 				// Obtain the next newest request
-				currentEntry = reader->readNextEntry();
+				currentEntry = nextEntry();
 
 				// Trace reader has read all entries, time to begin draining
 				// the system, caches etc
@@ -327,7 +328,18 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 
 		currentOutstanding++;
 	}
+}
+
+// Entries are taken from the reader a batch at a time, the returned entry is
+// valid until the next call
+ProsperoTraceEntry* ProsperoComponent::nextEntry() {
+	if(entryBatchIndex >= entryBatch.size()) {
+		entryBatchIndex = 0;
+
+		if(!reader->readNextBatch(entryBatch)) {
+			return NULL;
+		}
+	}
 
-	// Delete this entry, we are done converting it into a request
-	delete entry;
+	return &entryBatch[entryBatchIndex++];
 }
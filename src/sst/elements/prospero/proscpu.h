@@ -83,10 +83,13 @@ private:
   void handleResponse( StandardMem::Request* ev );
   bool tick( Cycle_t );
   void issueRequest(const ProsperoTraceEntry* entry);
+  ProsperoTraceEntry* nextEntry();
 
   Output* output;
   ProsperoTraceReader* reader;
   ProsperoTraceEntry* currentEntry;
+  std::vector<ProsperoTraceEntry> entryBatch;
+  size_t entryBatchIndex;
   ProsperoMemoryManager* memMgr;
   StandardMem* cache_link;
   FILE* traceFile;
@@ -0,0 +1,406 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proslookaheadreader.h"
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Prospero;
+
+
+ProsperoLookaheadTraceReader::ProsperoLookaheadTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out), mapping(NULL), mappingLength(0), mappingOffset(0),
+	stopDecode(false), decodeEnded(false), partialRecordLength(0), singleIndex(0) {
+
+#ifdef HAVE_LIBZ
+	gzInput = NULL;
+#endif
+#ifdef HAVE_ZSTD
+	zstdInput = NULL;
+	zstdStream = NULL;
+	zstdInputEnded = false;
+#endif
+
+	std::string traceFile = params.find<std::string>("file", "");
+	std::string compressionName = params.find<std::string>("compression", "auto");
+	batchRecords = std::max((size_t) 1, (size_t) params.find<uint64_t>("batchrecords", 8192));
+	const uint32_t batchCount = std::max((uint32_t) 1, params.find<uint32_t>("batches", 2));
+
+	if("auto" == compressionName) {
+		FILE* probe = fopen(traceFile.c_str(), "rb");
+
+		if(NULL == probe) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in lookahead reader.\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		uint8_t magic[4] = { 0, 0, 0, 0 };
+		const size_t magicLength = fread(magic, 1, sizeof(magic), probe);
+		fclose(probe);
+
+		if(magicLength >= 2 && 0x1f == magic[0] && 0x8b == magic[1]) {
+			compressionName = "gzip";
+		} else if(magicLength == 4 && 0x28 == magic[0] && 0xb5 == magic[1] && 0x2f == magic[2] && 0xfd == magic[3]) {
+			compressionName = "zstd";
+		} else {
+			compressionName = "none";
+		}
+	}
+
+	if("none" == compressionName) {
+		compression = TRACE_PLAIN;
+		openPlain(traceFile);
+	} else if("gzip" == compressionName) {
+		compression = TRACE_GZIP;
+#ifdef HAVE_LIBZ
+		gzInput = gzopen(traceFile.c_str(), "rb");
+
+		if(Z_NULL == gzInput) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: attempted to open: %s but zlib returns error condition.\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		gzbuffer(gzInput, ChunkLength);
+#else
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s is gzip compressed but Prospero was built without libz.\n",
+			getName().c_str(), traceFile.c_str());
+#endif
+	} else if("zstd" == compressionName) {
+		compression = TRACE_ZSTD;
+#ifdef HAVE_ZSTD
+		zstdInput = fopen(traceFile.c_str(), "rb");
+
+		if(NULL == zstdInput) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in lookahead reader.\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		zstdStream = ZSTD_createDStream();
+		ZSTD_initDStream(zstdStream);
+
+		zstdStaging.resize(ZSTD_DStreamInSize());
+		zstdIn.src = zstdStaging.data();
+		zstdIn.size = 0;
+		zstdIn.pos = 0;
+#else
+		output->fatal(CALL_INFO, -1, "%s, Fatal: %s is zstd compressed but Prospero was built without zstd.\n",
+			getName().c_str(), traceFile.c_str());
+#endif
+	} else {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unknown compression \"%s\", expected auto, none, gzip or zstd.\n",
+			getName().c_str(), compressionName.c_str());
+	}
+
+	for(uint32_t i = 0; i < batchCount; ++i) {
+		freeBatches.push_back(std::vector<ProsperoTraceEntry>());
+		freeBatches.back().reserve(batchRecords);
+	}
+
+	output->verbose(CALL_INFO, 1, 0, "Lookahead reader opened %s (%s), %" PRIu32 " batches of %" PRIu64 " records\n",
+		traceFile.c_str(), compressionName.c_str(), batchCount, (uint64_t) batchRecords);
+
+	decoder = std::thread(&ProsperoLookaheadTraceReader::decodeLoop, this);
+}
+
+ProsperoLookaheadTraceReader::~ProsperoLookaheadTraceReader() {
+	{
+		std::unique_lock<std::mutex> lock(batchLock);
+		stopDecode = true;
+	}
+
+	batchFree.notify_all();
+	decoder.join();
+
+	if(NULL != mapping) {
+		munmap((void*) mapping, mappingLength);
+	}
+
+#ifdef HAVE_LIBZ
+	if(NULL != gzInput) {
+		gzclose(gzInput);
+	}
+#endif
+
+#ifdef HAVE_ZSTD
+	if(NULL != zstdStream) {
+		ZSTD_freeDStream(zstdStream);
+	}
+
+	if(NULL != zstdInput) {
+		fclose(zstdInput);
+	}
+#endif
+}
+
+void ProsperoLookaheadTraceReader::openPlain(const std::string& traceFile) {
+	const int fd = open(traceFile.c_str(), O_RDONLY);
+
+	if(fd < 0) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in lookahead reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	struct stat info;
+	if(0 != fstat(fd, &info)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to stat trace file: %s\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	mappingLength = (size_t) info.st_size;
+
+	if(mappingLength > 0) {
+		void* mapped = mmap(NULL, mappingLength, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if(MAP_FAILED == mapped) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: unable to map trace file: %s\n",
+				getName().c_str(), traceFile.c_str());
+		}
+
+		madvise(mapped, mappingLength, MADV_SEQUENTIAL);
+		mapping = (const uint8_t*) mapped;
+	}
+
+	close(fd);
+}
+
+// Point data at the next run of raw trace bytes, false at the end of the trace
+// or on an error, which is left in decodeError. Runs on the decoder thread.
+bool ProsperoLookaheadTraceReader::nextChunk(std::vector<uint8_t>& staging, const uint8_t** data, size_t* length) {
+	switch(compression) {
+	case TRACE_PLAIN:
+		{
+			if(mappingOffset >= mappingLength) {
+				return false;
+			}
+
+			*data = mapping + mappingOffset;
+			*length = std::min(ChunkLength, mappingLength - mappingOffset);
+			mappingOffset += *length;
+
+			// Ask for the following chunk now so the page faults overlap with decode
+			if(mappingOffset < mappingLength) {
+				const size_t pageSize = (size_t) sysconf(_SC_PAGESIZE);
+				const size_t adviseStart = mappingOffset - (mappingOffset % pageSize);
+				madvise((void*) (mapping + adviseStart), std::min(ChunkLength, mappingLength - adviseStart), MADV_WILLNEED);
+			}
+
+			return true;
+		}
+
+	case TRACE_GZIP:
+#ifdef HAVE_LIBZ
+		{
+			staging.resize(ChunkLength);
+			const int bytesRead = gzread(gzInput, staging.data(), (unsigned int) staging.size());
+
+			if(bytesRead < 0) {
+				int errorNumber = 0;
+				decodeError = gzerror(gzInput, &errorNumber);
+				return false;
+			}
+
+			*data = staging.data();
+			*length = (size_t) bytesRead;
+			return bytesRead > 0;
+		}
+#else
+		return false;
+#endif
+
+	case TRACE_ZSTD:
+#ifdef HAVE_ZSTD
+		{
+			staging.resize(ChunkLength);
+
+			ZSTD_outBuffer zstdOut;
+			zstdOut.dst = staging.data();
+			zstdOut.size = staging.size();
+			zstdOut.pos = 0;
+
+			while(0 == zstdOut.pos) {
+				if(zstdIn.pos == zstdIn.size && !zstdInputEnded) {
+					zstdIn.size = fread(zstdStaging.data(), 1, zstdStaging.size(), zstdInput);
+					zstdIn.pos = 0;
+					zstdInputEnded = zstdIn.size < zstdStaging.size();
+				}
+
+				// Called even with no input left so data held back by a full output buffer is flushed
+				const size_t result = ZSTD_decompressStream(zstdStream, &zstdOut, &zstdIn);
+
+				if(ZSTD_isError(result)) {
+					decodeError = ZSTD_getErrorName(result);
+					return false;
+				}
+
+				if(0 == zstdOut.pos && zstdIn.pos == zstdIn.size && zstdInputEnded) {
+					return false;
+				}
+			}
+
+			*data = staging.data();
+			*length = zstdOut.pos;
+			return true;
+		}
+#else
+		return false;
+#endif
+	}
+
+	return false;
+}
+
+bool ProsperoLookaheadTraceReader::takeFreeBatch(std::vector<ProsperoTraceEntry>& batch) {
+	std::unique_lock<std::mutex> lock(batchLock);
+	batchFree.wait(lock, [this] { return stopDecode || !freeBatches.empty(); });
+
+	if(stopDecode) {
+		return false;
+	}
+
+	batch = std::move(freeBatches.front());
+	freeBatches.pop_front();
+	batch.clear();
+	return true;
+}
+
+void ProsperoLookaheadTraceReader::publishBatch(std::vector<ProsperoTraceEntry>& batch) {
+	{
+		std::unique_lock<std::mutex> lock(batchLock);
+		readyBatches.push_back(std::move(batch));
+	}
+
+	batchReady.notify_one();
+}
+
+void ProsperoLookaheadTraceReader::decodeLoop() {
+	std::vector<uint8_t> staging;
+	std::vector<ProsperoTraceEntry> batch;
+
+	uint8_t carry[RecordLength];
+	size_t carryLength = 0;
+
+	bool running = takeFreeBatch(batch);
+
+	auto decode = [&](const uint8_t* record) {
+		uint64_t reqCycles;
+		char reqType;
+		uint64_t reqAddress;
+		uint32_t reqLength;
+
+		memcpy(&reqCycles,  record, sizeof(uint64_t));
+		memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+		memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+		memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+		batch.push_back(ProsperoTraceEntry(reqCycles, reqAddress, reqLength,
+			(reqType == 'R' || reqType == 'r') ? READ : WRITE));
+
+		if(batch.size() == batchRecords) {
+			publishBatch(batch);
+			running = takeFreeBatch(batch);
+		}
+	};
+
+	const uint8_t* data;
+	size_t length;
+
+	while(running && nextChunk(staging, &data, &length)) {
+		// Finish a record split across the previous chunk
+		if(carryLength > 0) {
+			const size_t take = std::min(RecordLength - carryLength, length);
+			memcpy(carry + carryLength, data, take);
+			carryLength += take;
+			data += take;
+			length -= take;
+
+			if(RecordLength == carryLength) {
+				carryLength = 0;
+				decode(carry);
+			}
+		}
+
+		while(running && length >= RecordLength) {
+			decode(data);
+			data += RecordLength;
+			length -= RecordLength;
+		}
+
+		if(running && length > 0) {
+			memcpy(carry, data, length);
+			carryLength = length;
+		}
+	}
+
+	std::unique_lock<std::mutex> lock(batchLock);
+
+	partialRecordLength = carryLength;
+
+	if(running && !batch.empty()) {
+		readyBatches.push_back(std::move(batch));
+	}
+
+	decodeEnded = true;
+	batchReady.notify_one();
+}
+
+bool ProsperoLookaheadTraceReader::readNextBatch(std::vector<ProsperoTraceEntry>& batch) {
+	std::unique_lock<std::mutex> lock(batchLock);
+
+	// Hand the consumed batch back to the decoder
+	if(batch.capacity() > 0) {
+		freeBatches.push_back(std::move(batch));
+		batchFree.notify_one();
+	}
+
+	batchReady.wait(lock, [this] { return decodeEnded || !readyBatches.empty(); });
+
+	if(readyBatches.empty()) {
+		if(!decodeError.empty()) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+				getName().c_str(), decodeError.c_str());
+		}
+
+		if(partialRecordLength > 0) {
+			output->verbose(CALL_INFO, 2, 0, "Trace ends with a partial record of %" PRIu64 " bytes, ignored.\n", (uint64_t) partialRecordLength);
+			partialRecordLength = 0;
+		}
+
+		batch = std::vector<ProsperoTraceEntry>();
+		return false;
+	}
+
+	batch = std::move(readyBatches.front());
+	readyBatches.pop_front();
+	return true;
+}
+
+ProsperoTraceEntry* ProsperoLookaheadTraceReader::readNextEntry() {
+	if(singleIndex >= singleBatch.size()) {
+		singleIndex = 0;
+
+		if(!readNextBatch(singleBatch)) {
+			return NULL;
+		}
+	}
+
+	return new ProsperoTraceEntry(singleBatch[singleIndex++]);
+}
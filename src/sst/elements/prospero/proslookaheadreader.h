@@ -0,0 +1,127 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_LOOKAHEAD_READER
+#define _H_SST_PROSPERO_LOOKAHEAD_READER
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "prosreader.h"
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Binary trace reader which decodes ahead of the simulation. Uncompressed
+ * traces are memory mapped, gzip and zstd traces are inflated, and in every
+ * case a background thread decodes records into a small ring of batches which
+ * the CPU swaps out whole, so the simulation thread never touches the file.
+ */
+class ProsperoLookaheadTraceReader : public ProsperoTraceReader {
+
+public:
+    ProsperoLookaheadTraceReader( ComponentId_t id, Params& params, Output* out );
+    ~ProsperoLookaheadTraceReader();
+    ProsperoTraceEntry* readNextEntry();
+    bool readNextBatch(std::vector<ProsperoTraceEntry>& batch);
+
+ 	SST_ELI_REGISTER_SUBCOMPONENT(
+        ProsperoLookaheadTraceReader,
+        "prospero",
+        "ProsperoLookaheadTraceReader",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Binary Trace Reader with background decompression and decode (plain, gzip or zstd)",
+        SST::Prospero::ProsperoTraceReader
+    )
+
+	SST_ELI_DOCUMENT_PARAMS(
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "compression", "Compression of the trace: auto (detect from the file header), none, gzip or zstd", "auto" },
+		{ "batchrecords", "Number of records decoded into each batch", "8192" },
+		{ "batches", "Number of batches in the ring, the decoder runs this far ahead of the CPU", "2" }
+	)
+
+private:
+	typedef enum {
+		TRACE_PLAIN,
+		TRACE_GZIP,
+		TRACE_ZSTD
+	} TraceCompression;
+
+	void openPlain(const std::string& traceFile);
+	void decodeLoop();
+	bool nextChunk(std::vector<uint8_t>& staging, const uint8_t** data, size_t* length);
+	bool takeFreeBatch(std::vector<ProsperoTraceEntry>& batch);
+	void publishBatch(std::vector<ProsperoTraceEntry>& batch);
+
+	static const size_t RecordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+	static const size_t ChunkLength = 1024 * 1024;
+
+	TraceCompression compression;
+
+	const uint8_t* mapping;
+	size_t mappingLength;
+	size_t mappingOffset;
+
+#ifdef HAVE_LIBZ
+	gzFile gzInput;
+#endif
+
+#ifdef HAVE_ZSTD
+	FILE* zstdInput;
+	ZSTD_DStream* zstdStream;
+	std::vector<uint8_t> zstdStaging;
+	ZSTD_inBuffer zstdIn;
+	bool zstdInputEnded;
+#endif
+
+	size_t batchRecords;
+
+	std::thread decoder;
+	std::mutex batchLock;
+	std::condition_variable batchReady;
+	std::condition_variable batchFree;
+	std::deque<std::vector<ProsperoTraceEntry>> readyBatches;
+	std::deque<std::vector<ProsperoTraceEntry>> freeBatches;
+	bool stopDecode;
+	bool decodeEnded;
+
+	// Set by the decoder thread before decodeEnded, reported by readNextBatch
+	// so Output is only used from the simulation thread
+	std::string decodeError;
+	size_t partialRecordLength;
+
+	std::vector<ProsperoTraceEntry> singleBatch;
+	size_t singleIndex;
+};
+
+}
+}
+
+#endif
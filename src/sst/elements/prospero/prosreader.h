@@ -22,6 +22,8 @@
 #include <sst/core/subcomponent.h>
 #include <sst/core/params.h>
 
+#include <vector>
+
 namespace SST {
 namespace Prospero {
 
@@ -32,6 +34,8 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() : cycles(0), address(0), length(0), op(READ) {}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -48,10 +52,10 @@ public:
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -65,6 +69,21 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Replace batch with the next run of entries in trace order, returns false
+	// once the trace is exhausted. The vector passed in may be kept by the reader
+	// for reuse so callers must not hold pointers into it across calls.
+	virtual bool readNextBatch(std::vector<ProsperoTraceEntry>& batch) {
+		batch.clear();
+
+		ProsperoTraceEntry* entry;
+		while(batch.size() < 1024 && NULL != (entry = readNextEntry())) {
+			batch.push_back(*entry);
+			delete entry;
+		}
+
+		return !batch.empty();
+	}
 	void setOutput(Output* out) { output = out; }
 
 protected:
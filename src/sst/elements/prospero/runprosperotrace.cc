@@ -38,6 +38,14 @@ void printUsage() {
 	printf("  -o <file>     Name of trace output files.\n");
 	printf("  -f <format>   Output <format> = {text, binary, compressed}\n");
 	printf("  -t <maxthr>   Maximum number of threads to trace, if not set will search for OMP_NUM_THREADS or set to 1\n");
+	printf("  -b <bytes>    Size of each per-thread trace buffer\n");
+	printf("  -n <count>    Number of trace buffers per thread\n");
+	printf("  -d <0|1>      Start with tracing disabled (0) or enabled (1)\n");
+	printf("  -l <count>    Start a new trace file every <count> instructions\n");
+	printf("  -amin <addr>  Only trace accesses at or above <addr>\n");
+	printf("  -amax <addr>  Only trace accesses below <addr>\n");
+	printf("  -istart <n>   Only trace accesses from instruction <n> of each thread\n");
+	printf("  -iend <n>     Stop tracing accesses at instruction <n> of each thread\n");
 	printf("\n");
 }
 
@@ -148,6 +156,21 @@ int main(int argc, char* argv[]) {
 					exit(-1);
 				}
 			}
+		} else if( std::strcmp(prosParams[i], "-b") == 0 ||
+			std::strcmp(prosParams[i], "-n") == 0 ||
+			std::strcmp(prosParams[i], "-d") == 0 ||
+			std::strcmp(prosParams[i], "-l") == 0 ||
+			std::strcmp(prosParams[i], "-amin") == 0 ||
+			std::strcmp(prosParams[i], "-amax") == 0 ||
+			std::strcmp(prosParams[i], "-istart") == 0 ||
+			std::strcmp(prosParams[i], "-iend") == 0 ) {
+			// Passed straight through to the tool
+			if(i == (prosParams.size() - 1) ) {
+				fprintf(stderr, "%s needs a value to be specified\n", prosParams[i]);
+				exit(-1);
+			} else {
+				i++;
+			}
 		} else {
 			fprintf(stderr, "Error: program option: %s\n",
 				prosParams[i]);
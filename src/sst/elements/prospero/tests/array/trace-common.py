@@ -8,6 +8,7 @@ traceFile = "File Error"
 traceDir = "Dir Error"
 memSize = "4096"
 useTimingDram="no"
+readerName = ""
 
 def main():
     global Tracetype
@@ -15,9 +16,10 @@ def main():
     global traceDir
     global memSize
     global useTimingDram
+    global readerName
 
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","Reader="])
     except getopt.GetopError as err:
         print(str(err))
         sys.exit(2)
@@ -43,6 +45,9 @@ def main():
                 useTimingDram = 'yes'
         elif o in ("--TraceDir"):
             traceDir=a
+        elif o in ("--Reader"):
+            # Read binary or compressed traces with another reader, e.g. Lookahead
+            readerName = a
         else:
             print("no match for o", o)
             assert False, "Unknown Options !"
@@ -50,6 +55,9 @@ def main():
 
 main()
 
+if readerName == "":
+    readerName = Tracetype
+
 # Define SST core options
 sst.setProgramOption("timebase", "1ps")
 sst.setProgramOption("stop-at", "5s")
@@ -58,7 +66,7 @@ sst.setProgramOption("stop-at", "5s")
 comp_cpu = sst.Component("cpu", "prospero.prosperoCPU")
 comp_cpu.addParams({
        "verbose" : "0",
-       "reader" : "prospero.Prospero" + Tracetype + "TraceReader",
+       "reader" : "prospero.Prospero" + readerName + "TraceReader",
        "readerParams.file" : traceDir + "/" + traceFile
 })
 comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
@@ -0,0 +1,143 @@
+# Replay a multi-threaded Prospero trace, one prosperoCPU per traced thread
+# sharing an L2 through a bus.
+#
+# Generate the traces with the tool, e.g. for four threads:
+#   sst-prospero-trace -t 4 -f compressed -- ./array
+# and run with:
+#   sst trace-multicore.py -- --TraceType=compressed --TraceDir=. --Cores=4
+import sst
+import os
+import sys,getopt
+
+traceSuffix = ""
+reader = "prospero.ProsperoTextTraceReader"
+traceDir = "."
+cores = 2
+memSize = "4096"
+useTimingDram = "no"
+
+def main():
+    global traceSuffix
+    global reader
+    global traceDir
+    global cores
+    global useTimingDram
+
+    try:
+        opts, args = getopt.getopt(sys.argv[1:], "", ["TraceType=","UseTimingDram=","TraceDir=","Cores="])
+    except getopt.GetoptError as err:
+        print(str(err))
+        sys.exit(2)
+    for o, a in opts:
+        if o in ("--TraceType"):
+            if a == "text":
+                traceSuffix = ""
+                reader = "prospero.ProsperoTextTraceReader"
+            elif a == "binary":
+                traceSuffix = "-bin"
+                reader = "prospero.ProsperoLookaheadTraceReader"
+            elif a == "compressed":
+                traceSuffix = "-gz"
+                reader = "prospero.ProsperoLookaheadTraceReader"
+            else:
+                print("Unknown trace type ", a)
+                sys.exit(2)
+        elif o in ("--UseTimingDram"):
+            if a == "yes":
+                useTimingDram = "yes"
+        elif o in ("--TraceDir"):
+            traceDir = a
+        elif o in ("--Cores"):
+            cores = int(a)
+        else:
+            print("no match for o", o)
+            assert False, "Unknown Options !"
+
+
+main()
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stop-at", "5s")
+
+bus = sst.Component("bus", "memHierarchy.Bus")
+bus.addParams({
+      "bus_frequency" : "2 Ghz",
+})
+
+# One core and private L1 per traced thread
+for core in range(cores):
+    comp_cpu = sst.Component("cpu" + str(core), "prospero.prosperoCPU")
+    comp_cpu.addParams({
+          "verbose" : "0",
+          "reader" : reader,
+          "readerParams.file" : traceDir + "/sstprospero-" + str(core) + "-0" + traceSuffix + ".trace"
+    })
+
+    comp_l1cache = sst.Component("l1cache" + str(core), "memHierarchy.Cache")
+    comp_l1cache.addParams({
+          "access_latency_cycles" : "1",
+          "cache_frequency" : "2 Ghz",
+          "replacement_policy" : "lru",
+          "coherence_protocol" : "MESI",
+          "associativity" : "8",
+          "cache_line_size" : "64",
+          "L1" : "1",
+          "cache_size" : "64 KB"
+    })
+
+    link_cpu_cache = sst.Link("link_cpu_cache_" + str(core))
+    link_cpu_cache.connect( (comp_cpu, "cache_link", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+    link_l1_bus = sst.Link("link_l1_bus_" + str(core))
+    link_l1_bus.connect( (comp_l1cache, "low_network_0", "50ps"), (bus, "high_network_" + str(core), "50ps") )
+
+comp_l2cache = sst.Component("l2cache", "memHierarchy.Cache")
+comp_l2cache.addParams({
+      "access_latency_cycles" : "8",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "16",
+      "cache_line_size" : "64",
+      "cache_size" : "1 MB"
+})
+
+comp_memctrl = sst.Component("memory", "memHierarchy.MemController")
+comp_memctrl.addParams({
+      "clock" : "1GHz",
+      "addr_range_start" : 0,
+})
+if useTimingDram == "yes":
+    memory = comp_memctrl.setSubComponent("backend", "memHierarchy.timingDRAM")
+    memory.addParams({
+        "id" : 0,
+        "addrMapper" : "memHierarchy.roundRobinAddrMapper",
+        "addrMapper.interleave_size" : "64B",
+        "addrMapper.row_size" : "1KiB",
+        "clock" : "800MHz",
+        "mem_size" : str(memSize) + "MiB",
+        "channels" : 2,
+        "channel.numRanks" : 2,
+        "channel.rank.numBanks" : 2,
+        "channel.transaction_Q_size" : 32,
+        "channel.rank.bank.CL" : 14,
+        "channel.rank.bank.CL_WR" : 12,
+        "channel.rank.bank.RCD" : 14,
+        "channel.rank.bank.TRP" : 14,
+        "channel.rank.bank.dataCycles" : 2,
+        "channel.rank.bank.pagePolicy" : "memHierarchy.simplePagePolicy",
+        "channel.rank.bank.transactionQ" : "memHierarchy.reorderTransactionQ",
+        "channel.rank.bank.pagePolicy.close" : 0,
+    })
+else:
+    memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+        "access_time" : "1000 ns",
+        "mem_size" : str(memSize) + "MiB",
+    })
+
+# Define the simulation links
+link_bus_l2cache = sst.Link("link_bus_l2cache")
+link_bus_l2cache.connect( (bus, "low_network_0", "50ps"), (comp_l2cache, "high_network_0", "50ps") )
+link_l2_mem = sst.Link("link_l2_mem")
+link_l2_mem.connect( (comp_l2cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
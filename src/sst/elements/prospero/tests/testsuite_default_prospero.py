@@ -49,6 +49,15 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_binary_withtimingdram_using_TAR_traces(self):
         self.prospero_test_template("binary", WITH_TIMINGDRAM, USE_TAR_TRACES)
 
+    # The lookahead reader decodes the same binary traces on a background
+    # thread and must reproduce the output of the reader for their format
+    def test_prospero_binary_lookahead_using_TAR_traces(self):
+        self.prospero_test_template("binary", NO_TIMINGDRAM, USE_TAR_TRACES, reader="Lookahead")
+
+    @unittest.skipIf(libz_missing, "test_prospero_compressed_lookahead_using_TAR_traces test: Requires LIBZ, but LIBZ is not found in build configuration.")
+    def test_prospero_compressed_lookahead_using_TAR_traces(self):
+        self.prospero_test_template("compressed", NO_TIMINGDRAM, USE_TAR_TRACES, reader="Lookahead")
+
     @unittest.skipIf(not pin_loaded, "test_prospero_text_using_PIN_traces: Requires PIN, but Env Var 'INTEL_PIN_DIR' is not found or path does not exist.")
     def test_prospero_text_using_PIN_traces(self):
         self.prospero_test_template("text", NO_TIMINGDRAM, USE_PIN_TRACES)
@@ -67,7 +76,7 @@ class testcase_prospero(SSTTestCase):
 
 #####
 
-    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240):
+    def prospero_test_template(self, trace_name, with_timingdram, use_pin_traces, testtimeout=240, reader=None):
         pass
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -91,21 +100,29 @@ class testcase_prospero(SSTTestCase):
         # Set the various file paths
         if with_timingdram:
             testDataFileName = ("test_prospero_with_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=yes --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            modelargs = "--TraceType={0} --UseTimingDram=yes --TraceDir={1}".format(trace_name, prospero_trace_dir)
         else:
             testDataFileName = ("test_prospero_wo_timingdram_{0}".format(trace_name))
-            otherargs = '--model-options=\"--TraceType={0} --UseTimingDram=no --TraceDir={1}\"'.format(trace_name, prospero_trace_dir)
+            modelargs = "--TraceType={0} --UseTimingDram=no --TraceDir={1}".format(trace_name, prospero_trace_dir)
 
         if use_pin_traces:
             tracetype = "pin"
         else:
             tracetype = "tar"
 
+        # Other readers are compared against the reference file of the trace
+        # format, only the output file name and the reader change
+        runFileName = testDataFileName
+        if reader is not None:
+            runFileName = "{0}_{1}".format(testDataFileName, reader.lower())
+            modelargs = "{0} --Reader={1}".format(modelargs, reader)
+        otherargs = '--model-options=\"{0}\"'.format(modelargs)
+
         sdlfile = "{0}/array/trace-common.py".format(test_path)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
-        outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, testDataFileName, tracetype)
-        errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, testDataFileName, tracetype)
-        mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, testDataFileName, tracetype)
+        outfile = "{0}/{1}_using_{2}_traces.out".format(outdir, runFileName, tracetype)
+        errfile = "{0}/{1}_using_{2}_traces.out.err".format(outdir, runFileName, tracetype)
+        mpioutfiles = "{0}/{1}_using_{2}_traces.out.testfile".format(outdir, runFileName, tracetype)
 
         log_debug("trace_name = {0}".format(trace_name))
         log_debug("testDataFileName = {0}".format(testDataFileName))
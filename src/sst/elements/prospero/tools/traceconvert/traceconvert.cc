@@ -0,0 +1,199 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Re-encodes a Prospero text trace ("<cycle> <R|W> <address> <length>" per
+// line) as the binary record format read by ProsperoBinaryTraceReader,
+// ProsperoCompressedBinaryTraceReader and ProsperoLookaheadTraceReader.
+// With --gzip the output is written through zlib.
+
+#include "sst_config.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+static const size_t record_length = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+struct trace_output {
+    FILE* plain;
+#ifdef HAVE_LIBZ
+    gzFile compressed;
+#endif
+};
+
+static bool
+write_block(trace_output& out, const std::vector<uint8_t>& block)
+{
+#ifdef HAVE_LIBZ
+    if ( NULL != out.compressed ) {
+        return (int) block.size() == gzwrite(out.compressed, block.data(), (unsigned int) block.size());
+    }
+#endif
+    return block.size() == fwrite(block.data(), 1, block.size(), out.plain);
+}
+
+// Parse one trace line, returns false for blank or malformed lines
+static bool
+parse_line(char* line, uint64_t* cycles, char* type, uint64_t* address, uint32_t* length)
+{
+    char* cursor = line;
+    char* end;
+
+    *cycles = strtoull(cursor, &end, 10);
+    if ( end == cursor ) return false;
+    cursor = end;
+
+    while ( ' ' == *cursor || '\t' == *cursor ) cursor++;
+    if ( '\0' == *cursor || '\n' == *cursor ) return false;
+    *type = *cursor++;
+
+    *address = strtoull(cursor, &end, 10);
+    if ( end == cursor ) return false;
+    cursor = end;
+
+    *length = (uint32_t) strtoul(cursor, &end, 10);
+    return end != cursor;
+}
+
+int
+main(int argc, char* argv[])
+{
+    bool gzip_output = false;
+    const char* input_path = NULL;
+    const char* output_path = NULL;
+
+    for ( int i = 1; i < argc; i++ ) {
+        if ( strcmp(argv[i], "--gzip") == 0 || strcmp(argv[i], "-z") == 0 ) {
+            gzip_output = true;
+        } else if ( argv[i][0] == '-' && argv[i][1] != '\0' ) {
+            input_path = NULL;
+            break;
+        } else if ( NULL == input_path ) {
+            input_path = argv[i];
+        } else {
+            output_path = argv[i];
+        }
+    }
+
+    if ( NULL == input_path || NULL == output_path ) {
+        fprintf(stderr, "usage: sst-prospero-traceconvert [--gzip] <text trace|-> <binary trace>\n");
+        return 1;
+    }
+
+#ifndef HAVE_LIBZ
+    if ( gzip_output ) {
+        fprintf(stderr, "Error: --gzip requested but this build does not have libz\n");
+        return 1;
+    }
+#endif
+
+    FILE* input = strcmp(input_path, "-") == 0 ? stdin : fopen(input_path, "rt");
+    if ( NULL == input ) {
+        fprintf(stderr, "Error: unable to open %s\n", input_path);
+        return 1;
+    }
+
+    trace_output out;
+    out.plain = NULL;
+#ifdef HAVE_LIBZ
+    out.compressed = NULL;
+
+    if ( gzip_output ) {
+        out.compressed = gzopen(output_path, "wb");
+        if ( NULL == out.compressed ) {
+            fprintf(stderr, "Error: unable to open %s\n", output_path);
+            return 1;
+        }
+    }
+#endif
+
+    if ( !gzip_output ) {
+        out.plain = fopen(output_path, "wb");
+        if ( NULL == out.plain ) {
+            fprintf(stderr, "Error: unable to open %s\n", output_path);
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> block;
+    block.reserve(record_length * 65536);
+
+    char line[512];
+    uint64_t line_number = 0;
+    uint64_t records = 0;
+    uint64_t skipped = 0;
+
+    while ( NULL != fgets(line, sizeof(line), input) ) {
+        line_number++;
+
+        uint64_t cycles;
+        char type;
+        uint64_t address;
+        uint32_t length;
+
+        if ( !parse_line(line, &cycles, &type, &address, &length) ) {
+            if ( strspn(line, " \t\r\n") != strlen(line) ) {
+                fprintf(stderr, "Warning: skipping malformed line %" PRIu64 "\n", line_number);
+                skipped++;
+            }
+            continue;
+        }
+
+        uint8_t record[record_length];
+        memcpy(record, &cycles, sizeof(uint64_t));
+        memcpy(record + sizeof(uint64_t), &type, sizeof(char));
+        memcpy(record + sizeof(uint64_t) + sizeof(char), &address, sizeof(uint64_t));
+        memcpy(record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &length, sizeof(uint32_t));
+        block.insert(block.end(), record, record + record_length);
+        records++;
+
+        if ( block.size() + record_length > block.capacity() ) {
+            if ( !write_block(out, block) ) {
+                fprintf(stderr, "Error: write to %s failed\n", output_path);
+                return 1;
+            }
+            block.clear();
+        }
+    }
+
+    if ( !write_block(out, block) ) {
+        fprintf(stderr, "Error: write to %s failed\n", output_path);
+        return 1;
+    }
+
+    if ( stdin != input ) {
+        fclose(input);
+    }
+
+#ifdef HAVE_LIBZ
+    if ( NULL != out.compressed ) {
+        gzclose(out.compressed);
+    }
+#endif
+
+    if ( NULL != out.plain && 0 != fclose(out.plain) ) {
+        fprintf(stderr, "Error: write to %s failed\n", output_path);
+        return 1;
+    }
+
+    printf("Converted %" PRIu64 " records (%" PRIu64 " malformed lines skipped)\n", records, skipped);
+    return 0;
+}
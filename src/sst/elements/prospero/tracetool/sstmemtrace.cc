@@ -25,51 +25,103 @@
 #include <iostream>
 #include <inttypes.h>
 
+// The Linux Pin tools link against the Pin CRT, so compressed traces need a
+// libz built against it (--with-pin-libz). On OSX the tool uses the host libz.
+#if defined(HAVE_PIN_LIBZ) || (defined(TARGET_MAC) && defined(HAVE_LIBZ))
+#define PROSPERO_TRACE_LIBZ 1
+#include <zlib.h>
+#endif
+
 using namespace std;
 
+// Application threads never touch a file. Each thread appends records to its
+// own ring of buffers and hands full buffers to a writer thread through two
+// counters (buffers filled by the thread, buffers drained by the writer), so
+// the only synchronization on the hot path is one release store per buffer.
+
+#define PROSPERO_RECORD_LENGTH (sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t))
+
 uint32_t max_thread_count;
 uint32_t trace_format;
 uint64_t instruction_count;
 uint32_t traceEnabled __attribute__((aligned(64)));
 uint64_t nextFileTrip;
 
+uint64_t traceAddressLow;
+uint64_t traceAddressHigh;
+uint64_t traceInsStart;
+uint64_t traceInsEnd;
+
+uint64_t buffer_size;
+uint32_t buffer_count;
+
 const char READ_OPERATION_CHAR = 'R';
 const char WRITE_OPERATION_CHAR = 'W';
 
-char RECORD_BUFFER[ sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char) ];
-
-// We have two file pointers, one for compressed traces and one for
-// "normal" (binary or text) traces
-FILE** trace;
+typedef struct {
+	char*  data;
+	UINT64 used;
+	UINT64 fileIndex;
+} traceBuffer;
 
+// Owned by the application thread, padded so threads do not share lines
 typedef struct {
 	UINT64 threadInit;
 	UINT64 insCount;
 	UINT64 readCount;
 	UINT64 writeCount;
 	UINT64 currentFile;
-	UINT64 padD;
-	UINT64 padE;
-	UINT64 padF;
+	UINT64 filled;
+	traceBuffer* buffers;
+	UINT64 padH;
 } threadRecord;
 
-char** fileBuffers;
+// Owned by the writer thread
+typedef struct {
+	UINT64 drained;
+	UINT64 openFile;
+	FILE* trace;
+#ifdef PROSPERO_TRACE_LIBZ
+	gzFile traceZ;
+#else
+	VOID* traceZ;
+#endif
+	UINT64 bytesWritten;
+	UINT64 padF;
+	UINT64 padG;
+	UINT64 padH;
+} writerRecord;
+
 threadRecord* thread_instr_id;
+writerRecord* writer_state;
+
+PIN_THREAD_UID writerThreadUID;
+volatile UINT32 writerStop;
 
 KNOB<string> KnobInsRoutine(KNOB_MODE_WRITEONCE, "pintool",
     "r", "", "Instrument only a specific routine (if not specified all instructions are instrumented");
 KNOB<string> KnobTraceFile(KNOB_MODE_WRITEONCE, "pintool",
     "o", "sstprospero", "Output analysis to trace file.");
 KNOB<string> KnobTraceFormat(KNOB_MODE_WRITEONCE, "pintool",
-    "f", "text", "Output format, \'text\' = Plain text, \'binary\' = Binary");
+    "f", "text", "Output format, \'text\' = Plain text, \'binary\' = Binary, \'compressed\' = gzip compressed binary");
 KNOB<UINT32> KnobMaxThreadCount(KNOB_MODE_WRITEONCE, "pintool",
     "t", "1", "Maximum number of threads to record memory patterns");
 KNOB<UINT32> KnobFileBufferSize(KNOB_MODE_WRITEONCE, "pintool",
-    "b", "32768", "Size in bytes for each trace buffer");
+    "b", "1048576", "Size in bytes for each trace buffer");
+KNOB<UINT32> KnobFileBufferCount(KNOB_MODE_WRITEONCE, "pintool",
+    "n", "4", "Number of trace buffers per thread, a thread only waits for the writer when all of them are full");
 KNOB<UINT32> KnobTraceEnabled(KNOB_MODE_WRITEONCE, "pintool",
     "d", "1", "Disable until application says that tracing can start, 0=disable until app, 1=start enabled, default=1");
 KNOB<UINT64> KnobFileTrip(KNOB_MODE_WRITEONCE, "pintool",
     "l", "1125899906842624", "Trip into a new trace file at this instruction count, default=1125899906842624 (2**50)");
+KNOB<UINT64> KnobAddressLow(KNOB_MODE_WRITEONCE, "pintool",
+    "amin", "0", "Only record accesses at or above this address");
+KNOB<UINT64> KnobAddressHigh(KNOB_MODE_WRITEONCE, "pintool",
+    "amax", "18446744073709551615", "Only record accesses below this address");
+KNOB<UINT64> KnobInsStart(KNOB_MODE_WRITEONCE, "pintool",
+    "istart", "0", "Only record accesses once a thread has executed this many instructions");
+KNOB<UINT64> KnobInsEnd(KNOB_MODE_WRITEONCE, "pintool",
+    "iend", "18446744073709551615", "Stop recording accesses once a thread has executed this many instructions");
 
 void prospero_enable() {
 	printf("PROSPERO: Tracing enabled\n");
@@ -81,21 +133,146 @@ void prospero_disable() {
 	traceEnabled = 0;
 }
 
-void copy(VOID* dest, const VOID* source, int destoffset, int count) {
-	char* dest_c = (char*) dest;
-	char* source_c = (char*) source;
-	int counter;
+void TraceFileName(char* buffer, size_t length, UINT32 thread, UINT64 file) {
+	const char* suffix = (0 == trace_format) ? "" : ((1 == trace_format) ? "-bin" : "-gz");
+
+	snprintf(buffer, length, "%s-%lu-%lu%s.trace", KnobTraceFile.Value().c_str(),
+		(unsigned long) thread, (unsigned long) file, suffix);
+}
+
+void OpenTraceFile(UINT32 thread, UINT64 file) {
+	char nameBuffer[256];
+	TraceFileName(nameBuffer, sizeof(nameBuffer), thread, file);
+
+	writer_state[thread].openFile = file;
+
+	if(2 == trace_format) {
+#ifdef PROSPERO_TRACE_LIBZ
+		writer_state[thread].traceZ = gzopen(nameBuffer, "wb1");
+
+		if(NULL == writer_state[thread].traceZ) {
+			std::cerr << "PROSPERO: Error: unable to open trace file " << nameBuffer << std::endl;
+			exit(-1);
+		}
+#endif
+	} else {
+		writer_state[thread].trace = fopen(nameBuffer, (0 == trace_format) ? "wt" : "wb");
 
-	for(counter = 0; counter < count; counter++) {
-		dest_c[destoffset + counter] = source_c[counter];
+		if(NULL == writer_state[thread].trace) {
+			std::cerr << "PROSPERO: Error: unable to open trace file " << nameBuffer << std::endl;
+			exit(-1);
+		}
 	}
 }
 
-VOID PerformInstrumentCountCheck(THREADID id) {
-	if(id >= max_thread_count) {
+void CloseTraceFile(UINT32 thread) {
+	if(NULL != writer_state[thread].trace) {
+		fclose(writer_state[thread].trace);
+		writer_state[thread].trace = NULL;
+	}
+
+#ifdef PROSPERO_TRACE_LIBZ
+	if(NULL != writer_state[thread].traceZ) {
+		gzclose(writer_state[thread].traceZ);
+		writer_state[thread].traceZ = NULL;
+	}
+#endif
+}
+
+// Writer thread only, text records are formatted here rather than in the application
+void WriteTraceBuffer(UINT32 thread, const traceBuffer* buffer) {
+	if(0 == buffer->used) {
 		return;
 	}
 
+	if(buffer->fileIndex != writer_state[thread].openFile) {
+		CloseTraceFile(thread);
+		OpenTraceFile(thread, buffer->fileIndex);
+	}
+
+	if(0 == trace_format) {
+		for(UINT64 offset = 0; offset < buffer->used; offset += PROSPERO_RECORD_LENGTH) {
+			uint64_t insCount;
+			char op;
+			uint64_t addr;
+			uint32_t size;
+
+			memcpy(&insCount, buffer->data + offset, sizeof(uint64_t));
+			memcpy(&op,       buffer->data + offset + sizeof(uint64_t), sizeof(char));
+			memcpy(&addr,     buffer->data + offset + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+			memcpy(&size,     buffer->data + offset + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+			fprintf(writer_state[thread].trace, "%llu %c %llu %d\n",
+				(unsigned long long int) insCount, op,
+				(unsigned long long int) addr, (int) size);
+		}
+	} else if(1 == trace_format) {
+		fwrite(buffer->data, 1, buffer->used, writer_state[thread].trace);
+	} else {
+#ifdef PROSPERO_TRACE_LIBZ
+		gzwrite(writer_state[thread].traceZ, buffer->data, (unsigned int) buffer->used);
+#endif
+	}
+
+	writer_state[thread].bytesWritten += buffer->used;
+}
+
+// Write every buffer the thread has handed over, returns true if anything was written
+BOOL DrainThread(UINT32 thread) {
+	const UINT64 filled = __atomic_load_n(&thread_instr_id[thread].filled, __ATOMIC_ACQUIRE);
+	BOOL wrote = false;
+
+	while(writer_state[thread].drained < filled) {
+		WriteTraceBuffer(thread, &thread_instr_id[thread].buffers[writer_state[thread].drained % buffer_count]);
+		__atomic_store_n(&writer_state[thread].drained, writer_state[thread].drained + 1, __ATOMIC_RELEASE);
+		wrote = true;
+	}
+
+	return wrote;
+}
+
+VOID WriterThread(VOID* arg) {
+	while(0 == writerStop) {
+		BOOL wrote = false;
+
+		for(UINT32 i = 0; i < max_thread_count; ++i) {
+			wrote = DrainThread(i) || wrote;
+		}
+
+		if(!wrote) {
+			PIN_Sleep(1);
+		}
+	}
+
+	// The application is exiting, write what has been handed over and then
+	// whatever each thread has in its current buffer
+	for(UINT32 i = 0; i < max_thread_count; ++i) {
+		DrainThread(i);
+		WriteTraceBuffer(i, &thread_instr_id[i].buffers[thread_instr_id[i].filled % buffer_count]);
+		CloseTraceFile(i);
+	}
+
+	PIN_ExitThread(0);
+}
+
+// Hand the current buffer to the writer and move on to the next one in the ring
+VOID HandOffBuffer(THREADID thr) {
+	threadRecord* record = &thread_instr_id[thr];
+	const UINT64 next = record->filled + 1;
+
+	__atomic_store_n(&record->filled, next, __ATOMIC_RELEASE);
+
+	// The next buffer is free once the writer has drained it
+	while((next - __atomic_load_n(&writer_state[thr].drained, __ATOMIC_ACQUIRE)) >= buffer_count) {
+		PIN_Yield();
+	}
+
+	traceBuffer* buffer = &record->buffers[next % buffer_count];
+	buffer->used = 0;
+	buffer->fileIndex = record->currentFile - 1;
+}
+
+VOID PerformInstrumentCountCheck(THREADID id) {
 	if(thread_instr_id[id].threadInit == 0) {
 		std::cout << "PROSPERO: Thread " << id << " starts at instruction " << thread_instr_id[0].insCount << std::endl;
 		// Copy over instructions from thread zero and mark started;
@@ -104,6 +281,35 @@ VOID PerformInstrumentCountCheck(THREADID id) {
 	}
 }
 
+// Returns false if the access is outside the traced instruction window or address range
+inline bool AppendRecord(THREADID thr, const char op, UINT64 addr, UINT32 size) {
+	threadRecord* record = &thread_instr_id[thr];
+
+	if(record->insCount < traceInsStart || record->insCount >= traceInsEnd) {
+		return false;
+	}
+
+	if(addr < traceAddressLow || addr >= traceAddressHigh) {
+		return false;
+	}
+
+	traceBuffer* buffer = &record->buffers[record->filled % buffer_count];
+	char* entry = buffer->data + buffer->used;
+
+	memcpy(entry, &(record->insCount), sizeof(uint64_t));
+	memcpy(entry + sizeof(uint64_t), &op, sizeof(char));
+	memcpy(entry + sizeof(uint64_t) + sizeof(char), &addr, sizeof(uint64_t));
+	memcpy(entry + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), &size, sizeof(uint32_t));
+
+	buffer->used += PROSPERO_RECORD_LENGTH;
+
+	if(buffer->used + PROSPERO_RECORD_LENGTH > buffer_size) {
+		HandOffBuffer(thr);
+	}
+
+	return true;
+}
+
 // Print a memory read record
 VOID RecordMemRead(VOID * addr, UINT32 size, THREADID thr)
 {
@@ -111,29 +317,14 @@ VOID RecordMemRead(VOID * addr, UINT32 size, THREADID thr)
      printf("PROSPERO: Calling into RecordMemRead...\n");
 #endif
 
-    UINT64 ma_addr = (UINT64) addr;
+    if(thr >= max_thread_count || 0 == traceEnabled) {
+	return;
+    }
 
     PerformInstrumentCountCheck(thr);
-
-    if(0 == trace_format) {
-	fprintf(trace[thr], "%llu R %llu %d\n",
-		(unsigned long long int) thread_instr_id[thr].insCount,
-		(unsigned long long int) ma_addr,
-		(int) size);
+    if(AppendRecord(thr, READ_OPERATION_CHAR, (UINT64) addr, size)) {
 	thread_instr_id[thr].readCount++;
-    } else if (1 == trace_format || 2 == trace_format) {
-	copy(RECORD_BUFFER, &(thread_instr_id[thr].insCount), 0, sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &READ_OPERATION_CHAR, sizeof(uint64_t), sizeof(char) );
-    	copy(RECORD_BUFFER, &ma_addr, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &size, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t) );
-
-	if(1 == trace_format) {
-		if(thr < max_thread_count && (traceEnabled > 0)) {
-    			fwrite(RECORD_BUFFER, sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char), 1, trace[thr]);
-			thread_instr_id[thr].readCount++;
-		}
-	}
-	}
+    }
 
 #ifdef PROSPERO_DEBUG
      printf("PROSPERO: Completed into RecordMemRead...\n");
@@ -148,29 +339,15 @@ VOID RecordMemWrite(VOID * addr, UINT32 size, THREADID thr)
      printf("PROSPERO: Calling into RecordMemWrite...\n");
 #endif
 
-    PerformInstrumentCountCheck(thr);
-
-    UINT64 ma_addr = (UINT64) addr;
+    if(thr >= max_thread_count || 0 == traceEnabled) {
+	return;
+    }
 
-    if(0 == trace_format) {
-	fprintf(trace[thr], "%llu W %llu %d\n",
-		(unsigned long long int) thread_instr_id[thr].insCount,
-		(unsigned long long int) ma_addr,
-		(int) size);
+    PerformInstrumentCountCheck(thr);
+    if(AppendRecord(thr, WRITE_OPERATION_CHAR, (UINT64) addr, size)) {
 	thread_instr_id[thr].writeCount++;
-    } else if(1 == trace_format || 2 == trace_format) {
-    	copy(RECORD_BUFFER, &(thread_instr_id[thr].insCount), 0, sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &WRITE_OPERATION_CHAR, sizeof(uint64_t), sizeof(char) );
-    	copy(RECORD_BUFFER, &ma_addr, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t) );
-    	copy(RECORD_BUFFER, &size, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t) );
-
-	if(1 == trace_format) {
-		if(thr < max_thread_count && (traceEnabled > 0)) {
-	   		fwrite(RECORD_BUFFER, sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t) + sizeof(char), 1, trace[thr]);
-			thread_instr_id[thr].writeCount++;
-		}
-	}
-	}
+    }
+
 #ifdef PROSPERO_DEBUG
      printf("PROSPERO: Completed into RecordMemWrite...\n");
 #endif
@@ -178,29 +355,24 @@ VOID RecordMemWrite(VOID * addr, UINT32 size, THREADID thr)
 }
 
 VOID IncrementInstructionCount(THREADID id) {
+	if(id >= max_thread_count) {
+		return;
+	}
+
 	thread_instr_id[id].insCount++;
 
 	if(thread_instr_id[id].insCount >= (nextFileTrip * thread_instr_id[id].currentFile)) {
-		char buffer[256];
-
-		if(trace_format == 0 || trace_format == 1) {
-			fclose(trace[id]);
-
-			if(trace_format == 0) {
-				sprintf(buffer, "%s-%lu-%lu.trace",
-					KnobTraceFile.Value().c_str(),
-					(unsigned long) id,
-					(unsigned long) thread_instr_id[id].currentFile);
-				trace[id] = fopen(buffer, "wt");
-			} else {
-				sprintf(buffer,	"%s-%lu-%lu-bin.trace",
-                                        KnobTraceFile.Value().c_str(),
-					(unsigned long) id,
-					(unsigned long) thread_instr_id[id].currentFile);
-                                trace[id] = fopen(buffer, "wb");
-			}
-		}
 		thread_instr_id[id].currentFile++;
+
+		// Records from here on go to the next file, the writer switches files
+		// when it reaches a buffer tagged with the new index
+		traceBuffer* buffer = &thread_instr_id[id].buffers[thread_instr_id[id].filled % buffer_count];
+
+		if(buffer->used > 0) {
+			HandOffBuffer(id);
+		} else {
+			buffer->fileIndex = thread_instr_id[id].currentFile - 1;
+		}
 	}
 }
 
@@ -280,19 +452,26 @@ VOID InstrumentSpecificRoutine(RTN rtn, VOID* v) {
 	}
 }
 
+VOID PrepareForFini(VOID *v)
+{
+    // Internal threads have to be stopped before Fini, the writer flushes everything on the way out
+    writerStop = 1;
+    PIN_WaitForThreadTermination(writerThreadUID, PIN_INFINITE_TIMEOUT, NULL);
+}
+
 VOID Fini(INT32 code, VOID *v)
 {
-    printf("PROSPERO: Tracing is complete, closing trace files...\n");
+    printf("PROSPERO: Tracing is complete, trace files are closed.\n");
     std::cout << "PROSPERO: Main thread exists with " << thread_instr_id[0].insCount << " instructions" << std::endl;
 
-    if( (0 == trace_format) || (1 == trace_format)) {
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-    		fclose(trace[i]);
-	}
+    UINT64 bytesWritten = 0;
+    for(UINT32 i = 0; i < max_thread_count; ++i) {
+	bytesWritten += writer_state[i].bytesWritten;
     }
 
     printf("PROSPERO: Thread read entries:     %" PRIu64 "\n", thread_instr_id[0].readCount);
     printf("PROSPERO: Thread write entries:    %" PRIu64 "\n", thread_instr_id[0].writeCount);
+    printf("PROSPERO: Record bytes written:    %" PRIu64 "\n", bytesWritten);
     printf("PROSPERO: Done.\n");
 }
 
@@ -319,8 +498,11 @@ int main(int argc, char *argv[])
     traceEnabled = KnobTraceEnabled.Value();
 
     max_thread_count = KnobMaxThreadCount.Value();
+    buffer_count = KnobFileBufferCount.Value() < 2 ? 2 : KnobFileBufferCount.Value();
+    buffer_size = KnobFileBufferSize.Value() < PROSPERO_RECORD_LENGTH ? PROSPERO_RECORD_LENGTH : KnobFileBufferSize.Value();
+
     std::cout << "PROSPERO: User requests that a maximum of " << max_thread_count << " threads are instrumented" << std::endl;
-    std::cout << "PROSPERO: File buffer per thread is " << KnobFileBufferSize.Value() << " bytes" << std::endl;
+    std::cout << "PROSPERO: " << buffer_count << " trace buffers per thread of " << buffer_size << " bytes each" << std::endl;
 
     if(traceEnabled == 0) {
     	std::cout << "PROSPERO: Trace is disabled from startup" << std::endl;
@@ -328,49 +510,60 @@ int main(int argc, char *argv[])
     	std::cout << "PROSPERO: Trace is enabled from startup" << std::endl;
     }
 
-    trace  = (FILE**) malloc(sizeof(FILE*) * max_thread_count);
-    fileBuffers = (char**) malloc(sizeof(char*) * max_thread_count);
-
-    char nameBuffer[256];
-
     if(KnobTraceFormat.Value() == "text") {
 	printf("PROSPERO: Tracing will be recorded in text format.\n");
 	trace_format = 0;
-
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		sprintf(nameBuffer, "%s-%lu-0.trace", KnobTraceFile.Value().c_str(), (unsigned long) i);
-		trace[i] = fopen(nameBuffer, "wt");
-	}
-
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		fileBuffers[i] = (char*) malloc(sizeof(char) * KnobFileBufferSize.Value());
-		setvbuf(trace[i], fileBuffers[i], _IOFBF, (size_t) KnobFileBufferSize.Value());
-	}
     } else if(KnobTraceFormat.Value() == "binary") {
 	printf("PROSPERO: Tracing will be recorded in uncompressed binary format.\n");
 	trace_format = 1;
-
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		sprintf(nameBuffer, "%s-%lu-0-bin.trace", KnobTraceFile.Value().c_str(), (unsigned long) i);
-		trace[i] = fopen(nameBuffer, "wb");
-	}
-
-	for(UINT32 i = 0; i < max_thread_count; ++i) {
-		fileBuffers[i] = (char*) malloc(sizeof(char) * KnobFileBufferSize.Value());
-		setvbuf(trace[i], fileBuffers[i], _IOFBF, (size_t) KnobFileBufferSize.Value());
-	}
+    } else if(KnobTraceFormat.Value() == "compressed") {
+#ifdef PROSPERO_TRACE_LIBZ
+	printf("PROSPERO: Tracing will be recorded in gzip compressed binary format.\n");
+	trace_format = 2;
+#else
+	std::cerr << "Error: compressed traces require a libz built against the Pin CRT, configure with --with-pin-libz=<dir>." << std::endl;
+	exit(-1);
+#endif
     } else {
 	std::cerr << "Error: Unknown trace format: " << KnobTraceFormat.Value() << "." << std::endl;
         exit(-1);
     }
 
+    traceAddressLow = KnobAddressLow.Value();
+    traceAddressHigh = KnobAddressHigh.Value();
+    traceInsStart = KnobInsStart.Value();
+    traceInsEnd = KnobInsEnd.Value();
+
+    printf("PROSPERO: Recording addresses [0x%" PRIx64 ", 0x%" PRIx64 ") between instructions %" PRIu64 " and %" PRIu64 ".\n",
+	traceAddressLow, traceAddressHigh, traceInsStart, traceInsEnd);
+
     posix_memalign((void**) &thread_instr_id, 64, sizeof(threadRecord) * max_thread_count);
+    posix_memalign((void**) &writer_state, 64, sizeof(writerRecord) * max_thread_count);
+
     for(UINT32 i = 0; i < max_thread_count; ++i) {
 	thread_instr_id[i].insCount = 0;
 	thread_instr_id[i].threadInit = 0;
+	thread_instr_id[i].readCount = 0;
+	thread_instr_id[i].writeCount = 0;
+	thread_instr_id[i].filled = 0;
 
 	// Next file is going to be marked as 1 (we are really on file 0).
 	thread_instr_id[i].currentFile = 1;
+
+	thread_instr_id[i].buffers = (traceBuffer*) malloc(sizeof(traceBuffer) * buffer_count);
+	for(UINT32 j = 0; j < buffer_count; ++j) {
+		thread_instr_id[i].buffers[j].data = (char*) malloc(buffer_size);
+		thread_instr_id[i].buffers[j].used = 0;
+		thread_instr_id[i].buffers[j].fileIndex = 0;
+	}
+
+	writer_state[i].drained = 0;
+	writer_state[i].bytesWritten = 0;
+	writer_state[i].trace = NULL;
+	writer_state[i].traceZ = NULL;
+
+	// Every thread gets a first file even if it never runs
+	OpenTraceFile(i, 0);
     }
 
     nextFileTrip = KnobFileTrip.Value();
@@ -379,6 +572,12 @@ int main(int argc, char *argv[])
     // Thread zero is always started
     thread_instr_id[0].threadInit = 1;
 
+    writerStop = 0;
+    if(INVALID_THREADID == PIN_SpawnInternalThread(WriterThread, NULL, 0, &writerThreadUID)) {
+	std::cerr << "Error: unable to start the trace writer thread." << std::endl;
+	exit(-1);
+    }
+
     //std::cout << "PROSPERO: Checking for specific routine instrumentation...";
 
     //if(KnobInsRoutine.Value() == "") {
@@ -389,6 +588,7 @@ int main(int argc, char *argv[])
 	RTN_AddInstrumentFunction(InstrumentSpecificRoutine, 0);
  //   }
 
+    PIN_AddPrepareForFiniFunction(PrepareForFini, 0);
     PIN_AddFiniFunction(Fini, 0);
 
     // Never returns
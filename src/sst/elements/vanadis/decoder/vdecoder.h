@@ -49,6 +49,9 @@
           "micro-ops",                                                                                \
           "uops", 1 },                                                                                \
         { "ins_bytes_loaded", "Count the number of bytes loaded for decode operations", "bytes", 1 }, \
+        { "ins_bytes_decoded", "Count the number of instruction bytes consumed by decode operations (code density)", "bytes", 1 }, \
+        { "compressed_ins_decoded", "Count the number of compressed (16b) instructions decoded", "instructions", 1 }, \
+        { "icache_line_requests", "Count the number of cache line reads issued to the instruction cache", "requests", 1 }, \
         { "uop_delayed_rob_full", "Number of times a micro-op cannot be added to the ROB because it is full.", "cycles", 1 }, \
     {                                                                                                 \
         "uops_generated",                                                                             \
@@ -129,6 +132,9 @@ public:
         stat_uop_generated    = registerStatistic<uint64_t>("uops_generated", "1");
         stat_decode_fault     = registerStatistic<uint64_t>("decode_faults", "1");
         stat_ins_bytes_loaded = registerStatistic<uint64_t>("ins_bytes_loaded", "1");
+        stat_ins_bytes_decoded = registerStatistic<uint64_t>("ins_bytes_decoded", "1");
+        stat_compressed_ins_decoded = registerStatistic<uint64_t>("compressed_ins_decoded", "1");
+        stat_icache_line_requests = registerStatistic<uint64_t>("icache_line_requests", "1");
         stat_uop_delayed_rob_full = registerStatistic<uint64_t>("uop_delayed_rob_full", "1");
     }
 
@@ -264,6 +270,9 @@ protected:
     Statistic<uint64_t>* stat_decode_fault;
     Statistic<uint64_t>* stat_uop_generated;
     Statistic<uint64_t>* stat_ins_bytes_loaded;
+    Statistic<uint64_t>* stat_ins_bytes_decoded;
+    Statistic<uint64_t>* stat_compressed_ins_decoded;
+    Statistic<uint64_t>* stat_icache_line_requests;
 };
 
 } // namespace Vanadis
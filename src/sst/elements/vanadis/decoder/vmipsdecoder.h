@@ -500,6 +500,7 @@ public:
                                     stat_predecode_hit->addData(1);
 
                                     decode(output, ip + 4, temp_delay, delay_bundle);
+                                    stat_ins_bytes_decoded->addData(4);
                                     ins_loader->cacheDecodedBundle(delay_bundle);
                                     decodes_performed++;
                                 }
@@ -516,7 +517,7 @@ public:
                                     CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
                                     "-----> Branch delay slot also misses in "
                                     "pre-decode cache, need to request it.\n");
-                                ins_loader->requestLoadAt(output, ip + 4, 4);
+                                stat_icache_line_requests->addData(ins_loader->requestLoadAt(output, ip + 4, 4));
                                 stat_ins_bytes_loaded->addData(4);
                                 stat_predecode_miss->addData(1);
                             }
@@ -679,6 +680,7 @@ public:
                             "(ins-bytes: 0x%x)\n",
                             temp_ins);
                         decode(output, ip, temp_ins, decoded_bundle);
+                        stat_ins_bytes_decoded->addData(4);
 
                         output->verbose(
                             CALL_INFO, 16, VANADIS_DBG_DECODER_FLG,
@@ -704,7 +706,7 @@ public:
                         "---> uop bundle and pre-decoded bytes are not found "
                         "(ip=%p), requesting icache read (line-width=%" PRIu64 ")\n",
                         (void*)ip, ins_loader->getCacheLineWidth());
-                    ins_loader->requestLoadAt(output, ip, 4);
+                    stat_icache_line_requests->addData(ins_loader->requestLoadAt(output, ip, 4));
                     stat_ins_bytes_loaded->addData(4);
                     stat_predecode_miss->addData(1);
                     break;
@@ -2098,6 +2100,10 @@ protected:
                 CALL_INFO, 16, VANADIS_DBG_DECODER_FLG, "-> [%3" PRIu32 "]: %s\n", i, bundle->getInstructionByIndex(i)->getInstCode());
         }
 
+        for ( uint32_t i = 0; i < bundle->getInstructionCount(); ++i ) {
+            bundle->getInstructionByIndex(i)->setInstructionBits(next_ins);
+        }
+
         // Mark the end of a micro-op group so we can count real instructions and
         // not just micro-ops
         if ( bundle->getInstructionCount() > 0 ) {
@@ -17,6 +17,7 @@
 #define _H_VANADIS_RISCV64_DECODER
 
 #include "decoder/vdecoder.h"
+#include "decoder/vriscv64factory.h"
 #include "inst/vinstall.h"
 #include "os/vriscvcpuos.h"
 
@@ -193,7 +194,7 @@ public:
                                             CALL_INFO, 16, 0,
                                             "----> contains a branch: 0x%" PRI_ADDR " / predicted "
                                             "(not-found in predictor): 0x%" PRI_ADDR ", pc-increment: %" PRIu64 "\n",
-                                            ip, ip + 4, bundle->pcIncrement());
+                                            ip, ip + bundle->pcIncrement(), bundle->pcIncrement());
                                     }
 
                                     ip += bundle->pcIncrement();
@@ -222,66 +223,87 @@ public:
                         stat_uop_delayed_rob_full->addData(1);
                     }
                 }
-                else if ( ins_loader->hasPredecodeAt(ip, 4) ) {
-                    // We have a loaded instruction cache line but have not decoded it yet
-                    if(output->getVerboseLevel() >= 16) {
-                        output->verbose(
-                            CALL_INFO, 16, 0,
-                            "---> uop not found, but is located in the predecode "
-                            "i0-icache (ip=0x%" PRI_ADDR ")\n",
-                            ip);
-                    }
+                else {
+                    // Instructions are either 16b (compressed) or 32b, the length is
+                    // encoded in the low bits of the first parcel so only fetch what
+                    // this instruction actually occupies
+                    const uint64_t ins_len = predecodeLengthAt(output, ip);
+
+                    if ( ins_loader->hasPredecodeAt(ip, ins_len) ) {
+                        // We have a loaded instruction cache line but have not decoded it yet
+                        if(output->getVerboseLevel() >= 16) {
+                            output->verbose(
+                                CALL_INFO, 16, 0,
+                                "---> uop not found, but is located in the predecode "
+                                "i0-icache (ip=0x%" PRI_ADDR ", len=%" PRIu64 ")\n",
+                                ip, ins_len);
+                        }
 
-                    VanadisInstructionBundle* decoded_bundle = new VanadisInstructionBundle(ip);
-                    stat_predecode_hit->addData(1);
+                        VanadisInstructionBundle* decoded_bundle = new VanadisInstructionBundle(ip);
+                        stat_predecode_hit->addData(1);
 
-                    uint32_t temp_ins = 0;
+                        uint32_t temp_ins = 0;
 
-                    const bool predecode_bytes =
-                        ins_loader->getPredecodeBytes(output, ip, (uint8_t*)&temp_ins, sizeof(temp_ins));
+                        const bool predecode_bytes =
+                            ins_loader->getPredecodeBytes(output, ip, (uint8_t*)&temp_ins, ins_len);
 
-                    if ( predecode_bytes ) {
-                        output->verbose(CALL_INFO, 16, 0, "---> performing a decode for ip=0x%" PRI_ADDR "\n", ip);
-                        decode(output, ip, temp_ins, decoded_bundle);
+                        if ( predecode_bytes ) {
+                            output->verbose(CALL_INFO, 16, 0, "---> performing a decode for ip=0x%" PRI_ADDR "\n", ip);
+                            decode(output, ip, temp_ins, decoded_bundle);
 
-                        if(output->getVerboseLevel() >= 16) {
-                            output->verbose(
-                                CALL_INFO, 16, 0, "---> bundle generates %" PRIu32 " micro-ops\n",
-                                (uint32_t)decoded_bundle->getInstructionCount());
-                        }
+                            for ( uint32_t i = 0; i < decoded_bundle->getInstructionCount(); ++i ) {
+                                decoded_bundle->getInstructionByIndex(i)->setInstructionBits(temp_ins);
+                            }
 
-                        ins_loader->cacheDecodedBundle(decoded_bundle);
+                            // mark the last micro-op so retire can tell where each
+                            // instruction ends
+                            if ( decoded_bundle->getInstructionCount() > 0 ) {
+                                decoded_bundle->getInstructionByIndex(decoded_bundle->getInstructionCount() - 1)
+                                    ->markEndOfMicroOpGroup();
+                            }
 
-                        if ( 0 == decoded_bundle->getInstructionCount() ) {
-                            output->fatal(CALL_INFO, -1, "Error - bundle at: 0x%" PRI_ADDR " generates no micro-ops.\n", ip);
-                        }
+                            stat_ins_bytes_decoded->addData(ins_len);
+                            if ( 2 == ins_len ) { stat_compressed_ins_decoded->addData(1); }
 
-                        // Exit this cycle because results saved to cache are available next
-                        // cycle
-                        break;
+                            if(output->getVerboseLevel() >= 16) {
+                                output->verbose(
+                                    CALL_INFO, 16, 0, "---> bundle generates %" PRIu32 " micro-ops\n",
+                                    (uint32_t)decoded_bundle->getInstructionCount());
+                            }
+
+                            ins_loader->cacheDecodedBundle(decoded_bundle);
+
+                            if ( 0 == decoded_bundle->getInstructionCount() ) {
+                                output->fatal(CALL_INFO, -1, "Error - bundle at: 0x%" PRI_ADDR " generates no micro-ops.\n", ip);
+                            }
+
+                            // Exit this cycle because results saved to cache are available next
+                            // cycle
+                            break;
+                        }
+                        else {
+                            output->fatal(
+                                CALL_INFO, -1,
+                                "Error - predecoded bytes for 0x%" PRIu64 " found, but "
+                                "retrieval of bytes failed.\n",
+                                ip);
+                        }
                     }
                     else {
-                        output->fatal(
-                            CALL_INFO, -1,
-                            "Error - predecoded bytes for 0x%" PRIu64 " found, but "
-                            "retrieval of bytes failed.\n",
-                            ip);
-                    }
-                }
-                else {
-                    // Not in micro or predecode cache, so we have to regenrata a request
-                    // and stop further processing
-                    if(output->getVerboseLevel() >= 16) {
-                        output->verbose(
-                            CALL_INFO, 16, 0,
-                            "---> microop bundle and pre-decoded bytes are not found for "
-                            "0x%" PRI_ADDR ", requested read for cache line (line=%" PRIu64 ")\n",
-                            ip, ins_loader->getCacheLineWidth());
+                        // Not in micro or predecode cache, so we have to regenrata a request
+                        // and stop further processing
+                        if(output->getVerboseLevel() >= 16) {
+                            output->verbose(
+                                CALL_INFO, 16, 0,
+                                "---> microop bundle and pre-decoded bytes are not found for "
+                                "0x%" PRI_ADDR ", requested read for cache line (line=%" PRIu64 ", len=%" PRIu64 ")\n",
+                                ip, ins_loader->getCacheLineWidth(), ins_len);
+                        }
+                        stat_icache_line_requests->addData(ins_loader->requestLoadAt(output, ip, ins_len));
+                        stat_ins_bytes_loaded->addData(ins_len);
+                        stat_predecode_miss->addData(1);
+                        break;
                     }
-                    ins_loader->requestLoadAt(output, ip, 4);
-                    stat_ins_bytes_loaded->addData(4);
-                    stat_predecode_miss->addData(1);
-                    break;
                 }
             }
             else {
@@ -305,6 +327,21 @@ protected:
     uint16_t                     max_decodes_per_cycle;
     uint16_t                     decode_buffer_max_entries;
 
+    // Returns the number of bytes which must be present in the predecoder to
+    // decode the instruction at addr. If the first 16b parcel is not present
+    // yet we only ask for the parcel, the full length is known once it arrives
+    // (a 32b instruction straddling a line therefore takes two fetches but we
+    // never load a line a compressed instruction does not touch).
+    uint64_t predecodeLengthAt(SST::Output* output, const uint64_t addr)
+    {
+        if ( !ins_loader->hasPredecodeAt(addr, 2) ) { return 2; }
+
+        uint16_t parcel = 0;
+        ins_loader->getPredecodeBytes(output, addr, (uint8_t*)&parcel, sizeof(parcel));
+
+        return ((parcel & 0x3) == 0x3) ? 4 : 2;
+    }
+
     void decode(SST::Output* output, const uint64_t ins_address, const uint32_t ins, VanadisInstructionBundle* bundle)
     {
         output->verbose(CALL_INFO, 16, 0, "[decode] -> addr: 0x%" PRI_ADDR " / ins: 0x%08x\n", ins_address, ins);
@@ -332,691 +369,27 @@ protected:
         bool decode_fault = true;
 
 
+        // Base integer, multiply/divide and floating point memory encodings are
+        // resolved through the mask/match table (see vriscv64dectable.h), the
+        // table only holds 32bit formats so compressed encodings never match
+        const VanadisRISCV64DecodeEntry* table_entry = vanadis_riscv64_decode_table.find(ins);
+
+        if ( nullptr != table_entry ) {
+            output->verbose(
+                CALL_INFO, 16, 0, "[decode] -> table: %s rd: %" PRIu16 " rs1: %" PRIu16 " rs2: %" PRIu16 "\n",
+                table_entry->mnemonic, extract_rd(ins), extract_rs1(ins), extract_rs2(ins));
+
+            vanadis_riscv64_factories[table_entry->op](ins_address, hw_thr, options, ins, 4, bundle);
+            decode_fault = false;
+        }
         // if the last two bits that are set are 11, then we are performing at least 32bit instruction formats,
         // otherwise we are performing decodes on the C-extension (16b) formats
-        if ( (ins & 0x3) == 0x3 ) {
+        else if ( (ins & 0x3) == 0x3 ) {
             output->verbose(
                 CALL_INFO, 16, 0, "[decode] -> 32bit format / ins-op-code-family: %" PRIu32 " / 0x%x\n", op_code,
                 op_code);
 
             switch ( op_code ) {
-            case 0x3:
-            {
-                // Load data
-                processI<int64_t>(ins, op_code, rd, rs1, func_code, simm64);
-
-                switch ( func_code ) {
-                case 0:
-                {
-                    // LB
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LB %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 1, true, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 1:
-                {
-                    // LH
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LH %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 2, true, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 2:
-                {
-                    // LW
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LW %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 4, true, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 3:
-                {
-                    // LD
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LD %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 8, true, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 4:
-                {
-                    // LBU
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LBU %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 1, false, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 5:
-                {
-                    // LHU
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LHU %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 2, false, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 6:
-                {
-                    // LWU
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> LWU %" PRIu16 " <- %" PRIu16 " %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 4, false, MEM_TRANSACTION_NONE,
-                        LOAD_INT_REGISTER));
-                    decode_fault = false;
-                } break;
-                }
-            } break;
-            case 0x7:
-            {
-                processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-
-                // Floating point load
-                switch ( func_code3 ) {
-                case 0x2:
-                {
-                    // FLW
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> FLW %" PRIu16 " <- memory[ %" PRIu16 " + %" PRId64 " ]\n", rd, rs1,
-                        simm64);
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 4, true, MEM_TRANSACTION_NONE,
-                        LOAD_FP_REGISTER));
-                    decode_fault = false;
-                } break;
-                case 0x3:
-                {
-                    // FLD
-                    output->verbose(
-                        CALL_INFO, 16, 0, "----> FLD %" PRIu16 " <- memory[ %" PRIu16 " + %" PRId64 " ]\n", rd, rs1,
-                        simm64);
-                    bundle->addInstruction(new VanadisLoadInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rd, 8, true, MEM_TRANSACTION_NONE,
-                        LOAD_FP_REGISTER));
-                    decode_fault = false;
-                } break;
-                }
-            } break;
-            case 0x23:
-            {
-                // Store data
-                processS<int64_t>(ins, op_code, rs1, rs2, func_code3, simm64);
-
-                if ( func_code < 4 ) {
-                    // shift to get the power of 2 number of bytes to store
-                    const uint32_t store_bytes = 1 << func_code3;
-
-                    output->verbose(
-                        CALL_INFO, 16, 0,
-                        "----> STORE width: %" PRIu32 " bytes == (1 << %" PRIu32 ") %" PRIu16 " -> memory[ %" PRIu16
-                        " + %" PRId64 " / (0x%" PRI_ADDR ")]\n",
-                        store_bytes, func_code3, rs2, rs1, simm64, simm64);
-
-                    bundle->addInstruction(new VanadisStoreInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rs2, store_bytes, MEM_TRANSACTION_NONE,
-                        STORE_INT_REGISTER));
-                    decode_fault = false;
-                }
-            } break;
-            case 0x13:
-            {
-                // Immediate arithmetic
-                func_code = extract_func3(ins);
-
-                output->verbose(CALL_INFO, 16, 0, "----> immediate-arith func: %" PRIu32 "\n", func_code);
-
-                switch ( func_code ) {
-                case 0:
-                {
-                    // ADDI
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-
-                    output->verbose(
-                        CALL_INFO, 16, 0, "------> ADDI %" PRIu16 " <- %" PRIu16 " + %" PRId64 "\n", rd, rs1, simm64);
-
-                    bundle->addInstruction(new VanadisAddImmInstruction<int64_t>(
-                        ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                case 1:
-                {
-                    // SLLI
-                    rd  = extract_rd(ins);
-                    rs1 = extract_rs1(ins);
-
-                    uint32_t func_code6 = (ins & 0xFC000000);
-                    uint32_t shift_by   = (ins & 0x3F00000) >> 20;
-
-                    output->verbose(
-                        CALL_INFO, 16, 0, "------> func_code6 = %" PRIu32 " / shift = %" PRIu32 " (0x%" PRIx32 ")\n",
-                        func_code6, shift_by, shift_by);
-
-                    switch ( func_code6 ) {
-                    case 0x0:
-                    {
-                        bundle->addInstruction(
-                            new VanadisShiftLeftLogicalImmInstruction<uint64_t>(
-                                ins_address, hw_thr, options, rd, rs1, shift_by));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 2:
-                {
-                    // SLTI
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisSetRegCompareImmInstruction<
-                                           REG_COMPARE_LT, int64_t>(
-                        ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                case 3:
-                {
-                    // SLTIU
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisSetRegCompareImmInstruction<
-                                           REG_COMPARE_LT, uint64_t>(
-                        ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                case 4:
-                {
-                    // XORI
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisXorImmInstruction(ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                case 5:
-                {
-                    // CHECK SRLI / SRAI
-                    rd  = extract_rd(ins);
-                    rs1 = extract_rs1(ins);
-
-                    uint32_t func_code6 = (ins & 0xFC000000);
-                    uint32_t shift_by   = (ins & 0x3F00000) >> 20;
-
-                    output->verbose(
-                        CALL_INFO, 16, 0, "------> func_code6 = %" PRIu32 " / shift = %" PRIu32 " (0x%" PRIx32 ")\n",
-                        func_code6, shift_by, shift_by);
-
-                    switch ( func_code6 ) {
-                    case 0x0:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "--------> SRLI %" PRIu16 " <- %" PRIu16 " >> %" PRIu32 "\n", rd, rs1,
-                            shift_by);
-                        bundle->addInstruction(
-                            new VanadisShiftRightLogicalImmInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT64>(
-                                ins_address, hw_thr, options, rd, rs1, shift_by));
-                        decode_fault = false;
-                    } break;
-                    case 0x40000000:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "--------> SRAI %" PRIu16 " <- %" PRIu16 " >> %" PRIu32 "\n", rd, rs1,
-                            shift_by);
-                        bundle->addInstruction(
-                            new VanadisShiftRightArithmeticImmInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT64>(
-                                ins_address, hw_thr, options, rd, rs1, shift_by));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 6:
-                {
-                    // ORI
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisOrImmInstruction(ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                case 7:
-                {
-                    // ANDI
-                    processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-                    bundle->addInstruction(new VanadisAndImmInstruction(ins_address, hw_thr, options, rd, rs1, simm64));
-                    decode_fault = false;
-                } break;
-                };
-            } break;
-            case 0x33:
-            {
-                // integer arithmetic/logical
-                processR(ins, op_code, rd, rs1, rs2, func_code3, func_code7);
-
-                output->verbose(
-                    CALL_INFO, 16, 0, "-----> decode R-type, func_code3=%" PRIu32 " / func_code7=%" PRIu32 "\n",
-                    func_code3, func_code7);
-
-                switch ( func_code3 ) {
-                case 0:
-                {
-                    switch ( func_code7 ) {
-                    case 0:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> ADD %" PRIu16 " <- %" PRIu16 " + %" PRIu16 "\n", rd, rs1, rs2);
-                        // ADD
-                        bundle->addInstruction(
-                            new VanadisAddInstruction<int64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 1:
-                    {
-                        // MUL
-                        // TODO - check register ordering
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> MUL %" PRIu16 " <- %" PRIu16 " + %" PRIu16 "\n", rd, rs1, rs2);
-
-                        bundle->addInstruction(
-                            new VanadisMultiplyInstruction<int64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x20:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SUB %" PRIu16 " <- %" PRIu16 " - %" PRIu16 "\n", rd, rs1, rs2);
-                        // SUB
-                        bundle->addInstruction(new VanadisSubInstruction<int64_t>(
-                            ins_address, hw_thr, options, rd, rs1, rs2, false));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 1:
-                {
-                    switch ( func_code7 ) {
-                    case 0:
-                    {
-                        // SLL
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SLL %" PRIu16 " <- %" PRIu16 " << %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftLeftLogicalInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT64>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 1:
-                    {
-                        // MULH
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> MULH %" PRIu16 " <- %" PRIu16 " + %" PRIu16 "\n", rd, rs1, rs2);
-
-                        bundle->addInstruction(
-                            new VanadisMultiplyHighInstruction<int64_t,int64_t>( ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 2:
-                {
-                    switch ( func_code7 ) {
-                    case 0:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SLT %" PRIu16 " <-  %" PRIu16 " < %" PRIu16 "\n", rd, rs1,
-                            rs2);
-                        // SLT
-                        bundle->addInstruction(
-                            new VanadisSetRegCompareInstruction<
-                                VanadisRegisterCompareType::REG_COMPARE_LT, int64_t>(ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 1:
-                    {
-                        // MULHSU
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> MULHSU %" PRIu16 " <- %" PRIu16 " + %" PRIu16 "\n", rd, rs1, rs2);
-
-                        bundle->addInstruction(
-                            new VanadisMultiplyHighInstruction<int64_t,uint64_t>( ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 3:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SLTU %" PRIu16 " <-  %" PRIu16 " < %" PRIu16 "\n", rd, rs1,
-                            rs2);
-                        // SLTU
-                        bundle->addInstruction(
-                            new VanadisSetRegCompareInstruction<
-                                VanadisRegisterCompareType::REG_COMPARE_LT, uint64_t>(ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x1:
-                    {
-                        // MULHU mul und place in upper XLEN bits, unsigned
-                        // need to check the register order
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> MULHU %" PRIu16 " <- %" PRIu16 " + %" PRIu16 "\n", rd, rs1, rs2);
-
-                        bundle->addInstruction(
-                            new VanadisMultiplyHighInstruction<uint64_t,uint64_t>( ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 4:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // XOR
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> XOR %" PRIu16 " <-  %" PRIu16 " ^ %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(new VanadisXorInstruction(ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 1:
-                    {
-                        // DIV
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> DIV %" PRIu16 " <-  %" PRIu16 " / %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisDivideInstruction<int64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 5:
-                {
-                    switch ( func_code7 ) {
-                    case 0:
-                    {
-                        // SRL
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SRL %" PRIu16 " <-  %" PRIu16 " >> %" PRIu16 "\n", rd, rs1,
-                            rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftRightLogicalInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT64>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 1:
-                    {
-                        // DIVU
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> DIVU %" PRIu16 " <-  %" PRIu16 " / %" PRIu16 "\n", rd, rs1,
-                            rs2);
-                        bundle->addInstruction(
-                            new VanadisDivideInstruction<uint64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 32:
-                    {
-                        // SRA
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SRA %" PRIu16 " <- %" PRIu16 " >> %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftRightArithmeticInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT64>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 6:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // OR
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-----> OR %" PRIu16 " <- %" PRIu16 " | %" PRIu16 "\n", rd, rs1, rs2);
-
-                        bundle->addInstruction(new VanadisOrInstruction(ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x1:
-                    {
-                        // REM
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-----> REM %" PRIu16 " <- %" PRIu16 " %% %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisModuloInstruction<int64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    }
-                } break;
-                case 7:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // AND
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-----> AND %" PRIu16 " <- %" PRIu16 " & %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(new VanadisAndInstruction(ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x1:
-                    {
-                        // REMU
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-----> REMU %" PRIu16 " <- %" PRIu16 " %% %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisModuloInstruction<uint64_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    }
-                } break;
-                };
-            } break;
-            case 0x37:
-            {
-                // LUI
-		int32_t uimm32 = 0;
-                processU<int32_t>(ins, op_code, rd, uimm32);;
-
-		output->verbose(CALL_INFO, 16, 0, "----> LUI %" PRIu16 " <- %#" PRIx32 "\n", rd, uimm32);
-
-                bundle->addInstruction(new VanadisSetRegisterInstruction<int32_t>(
-                    ins_address, hw_thr, options, rd, uimm32));
-                decode_fault = false;
-            } break;
-            case 0x17:
-            {
-                // AUIPC
-                processU<int64_t>(ins, op_code, rd, simm64);
-
-                bundle->addInstruction(new VanadisPCAddImmInstruction<int64_t>(
-                    ins_address, hw_thr, options, rd, simm64));
-                decode_fault = false;
-            } break;
-
-            case 0x1B:
-            {
-                processR(ins, op_code, rd, rs1, rs2, func_code3, func_code7);
-
-                output->verbose(
-                    CALL_INFO, 16, 0, "-----> decode R-type, func_code3=%" PRIu32 " / func_code7=%" PRIu32 "\n",
-                    func_code3, func_code7);
-
-                switch ( func_code3 ) {
-                case 0x0:
-                {
-                    // ADDIW?
-                    int64_t addiw_imm = 0;
-                    processI(ins, op_code, rd, rs1, func_code3, addiw_imm);
-
-                    output->verbose(
-                        CALL_INFO, 16, 0, "-------> ADDIW %" PRIu16 " <- %" PRIu16 " + %" PRId64 "\n", rd, rs1,
-                        addiw_imm);
-
-                    bundle->addInstruction(new VanadisAddImmInstruction<int32_t>(
-                        ins_address, hw_thr, options, rd, rs1, static_cast<int32_t>(addiw_imm)));
-                    decode_fault = false;
-                } break;
-                case 0x1:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // RS2 acts as an immediate
-                        // SLLIW (32bit result generated)
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SLLIW %" PRIu16 " <- %" PRIu16 " << %" PRIu16 " (%#" PRIx16 ")\n", rd,
-                            rs1, rs2, rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftLeftLogicalImmInstruction<uint32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    }
-                } break;
-                case 0x5:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // RS2 acts as an immediate
-                        // SRLIW (32bit result generated)
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SRLIW %" PRIu16 " <- %" PRIu16 " << %" PRIu16 " (%#" PRIx16 ")\n", rd,
-                            rs1, rs2, rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftRightLogicalImmInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT32>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-
-                    } break;
-                    case 32:
-                    {
-                        // RS2 acts as an immediate
-                        // SRAIW
-                        output->verbose(
-                            CALL_INFO, 16, 0, "-------> SRAIW %" PRIu16 " <- %" PRIu16 " << %" PRIu16 " (%#" PRIx16 ")\n", rd,
-                            rs1, rs2, rs2);
-                        bundle->addInstruction(
-                            new VanadisShiftRightArithmeticImmInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT32>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    }
-                } break;
-                }
-            } break;
-            case 0x6F:
-            {
-                // JAL
-                processJ<int64_t>(ins, op_code, rd, simm64);
-                // Immediate specifies jump in multiples of 2 byts per RISCV spec
-                const int64_t jump_to = static_cast<int64_t>(ins_address) + simm64;
-
-                output->verbose(
-                    CALL_INFO, 16, 0,
-                    "-----> JAL link-reg: %" PRIu16 " / jump-address: 0x%" PRI_ADDR " + %" PRId64 " = 0x%" PRI_ADDR "\n", rd, ins_address,
-                    simm64, jump_to);
-
-                bundle->addInstruction(new VanadisJumpLinkInstruction(
-                    ins_address, hw_thr, options, 4, rd, jump_to, VANADIS_NO_DELAY_SLOT));
-                decode_fault = false;
-            } break;
-            case 0x67:
-            {
-                // JALR
-                processI<int64_t>(ins, op_code, rd, rs1, func_code3, simm64);
-
-                switch ( func_code3 ) {
-                case 0:
-                {
-                    // TODO - may need to zero bit 1 with an AND microop?
-                    bundle->addInstruction(new VanadisJumpRegLinkInstruction(
-                        ins_address, hw_thr, options, 4, rd, rs1, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                };
-            } break;
-            case 0x63:
-            {
-                // Branch
-                processB<int64_t>(ins, op_code, rs1, rs2, func_code, simm64);
-
-                switch ( func_code ) {
-                case 0:
-                {
-                    // BEQ
-                    output->verbose(
-                        CALL_INFO, 16, 0, "-----> BEQ %" PRIu16 " == %" PRIu16 " / offset: %" PRId64 "\n", rs1, rs2,
-                        simm64);
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<int64_t, REG_COMPARE_EQ>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                case 1:
-                {
-                    // BNE
-                    output->verbose(
-                        CALL_INFO, 16, 0,
-                        "-----> BNE %" PRIu16 " != %" PRIu16 " / offset: %" PRId64 " (ip+offset %" PRIu64 ")\n", rs1,
-                        rs2, simm64, ins_address + simm64);
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<int64_t, REG_COMPARE_NEQ>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                case 4:
-                {
-                    // BLT
-                    output->verbose(
-                        CALL_INFO, 16, 0, "-----> BLT %" PRIu16 " < %" PRIu16 " / offset: %" PRId64 "\n", rs1, rs2,
-                        simm64);
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<int64_t, REG_COMPARE_LT>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                case 5:
-                {
-                    // BGE
-                    output->verbose(
-                        CALL_INFO, 16, 0, "-----> BGE %" PRIu16 " >= %" PRIu16 " / offset: %" PRId64 "\n", rs1, rs2,
-                        simm64);
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<int64_t, REG_COMPARE_GTE>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                case 6:
-                {
-                    // BLTU
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<uint64_t, REG_COMPARE_LT>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                case 7:
-                {
-                    // BGEU
-                    bundle->addInstruction(new VanadisBranchRegCompareInstruction<uint64_t, REG_COMPARE_GTE>(
-                        ins_address, hw_thr, options, 4, rs1, rs2, simm64, VANADIS_NO_DELAY_SLOT));
-                    decode_fault = false;
-                } break;
-                };
-            } break;
             case 0x73:
             {
                 // Syscall/ECALL and EBREAK
@@ -1123,149 +496,6 @@ protected:
                     }
                 }
             } break; // end of  0x73:
-            case 0x3B:
-            {
-                // 64b integer arithmetic-W
-                processR(ins, op_code, rd, rs1, rs2, func_code3, func_code7);
-
-                switch ( func_code3 ) {
-                case 0:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // ADDW
-                        // TODO - check register ordering
-                        bundle->addInstruction(
-                            new VanadisAddInstruction<int32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x1:
-                    {
-                        // MULW
-                        // TODO - check register ordering
-                        bundle->addInstruction(
-                            new VanadisMultiplyInstruction<int32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x20:
-                    {
-                        // SUBW
-                        // TODO - check register ordering
-                        bundle->addInstruction(new VanadisSubInstruction<int32_t>(
-                            ins_address, hw_thr, options, rd, rs1, rs2, true));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 1:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // SLLW
-                        // TODO - check register ordering
-                        bundle->addInstruction(
-                            new VanadisShiftLeftLogicalInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT32>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 4:
-                {
-                    switch ( func_code7 ) {
-                    case 0x1:
-                    {
-                        // DIVW
-                        bundle->addInstruction(
-                            new VanadisDivideInstruction<int32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 5:
-                {
-                    switch ( func_code7 ) {
-                    case 0x0:
-                    {
-                        // SRLW
-                        // TODO - check register ordering
-                        bundle->addInstruction(
-                            new VanadisShiftRightLogicalInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT32>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x1:
-                    {
-                        // DIVUW
-                        bundle->addInstruction(
-                            new VanadisDivideInstruction<uint32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    case 0x20:
-                    {
-                        // SRAW
-                        // TODO - check register ordering
-                        bundle->addInstruction(
-                            new VanadisShiftRightArithmeticInstruction<VanadisRegisterFormat::VANADIS_FORMAT_INT32>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 6:
-                {
-                    switch ( func_code7 ) {
-                    case 0x1:
-                    {
-                        // REMW
-                        output->verbose(
-                            CALL_INFO, 16, 0, "----> REMW %" PRIu16 " <- %" PRIu16 " %% %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisModuloInstruction<int32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    };
-                } break;
-                case 7:
-                {
-                    switch ( func_code7 ) {
-                    case 0x1:
-                    {
-                        // REMUW
-                        output->verbose(
-                            CALL_INFO, 16, 0, "----> REMUW %" PRIu16 " <- %" PRIu16 " %% %" PRIu16 "\n", rd, rs1, rs2);
-                        bundle->addInstruction(
-                            new VanadisModuloInstruction<uint32_t>(
-                                ins_address, hw_thr, options, rd, rs1, rs2));
-                        decode_fault = false;
-                    } break;
-                    }
-                }; break;
-                };
-            } break;
-				case 0xF:
-			   {
-                    processR(ins, op_code, rd, rs1, rs2, func_code3, func_code7);
-                    switch ( func_code3 ) {
-                        case 0x0:
-                        {
-					        // Fence operations
-					        // For now, we conduct a heavy fence
-				            // could optimize this to be more efficient
-					        output->verbose(CALL_INFO, 16, 0, "----> FENCE\n");
-					        bundle->addInstruction(
-								    new VanadisFenceInstruction(ins_address, hw_thr, options, VANADIS_LOAD_STORE_FENCE));
-                            decode_fault = false;
-                        } break;
-                    }
-				} break;
             case 0x2F:
             {
                 // Atomic operations (A extension)
@@ -1499,31 +729,6 @@ protected:
                 } break;
                 }
             } break;
-            case 0x27:
-            {
-                // Floating point store
-					 processS<int64_t>(ins, op_code, rs1, rs2, func_code3, simm64);
-
-					 output->verbose(CALL_INFO, 16, 0, "---> STORE-FP func_code3=%" PRIu32 " imm=%" PRId64 " / rs1: %" PRIu16 " / rs2: %" PRIu16 "\n",
-						func_code3, simm64, rs1, rs2);
-
-					switch(func_code3) {
-					case 0x2:
-						{
-							output->verbose(CALL_INFO, 16, 0, "-------> FSW imm=%" PRId64 " / rs1: %" PRIu16 " / rs2: %" PRIu16 "\n", simm64, rs1, rs2);
-							bundle->addInstruction(new VanadisStoreInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rs2, 4, MEM_TRANSACTION_NONE, STORE_FP_REGISTER));
-                        decode_fault = false;
-						} break;
-					case 0x3:
-						{
-							output->verbose(CALL_INFO, 16, 0, "-------> FSD imm=%" PRId64 " / rs1: %" PRIu16 " / rs2: %" PRIu16 "\n", simm64, rs1, rs2);
-							bundle->addInstruction(new VanadisStoreInstruction(
-                        ins_address, hw_thr, options, rs1, simm64, rs2, 8, MEM_TRANSACTION_NONE, STORE_FP_REGISTER));
-                        decode_fault = false;
-						} break;
-					}
-            } break;
             case 0x53:
             {
                 // floating point arithmetic
@@ -0,0 +1,381 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_RISCV64_DECODE_TABLE
+#define _H_VANADIS_RISCV64_DECODE_TABLE
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// This header is deliberately free of SST core dependencies so that
+// stand-alone tools (see tools/decodebench) can use the same tables as
+// the simulated decoder.
+
+namespace SST {
+namespace Vanadis {
+
+enum class VanadisRISCV64Extension : uint8_t { RV64I, RV64M, RV64F, RV64D };
+
+// Every instruction which is resolved through the mask/match table gets
+// an operation identifier, the decoder maps these to factory functions
+// which create the micro-ops
+enum VanadisRISCV64Op : uint16_t {
+    VANADIS_RISCV_OP_LUI,
+    VANADIS_RISCV_OP_AUIPC,
+    VANADIS_RISCV_OP_JAL,
+    VANADIS_RISCV_OP_JALR,
+    VANADIS_RISCV_OP_BEQ,
+    VANADIS_RISCV_OP_BNE,
+    VANADIS_RISCV_OP_BLT,
+    VANADIS_RISCV_OP_BGE,
+    VANADIS_RISCV_OP_BLTU,
+    VANADIS_RISCV_OP_BGEU,
+    VANADIS_RISCV_OP_LB,
+    VANADIS_RISCV_OP_LH,
+    VANADIS_RISCV_OP_LW,
+    VANADIS_RISCV_OP_LD,
+    VANADIS_RISCV_OP_LBU,
+    VANADIS_RISCV_OP_LHU,
+    VANADIS_RISCV_OP_LWU,
+    VANADIS_RISCV_OP_SB,
+    VANADIS_RISCV_OP_SH,
+    VANADIS_RISCV_OP_SW,
+    VANADIS_RISCV_OP_SD,
+    VANADIS_RISCV_OP_ADDI,
+    VANADIS_RISCV_OP_SLTI,
+    VANADIS_RISCV_OP_SLTIU,
+    VANADIS_RISCV_OP_XORI,
+    VANADIS_RISCV_OP_ORI,
+    VANADIS_RISCV_OP_ANDI,
+    VANADIS_RISCV_OP_SLLI,
+    VANADIS_RISCV_OP_SRLI,
+    VANADIS_RISCV_OP_SRAI,
+    VANADIS_RISCV_OP_ADD,
+    VANADIS_RISCV_OP_SUB,
+    VANADIS_RISCV_OP_SLL,
+    VANADIS_RISCV_OP_SLT,
+    VANADIS_RISCV_OP_SLTU,
+    VANADIS_RISCV_OP_XOR,
+    VANADIS_RISCV_OP_SRL,
+    VANADIS_RISCV_OP_SRA,
+    VANADIS_RISCV_OP_OR,
+    VANADIS_RISCV_OP_AND,
+    VANADIS_RISCV_OP_FENCE,
+    VANADIS_RISCV_OP_ADDIW,
+    VANADIS_RISCV_OP_SLLIW,
+    VANADIS_RISCV_OP_SRLIW,
+    VANADIS_RISCV_OP_SRAIW,
+    VANADIS_RISCV_OP_ADDW,
+    VANADIS_RISCV_OP_SUBW,
+    VANADIS_RISCV_OP_SLLW,
+    VANADIS_RISCV_OP_SRLW,
+    VANADIS_RISCV_OP_SRAW,
+    VANADIS_RISCV_OP_MUL,
+    VANADIS_RISCV_OP_MULH,
+    VANADIS_RISCV_OP_MULHSU,
+    VANADIS_RISCV_OP_MULHU,
+    VANADIS_RISCV_OP_DIV,
+    VANADIS_RISCV_OP_DIVU,
+    VANADIS_RISCV_OP_REM,
+    VANADIS_RISCV_OP_REMU,
+    VANADIS_RISCV_OP_MULW,
+    VANADIS_RISCV_OP_DIVW,
+    VANADIS_RISCV_OP_DIVUW,
+    VANADIS_RISCV_OP_REMW,
+    VANADIS_RISCV_OP_REMUW,
+    VANADIS_RISCV_OP_FLW,
+    VANADIS_RISCV_OP_FSW,
+    VANADIS_RISCV_OP_FLD,
+    VANADIS_RISCV_OP_FSD,
+    VANADIS_RISCV_OP_COUNT
+};
+
+struct VanadisRISCV64DecodeEntry
+{
+    uint32_t                mask     = 0;
+    uint32_t                match    = 0;
+    VanadisRISCV64Op        op       = VANADIS_RISCV_OP_COUNT;
+    VanadisRISCV64Extension ext      = VanadisRISCV64Extension::RV64I;
+    const char*             mnemonic = "";
+};
+
+// Encoding masks for the common RISC-V formats
+#define VANADIS_RISCV_MATCH_OPCODE      0x0000007F
+#define VANADIS_RISCV_MATCH_FUNC3       0x0000707F
+#define VANADIS_RISCV_MATCH_FUNC7       0xFE00707F
+#define VANADIS_RISCV_MATCH_FUNC6_SHAMT 0xFC00707F
+
+// Field extraction, these are shared by the decoder factories and any tools
+// which walk the same tables
+constexpr uint16_t
+vanadis_riscv_rd(const uint32_t ins)
+{
+    return static_cast<uint16_t>((ins >> 7) & 0x1F);
+}
+
+constexpr uint16_t
+vanadis_riscv_rs1(const uint32_t ins)
+{
+    return static_cast<uint16_t>((ins >> 15) & 0x1F);
+}
+
+constexpr uint16_t
+vanadis_riscv_rs2(const uint32_t ins)
+{
+    return static_cast<uint16_t>((ins >> 20) & 0x1F);
+}
+
+constexpr uint32_t
+vanadis_riscv_major_opcode(const uint32_t ins)
+{
+    return (ins >> 2) & 0x1F;
+}
+
+constexpr int64_t
+vanadis_riscv_imm_i(const uint32_t ins)
+{
+    return static_cast<int64_t>(static_cast<int32_t>(ins) >> 20);
+}
+
+constexpr int64_t
+vanadis_riscv_imm_s(const uint32_t ins)
+{
+    return static_cast<int64_t>(
+        (static_cast<int32_t>(ins & 0xFE000000) >> 20) | static_cast<int32_t>((ins >> 7) & 0x1F));
+}
+
+constexpr int64_t
+vanadis_riscv_imm_b(const uint32_t ins)
+{
+    return static_cast<int64_t>(
+        (static_cast<int32_t>(ins & 0x80000000) >> 19) | static_cast<int32_t>((ins & 0x80) << 4) |
+        static_cast<int32_t>((ins >> 20) & 0x7E0) | static_cast<int32_t>((ins >> 7) & 0x1E));
+}
+
+constexpr int64_t
+vanadis_riscv_imm_u(const uint32_t ins)
+{
+    return static_cast<int64_t>(static_cast<int32_t>(ins & 0xFFFFF000));
+}
+
+constexpr int64_t
+vanadis_riscv_imm_j(const uint32_t ins)
+{
+    return static_cast<int64_t>(
+        (static_cast<int32_t>(ins & 0x80000000) >> 11) | static_cast<int32_t>(ins & 0xFF000) |
+        static_cast<int32_t>((ins >> 9) & 0x800) | static_cast<int32_t>((ins >> 20) & 0x7FE));
+}
+
+constexpr uint32_t
+vanadis_riscv_shamt6(const uint32_t ins)
+{
+    return (ins >> 20) & 0x3F;
+}
+
+constexpr uint32_t
+vanadis_riscv_shamt5(const uint32_t ins)
+{
+    return (ins >> 20) & 0x1F;
+}
+
+// RV64I base integer instruction set, also contains FENCE (the only Zifencei
+// /memory ordering instruction we model). ECALL and the CSR instructions
+// generate multiple or state dependent micro-ops and remain in the decoder.
+constexpr std::array<VanadisRISCV64DecodeEntry, 50> vanadis_riscv64_rv64i_table = { {
+    { VANADIS_RISCV_MATCH_OPCODE, 0x00000037, VANADIS_RISCV_OP_LUI, VanadisRISCV64Extension::RV64I, "LUI" },
+    { VANADIS_RISCV_MATCH_OPCODE, 0x00000017, VANADIS_RISCV_OP_AUIPC, VanadisRISCV64Extension::RV64I, "AUIPC" },
+    { VANADIS_RISCV_MATCH_OPCODE, 0x0000006F, VANADIS_RISCV_OP_JAL, VanadisRISCV64Extension::RV64I, "JAL" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00000067, VANADIS_RISCV_OP_JALR, VanadisRISCV64Extension::RV64I, "JALR" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00000063, VANADIS_RISCV_OP_BEQ, VanadisRISCV64Extension::RV64I, "BEQ" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00001063, VANADIS_RISCV_OP_BNE, VanadisRISCV64Extension::RV64I, "BNE" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00004063, VANADIS_RISCV_OP_BLT, VanadisRISCV64Extension::RV64I, "BLT" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00005063, VANADIS_RISCV_OP_BGE, VanadisRISCV64Extension::RV64I, "BGE" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00006063, VANADIS_RISCV_OP_BLTU, VanadisRISCV64Extension::RV64I, "BLTU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00007063, VANADIS_RISCV_OP_BGEU, VanadisRISCV64Extension::RV64I, "BGEU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00000003, VANADIS_RISCV_OP_LB, VanadisRISCV64Extension::RV64I, "LB" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00001003, VANADIS_RISCV_OP_LH, VanadisRISCV64Extension::RV64I, "LH" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00002003, VANADIS_RISCV_OP_LW, VanadisRISCV64Extension::RV64I, "LW" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00003003, VANADIS_RISCV_OP_LD, VanadisRISCV64Extension::RV64I, "LD" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00004003, VANADIS_RISCV_OP_LBU, VanadisRISCV64Extension::RV64I, "LBU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00005003, VANADIS_RISCV_OP_LHU, VanadisRISCV64Extension::RV64I, "LHU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00006003, VANADIS_RISCV_OP_LWU, VanadisRISCV64Extension::RV64I, "LWU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00000023, VANADIS_RISCV_OP_SB, VanadisRISCV64Extension::RV64I, "SB" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00001023, VANADIS_RISCV_OP_SH, VanadisRISCV64Extension::RV64I, "SH" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00002023, VANADIS_RISCV_OP_SW, VanadisRISCV64Extension::RV64I, "SW" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00003023, VANADIS_RISCV_OP_SD, VanadisRISCV64Extension::RV64I, "SD" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00000013, VANADIS_RISCV_OP_ADDI, VanadisRISCV64Extension::RV64I, "ADDI" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00002013, VANADIS_RISCV_OP_SLTI, VanadisRISCV64Extension::RV64I, "SLTI" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00003013, VANADIS_RISCV_OP_SLTIU, VanadisRISCV64Extension::RV64I, "SLTIU" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00004013, VANADIS_RISCV_OP_XORI, VanadisRISCV64Extension::RV64I, "XORI" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00006013, VANADIS_RISCV_OP_ORI, VanadisRISCV64Extension::RV64I, "ORI" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00007013, VANADIS_RISCV_OP_ANDI, VanadisRISCV64Extension::RV64I, "ANDI" },
+    { VANADIS_RISCV_MATCH_FUNC6_SHAMT, 0x00001013, VANADIS_RISCV_OP_SLLI, VanadisRISCV64Extension::RV64I, "SLLI" },
+    { VANADIS_RISCV_MATCH_FUNC6_SHAMT, 0x00005013, VANADIS_RISCV_OP_SRLI, VanadisRISCV64Extension::RV64I, "SRLI" },
+    { VANADIS_RISCV_MATCH_FUNC6_SHAMT, 0x40005013, VANADIS_RISCV_OP_SRAI, VanadisRISCV64Extension::RV64I, "SRAI" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00000033, VANADIS_RISCV_OP_ADD, VanadisRISCV64Extension::RV64I, "ADD" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x40000033, VANADIS_RISCV_OP_SUB, VanadisRISCV64Extension::RV64I, "SUB" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00001033, VANADIS_RISCV_OP_SLL, VanadisRISCV64Extension::RV64I, "SLL" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00002033, VANADIS_RISCV_OP_SLT, VanadisRISCV64Extension::RV64I, "SLT" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00003033, VANADIS_RISCV_OP_SLTU, VanadisRISCV64Extension::RV64I, "SLTU" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00004033, VANADIS_RISCV_OP_XOR, VanadisRISCV64Extension::RV64I, "XOR" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00005033, VANADIS_RISCV_OP_SRL, VanadisRISCV64Extension::RV64I, "SRL" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x40005033, VANADIS_RISCV_OP_SRA, VanadisRISCV64Extension::RV64I, "SRA" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00006033, VANADIS_RISCV_OP_OR, VanadisRISCV64Extension::RV64I, "OR" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x00007033, VANADIS_RISCV_OP_AND, VanadisRISCV64Extension::RV64I, "AND" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x0000000F, VANADIS_RISCV_OP_FENCE, VanadisRISCV64Extension::RV64I, "FENCE" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x0000001B, VANADIS_RISCV_OP_ADDIW, VanadisRISCV64Extension::RV64I, "ADDIW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0000101B, VANADIS_RISCV_OP_SLLIW, VanadisRISCV64Extension::RV64I, "SLLIW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0000501B, VANADIS_RISCV_OP_SRLIW, VanadisRISCV64Extension::RV64I, "SRLIW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x4000501B, VANADIS_RISCV_OP_SRAIW, VanadisRISCV64Extension::RV64I, "SRAIW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0000003B, VANADIS_RISCV_OP_ADDW, VanadisRISCV64Extension::RV64I, "ADDW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x4000003B, VANADIS_RISCV_OP_SUBW, VanadisRISCV64Extension::RV64I, "SUBW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0000103B, VANADIS_RISCV_OP_SLLW, VanadisRISCV64Extension::RV64I, "SLLW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0000503B, VANADIS_RISCV_OP_SRLW, VanadisRISCV64Extension::RV64I, "SRLW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x4000503B, VANADIS_RISCV_OP_SRAW, VanadisRISCV64Extension::RV64I, "SRAW" },
+} };
+
+// RV64M integer multiply/divide
+constexpr std::array<VanadisRISCV64DecodeEntry, 13> vanadis_riscv64_rv64m_table = { {
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02000033, VANADIS_RISCV_OP_MUL, VanadisRISCV64Extension::RV64M, "MUL" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02001033, VANADIS_RISCV_OP_MULH, VanadisRISCV64Extension::RV64M, "MULH" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02002033, VANADIS_RISCV_OP_MULHSU, VanadisRISCV64Extension::RV64M, "MULHSU" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02003033, VANADIS_RISCV_OP_MULHU, VanadisRISCV64Extension::RV64M, "MULHU" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02004033, VANADIS_RISCV_OP_DIV, VanadisRISCV64Extension::RV64M, "DIV" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02005033, VANADIS_RISCV_OP_DIVU, VanadisRISCV64Extension::RV64M, "DIVU" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02006033, VANADIS_RISCV_OP_REM, VanadisRISCV64Extension::RV64M, "REM" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x02007033, VANADIS_RISCV_OP_REMU, VanadisRISCV64Extension::RV64M, "REMU" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0200003B, VANADIS_RISCV_OP_MULW, VanadisRISCV64Extension::RV64M, "MULW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0200403B, VANADIS_RISCV_OP_DIVW, VanadisRISCV64Extension::RV64M, "DIVW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0200503B, VANADIS_RISCV_OP_DIVUW, VanadisRISCV64Extension::RV64M, "DIVUW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0200603B, VANADIS_RISCV_OP_REMW, VanadisRISCV64Extension::RV64M, "REMW" },
+    { VANADIS_RISCV_MATCH_FUNC7, 0x0200703B, VANADIS_RISCV_OP_REMUW, VanadisRISCV64Extension::RV64M, "REMUW" },
+} };
+
+// RV64F/RV64D memory operations, the floating point arithmetic is still
+// decoded by the switch in the decoder because of rounding-mode handling
+constexpr std::array<VanadisRISCV64DecodeEntry, 4> vanadis_riscv64_rv64fd_mem_table = { {
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00002007, VANADIS_RISCV_OP_FLW, VanadisRISCV64Extension::RV64F, "FLW" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00002027, VANADIS_RISCV_OP_FSW, VanadisRISCV64Extension::RV64F, "FSW" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00003007, VANADIS_RISCV_OP_FLD, VanadisRISCV64Extension::RV64D, "FLD" },
+    { VANADIS_RISCV_MATCH_FUNC3, 0x00003027, VANADIS_RISCV_OP_FSD, VanadisRISCV64Extension::RV64D, "FSD" },
+} };
+
+template <size_t A, size_t B>
+constexpr std::array<VanadisRISCV64DecodeEntry, A + B>
+vanadisConcatDecodeTables(
+    const std::array<VanadisRISCV64DecodeEntry, A>& left, const std::array<VanadisRISCV64DecodeEntry, B>& right)
+{
+    std::array<VanadisRISCV64DecodeEntry, A + B> result {};
+
+    for ( size_t i = 0; i < A; ++i ) {
+        result[i] = left[i];
+    }
+
+    for ( size_t i = 0; i < B; ++i ) {
+        result[A + i] = right[i];
+    }
+
+    return result;
+}
+
+// A table is well formed when every match value only has bits set inside
+// its mask, every entry is a 32b encoding and no two entries can match the
+// same instruction word (so the order of entries does not matter). Each
+// operation may only appear once.
+template <size_t N>
+constexpr bool
+vanadisDecodeTableWellFormed(const std::array<VanadisRISCV64DecodeEntry, N>& table)
+{
+    for ( size_t i = 0; i < N; ++i ) {
+        if ( (table[i].match & ~table[i].mask) != 0 ) { return false; }
+        if ( (table[i].match & 0x3) != 0x3 ) { return false; }
+        if ( table[i].op == VANADIS_RISCV_OP_COUNT ) { return false; }
+
+        for ( size_t j = i + 1; j < N; ++j ) {
+            const uint32_t common_mask = table[i].mask & table[j].mask;
+            if ( ((table[i].match ^ table[j].match) & common_mask) == 0 ) { return false; }
+            if ( table[i].op == table[j].op ) { return false; }
+        }
+    }
+
+    return true;
+}
+
+// Groups table entries by the major opcode (bits 6:2) so a lookup only has
+// to walk the handful of encodings which share that opcode. The grouping is
+// performed at compile time.
+template <size_t N>
+class VanadisRISCV64DecodeTable
+{
+public:
+    constexpr explicit VanadisRISCV64DecodeTable(const std::array<VanadisRISCV64DecodeEntry, N>& table) :
+        entries(),
+        group_start(),
+        group_end()
+    {
+        size_t next = 0;
+
+        for ( uint32_t major = 0; major < 32; ++major ) {
+            group_start[major] = static_cast<uint16_t>(next);
+
+            for ( size_t i = 0; i < N; ++i ) {
+                if ( vanadis_riscv_major_opcode(table[i].match) == major ) { entries[next++] = table[i]; }
+            }
+
+            group_end[major] = static_cast<uint16_t>(next);
+        }
+    }
+
+    // Returns the entry matching ins or nullptr if the table does not
+    // contain the encoding. ins must be a 32b (non-RVC) instruction.
+    const VanadisRISCV64DecodeEntry* find(const uint32_t ins) const
+    {
+        const uint32_t major = vanadis_riscv_major_opcode(ins);
+
+        for ( uint16_t i = group_start[major]; i < group_end[major]; ++i ) {
+            if ( (ins & entries[i].mask) == entries[i].match ) { return &entries[i]; }
+        }
+
+        return nullptr;
+    }
+
+    constexpr size_t size() const { return N; }
+    constexpr size_t groupSize(const uint32_t major) const { return group_end[major] - group_start[major]; }
+
+private:
+    std::array<VanadisRISCV64DecodeEntry, N> entries;
+    std::array<uint16_t, 32>                 group_start;
+    std::array<uint16_t, 32>                 group_end;
+};
+
+constexpr auto vanadis_riscv64_decode_entries = vanadisConcatDecodeTables(
+    vanadisConcatDecodeTables(vanadis_riscv64_rv64i_table, vanadis_riscv64_rv64m_table),
+    vanadis_riscv64_rv64fd_mem_table);
+
+static_assert(
+    vanadisDecodeTableWellFormed(vanadis_riscv64_decode_entries),
+    "RISC-V decode table contains an invalid or ambiguous encoding");
+static_assert(
+    vanadis_riscv64_decode_entries.size() == VANADIS_RISCV_OP_COUNT,
+    "RISC-V decode table must contain one encoding for every operation");
+
+constexpr VanadisRISCV64DecodeTable<vanadis_riscv64_decode_entries.size()> vanadis_riscv64_decode_table(
+    vanadis_riscv64_decode_entries);
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,284 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_RISCV64_FACTORY
+#define _H_VANADIS_RISCV64_FACTORY
+
+#include "decoder/vdecoder.h"
+#include "decoder/vriscv64dectable.h"
+#include "inst/vinstall.h"
+
+#include <array>
+#include <cstdint>
+
+namespace SST {
+namespace Vanadis {
+
+// Creates the micro-ops for a single table-decoded instruction and places
+// them into the bundle. ins_width is the number of bytes the encoding
+// occupies in memory (used for link/branch return addresses).
+typedef void (*VanadisRISCV64FactoryFunc)(
+    const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+    const uint64_t ins_width, VanadisInstructionBundle* bundle);
+
+class VanadisRISCV64InstructionFactory
+{
+public:
+    template <uint16_t width, bool sign_extend, VanadisLoadRegisterType reg_type>
+    static void createLoad(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisLoadInstruction(
+            ins_address, hw_thr, options, vanadis_riscv_rs1(ins), vanadis_riscv_imm_i(ins), vanadis_riscv_rd(ins),
+            width, sign_extend, MEM_TRANSACTION_NONE, reg_type));
+    }
+
+    template <uint16_t width, VanadisStoreRegisterType reg_type>
+    static void createStore(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisStoreInstruction(
+            ins_address, hw_thr, options, vanadis_riscv_rs1(ins), vanadis_riscv_imm_s(ins), vanadis_riscv_rs2(ins),
+            width, MEM_TRANSACTION_NONE, reg_type));
+    }
+
+    template <typename register_format, VanadisRegisterCompareType compare_type>
+    static void createBranch(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisBranchRegCompareInstruction<register_format, compare_type>(
+            ins_address, hw_thr, options, ins_width, vanadis_riscv_rs1(ins), vanadis_riscv_rs2(ins),
+            vanadis_riscv_imm_b(ins), VANADIS_NO_DELAY_SLOT));
+    }
+
+    // Register-register operations, T is the instruction class
+    template <typename T>
+    static void createRType(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(
+            new T(ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins), vanadis_riscv_rs2(ins)));
+    }
+
+    // Register-immediate operations, T is the instruction class and the
+    // immediate is the sign-extended 12b I-type value
+    template <typename T>
+    static void createIType(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(
+            new T(ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins), vanadis_riscv_imm_i(ins)));
+    }
+
+    // Shift-immediate operations, 6b shift amounts for 64b shifts, 5b for the
+    // W-variants
+    template <typename T, bool shamt_64>
+    static void createShiftImm(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new T(
+            ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins),
+            shamt_64 ? vanadis_riscv_shamt6(ins) : vanadis_riscv_shamt5(ins)));
+    }
+
+    template <typename gpr_format, bool trap_overflow>
+    static void createSub(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisSubInstruction<gpr_format>(
+            ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins), vanadis_riscv_rs2(ins),
+            trap_overflow));
+    }
+
+    static void createADDIW(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisAddImmInstruction<int32_t>(
+            ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins),
+            static_cast<int32_t>(vanadis_riscv_imm_i(ins))));
+    }
+
+    static void createLUI(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisSetRegisterInstruction<int32_t>(
+            ins_address, hw_thr, options, vanadis_riscv_rd(ins), static_cast<int32_t>(vanadis_riscv_imm_u(ins))));
+    }
+
+    static void createAUIPC(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisPCAddImmInstruction<int64_t>(
+            ins_address, hw_thr, options, vanadis_riscv_rd(ins), vanadis_riscv_imm_u(ins)));
+    }
+
+    static void createJAL(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        // Immediate specifies jump in multiples of 2 byts per RISCV spec
+        const int64_t jump_to = static_cast<int64_t>(ins_address) + vanadis_riscv_imm_j(ins);
+
+        bundle->addInstruction(new VanadisJumpLinkInstruction(
+            ins_address, hw_thr, options, ins_width, vanadis_riscv_rd(ins), jump_to, VANADIS_NO_DELAY_SLOT));
+    }
+
+    static void createJALR(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        bundle->addInstruction(new VanadisJumpRegLinkInstruction(
+            ins_address, hw_thr, options, ins_width, vanadis_riscv_rd(ins), vanadis_riscv_rs1(ins),
+            vanadis_riscv_imm_i(ins), VANADIS_NO_DELAY_SLOT));
+    }
+
+    static void createFENCE(
+        const uint64_t ins_address, const uint32_t hw_thr, const VanadisDecoderOptions* options, const uint32_t ins,
+        const uint64_t ins_width, VanadisInstructionBundle* bundle)
+    {
+        // For now, we conduct a heavy fence, could optimize this to be more
+        // efficient by looking at the predecessor/successor sets
+        bundle->addInstruction(new VanadisFenceInstruction(ins_address, hw_thr, options, VANADIS_LOAD_STORE_FENCE));
+    }
+};
+
+// Maps every table operation to the factory which creates its micro-ops,
+// indexed by VanadisRISCV64Op
+constexpr std::array<VanadisRISCV64FactoryFunc, VANADIS_RISCV_OP_COUNT>
+vanadisBuildRISCV64Factories()
+{
+    typedef VanadisRISCV64InstructionFactory F;
+    typedef VanadisRegisterFormat            RF;
+
+    std::array<VanadisRISCV64FactoryFunc, VANADIS_RISCV_OP_COUNT> f {};
+
+    f[VANADIS_RISCV_OP_LUI]   = &F::createLUI;
+    f[VANADIS_RISCV_OP_AUIPC] = &F::createAUIPC;
+    f[VANADIS_RISCV_OP_JAL]   = &F::createJAL;
+    f[VANADIS_RISCV_OP_JALR]  = &F::createJALR;
+
+    f[VANADIS_RISCV_OP_BEQ]  = &F::createBranch<int64_t, REG_COMPARE_EQ>;
+    f[VANADIS_RISCV_OP_BNE]  = &F::createBranch<int64_t, REG_COMPARE_NEQ>;
+    f[VANADIS_RISCV_OP_BLT]  = &F::createBranch<int64_t, REG_COMPARE_LT>;
+    f[VANADIS_RISCV_OP_BGE]  = &F::createBranch<int64_t, REG_COMPARE_GTE>;
+    f[VANADIS_RISCV_OP_BLTU] = &F::createBranch<uint64_t, REG_COMPARE_LT>;
+    f[VANADIS_RISCV_OP_BGEU] = &F::createBranch<uint64_t, REG_COMPARE_GTE>;
+
+    f[VANADIS_RISCV_OP_LB]  = &F::createLoad<1, true, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LH]  = &F::createLoad<2, true, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LW]  = &F::createLoad<4, true, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LD]  = &F::createLoad<8, true, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LBU] = &F::createLoad<1, false, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LHU] = &F::createLoad<2, false, LOAD_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_LWU] = &F::createLoad<4, false, LOAD_INT_REGISTER>;
+
+    f[VANADIS_RISCV_OP_SB] = &F::createStore<1, STORE_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_SH] = &F::createStore<2, STORE_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_SW] = &F::createStore<4, STORE_INT_REGISTER>;
+    f[VANADIS_RISCV_OP_SD] = &F::createStore<8, STORE_INT_REGISTER>;
+
+    f[VANADIS_RISCV_OP_ADDI]  = &F::createIType<VanadisAddImmInstruction<int64_t>>;
+    f[VANADIS_RISCV_OP_SLTI]  = &F::createIType<VanadisSetRegCompareImmInstruction<REG_COMPARE_LT, int64_t>>;
+    f[VANADIS_RISCV_OP_SLTIU] = &F::createIType<VanadisSetRegCompareImmInstruction<REG_COMPARE_LT, uint64_t>>;
+    f[VANADIS_RISCV_OP_XORI]  = &F::createIType<VanadisXorImmInstruction>;
+    f[VANADIS_RISCV_OP_ORI]   = &F::createIType<VanadisOrImmInstruction>;
+    f[VANADIS_RISCV_OP_ANDI]  = &F::createIType<VanadisAndImmInstruction>;
+
+    f[VANADIS_RISCV_OP_SLLI] = &F::createShiftImm<VanadisShiftLeftLogicalImmInstruction<uint64_t>, true>;
+    f[VANADIS_RISCV_OP_SRLI] =
+        &F::createShiftImm<VanadisShiftRightLogicalImmInstruction<RF::VANADIS_FORMAT_INT64>, true>;
+    f[VANADIS_RISCV_OP_SRAI] =
+        &F::createShiftImm<VanadisShiftRightArithmeticImmInstruction<RF::VANADIS_FORMAT_INT64>, true>;
+
+    f[VANADIS_RISCV_OP_ADD]  = &F::createRType<VanadisAddInstruction<int64_t>>;
+    f[VANADIS_RISCV_OP_SUB]  = &F::createSub<int64_t, false>;
+    f[VANADIS_RISCV_OP_SLL]  = &F::createRType<VanadisShiftLeftLogicalInstruction<RF::VANADIS_FORMAT_INT64>>;
+    f[VANADIS_RISCV_OP_SLT]  = &F::createRType<VanadisSetRegCompareInstruction<REG_COMPARE_LT, int64_t>>;
+    f[VANADIS_RISCV_OP_SLTU] = &F::createRType<VanadisSetRegCompareInstruction<REG_COMPARE_LT, uint64_t>>;
+    f[VANADIS_RISCV_OP_XOR]  = &F::createRType<VanadisXorInstruction>;
+    f[VANADIS_RISCV_OP_SRL]  = &F::createRType<VanadisShiftRightLogicalInstruction<RF::VANADIS_FORMAT_INT64>>;
+    f[VANADIS_RISCV_OP_SRA]  = &F::createRType<VanadisShiftRightArithmeticInstruction<RF::VANADIS_FORMAT_INT64>>;
+    f[VANADIS_RISCV_OP_OR]   = &F::createRType<VanadisOrInstruction>;
+    f[VANADIS_RISCV_OP_AND]  = &F::createRType<VanadisAndInstruction>;
+
+    f[VANADIS_RISCV_OP_FENCE] = &F::createFENCE;
+
+    f[VANADIS_RISCV_OP_ADDIW] = &F::createADDIW;
+    f[VANADIS_RISCV_OP_SLLIW] = &F::createShiftImm<VanadisShiftLeftLogicalImmInstruction<uint32_t>, false>;
+    f[VANADIS_RISCV_OP_SRLIW] =
+        &F::createShiftImm<VanadisShiftRightLogicalImmInstruction<RF::VANADIS_FORMAT_INT32>, false>;
+    f[VANADIS_RISCV_OP_SRAIW] =
+        &F::createShiftImm<VanadisShiftRightArithmeticImmInstruction<RF::VANADIS_FORMAT_INT32>, false>;
+
+    f[VANADIS_RISCV_OP_ADDW] = &F::createRType<VanadisAddInstruction<int32_t>>;
+    f[VANADIS_RISCV_OP_SUBW] = &F::createSub<int32_t, true>;
+    f[VANADIS_RISCV_OP_SLLW] = &F::createRType<VanadisShiftLeftLogicalInstruction<RF::VANADIS_FORMAT_INT32>>;
+    f[VANADIS_RISCV_OP_SRLW] = &F::createRType<VanadisShiftRightLogicalInstruction<RF::VANADIS_FORMAT_INT32>>;
+    f[VANADIS_RISCV_OP_SRAW] = &F::createRType<VanadisShiftRightArithmeticInstruction<RF::VANADIS_FORMAT_INT32>>;
+
+    f[VANADIS_RISCV_OP_MUL]    = &F::createRType<VanadisMultiplyInstruction<int64_t>>;
+    f[VANADIS_RISCV_OP_MULH]   = &F::createRType<VanadisMultiplyHighInstruction<int64_t, int64_t>>;
+    f[VANADIS_RISCV_OP_MULHSU] = &F::createRType<VanadisMultiplyHighInstruction<int64_t, uint64_t>>;
+    f[VANADIS_RISCV_OP_MULHU]  = &F::createRType<VanadisMultiplyHighInstruction<uint64_t, uint64_t>>;
+    f[VANADIS_RISCV_OP_DIV]    = &F::createRType<VanadisDivideInstruction<int64_t>>;
+    f[VANADIS_RISCV_OP_DIVU]   = &F::createRType<VanadisDivideInstruction<uint64_t>>;
+    f[VANADIS_RISCV_OP_REM]    = &F::createRType<VanadisModuloInstruction<int64_t>>;
+    f[VANADIS_RISCV_OP_REMU]   = &F::createRType<VanadisModuloInstruction<uint64_t>>;
+
+    f[VANADIS_RISCV_OP_MULW]  = &F::createRType<VanadisMultiplyInstruction<int32_t>>;
+    f[VANADIS_RISCV_OP_DIVW]  = &F::createRType<VanadisDivideInstruction<int32_t>>;
+    f[VANADIS_RISCV_OP_DIVUW] = &F::createRType<VanadisDivideInstruction<uint32_t>>;
+    f[VANADIS_RISCV_OP_REMW]  = &F::createRType<VanadisModuloInstruction<int32_t>>;
+    f[VANADIS_RISCV_OP_REMUW] = &F::createRType<VanadisModuloInstruction<uint32_t>>;
+
+    f[VANADIS_RISCV_OP_FLW] = &F::createLoad<4, true, LOAD_FP_REGISTER>;
+    f[VANADIS_RISCV_OP_FSW] = &F::createStore<4, STORE_FP_REGISTER>;
+    f[VANADIS_RISCV_OP_FLD] = &F::createLoad<8, true, LOAD_FP_REGISTER>;
+    f[VANADIS_RISCV_OP_FSD] = &F::createStore<8, STORE_FP_REGISTER>;
+
+    return f;
+}
+
+constexpr bool
+vanadisRISCV64FactoriesComplete(const std::array<VanadisRISCV64FactoryFunc, VANADIS_RISCV_OP_COUNT>& factories)
+{
+    for ( size_t i = 0; i < factories.size(); ++i ) {
+        if ( nullptr == factories[i] ) { return false; }
+    }
+
+    return true;
+}
+
+constexpr std::array<VanadisRISCV64FactoryFunc, VANADIS_RISCV_OP_COUNT> vanadis_riscv64_factories =
+    vanadisBuildRISCV64Factories();
+
+static_assert(
+    vanadisRISCV64FactoriesComplete(vanadis_riscv64_factories),
+    "every RISC-V decode table operation must have a micro-op factory");
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
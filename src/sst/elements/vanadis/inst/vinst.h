@@ -37,6 +37,7 @@ public:
         const uint16_t c_isa_int_reg_out, const uint16_t c_phys_fp_reg_in, const uint16_t c_phys_fp_reg_out,
         const uint16_t c_isa_fp_reg_in, const uint16_t c_isa_fp_reg_out) :
         ins_address(address),
+        ins_bits(0),
         hw_thread(hw_thr),
         isa_options(isa_opts),
         count_phys_int_reg_in(c_phys_int_reg_in),
@@ -94,6 +95,7 @@ public:
 
     VanadisInstruction(const VanadisInstruction& copy_me) :
         ins_address(copy_me.ins_address),
+        ins_bits(copy_me.ins_bits),
         hw_thread(copy_me.hw_thread),
         isa_options(copy_me.isa_options),
         count_phys_int_reg_in(copy_me.count_phys_int_reg_in),
@@ -304,6 +306,10 @@ public:
     bool trapsError() const { return trapError; }
 
     uint64_t getInstructionAddress() const { return ins_address; }
+
+    // the instruction word this micro-op was decoded from, for the commit log
+    void     setInstructionBits(const uint32_t bits) { ins_bits = bits; }
+    uint32_t getInstructionBits() const { return ins_bits; }
     uint32_t getHWThread() const { return hw_thread; }
 
     virtual const char* getInstCode() const = 0;
@@ -350,6 +356,7 @@ public:
 
 protected:
     const uint64_t ins_address;
+    uint32_t       ins_bits;
     const uint32_t hw_thread;
 
     uint16_t count_isa_int_reg_in;
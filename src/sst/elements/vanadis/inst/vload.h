@@ -45,7 +45,8 @@ public:
         load_width(load_bytes),
         signed_extend(extend_sign),
         memAccessType(accessT),
-        regType(regT)
+        regType(regT),
+        replay_required(false)
     {
 
         isa_int_regs_in[0] = memAddrReg;
@@ -191,12 +192,18 @@ public:
 
     virtual uint16_t getRegisterOffset() const { return 0; }
 
+    // Set by the LSQ when the load was issued speculatively ahead of an older
+    // store that turned out to overlap it, the pipeline must restart at this load
+    void markReplayRequired() { replay_required = true; }
+    bool requiresReplay() const { return replay_required; }
+
 protected:
     const bool               signed_extend;
     VanadisMemoryTransaction memAccessType;
     const int64_t            offset;
     const uint16_t           load_width;
     VanadisLoadRegisterType  regType;
+    bool                     replay_required;
 };
 
 } // namespace Vanadis
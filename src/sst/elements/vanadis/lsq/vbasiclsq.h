@@ -30,6 +30,9 @@
 #include <cstdint>
 #include <vector>
 #include <queue>
+#include <deque>
+#include <set>
+#include <unordered_map>
 
 using namespace SST::Interfaces;
 
@@ -54,7 +57,8 @@ public:
             { "max_loads", "Set the maximum number of loads permitted in the queue", "16" },
             { "address_mask", "Can mask off address bits if needed during construction of a operation", "0xFFFFFFFFFFFFFFFF"},
             { "issues_per_cycle", "Maximum number of issues the LSQ can attempt per cycle.", "2"},
-            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"}
+            { "cache_line_width", "Number of bytes in a (L1) cache line", "64"},
+            { "store_set_entries", "Number of entries in the store-set dependence predictor, loads predicted independent may issue ahead of older stores with unknown addresses (0 = disabled, loads wait for all older stores)", "0"}
         )
 
     SST_ELI_DOCUMENT_STATISTICS({ "bytes_read", "Count all the bytes read for data operations", "bytes", 1 },
@@ -70,12 +74,16 @@ public:
                                 { "stores_in_flight", "Count the number of stores which are in-flight", "operations", 1},
                                 { "store_buffer_entries", "Count the number of stores held in the store buffer", "operations", 1},
                                 { "split_stores", "Count the number of stores which are fractured due to cache boundaries", "operations", 1},
-                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1})
+                                { "split_loads", "Count the number of loads which are fractured due to cache boundaries", "operations", 1},
+                                { "speculative_loads", "Count the number of loads issued ahead of older stores with unknown addresses", "operations", 1},
+                                { "memory_order_violations", "Count the number of speculative loads which overlapped an older store and must be replayed", "operations", 1},
+                                { "store_set_stalls", "Count the number of times the store-set predictor held a load behind an older store", "operations", 1})
 
     VanadisBasicLoadStoreQueue(ComponentId_t id, Params& params, int coreid, int hwthreads) : VanadisLoadStoreQueue(id, params, coreid, hwthreads),
         max_stores(params.find<size_t>("max_stores", 8)),
         max_loads(params.find<size_t>("max_loads", 16)),
-        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)) {
+        max_issue_attempts_per_cycle(params.find("issues_per_cycle", 2)),
+        store_set_entries(params.find<size_t>("store_set_entries", 0)) {
 
         std_mem_handlers = new VanadisBasicLoadStoreQueue::StandardMemHandlers(this, output);
 
@@ -96,6 +104,17 @@ public:
         stores_pending_index = 0;
         stores_pending_size = 0;
 
+        store_index.resize(hw_threads);
+        speculative_loads.resize(hw_threads);
+
+        store_set_ids.resize(store_set_entries, 0);
+        next_store_set_id = 1;
+
+        // payload buffers are reused for every operation, a request never
+        // covers more than a single cache line or register
+        store_payload.reserve(cache_line_width);
+        load_register_buffer.reserve(64);
+
         stat_loads_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_stores_issued = registerStatistic<uint64_t>("stores_issued", "1");
         stat_fences_issued = registerStatistic<uint64_t>("fences_issued", "1");
@@ -111,6 +130,10 @@ public:
         stat_stores_pending = registerStatistic<uint64_t>("stores_in_flight", "1");
         stat_loads_pending = registerStatistic<uint64_t>("loads_in_flight", "1");
         stat_op_q_size = registerStatistic<uint64_t>("operations_pending");
+
+        stat_speculative_loads = registerStatistic<uint64_t>("speculative_loads", "1");
+        stat_order_violations = registerStatistic<uint64_t>("memory_order_violations", "1");
+        stat_store_set_stalls = registerStatistic<uint64_t>("store_set_stalls", "1");
     }
 
     virtual ~VanadisBasicLoadStoreQueue() {
@@ -119,6 +142,10 @@ public:
                 delete (*op_q_itr);
                 op_q_itr = op_q[i].erase(op_q_itr);
             }
+
+            for(auto spec_itr : speculative_loads[i]) {
+                delete spec_itr;
+            }
         }
         delete std_mem_handlers;
     }
@@ -175,6 +202,13 @@ public:
             delete (*store_itr);
             store_itr = stores_pending[thread].erase(store_itr);
         }
+        store_index[thread].clear();
+
+        // the loads and stores these refer to have been removed from the pipeline
+        for(auto spec_itr = speculative_loads[thread].begin(); spec_itr != speculative_loads[thread].end(); ) {
+            delete (*spec_itr);
+            spec_itr = speculative_loads[thread].erase(spec_itr);
+        }
     }
 
     // must be implemented to allow the memory system to initialize itself during
@@ -349,7 +383,8 @@ protected:
 
                 if(target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
                     reg_width = lsq->registerFiles->at(hw_thr)->getIntRegWidth();
-                    std::vector<uint8_t> register_value(reg_width);
+                    std::vector<uint8_t>& register_value = lsq->load_register_buffer;
+                    register_value.resize(reg_width);
                     // copy entire register here
                     lsq->registerFiles->at(hw_thr)->copyFromIntRegister(target_reg, 0, &register_value[0], reg_width);
 
@@ -391,7 +426,8 @@ protected:
                 target_reg = load_ins->getPhysFPRegOut(0);
 
                 reg_width = lsq->registerFiles->at(hw_thr)->getFPRegWidth();
-                std::vector<uint8_t> register_value(reg_width);
+                std::vector<uint8_t>& register_value = lsq->load_register_buffer;
+                register_value.resize(reg_width);
 
                 // copy entire register here
                 lsq->registerFiles->at(hw_thr)->copyFromFPRegister(target_reg, 0, &register_value[0], reg_width);
@@ -504,6 +540,7 @@ protected:
                     }
 
                     store_entry->getInstruction()->markExecuted();
+                    lsq->unindexStore(thr, store_entry);
                     lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                     lsq->stores_pending_size--;
                     delete store_entry;
@@ -512,6 +549,7 @@ protected:
                 case MEM_TRANSACTION_LOCK:
                 {
                     store_entry->getInstruction()->markExecuted();
+                    lsq->unindexStore(thr, store_entry);
                     lsq->stores_pending[thr].erase(lsq->stores_pending[thr].begin());
                     lsq->stores_pending_size--;
                     delete store_entry;
@@ -576,6 +614,7 @@ protected:
 
                 // this was a standard store (not LLSC/LOCK) and we issued into system successfully
                 if(LIKELY(issue_result)) {
+                    unindexStore(thr, current_store);
                     stores_pending[thr].pop_front();
                     stores_pending_size--;
                     delete current_store;
@@ -610,7 +649,8 @@ protected:
         const uint64_t store_address = store_entry->getStoreAddress();
         const uint64_t store_width   = store_entry->getStoreWidth();
         StandardMem::Request* store_req = nullptr;
-        std::vector<uint8_t> payload(store_width);
+        std::vector<uint8_t>& payload = store_payload;
+        payload.resize(store_width);
 
 #ifdef VANADIS_BUILD_DEBUG
         if ( isDbgInsAddr( store_ins->getInstructionAddress() ) || isDbgAddr( store_address ) ) {
@@ -889,6 +929,13 @@ protected:
                 output->verbose(CALL_INFO, 16, 0, "--> ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " has not completed issue, will not process this cycle.\n",
                     front_entry->getInstruction()->getInstructionAddress(), front_entry->getInstruction()->getHWThread());
             }
+
+            // a store waiting on its address operands does not have to hold up
+            // younger loads the predictor believes are independent of it
+            if((store_set_entries > 0) && (front_entry->getEntryOp() == VanadisBasicLoadStoreEntryOp::STORE)) {
+                return attemptSpeculativeLoadIssue(thr);
+            }
+
             return false;
         }
 
@@ -1012,6 +1059,12 @@ protected:
 
                     stores_pending[store_ins->getHWThread()].push_back(new_pending_store);
                     stores_pending_size++;
+                    indexStore(store_ins->getHWThread(), new_pending_store);
+                }
+
+                // any loads which went ahead of this store can now be checked
+                if(UNLIKELY(!speculative_loads[thr].empty())) {
+                    resolveSpeculativeLoads(thr, store_ins, store_address, store_width);
                 }
 
                 // clear the front entry as we have just processed it
@@ -1105,9 +1158,193 @@ protected:
         return matchID;
     }
 
+    // Store-set dependence predictor (Chrysos & Emer), the table maps an
+    // instruction address to a store set, 0 means the instruction has never
+    // been involved in an ordering violation
+    size_t storeSetIndex(const uint64_t ins_address) const {
+        return (ins_address >> 1) % store_set_entries;
+    }
+
+    bool predictDependence(VanadisLoadInstruction* load_ins, VanadisStoreInstruction* store_ins) const {
+        const uint32_t load_set = store_set_ids[storeSetIndex(load_ins->getInstructionAddress())];
+
+        return (0 != load_set) && (load_set == store_set_ids[storeSetIndex(store_ins->getInstructionAddress())]);
+    }
+
+    void trainStoreSet(VanadisLoadInstruction* load_ins, VanadisStoreInstruction* store_ins) {
+        uint32_t& load_set  = store_set_ids[storeSetIndex(load_ins->getInstructionAddress())];
+        uint32_t& store_set = store_set_ids[storeSetIndex(store_ins->getInstructionAddress())];
+
+        if((0 == load_set) && (0 == store_set)) {
+            load_set  = next_store_set_id++;
+            store_set = load_set;
+        } else if(0 == load_set) {
+            load_set = store_set;
+        } else if(0 == store_set) {
+            store_set = load_set;
+        } else {
+            // merge the two sets, the smaller identifier wins
+            load_set  = std::min(load_set, store_set);
+            store_set = load_set;
+        }
+    }
+
+    // The front of the queue is a store which has not computed its address yet,
+    // walk past it (and any other stores) to the first load and issue that load
+    // early if the predictor does not tie it to any of the stores it would pass
+    bool attemptSpeculativeLoadIssue(const uint32_t thr) {
+        if(loads_pending.size() >= max_loads) {
+            return false;
+        }
+
+        auto op_q_itr = op_q[thr].begin();
+
+        for(; op_q_itr != op_q[thr].end(); op_q_itr++) {
+            if((*op_q_itr)->getEntryOp() != VanadisBasicLoadStoreEntryOp::STORE) {
+                break;
+            }
+        }
+
+        if((op_q_itr == op_q[thr].end()) || ((*op_q_itr)->getEntryOp() != VanadisBasicLoadStoreEntryOp::LOAD)) {
+            return false;
+        }
+
+        VanadisLoadInstruction* load_ins = static_cast<VanadisBasicLoadEntry*>(*op_q_itr)->getLoadInstruction();
+
+        // atomics and locks keep their ordering with respect to stores
+        if(!load_ins->completedIssue() || (load_ins->getTransactionType() != MEM_TRANSACTION_NONE)) {
+            return false;
+        }
+
+        for(auto store_itr = op_q[thr].begin(); store_itr != op_q_itr; store_itr++) {
+            if(predictDependence(load_ins, static_cast<VanadisBasicStoreEntry*>(*store_itr)->getStoreInstruction())) {
+                stat_store_set_stalls->addData(1);
+                return false;
+            }
+        }
+
+        uint64_t load_address = 0;
+        uint16_t load_width   = 0;
+
+        load_ins->computeLoadAddress(output, registerFiles->at(load_ins->getHWThread()), &load_address, &load_width);
+
+        // leave faulting loads and loads which would need forwarding from the store
+        // buffer to the in-order path
+        if(load_ins->trapsError() || checkStoreConflict(thr, load_address, load_width)) {
+            return false;
+        }
+
+        if(output->getVerboseLevel() >= 16) {
+            output->verbose(CALL_INFO, 16, 0, "---> speculative load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " issues ahead of %" PRIu64 " store(s) (load-addr: 0x%" PRI_ADDR " / width: %" PRIu16 ")\n",
+                load_ins->getInstructionAddress(), thr, (uint64_t) std::distance(op_q[thr].begin(), op_q_itr), load_address, load_width);
+        }
+
+        VanadisBasicSpeculativeLoadEntry* spec_entry = new VanadisBasicSpeculativeLoadEntry(load_ins, load_address, load_width);
+
+        for(auto store_itr = op_q[thr].begin(); store_itr != op_q_itr; store_itr++) {
+            spec_entry->addBypassedStore(static_cast<VanadisBasicStoreEntry*>(*store_itr)->getStoreInstruction());
+        }
+
+        speculative_loads[thr].push_back(spec_entry);
+
+        issueLoad(load_ins, load_address, load_width);
+        stat_speculative_loads->addData(1);
+
+        delete (*op_q_itr);
+        op_q[thr].erase(op_q_itr);
+        op_q_size--;
+
+        return true;
+    }
+
+    // A store has computed its address, check it against every load which was
+    // issued ahead of it, overlapping loads must be replayed by the pipeline
+    void resolveSpeculativeLoads(const uint32_t thr, VanadisStoreInstruction* store_ins,
+        const uint64_t store_address, const uint64_t store_width) {
+
+        for(auto spec_itr = speculative_loads[thr].begin(); spec_itr != speculative_loads[thr].end(); ) {
+            VanadisBasicSpeculativeLoadEntry* spec_entry = (*spec_itr);
+
+            if(spec_entry->resolveStore(store_ins)) {
+                if(UNLIKELY(!store_ins->trapsError() && spec_entry->overlaps(store_address, store_width))) {
+                    if(output->getVerboseLevel() >= 8) {
+                        output->verbose(CALL_INFO, 8, 0, "---> ordering violation, load ins: 0x%" PRI_ADDR " / thr: %" PRIu32 " overlaps store ins: 0x%" PRI_ADDR " (store-addr: 0x%" PRI_ADDR " / width: %" PRIu64 "), load will replay\n",
+                            spec_entry->getLoadInstruction()->getInstructionAddress(), thr, store_ins->getInstructionAddress(),
+                            store_address, store_width);
+                    }
+
+                    spec_entry->getLoadInstruction()->markReplayRequired();
+                    trainStoreSet(spec_entry->getLoadInstruction(), store_ins);
+                    stat_order_violations->addData(1);
+
+                    // nothing else to learn from this load, the pipeline is restarted at it
+                    delete spec_entry;
+                    spec_itr = speculative_loads[thr].erase(spec_itr);
+                    continue;
+                }
+
+                if(0 == spec_entry->countBypassedStores()) {
+                    delete spec_entry;
+                    spec_itr = speculative_loads[thr].erase(spec_itr);
+                    continue;
+                }
+            }
+
+            spec_itr++;
+        }
+    }
+
+    // Stores in the store buffer are indexed by the 8-byte granules they touch,
+    // only when a load touches an indexed granule do we need to walk the buffer
+    // to check for an exact byte overlap
+    static uint64_t storeIndexGranule(const uint64_t address) { return address >> 3; }
+
+    void indexStore(const uint32_t thread, VanadisBasicStorePendingEntry* store_entry) {
+        const uint64_t first = storeIndexGranule(store_entry->getStoreAddress());
+        const uint64_t last  = storeIndexGranule(store_entry->getStoreAddress() + store_entry->getStoreWidth() - 1);
+
+        for(uint64_t granule = first; granule <= last; ++granule) {
+            store_index[thread][granule]++;
+        }
+    }
+
+    void unindexStore(const uint32_t thread, VanadisBasicStorePendingEntry* store_entry) {
+        const uint64_t first = storeIndexGranule(store_entry->getStoreAddress());
+        const uint64_t last  = storeIndexGranule(store_entry->getStoreAddress() + store_entry->getStoreWidth() - 1);
+
+        for(uint64_t granule = first; granule <= last; ++granule) {
+            auto index_itr = store_index[thread].find(granule);
+
+            if(index_itr != store_index[thread].end()) {
+                if(0 == --(index_itr->second)) {
+                    store_index[thread].erase(index_itr);
+                }
+            }
+        }
+    }
+
     bool checkStoreConflict(const uint32_t thread, const uint64_t address, const uint64_t width) {
         bool conflicts = false;
 
+        if(LIKELY(store_index[thread].empty())) {
+            return false;
+        }
+
+        const uint64_t first = storeIndexGranule(address);
+        const uint64_t last  = storeIndexGranule(address + width - 1);
+        bool granule_match = false;
+
+        for(uint64_t granule = first; granule <= last; ++granule) {
+            if(store_index[thread].find(granule) != store_index[thread].end()) {
+                granule_match = true;
+                break;
+            }
+        }
+
+        if(LIKELY(!granule_match)) {
+            return false;
+        }
+
         for(auto store_itr = stores_pending[thread].begin(); store_itr != stores_pending[thread].end(); store_itr++) {
             VanadisBasicStorePendingEntry* current_entry = (*store_itr);
 
@@ -1125,6 +1362,12 @@ protected:
     std::vector< std::deque<VanadisBasicStorePendingEntry*> > stores_pending;
     std::deque<VanadisBasicLoadPendingEntry*> loads_pending;
     std::set<StandardMem::Request::id_t> std_stores_in_flight;
+    std::vector< std::unordered_map<uint64_t, uint32_t> > store_index;
+    std::vector< std::deque<VanadisBasicSpeculativeLoadEntry*> > speculative_loads;
+    std::vector<uint32_t> store_set_ids;
+    uint32_t next_store_set_id;
+    std::vector<uint8_t> store_payload;
+    std::vector<uint8_t> load_register_buffer;
     int op_q_index; // Next hw_thread to check in op_q queues
     int stores_pending_index; // Next hw thread to check in stores_pending q's
     size_t op_q_size;
@@ -1137,6 +1380,7 @@ protected:
     const size_t max_loads;
 
     const uint32_t max_issue_attempts_per_cycle;
+    const size_t store_set_entries;
 
     uint64_t cache_line_width;
     uint64_t address_mask;
@@ -1155,6 +1399,9 @@ protected:
     Statistic<uint64_t>* stat_split_loads;
     Statistic<uint64_t>* stat_stored_bytes;
     Statistic<uint64_t>* stat_loaded_bytes;
+    Statistic<uint64_t>* stat_speculative_loads;
+    Statistic<uint64_t>* stat_order_violations;
+    Statistic<uint64_t>* stat_store_set_stalls;
 };
 
 } // namespace Vanadis
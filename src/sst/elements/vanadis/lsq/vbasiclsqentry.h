@@ -259,5 +259,46 @@ protected:
     const uint64_t load_width;
 };
 
+// A load which was issued to memory ahead of one or more older stores whose
+// addresses were not yet known. The entry is retired once every bypassed
+// store has computed its address, if any of them overlap the load the load
+// instruction is marked for replay.
+class VanadisBasicSpeculativeLoadEntry {
+public:
+    VanadisBasicSpeculativeLoadEntry(VanadisLoadInstruction* load_ins, uint64_t address, uint64_t width) :
+        load_ins(load_ins), load_address(address), load_width(width) {}
+
+    VanadisLoadInstruction* getLoadInstruction() { return load_ins; }
+
+    uint64_t getLoadAddress() const { return load_address; }
+    uint64_t getLoadWidth() const { return load_width; }
+
+    void addBypassedStore(VanadisStoreInstruction* store_ins) { bypassed_stores.push_back(store_ins); }
+
+    // returns true if the store was one this load issued ahead of
+    bool resolveStore(VanadisStoreInstruction* store_ins) {
+        for(auto store_itr = bypassed_stores.begin(); store_itr != bypassed_stores.end(); store_itr++) {
+            if((*store_itr) == store_ins) {
+                bypassed_stores.erase(store_itr);
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    size_t countBypassedStores() const { return bypassed_stores.size(); }
+
+    bool overlaps(const uint64_t store_address, const uint64_t store_width) const {
+        return (load_address < (store_address + store_width)) && (store_address < (load_address + load_width));
+    }
+
+protected:
+    VanadisLoadInstruction* load_ins;
+    std::vector<VanadisStoreInstruction*> bypassed_stores;
+    const uint64_t load_address;
+    const uint64_t load_width;
+};
+
 }
 }
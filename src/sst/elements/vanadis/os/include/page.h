@@ -35,8 +35,8 @@ namespace OS {
 
 class Page {
   public:
-    Page( PhysMemManager* mem ) : mem(mem), refCnt(1) {
-        ppn = mem->allocPage( PhysMemManager::PageSize::FourKB ); 
+    Page( PhysMemManager* mem, unsigned region = 0 ) : mem(mem), refCnt(1) {
+        ppn = mem->allocPage( PhysMemManager::PageSize::FourKB, region ); 
         PageDbg("ppn=%d\n",ppn);
     }
 
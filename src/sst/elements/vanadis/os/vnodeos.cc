@@ -69,6 +69,14 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
         output->fatal(CALL_INFO, -1, "Missing parameter (%s): 'cores' must be specified and at least 1.\n", getName().c_str());
     }
 
+    const uint32_t shard_count = params.find<uint32_t>("os_shards", 1);
+
+    if ( shard_count == 0 || shard_count > core_count ) {
+        output->fatal(CALL_INFO, -1, "Error (%s): 'os_shards' must be between 1 and the number of cores (%" PRIu32 ").\n", getName().c_str(), core_count);
+    }
+
+    m_shards.resize( shard_count );
+
     for ( int i = 0; i < core_count; i++ ) {
         for ( int j = 0; j < hardwareThreadCount; j++ ) {
             m_availHwThreads.push( new OS::HwThreadID( i,j ) );
@@ -106,7 +114,7 @@ VanadisNodeOSComponent::VanadisNodeOSComponent(SST::ComponentId_t id, SST::Param
             std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6, 
             std::placeholders::_7, std::placeholders::_8, std::placeholders::_9 );
         m_mmu->registerPermissionsCallback( callback );
-        m_physMemMgr = new PhysMemManager( physMemSize.getRoundedValue()); 
+        m_physMemMgr = new PhysMemManager( physMemSize.getRoundedValue(), shard_count ); 
         // this assumes the first page allocated is physical address 0
         auto zeroPage = allocPage( );
         // we don't use it
@@ -310,8 +318,11 @@ VanadisNodeOSComponent::checkpoint( std::string dir )
     fprintf(fp,"m_osStartTimeNano: %llu\n",m_osStartTimeNano);
     fprintf(fp,"m_currentTid: %d\n",m_currentTid);
 
-    assert( m_pendingFault.empty() );
-    assert( m_blockMemoryWriteReqQ.empty() );
+    for ( auto & shard : m_shards ) {
+        assert( shard.pendingFault.empty() );
+        assert( shard.blockMemoryReqQ.empty() );
+    }
+    assert( m_faultsInFlight.empty() );
     assert( m_memRespMap.empty() );
 }
 
@@ -478,14 +489,23 @@ void VanadisNodeOSComponent::handleIncomingMemory(StandardMem::Request* ev) {
     auto lookup_result = m_memRespMap.find(ev->getID());
 
     if ( lookup_result == m_memRespMap.end() )  {
-        if ( ! m_blockMemoryWriteReqQ.empty( ) ) {
-            auto req = m_blockMemoryWriteReqQ.front();
+        // only the front transfer of each shard has requests outstanding
+        std::queue<PageMemReq*>* reqQ = nullptr;
+        for ( auto & shard : m_shards ) {
+            if ( ! shard.blockMemoryReqQ.empty() && shard.blockMemoryReqQ.front()->ownsResp( ev ) ) {
+                reqQ = &shard.blockMemoryReqQ;
+                break;
+            }
+        }
+
+        if ( nullptr != reqQ ) {
+            auto req = reqQ->front();
             try {
                 if ( req->handleResp( ev ) ) {
                     delete req;
-                    m_blockMemoryWriteReqQ.pop();
-                    if ( ! m_blockMemoryWriteReqQ.empty() ) {
-                        startBlockXfer( m_blockMemoryWriteReqQ.front());
+                    reqQ->pop();
+                    if ( ! reqQ->empty() ) {
+                        startBlockXfer( reqQ->front());
                     }
                 }
             } catch ( int e ) {
@@ -507,13 +527,13 @@ void VanadisNodeOSComponent::handleIncomingMemory(StandardMem::Request* ev) {
     }
 }
 
-void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsigned pageSize,Callback* callback )
+void VanadisNodeOSComponent::copyPage( uint64_t physFrom, uint64_t physTo, unsigned pageSize,Callback* callback, unsigned shard )
 {
     auto data = new uint8_t[m_pageSize];
     Callback* tmp = new Callback( [=](){
-        writePage( physTo, data, pageSize, callback );
+        writePage( physTo, data, pageSize, callback, shard );
     });
-    readPage( physFrom, data, pageSize, tmp );
+    readPage( physFrom, data, pageSize, tmp, shard );
 }
 
 void
@@ -690,12 +710,16 @@ void VanadisNodeOSComponent::pageFaultHandler2( MMU_Lib::RequestID reqId, unsign
     output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT, "RequestID=%#" PRIx64 " link=%d pid=%d vpn=%d perms=%#x instPtr=%#" PRIx64 " syscall=%p\n",
             reqId, link, pid, vpn, faultPerms, instPtr, syscall ); 
 
-    auto tmp = new PageFault( reqId, link, core, hwThread, pid, vpn, faultPerms, instPtr, memVirtAddr, syscall );
-    m_pendingFault.push( tmp );
-    if ( 1 == m_pendingFault.size() ) {
+    // faults raised by a syscall do not come from a core link, use the core the syscall was made on
+    unsigned shard = getShard( syscall ? syscall->getCoreId() : core );
+
+    auto tmp = new PageFault( reqId, link, core, hwThread, pid, vpn, faultPerms, instPtr, memVirtAddr, syscall, shard );
+    auto& pendingFault = m_shards.at(shard).pendingFault;
+    pendingFault.push( tmp );
+    if ( 1 == pendingFault.size() ) {
         pageFault( tmp );
     } else { 
-        output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT, "queue page fault\n" ); 
+        output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT, "queue page fault shard=%u\n", shard ); 
     }
 }
 
@@ -711,11 +735,27 @@ void VanadisNodeOSComponent::pageFaultFini( PageFault* info, bool success )
     } else {
         m_mmu->faultHandled( info->reqId, info->link, info->pid, info->vpn, success );
     }
+
+    // faults from other shards on the same page were held back behind this one
+    std::queue<PageFault*> waiting;
+    auto inFlight = m_faultsInFlight.find( info->key() );
+    assert( inFlight != m_faultsInFlight.end() );
+    waiting.swap( inFlight->second );
+    m_faultsInFlight.erase( inFlight );
+
+    auto& pendingFault = m_shards.at(info->shard).pendingFault;
     delete info;
 
-    m_pendingFault.pop();
-    if ( m_pendingFault.size() ) {
-        auto tmp = m_pendingFault.front();
+    pendingFault.pop();
+    if ( pendingFault.size() ) {
+        auto tmp = pendingFault.front();
+        pageFault( tmp );
+    }
+
+    // the page is now mapped (or known to be bad), retry the held faults in arrival order
+    while ( ! waiting.empty() ) {
+        auto tmp = waiting.front();
+        waiting.pop();
         pageFault( tmp );
     }
 }
@@ -728,6 +768,15 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
     uint32_t vpn = info->vpn;
     uint32_t faultPerms = info->faultPerms;
 
+    // another shard is already resolving this page, wait for it to finish
+    auto inFlight = m_faultsInFlight.find( info->key() );
+    if ( inFlight != m_faultsInFlight.end() ) {
+        output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"pid=%d vpn=%d is being handled by another shard, shard %u waits\n",pid,vpn,info->shard);
+        inFlight->second.push( info );
+        return;
+    }
+    m_faultsInFlight[ info->key() ];
+
     assert(pid > 0);
     if ( m_threadMap.find(pid) == m_threadMap.end() ) {
         output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"process %d is gone, wanted vpn=%d pass error back to CPU\n",pid,vpn);
@@ -784,7 +833,7 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             }
 
             try {
-                newPage = allocPage( );
+                newPage = allocPage( info->shard );
             } catch ( int err ) {
                 output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
             }
@@ -798,7 +847,7 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             auto callback = new Callback( [=]() {
                 pageFaultFini( info );
             });
-            copyPage( origPPN << m_pageShift, newPage->getPPN() << m_pageShift, m_pageSize, callback );
+            copyPage( origPPN << m_pageShift, newPage->getPPN() << m_pageShift, m_pageSize, callback, info->shard );
             return;
         }
 
@@ -855,7 +904,7 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
         // if there is no physical backing for this virtual page, get a page
         if ( nullptr == page ) {
             try {
-                page = allocPage( );
+                page = allocPage( info->shard );
             } catch ( int err ) {
                 output->fatal(CALL_INFO, -1, "Error: ran out of physical memory\n");
             }
@@ -891,7 +940,7 @@ void VanadisNodeOSComponent::pageFault( PageFault *info )
             bzero( data, m_pageSize );
         }
         output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"write page\n");
-        writePage( page->getPPN() << m_pageShift, data, m_pageSize, callback );
+        writePage( page->getPPN() << m_pageShift, data, m_pageSize, callback, info->shard );
         
     } else {
 
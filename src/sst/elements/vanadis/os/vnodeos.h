@@ -57,6 +57,7 @@ public:
                             { "physMemSize", "Size of available physical memory in bytes, with units. Ex: 2GiB", NULL },
                             { "page_size", "Size of a page, in bytes", "4096" },
                             { "useMMU", "Whether an MMU subcomponent is being used.", "False" },
+                            { "os_shards", "Number of shards the cores are partitioned into. Each shard queues its own page faults and page transfers and allocates physical pages from its own region of memory. All shards run inside this one component on one simulation thread; sharding removes head-of-line blocking between core groups, it does not parallelise the OS across host threads.", "1" },
                             { "process%(processnum)d.env_count", "Number of environment variables to pass to the process", "0"},
                             { "process%(processnum)d.env%(argnum)d", "Environment variable to pass to the process. Example: 'OMPNUMTHREADS=64'. 'argnum' should be contiguous starting at 0 and ending at env_count-1", ""},
                             { "proccess%(processnum)d.exe", "Name of executable, including path", NULL},
@@ -88,6 +89,7 @@ private:
         }
         virtual bool handleResp( StandardMem::Request* ev = nullptr ) = 0;
         virtual void sendReq() = 0;
+        bool ownsResp( StandardMem::Request* ev ) { return reqMap.find( ev->getID() ) != reqMap.end(); }
       protected:
         StandardMem* mem_if;
         size_t offset;
@@ -126,9 +128,10 @@ private:
 
     struct PageFault {
         PageFault(MMU_Lib::RequestID reqId, unsigned link, unsigned core,unsigned hwThread, unsigned pid,  uint32_t vpn,
-                            uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall )
+                            uint32_t faultPerms, uint64_t instPtr, uint64_t memVirtAddr, VanadisSyscall* syscall, unsigned shard )
             : reqId(reqId), link(link), core(core), hwThread(hwThread), pid(pid), vpn(vpn), faultPerms(faultPerms),
-                instPtr(instPtr), memVirtAddr(memVirtAddr), syscall(syscall) {}
+                instPtr(instPtr), memVirtAddr(memVirtAddr), syscall(syscall), shard(shard) {}
+        uint64_t key() const { return ( (uint64_t) pid << 32 ) | vpn; }
         MMU_Lib::RequestID reqId;
         unsigned link;
         unsigned core;
@@ -139,6 +142,18 @@ private:
         uint64_t instPtr;
         uint64_t memVirtAddr;
         VanadisSyscall* syscall;
+        unsigned shard;
+    };
+
+    // A shard owns the page fault handling and page transfers for a contiguous
+    // group of cores, faults in different shards make progress independently.
+    // Shards are queues inside this component, not separate components, so
+    // they all run on the thread that owns the node OS.
+    // The only state the shards share is the process page tables, faults on the
+    // same process page are funneled through m_faultsInFlight.
+    struct OSShard {
+        std::queue<PageFault*>   pendingFault;
+        std::queue<PageMemReq*>  blockMemoryReqQ;
     };
 
 
@@ -169,7 +184,11 @@ private:
     void pageFault( PageFault* );
     void pageFaultFini( PageFault*, bool success = true );
     void startProcess( OS::HwThreadID&, OS::ProcessInfo* process );
-    void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback* );
+    void copyPage(uint64_t physFrom, uint64_t physTo, unsigned pageSize, Callback*, unsigned shard );
+
+    unsigned getShard( unsigned core ) {
+        return core < m_coreInfoMap.size() ? ( core * m_shards.size() ) / m_coreInfoMap.size() : 0;
+    }
 
     void sendMemoryEvent(VanadisSyscall* syscall, StandardMem::Request* ev ) {
         m_memRespMap.insert(std::pair<StandardMem::Request::id_t, VanadisSyscall*>(ev->getID(), syscall));
@@ -178,20 +197,21 @@ private:
 
     uint64_t getNanoSeconds() { return getCurrentSimTimeNano() + m_osStartTimeNano;  }
 
-    void writePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
+    void writePage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback, unsigned shard = 0 )
     {
-        queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback ) );
+        queueBlockMemoryReq( new PageMemWriteReq( mem_if, physAddr, page_size, data, callback ), shard );
     }
 
-    void readPage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback )
+    void readPage( uint64_t physAddr, uint8_t* data, unsigned page_size, Callback* callback, unsigned shard = 0 )
     {
-        queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback ) );
+        queueBlockMemoryReq( new PageMemReadReq( mem_if, physAddr, page_size, data, callback ), shard );
     }
 
-    void queueBlockMemoryReq( PageMemReq* req ) {
-        m_blockMemoryWriteReqQ.push( req );
-        if ( 1 == m_blockMemoryWriteReqQ.size() ) {
-            startBlockXfer( m_blockMemoryWriteReqQ.front() );    
+    void queueBlockMemoryReq( PageMemReq* req, unsigned shard ) {
+        auto& reqQ = m_shards.at(shard).blockMemoryReqQ;
+        reqQ.push( req );
+        if ( 1 == reqQ.size() ) {
+            startBlockXfer( reqQ.front() );    
         }
     } 
 
@@ -375,10 +395,10 @@ private:
     int                         m_nodeNum;
     uint64_t                    m_osStartTimeNano;
 
-    std::queue<PageFault*>                          m_pendingFault;
+    std::vector<OSShard>                            m_shards;
+    std::unordered_map<uint64_t, std::queue<PageFault*> > m_faultsInFlight;
     std::map<std::string, VanadisELFInfo* >         m_elfMap; 
     std::unordered_map<uint32_t,OS::ProcessInfo*>   m_threadMap;
-    std::queue<PageMemReq*>                         m_blockMemoryWriteReqQ;
 
     std::map< VanadisELFInfo*, std::map<int,OS::Page*> >            m_elfPageCache;
     std::unordered_map<StandardMem::Request::id_t, VanadisSyscall*> m_memRespMap;
@@ -389,8 +409,8 @@ private:
 
     int m_currentTid;
 
-    OS::Page* allocPage() {
-        auto page = new OS::Page(m_physMemMgr);
+    OS::Page* allocPage( unsigned shard = 0 ) {
+        auto page = new OS::Page(m_physMemMgr, shard);
         output->verbose(CALL_INFO, 1, VANADIS_OS_DBG_PAGE_FAULT,"ppn=%d\n",page->getPPN());
         return page;
     }
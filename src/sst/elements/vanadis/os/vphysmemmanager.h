@@ -48,18 +48,32 @@ class PhysMemManager {
         void setBit( int pos ) { m_bitMap.at( pos/64 ) |= ( 1UL << ( pos % 64 ) ); }
         void clearBit( int pos ) { m_bitMap.at( pos/64 ) &= ~( 1UL << ( pos % 64 ) ); }
 
+        size_t size() const { return m_bitMap.size() * 64; }
+
         size_t findFirstEmptyBit( size_t start ) {
-            for ( size_t i = start/64; i < m_bitMap.size(); i++ ) {
-                if ( m_bitMap[i] != 0xffffffffffff ) {
+            size_t pos = findFirstEmptyBit( start, size() );
+            if ( pos == size() ) {
+                throw -1;
+            }
+            return pos;
+        }
+
+        // returns end if there is no empty bit in [start,end)
+        size_t findFirstEmptyBit( size_t start, size_t end ) {
+            for ( size_t i = start/64; i < m_bitMap.size() && i * 64 < end; i++ ) {
+                if ( m_bitMap[i] != 0xffffffffffffffff ) {
 
                     for ( int j = i == start/64 ? start % 64: 0; j < 64; j++ ) {
+                        if ( i * 64 + j >= end ) {
+                            return end;
+                        }
                         if ( ! getBit( i * 64 + j ) ) {
                             return i * 64 + j; 
                         }
                     }
                 } 
             }
-            throw -1; 
+            return end;
         }
 
         bool findEmptyBits( size_t start, int numBits ) {
@@ -102,7 +116,30 @@ class PhysMemManager {
 
     typedef std::vector<uint32_t> PageList;
     enum PageSize { FourKB, TwoMB, OneGB }; 
-    PhysMemManager( size_t memSize ) : m_bitMap( memSize/4096), m_numAllocated(0) { }
+    // Physical memory can be split into regions, each with its own allocation
+    // cursor, so that independent allocators (e.g. the OS shards of a node) do
+    // not contend for, or rescan, the same pages. An allocation that finds its
+    // region full falls back to the following regions.
+    PhysMemManager( size_t memSize, unsigned numRegions = 1 ) : m_bitMap( memSize/4096), m_numAllocated(0) {
+        setNumRegions( numRegions );
+    }
+
+    void setNumRegions( unsigned numRegions ) {
+        assert( numRegions > 0 );
+        // keep regions a multiple of a bitmap word so a word is only ever owned by one region
+        m_regionPages = ( ( m_bitMap.size() / numRegions ) / 64 ) * 64;
+        if ( 0 == m_regionPages ) {
+            numRegions = 1;
+            m_regionPages = m_bitMap.size();
+        }
+        m_regionCursor.resize( numRegions );
+        for ( unsigned i = 0; i < numRegions; i++ ) {
+            m_regionCursor[i] = regionStart( i );
+        }
+    }
+
+    unsigned getNumRegions() const { return m_regionCursor.size(); }
+
     ~PhysMemManager() {
 #if 0
         if ( m_numAllocated > 1 ) { 
@@ -111,15 +148,15 @@ class PhysMemManager {
 #endif
     }
     
-    void allocPages( PageSize pageSize, int numPages, PageList& pagesOut ) {
+    void allocPages( PageSize pageSize, int numPages, PageList& pagesOut, unsigned region = 0 ) {
         while ( numPages ) {
-            pagesOut.push_back( findFreePage( pageSize ) );
+            pagesOut.push_back( findFreePage( pageSize, region % getNumRegions() ) );
             --numPages;
         }
     }
 
-    uint32_t allocPage( PageSize pageSize ) {
-        return findFreePage( pageSize );
+    uint32_t allocPage( PageSize pageSize, unsigned region = 0 ) {
+        return findFreePage( pageSize, region % getNumRegions() );
     }
 
 
@@ -133,6 +170,12 @@ class PhysMemManager {
         if ( FourKB == pageSize ) {
             --m_numAllocated;
             m_bitMap.clearBit( pageNum );
+
+            // there are no free pages below the cursor of a region
+            unsigned region = regionOf( pageNum );
+            if ( pageNum < m_regionCursor[region] ) {
+                m_regionCursor[region] = pageNum;
+            }
         } else {
             assert(0);
         }
@@ -169,12 +212,33 @@ class PhysMemManager {
         }
     }
 
-    int findFreePage( PageSize pageSize ) {
+    size_t regionStart( unsigned region ) const { return region * m_regionPages; }
+
+    size_t regionEnd( unsigned region ) const {
+        return ( region + 1 == m_regionCursor.size() ) ? m_bitMap.size() : ( region + 1 ) * m_regionPages;
+    }
+
+    unsigned regionOf( size_t pageNum ) const {
+        unsigned region = pageNum / m_regionPages;
+        return region < m_regionCursor.size() ? region : m_regionCursor.size() - 1;
+    }
+
+    int findFreePage( PageSize pageSize, unsigned region ) {
         if ( FourKB == pageSize ) {
-            size_t page = m_bitMap.findFirstEmptyBit(0);
-            m_bitMap.setBit( page );
-            ++m_numAllocated;
-            return page;
+            for ( unsigned i = 0; i < m_regionCursor.size(); i++ ) {
+                unsigned current = ( region + i ) % m_regionCursor.size();
+                size_t end = regionEnd( current );
+                size_t page = m_bitMap.findFirstEmptyBit( m_regionCursor[current], end );
+
+                if ( page < end ) {
+                    m_bitMap.setBit( page );
+                    m_regionCursor[current] = page + 1;
+                    ++m_numAllocated;
+                    return page;
+                }
+                m_regionCursor[current] = end;
+            }
+            throw -1;
         }   
         assert(0);
 
@@ -203,6 +267,8 @@ class PhysMemManager {
 
     BitMap m_bitMap;
     uint64_t m_numAllocated;
+    size_t m_regionPages;
+    std::vector<size_t> m_regionCursor;
 };
 
 #endif
@@ -0,0 +1,184 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+// Decoder micro-benchmark, walks every executable section of a RISC-V ELF64
+// binary and resolves each instruction through the Vanadis decode tables,
+// reporting decodes per second and how much of the binary the tables cover.
+
+#include "decoder/vriscv64dectable.h"
+
+#include <cassert>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace SST::Vanadis;
+
+#define DECODEBENCH_SHF_EXECINSTR 0x4
+#define DECODEBENCH_EM_RISCV      243
+
+template <typename T>
+T
+read_le(const uint8_t* buffer)
+{
+    T value = 0;
+    for ( size_t i = 0; i < sizeof(T); ++i ) {
+        value |= static_cast<T>(buffer[i]) << (8 * i);
+    }
+    return value;
+}
+
+// Loads the contents of every executable section into text, returns false
+// if the file is not a little-endian RISC-V ELF64 binary
+bool
+read_text_sections(const char* path, std::vector<uint8_t>& text)
+{
+    FILE* bin_file = fopen(path, "rb");
+
+    if ( bin_file == NULL ) {
+        fprintf(stderr, "File: %s cannot be opened.\n", path);
+        return false;
+    }
+
+    fseek(bin_file, 0, SEEK_END);
+    const long file_len = ftell(bin_file);
+    fseek(bin_file, 0, SEEK_SET);
+
+    std::vector<uint8_t> image(file_len);
+
+    if ( fread(image.data(), 1, file_len, bin_file) != static_cast<size_t>(file_len) ) {
+        fprintf(stderr, "Error: unable to read %s\n", path);
+        fclose(bin_file);
+        return false;
+    }
+
+    fclose(bin_file);
+
+    if ( file_len < 64 || memcmp(image.data(), "\x7f" "ELF", 4) != 0 ) {
+        fprintf(stderr, "Error: %s is not an ELF binary\n", path);
+        return false;
+    }
+
+    // ELF64 (class 2), little endian (data 1)
+    if ( image[4] != 2 || image[5] != 1 || read_le<uint16_t>(&image[18]) != DECODEBENCH_EM_RISCV ) {
+        fprintf(stderr, "Error: %s is not a little-endian RISC-V ELF64 binary\n", path);
+        return false;
+    }
+
+    const uint64_t sec_hdr_offset = read_le<uint64_t>(&image[40]);
+    const uint16_t sec_hdr_size   = read_le<uint16_t>(&image[58]);
+    const uint16_t sec_hdr_count  = read_le<uint16_t>(&image[60]);
+
+    for ( uint16_t i = 0; i < sec_hdr_count; ++i ) {
+        const uint64_t hdr = sec_hdr_offset + (static_cast<uint64_t>(i) * sec_hdr_size);
+
+        if ( (hdr + 64) > static_cast<uint64_t>(file_len) ) { break; }
+
+        const uint64_t sec_flags  = read_le<uint64_t>(&image[hdr + 8]);
+        const uint64_t sec_offset = read_le<uint64_t>(&image[hdr + 24]);
+        const uint64_t sec_size   = read_le<uint64_t>(&image[hdr + 32]);
+
+        if ( (sec_flags & DECODEBENCH_SHF_EXECINSTR) && (sec_offset + sec_size) <= static_cast<uint64_t>(file_len) ) {
+            text.insert(text.end(), image.begin() + sec_offset, image.begin() + sec_offset + sec_size);
+        }
+    }
+
+    return true;
+}
+
+int
+main(int argc, char* argv[])
+{
+    if ( argc < 2 ) {
+        fprintf(stderr, "usage: decodebench <riscv64-elf-binary> [repeats]\n");
+        exit(1);
+    }
+
+    const int repeats = (argc > 2) ? atoi(argv[2]) : 10;
+
+    std::vector<uint8_t> text;
+
+    if ( !read_text_sections(argv[1], text) ) { exit(1); }
+
+    if ( text.size() < 4 ) {
+        fprintf(stderr, "Error: no executable sections found in %s\n", argv[1]);
+        exit(1);
+    }
+
+    // Walk the text once to find the instruction boundaries, compressed
+    // encodings are 2 bytes, everything else is treated as 4 bytes
+    std::vector<uint32_t> ins_words;
+    uint64_t              rvc_count = 0;
+
+    for ( size_t offset = 0; (offset + 2) <= text.size(); ) {
+        const uint16_t low = read_le<uint16_t>(&text[offset]);
+
+        if ( (low & 0x3) == 0x3 ) {
+            if ( (offset + 4) > text.size() ) { break; }
+            ins_words.push_back(read_le<uint32_t>(&text[offset]));
+            offset += 4;
+        }
+        else {
+            rvc_count++;
+            offset += 2;
+        }
+    }
+
+    uint64_t ext_counts[4] = { 0, 0, 0, 0 };
+    uint64_t table_misses  = 0;
+    uint64_t checksum      = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for ( int r = 0; r < repeats; ++r ) {
+        for ( const uint32_t next_ins : ins_words ) {
+            const VanadisRISCV64DecodeEntry* entry = vanadis_riscv64_decode_table.find(next_ins);
+
+            if ( nullptr != entry ) {
+                // Touch the operand fields as the factories would
+                checksum += entry->op + vanadis_riscv_rd(next_ins) + vanadis_riscv_rs1(next_ins) +
+                            vanadis_riscv_rs2(next_ins);
+
+                if ( 0 == r ) { ext_counts[static_cast<int>(entry->ext)]++; }
+            }
+            else if ( 0 == r ) {
+                table_misses++;
+            }
+        }
+    }
+
+    const auto   end     = std::chrono::steady_clock::now();
+    const double seconds = std::chrono::duration<double>(end - start).count();
+
+    const uint64_t total_decodes = static_cast<uint64_t>(ins_words.size()) * repeats;
+
+    printf("Text bytes:              %" PRIu64 "\n", static_cast<uint64_t>(text.size()));
+    printf("32b instructions:        %" PRIu64 "\n", static_cast<uint64_t>(ins_words.size()));
+    printf("16b (RVC) instructions:  %" PRIu64 " (not table decoded)\n", rvc_count);
+    printf("Table hits RV64I:        %" PRIu64 "\n", ext_counts[static_cast<int>(VanadisRISCV64Extension::RV64I)]);
+    printf("Table hits RV64M:        %" PRIu64 "\n", ext_counts[static_cast<int>(VanadisRISCV64Extension::RV64M)]);
+    printf("Table hits RV64F:        %" PRIu64 "\n", ext_counts[static_cast<int>(VanadisRISCV64Extension::RV64F)]);
+    printf("Table hits RV64D:        %" PRIu64 "\n", ext_counts[static_cast<int>(VanadisRISCV64Extension::RV64D)]);
+    printf("Table misses:            %" PRIu64 " (decoded by the fallback switch)\n", table_misses);
+    printf("Repeats:                 %d\n", repeats);
+    printf("Elapsed:                 %f seconds\n", seconds);
+    printf("Decodes/sec:             %f\n", (seconds > 0) ? (static_cast<double>(total_decodes) / seconds) : 0.0);
+    printf("Checksum:                %" PRIu64 "\n", checksum);
+
+    return 0;
+}
@@ -13,11 +13,20 @@
 // information, see the LICENSE file in the top level directory of the
 // distribution.
 
+#include "vcommitlog.h"
+
 #include <cassert>
+#include <cinttypes>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace SST::Vanadis;
 
 void
 read_line(FILE* input_file, char* buffer) {
@@ -48,19 +57,176 @@ generate_error(int left_line, int right_line, const char* error_msg) {
     fprintf(stderr, "Error left-line: %d, right-line: %d, cause: %s\n", left_line, right_line, error_msg);
 }
 
+struct mapped_log {
+    const char* data;
+    size_t length;
+};
+
+bool
+map_commit_log(const char* path, mapped_log* log) {
+    log->data = NULL;
+    log->length = 0;
+
+    int fd = open(path, O_RDONLY);
+
+    if (fd < 0) {
+        fprintf(stderr, "File: %s cannot be opened.\n", path);
+        exit(1);
+    }
+
+    struct stat file_stat;
+
+    if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(VanadisCommitLogHeader)) {
+        close(fd);
+        return false;
+    }
+
+    VanadisCommitLogHeader header;
+
+    if (pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+        memcmp(header.magic, VANADIS_COMMIT_LOG_MAGIC, sizeof(VANADIS_COMMIT_LOG_MAGIC)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    if (header.version != VANADIS_COMMIT_LOG_VERSION) {
+        fprintf(stderr, "File: %s is commit log version %" PRIu32 ", expected %d.\n", path, header.version,
+                VANADIS_COMMIT_LOG_VERSION);
+        exit(1);
+    }
+
+    if (header.record_size != sizeof(VanadisCommitLogRecord)) {
+        fprintf(stderr, "File: %s has record size %" PRIu32 ", expected %zu.\n", path, header.record_size,
+                sizeof(VanadisCommitLogRecord));
+        exit(1);
+    }
+
+    log->length = file_stat.st_size;
+    void* mapping = mmap(NULL, log->length, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (mapping == MAP_FAILED) {
+        fprintf(stderr, "File: %s cannot be mapped.\n", path);
+        exit(1);
+    }
+
+    madvise(mapping, log->length, MADV_SEQUENTIAL);
+    log->data = static_cast<const char*>(mapping);
+    return true;
+}
+
+void
+print_record(const char* side, const VanadisCommitLogRecord* record) {
+    fprintf(stderr, "%s: cycle: %" PRIu64 " thr: %" PRIu16 " pc: 0x%" PRIx64 " ins: 0x%08" PRIx32 " op: %" PRIu8 " flags: 0x%" PRIx8,
+            side, record->cycle, record->hw_thread, record->pc, record->ins_bits, record->op_class, record->flags);
+
+    for (int i = 0; i < record->reg_count && i < VANADIS_COMMIT_LOG_MAX_REG_WRITES; ++i) {
+        fprintf(stderr, " %c%" PRIu16 "=0x%" PRIx64, (record->flags & VANADIS_COMMIT_LOG_FLAG_FP_REG) ? 'f' : 'r',
+                record->reg_index[i], record->reg_value[i]);
+    }
+
+    if (record->flags & (VANADIS_COMMIT_LOG_FLAG_LOAD | VANADIS_COMMIT_LOG_FLAG_STORE)) {
+        fprintf(stderr, " %s 0x%" PRIx64 "/%" PRIu8, (record->flags & VANADIS_COMMIT_LOG_FLAG_LOAD) ? "ld" : "st",
+                record->mem_address, record->mem_width);
+    }
+
+    fprintf(stderr, "\n");
+}
+
+// Compares two binary commit logs, records are compared in blocks with memcmp
+// and only a mismatching block is walked record by record, so the comparison
+// runs at close to memory bandwidth for matching logs. Without --cycles a block
+// that differs only in retire cycles fails the block compare and is then
+// walked record by record with the cycle skipped.
+int
+diff_commit_logs(const mapped_log& left, const mapped_log& right, bool compare_cycles) {
+    const size_t record_size = sizeof(VanadisCommitLogRecord);
+    const size_t left_count = (left.length - sizeof(VanadisCommitLogHeader)) / record_size;
+    const size_t right_count = (right.length - sizeof(VanadisCommitLogHeader)) / record_size;
+    const size_t common_count = left_count < right_count ? left_count : right_count;
+
+    const VanadisCommitLogRecord* left_records =
+        reinterpret_cast<const VanadisCommitLogRecord*>(left.data + sizeof(VanadisCommitLogHeader));
+    const VanadisCommitLogRecord* right_records =
+        reinterpret_cast<const VanadisCommitLogRecord*>(right.data + sizeof(VanadisCommitLogHeader));
+
+    // cycle is the first field of a record, skip it unless timing is being compared
+    const size_t compare_offset = compare_cycles ? 0 : sizeof(uint64_t);
+    const size_t block_records = 4096;
+
+    for (size_t block_start = 0; block_start < common_count; block_start += block_records) {
+        const size_t block_end =
+            (block_start + block_records) < common_count ? (block_start + block_records) : common_count;
+
+        if (memcmp(left_records + block_start, right_records + block_start, (block_end - block_start) * record_size) == 0) {
+            continue;
+        }
+
+        for (size_t i = block_start; i < block_end; ++i) {
+            if (memcmp(reinterpret_cast<const char*>(left_records + i) + compare_offset,
+                       reinterpret_cast<const char*>(right_records + i) + compare_offset,
+                       record_size - compare_offset) != 0) {
+                print_record("left", left_records + i);
+                print_record("right", right_records + i);
+                generate_error(i + 1, i + 1, "Records do not match.");
+                return 1;
+            }
+        }
+    }
+
+    if (left_count != right_count) {
+        generate_error(common_count + 1, common_count + 1,
+                       left_count > right_count ? "Right file end reached, but left file end not reached, left file is longer."
+                                                : "Left file end but right file end not reached, right file is longer.");
+        return 1;
+    }
+
+    printf("Commit logs match: %zu records compared.\n", common_count);
+    return 0;
+}
+
 int
 main(int argc, char* argv[]) {
 
     char* left_file_path = NULL;
     char* right_file_path = NULL;
+    bool compare_cycles = false;
+
+    int arg_index = 1;
 
-    if (argc < 3) {
-        fprintf(stderr, "usage: tracediff <file1> <file2>\n");
+    if (argc > 1 && strcmp(argv[1], "--cycles") == 0) {
+        compare_cycles = true;
+        arg_index++;
+    }
+
+    if (argc - arg_index < 2) {
+        fprintf(stderr, "usage: tracediff [--cycles] <file1> <file2>\n");
+        fprintf(stderr, "       binary commit logs are detected automatically, --cycles also compares retire cycles\n");
         exit(1);
     }
 
-    left_file_path = argv[1];
-    right_file_path = argv[2];
+    left_file_path = argv[arg_index];
+    right_file_path = argv[arg_index + 1];
+
+    mapped_log left_log;
+    mapped_log right_log;
+
+    const bool left_is_log = map_commit_log(left_file_path, &left_log);
+    const bool right_is_log = map_commit_log(right_file_path, &right_log);
+
+    if (left_is_log != right_is_log) {
+        fprintf(stderr, "Cannot compare a binary commit log with a text trace.\n");
+        exit(1);
+    }
+
+    if (left_is_log) {
+        const int result = diff_commit_logs(left_log, right_log, compare_cycles);
+
+        munmap(const_cast<char*>(left_log.data), left_log.length);
+        munmap(const_cast<char*>(right_log.data), right_log.length);
+
+        return result;
+    }
 
     FILE* left_file = fopen(left_file_path, "rt");
     FILE* right_file = fopen(right_file_path, "rt");
@@ -33,6 +33,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     instPrintBuffer = new char[1024];
     pipelineTrace   = nullptr;
+    commitLog       = nullptr;
 
     max_cycle = params.find<uint64_t>("max_cycle", std::numeric_limits<uint64_t>::max());
 
@@ -355,6 +356,20 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         if ( pipelineTrace == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open pipeline trace file.\n"); }
     }
 
+    std::string commit_log_path = params.find<std::string>("commit_log_file", "");
+
+    if ( commit_log_path != "" ) {
+        const size_t commit_log_buffer_kb = params.find<size_t>("commit_log_buffer_kb", 4096);
+
+        output->verbose(CALL_INFO, 8, 0, "Opening a binary commit log at: %s (buffers: %zu KB)\n",
+            commit_log_path.c_str(), commit_log_buffer_kb);
+        FILE* commit_log_file = fopen(commit_log_path.c_str(), "wb");
+
+        if ( commit_log_file == nullptr ) { output->fatal(CALL_INFO, -1, "Failed to open commit log file.\n"); }
+
+        commitLog = new VanadisCommitLogWriter(commit_log_file, core_id, hw_threads, commit_log_buffer_kb * 1024);
+    }
+
     pause_on_retire_address = params.find<uint64_t>("pause_when_retire_address", 0);
     stop_verbose_when_retire_address = params.find<uint64_t>("stop_verbose_when_retire_address", 0);
 
@@ -389,6 +404,7 @@ VANADIS_COMPONENT::~VANADIS_COMPONENT()
     }
 
     if ( pipelineTrace != nullptr ) { fclose(pipelineTrace); }
+    delete commitLog;
 
 	for( VanadisFloatingPointFlags* next_fp_flags : fp_flags ) {
 		delete next_fp_flags;
@@ -766,6 +782,19 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
     bool                perform_pipeline_clear = false;
     const uint32_t      ins_thread             = rob->peekAt(0)->getHWThread();
 
+    // Load was issued ahead of an older store which it turned out to overlap,
+    // discard it and everything younger and restart fetch at the load
+    if ( UNLIKELY(INST_LOAD == rob_front->getInstFuncType()) &&
+         UNLIKELY(static_cast<VanadisLoadInstruction*>(rob_front)->requiresReplay()) ) {
+#ifdef VANADIS_BUILD_DEBUG
+        output->verbose(
+            CALL_INFO, 8, VANADIS_DBG_RETIRE_FLG, "----> load 0x%" PRI_ADDR " thread %" PRIu32 " requires replay, clearing pipeline\n",
+            rob_front->getInstructionAddress(), ins_thread);
+#endif
+        handleMisspeculate(ins_thread, rob_front->getInstructionAddress());
+        return 1;
+    }
+
     // Instruction is flagging error, print out and halt
     if ( UNLIKELY(rob_front->trapsError()) ) {
         output->verbose(
@@ -934,6 +963,8 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                 fprintf(pipelineTrace, "0x%08" PRI_ADDR " %s\n", rob_front->getInstructionAddress(), rob_front->getInstCode());
             }
 
+            if ( commitLog != nullptr ) { logRetiredInstruction(rob_front, cycle); }
+
 			if(UNLIKELY(rob_front->updatesFPFlags())) {
                 output->verbose(CALL_INFO, 16, VANADIS_DBG_RETIRE_FLG, "------> updating floating-point flags.\n");
 				rob_front->updateFPFlags();
@@ -972,6 +1003,8 @@ VANADIS_COMPONENT::performRetire(int rob_num, VanadisCircularQueue<VanadisInstru
                         pipelineTrace, "0x%08" PRI_ADDR " %s\n", delay_ins->getInstructionAddress(), delay_ins->getInstCode());
                 }
 
+                if ( commitLog != nullptr ) { logRetiredInstruction(delay_ins, cycle); }
+
 				if(UNLIKELY(rob_front->updatesFPFlags())) {
                     output->verbose(CALL_INFO, 16, VANADIS_DBG_RETIRE_FLG, "------> updating floating-point flags.\n");
 					rob_front->updateFPFlags();
@@ -1697,6 +1730,84 @@ VANADIS_COMPONENT::assignRegistersToInstruction(
     return 0;
 }
 
+void
+VANADIS_COMPONENT::logRetiredInstruction(VanadisInstruction* ins, const uint64_t cycle)
+{
+    // called before the output registers are recovered so the physical registers
+    // still hold the values this instruction produced, every micro-op of an
+    // instruction is merged into one record which is logged with the last one
+    const uint32_t          ins_thread = ins->getHWThread();
+    VanadisRegisterFile*    reg_file   = register_files[ins_thread];
+    VanadisCommitLogRecord* record     = commitLog->stageRecord(ins_thread, ins->getInstructionAddress());
+
+    record->cycle    = cycle;
+    record->ins_bits = ins->getInstructionBits();
+
+    // the memory micro-op decides the class of an instruction that has one
+    if ( record->mem_width == 0 ) { record->op_class = static_cast<uint8_t>(ins->getInstFuncType()); }
+
+    // a later micro-op writing the same register replaces the earlier value
+    auto log_reg_write = [record](uint16_t reg_index, uint64_t reg_value) {
+        for ( uint8_t i = 0; i < record->reg_count; ++i ) {
+            if ( record->reg_index[i] == reg_index ) {
+                record->reg_value[i] = reg_value;
+                return;
+            }
+        }
+
+        if ( record->reg_count < VANADIS_COMMIT_LOG_MAX_REG_WRITES ) {
+            record->reg_index[record->reg_count] = reg_index;
+            record->reg_value[record->reg_count] = reg_value;
+            record->reg_count++;
+        }
+    };
+
+    const uint16_t int_writes = std::min(ins->countISAIntRegOut(), ins->countPhysIntRegOut());
+
+    for ( uint16_t i = 0; i < int_writes; ++i ) {
+        log_reg_write(ins->getISAIntRegOut(i), reg_file->getIntReg<uint64_t>(ins->getPhysIntRegOut(i)));
+    }
+
+    for ( uint16_t i = 0; i < ins->countISAFPRegOut(); ++i ) {
+        log_reg_write(ins->getISAFPRegOut(i), reg_file->getFPReg<uint64_t>(ins->getPhysFPRegOut(i)));
+        record->flags |= VANADIS_COMMIT_LOG_FLAG_FP_REG;
+    }
+
+    uint64_t mem_address = 0;
+    uint16_t mem_width   = 0;
+
+    switch ( ins->getInstFuncType() ) {
+    case INST_LOAD:
+    {
+        VanadisLoadInstruction* load_ins = dynamic_cast<VanadisLoadInstruction*>(ins);
+
+        if ( load_ins != nullptr ) {
+            load_ins->computeLoadAddress(reg_file, &mem_address, &mem_width);
+            record->flags |= VANADIS_COMMIT_LOG_FLAG_LOAD;
+        }
+    } break;
+    case INST_STORE:
+    {
+        VanadisStoreInstruction* store_ins = dynamic_cast<VanadisStoreInstruction*>(ins);
+
+        if ( store_ins != nullptr ) {
+            store_ins->computeStoreAddress(output, reg_file, &mem_address, &mem_width);
+            record->flags |= VANADIS_COMMIT_LOG_FLAG_STORE;
+        }
+    } break;
+    default:
+        break;
+    }
+
+    // keep the first memory access of the instruction
+    if ( mem_width > 0 && record->mem_width == 0 ) {
+        record->mem_address = mem_address;
+        record->mem_width   = static_cast<uint8_t>(mem_width);
+    }
+
+    if ( ins->endsMicroOpGroup() ) { commitLog->commitRecord(ins_thread); }
+}
+
 int
 VANADIS_COMPONENT::recoverRetiredRegisters(
     VanadisInstruction* ins, VanadisRegisterStack* int_regs, VanadisRegisterStack* fp_regs,
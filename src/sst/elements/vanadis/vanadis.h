@@ -25,6 +25,7 @@
 #include "lsq/vlsq.h"
 #include "lsq/vbasiclsq.h"
 #include "velf/velfinfo.h"
+#include "vcommitlog.h"
 #include "vfpflags.h"
 #include "vfuncunit.h"
 
@@ -119,6 +120,8 @@ public:
                                         "address is retired, set verbose to 0", ""},
         { "pause_when_retire_address", "If specified, the simulation will stop when this address is retired.", "0"},
         { "pipeline_trace_file", "If specified, a trace of the pipeline activity will be generated to this file.", ""},
+        { "commit_log_file", "If specified, a binary log of every retired instruction (address, register writes, memory address) will be written to this file, compare logs with sst-vanadis-tracediff.", ""},
+        { "commit_log_buffer_kb", "Size in KB of each commit log buffer, buffers are written to the file by a background thread", "4096"},
         { "max_cycle", "Maximum number of cycles to execute. The core will halt after this many cycles." , "std::numeric_limits<uint64_t>::max()"},
         { "node_id", "Identifier for the node this core belongs to. Each node in the system needs a unique ID between 0 and (number of nodes) - 1. Used to tag output.", "0"},
         { "core_id", "Identifier for this core. Each core in the system needs a unique ID between 0 and (number of cores) - 1.", 0 },
@@ -243,6 +246,7 @@ private:
     int  performExecute(const uint64_t cycle);
     int  performRetire(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob, const uint64_t cycle);
     int  allocateFunctionalUnit(VanadisInstruction* ins);
+    void logRetiredInstruction(VanadisInstruction* ins, const uint64_t cycle);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
     void printRob(int rob_num, VanadisCircularQueue<VanadisInstruction*>* rob);
 
@@ -328,6 +332,7 @@ private:
     Clock::Handler<VANADIS_COMPONENT>* cpuClockHandler;
 
     FILE*           pipelineTrace;
+    VanadisCommitLogWriter* commitLog;
 
     Statistic<uint64_t>* stat_ins_retired;
     Statistic<uint64_t>* stat_ins_decoded;
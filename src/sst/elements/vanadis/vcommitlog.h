@@ -0,0 +1,239 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_COMMIT_LOG
+#define _H_VANADIS_COMMIT_LOG
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_COMMIT_LOG_MAGIC   "VCOMMIT"
+#define VANADIS_COMMIT_LOG_VERSION 3
+
+#define VANADIS_COMMIT_LOG_FLAG_LOAD     (1 << 0)
+#define VANADIS_COMMIT_LOG_FLAG_STORE    (1 << 1)
+#define VANADIS_COMMIT_LOG_FLAG_FP_REG   (1 << 2)
+
+#define VANADIS_COMMIT_LOG_MAX_REG_WRITES 2
+
+struct VanadisCommitLogHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t record_size;
+    uint32_t core_id;
+    uint32_t reserved;
+};
+
+// One record per retired instruction, the micro-ops an instruction decodes
+// into are merged into its record. Records are fixed size so that a reader can
+// seek to record N and two logs can be compared without parsing. The cycle is the
+// first field so a timing-insensitive comparison can skip it in one memcmp.
+// ins_bits holds the instruction word as fetched, the low 16 bits only for a
+// compressed instruction.
+struct VanadisCommitLogRecord
+{
+    uint64_t cycle;
+    uint64_t pc;
+    uint64_t mem_address;
+    uint64_t reg_value[VANADIS_COMMIT_LOG_MAX_REG_WRITES];
+    uint32_t ins_bits;
+    uint16_t reg_index[VANADIS_COMMIT_LOG_MAX_REG_WRITES];
+    uint16_t hw_thread;
+    uint8_t  op_class;
+    uint8_t  flags;
+    uint8_t  mem_width;
+    uint8_t  reg_count;
+    uint8_t  reserved[9];
+};
+
+static_assert(sizeof(VanadisCommitLogRecord) == 64, "commit log records must stay 64 bytes");
+
+// Records are appended to an in-memory buffer on the simulation thread, full
+// buffers are handed to a background thread which writes them out so the core
+// never waits on the file system unless every buffer is waiting to be written.
+class VanadisCommitLogWriter
+{
+public:
+    VanadisCommitLogWriter(
+        FILE* log_file, uint32_t core_id, uint32_t hw_threads, size_t buffer_bytes, size_t buffer_count = 4) :
+        log_file(log_file),
+        staged_records(hw_threads),
+        stop_flush(false),
+        records_per_buffer(std::max(static_cast<size_t>(1), buffer_bytes / sizeof(VanadisCommitLogRecord))),
+        records_written(0)
+    {
+        VanadisCommitLogHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, VANADIS_COMMIT_LOG_MAGIC, sizeof(VANADIS_COMMIT_LOG_MAGIC));
+        header.version     = VANADIS_COMMIT_LOG_VERSION;
+        header.record_size = sizeof(VanadisCommitLogRecord);
+        header.core_id     = core_id;
+
+        fwrite(&header, sizeof(header), 1, log_file);
+
+        for ( size_t i = 0; i < std::max(static_cast<size_t>(2), buffer_count); ++i ) {
+            free_buffers.push_back(new std::vector<VanadisCommitLogRecord>());
+            free_buffers.back()->reserve(records_per_buffer);
+        }
+
+        active_buffer = free_buffers.front();
+        free_buffers.pop_front();
+
+        flush_thread = std::thread(&VanadisCommitLogWriter::flushLoop, this);
+    }
+
+    ~VanadisCommitLogWriter()
+    {
+        for ( uint32_t i = 0; i < staged_records.size(); ++i ) {
+            commitRecord(i);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(buffer_lock);
+            if ( !active_buffer->empty() ) { full_buffers.push_back(active_buffer); }
+            else {
+                free_buffers.push_back(active_buffer);
+            }
+            active_buffer = nullptr;
+            stop_flush    = true;
+        }
+
+        buffer_ready.notify_one();
+        flush_thread.join();
+
+        for ( auto next_buffer : free_buffers ) {
+            delete next_buffer;
+        }
+
+        fclose(log_file);
+    }
+
+    // Returns the record of the instruction that a retiring micro-op at pc
+    // belongs to. The record stays staged for the hardware thread until
+    // commitRecord is called for the last micro-op of the instruction.
+    VanadisCommitLogRecord* stageRecord(uint32_t hw_thread, uint64_t pc)
+    {
+        StagedRecord& staged = staged_records[hw_thread];
+
+        // the previous instruction never retired a micro-op marked as the end of
+        // its group (for example it trapped part way through), log what it did
+        if ( staged.valid && staged.record.pc != pc ) { commitRecord(hw_thread); }
+
+        if ( !staged.valid ) {
+            memset(&staged.record, 0, sizeof(VanadisCommitLogRecord));
+            staged.record.pc        = pc;
+            staged.record.hw_thread = static_cast<uint16_t>(hw_thread);
+            staged.valid            = true;
+        }
+
+        return &staged.record;
+    }
+
+    void commitRecord(uint32_t hw_thread)
+    {
+        StagedRecord& staged = staged_records[hw_thread];
+
+        if ( !staged.valid ) { return; }
+
+        if ( active_buffer->size() == records_per_buffer ) { swapBuffer(); }
+
+        active_buffer->push_back(staged.record);
+        staged.valid = false;
+        records_written++;
+    }
+
+    uint64_t getRecordsWritten() const { return records_written; }
+
+protected:
+    struct StagedRecord
+    {
+        StagedRecord() : valid(false) {}
+
+        VanadisCommitLogRecord record;
+        bool                   valid;
+    };
+
+    void swapBuffer()
+    {
+        std::unique_lock<std::mutex> lock(buffer_lock);
+        full_buffers.push_back(active_buffer);
+        buffer_ready.notify_one();
+
+        // all buffers are waiting to be written, the simulation has to wait
+        buffer_free.wait(lock, [this] { return !free_buffers.empty(); });
+
+        active_buffer = free_buffers.front();
+        free_buffers.pop_front();
+    }
+
+    void flushLoop()
+    {
+        std::unique_lock<std::mutex> lock(buffer_lock);
+
+        while ( true ) {
+            buffer_ready.wait(lock, [this] { return stop_flush || !full_buffers.empty(); });
+
+            if ( full_buffers.empty() ) {
+                // only get here when stopping with nothing left to write
+                break;
+            }
+
+            std::vector<VanadisCommitLogRecord>* next_buffer = full_buffers.front();
+            full_buffers.pop_front();
+
+            lock.unlock();
+            fwrite(next_buffer->data(), sizeof(VanadisCommitLogRecord), next_buffer->size(), log_file);
+            next_buffer->clear();
+            lock.lock();
+
+            free_buffers.push_back(next_buffer);
+            buffer_free.notify_one();
+        }
+
+        fflush(log_file);
+    }
+
+    FILE*                     log_file;
+    std::vector<StagedRecord> staged_records;
+    std::thread               flush_thread;
+
+    std::mutex              buffer_lock;
+    std::condition_variable buffer_ready;
+    std::condition_variable buffer_free;
+    bool                    stop_flush;
+
+    std::vector<VanadisCommitLogRecord>*              active_buffer;
+    std::deque<std::vector<VanadisCommitLogRecord>*> full_buffers;
+    std::deque<std::vector<VanadisCommitLogRecord>*> free_buffers;
+
+    const size_t records_per_buffer;
+    uint64_t     records_written;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -264,7 +264,10 @@ public:
         assert(0);
     }
 
-    void requestLoadAt(SST::Output* output, const uint64_t addr, const uint64_t len) {
+    // Requests the cache line(s) holding [addr, addr + len), returns the number
+    // of line reads which were issued to the instruction cache (lines already
+    // held in the predecoder or already in flight are not counted)
+    uint64_t requestLoadAt(SST::Output* output, const uint64_t addr, const uint64_t len) {
         if (len > cache_line_width) {
             output->fatal(CALL_INFO, -1,
                           "Error: requested an instruction load which is longer than "
@@ -279,6 +282,7 @@ public:
 
         const uint64_t line_start_offset = (addr % cache_line_width);
         uint64_t line_start = addr - line_start_offset;
+        uint64_t lines_issued = 0;
 
         do {
             output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG,
@@ -314,6 +318,7 @@ public:
 	                        req_line->getID(), req_line));
 
 	                mem_if->send(req_line);
+	                lines_issued++;
 
 	            } else {
    	             output->verbose(CALL_INFO, 8, VANADIS_DBG_INS_LDR_FLG,
@@ -326,6 +331,8 @@ public:
         } while (line_start < (addr + len));
 
 		printPendingLoads(output);
+
+        return lines_issued;
     }
 
     void printStatus(SST::Output* output) {
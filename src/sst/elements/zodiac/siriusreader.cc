@@ -32,13 +32,11 @@ using namespace SST::Zodiac;
 #endif
 
 
-SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose)
+SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose) :
+	ZodiacTraceSource(maxQLen, evQ)
 {
 
 	rank = focusOnRank;
-	eventQ = evQ;
-	qLimit = maxQLen;
-	foundFinalize = false;
 
 	trace = fopen(file, "rb");
 	if(NULL == trace) {
@@ -46,9 +44,14 @@ SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, s
 		exit(-1);
 	}
 
-	prevEventTime = 0;
+	parser = new SiriusTraceParser(trace);
 	output = new Output("SiriusReader", verbose, 0, Output::STDOUT);
-	readInit();
+
+	pushEvent(SiriusTraceParser::makeRecord(SIRIUS_MPI_INIT));
+}
+
+SiriusReader::~SiriusReader() {
+	delete parser;
 }
 
 void SiriusReader::close() {
@@ -59,10 +62,10 @@ void SiriusReader::close() {
 	}
 
 	fclose(trace);
+	trace = NULL;
 }
 
 uint32_t SiriusReader::generateNextEvents() {
-//	int finalized_reached = 0;
 
 	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
 		generateNextEvent();
@@ -71,239 +74,26 @@ uint32_t SiriusReader::generateNextEvents() {
 	return (uint32_t) eventQ->size();
 }
 
-uint32_t SiriusReader::getQueueLimit() {
-	return qLimit;
-}
-
-uint32_t SiriusReader::getCurrentQueueSize() {
-	return eventQ->size();
-}
-
 void SiriusReader::generateNextEvent() {
-	uint32_t call_type = readUINT32();
-	double callTime = readTime();
-	double evTimeDiff = callTime - prevEventTime;
+	records.clear();
 
-	if(evTimeDiff > 0) {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", evTimeDiff);
-		ZodiacComputeEvent* ev = new ZodiacComputeEvent(evTimeDiff);
-		eventQ->push(ev);
-	} else {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
-			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
-			prevEventTime, callTime, evTimeDiff);
-	}
-
-	switch(call_type) {
-	case SIRIUS_MPI_SEND:
-		readSend();
+	switch(parser->readNext(records)) {
+	case SiriusTraceParser::OK:
 		break;
 
-	case SIRIUS_MPI_RECV:
-		readRecv();
-		break;
-
-	case SIRIUS_MPI_IRECV:
-		readIrecv();
-		break;
-
-	case SIRIUS_MPI_ALLREDUCE:
-		readAllreduce();
-		break;
-
-	case SIRIUS_MPI_BARRIER:
-		readBarrier();
-		break;
-
-	case SIRIUS_MPI_WAIT:
-		readWait();
-		break;
-
-	case SIRIUS_MPI_INIT:
-		readInit();
-		break;
+	case SiriusTraceParser::END:
+		output->verbose(CALL_INFO, 1, 0, "Trace for rank %" PRIu32 " ended without an MPI_Finalize\n", rank);
+		foundFinalize = true;
+		return;
 
-	case SIRIUS_MPI_FINALIZE:
-		readFinalize();
-		break;
-
-	default:
-		std::cout << "Unknown MPI command in trace (" << call_type << ") position: " <<
-			ftell(trace) << std::endl;
-		exit(-1);
-		break;
+	case SiriusTraceParser::BAD_CALL:
+		fail("Unknown MPI command in trace (%" PRIu32 ") position: %ld\n", parser->getBadCall(), ftell(trace));
+		return;
 	}
 
-
-	// Read the profiled MPI time
-	prevEventTime = readTime();
-	// read the MPI function result
-	readINT32();
-}
-
-void SiriusReader::readAllreduce() {
-	uint64_t sbuff = readUINT64();
-	uint64_t rbuff = readUINT64();
-	uint32_t length = readUINT32();
-	uint32_t dtype = readUINT32();
-	uint32_t op    = readUINT32();
-	uint32_t comm  = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
-
-	ZodiacAllreduceEvent* ev = new ZodiacAllreduceEvent(
-			length,
-			convertToHermesType(dtype),
-			convertToHermesOp(op),
-			comm);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readSend() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  dest   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
-
-	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) dest, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readRecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
-
-	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readIrecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-	uint64_t req    = readUINT64();
-
-	output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
-
-	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm, req);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readWait() {
-	uint64_t reqID = readUINT64();
-	uint64_t status = readUINT64();
-
-	output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
-
-	ZodiacWaitEvent* ev = new ZodiacWaitEvent(reqID);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readInit() {
-	output->verbose(__LINE__, __FILE__, "readInit", 8, 0, "Read an MPI_Init\n");
-	ZodiacInitEvent* ev = new ZodiacInitEvent();
-	eventQ->push(ev);
-}
-
-void SiriusReader::readFinalize() {
-	output->verbose(__LINE__, __FILE__, "readFinalize", 8, 0, "Read an MPI_Finalize\n");
-
-	ZodiacFinalizeEvent* ev = new ZodiacFinalizeEvent();
-	eventQ->push(ev);
-
-	foundFinalize = true;
-}
-
-void SiriusReader::readBarrier() {
-	uint32_t comm = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
-
-	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(comm);
-	eventQ->push(ev);
-}
-
-uint32_t SiriusReader::readUINT32() {
-	uint32_t temp;
-	fread(&temp, 1, sizeof(uint32_t), trace);
-	return temp;
-}
-
-uint64_t SiriusReader::readUINT64() {
-	uint64_t temp;
-	fread(&temp, 1, sizeof(uint64_t), trace);
-	return temp;
-}
-
-double SiriusReader::readTime() {
-	double temp;
-	fread(&temp, 1, sizeof(double), trace);
-	return temp;
-}
-
-int32_t SiriusReader::readINT32() {
-	int32_t temp;
-	fread(&temp, 1, sizeof(int32_t), trace);
-	return temp;
-}
-
-int64_t SiriusReader::readINT64() {
-	int64_t temp;
-	fread(&temp, 1, sizeof(int64_t), trace);
-	return temp;
-}
-
-PayloadDataType SiriusReader::convertToHermesType(uint32_t dtype) {
-	PayloadDataType hType = CHAR;
-
-	if(dtype == SIRIUS_MPI_INTEGER) {
-		hType = INT;
-	} else if(dtype == SIRIUS_MPI_DOUBLE) {
-		hType = DOUBLE;
-	}
-
-	return hType;
-}
-
-ReductionOperation SiriusReader::convertToHermesOp(uint32_t op) {
-	ReductionOperation h_op = SUM;
-
-	switch(op) {
-	case SIRIUS_MPI_SUM:
-		h_op = SUM;
-		break;
-	case SIRIUS_MPI_MAX:
-		h_op = MAX;
-		break;
-	case SIRIUS_MPI_MIN:
-		h_op = MIN;
-		break;
-	default:
-		std::cout << "Unknown MPI operation, cannot convert to Hermes." << std::endl;
-		exit(-1);
+	for(unsigned i = 0; i < records.size(); i++) {
+		pushEvent(records[i]);
 	}
-
-	return h_op;
-}
-
-bool SiriusReader::hasReachedFinalize() {
-	return foundFinalize;
 }
 
 void SiriusReader::setOutput(Output* oput) {
@@ -25,22 +25,13 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <vector>
 
 #include "sst/core/output.h"
 #include "sst/elements/hermes/msgapi.h"
 
-#include "sirius/siriusconst.h"
-
-#include "zevent.h"
-#include "zinitevent.h"
-#include "zsendevent.h"
-#include "zirecvevent.h"
-#include "zrecvevent.h"
-#include "zbarrierevent.h"
-#include "zcomputeevent.h"
-#include "zwaitevent.h"
-#include "zfinalizeevent.h"
-#include "zallredevent.h"
+#include "ztraceformat.h"
+#include "ztracesource.h"
 
 using namespace std;
 using namespace SST::Hermes;
@@ -49,41 +40,20 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
-class SiriusReader {
+class SiriusReader : public ZodiacTraceSource {
     public:
 	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	~SiriusReader();
         void close();
 	void setOutput(Output* oput);
 	uint32_t generateNextEvents();
-	uint32_t getQueueLimit();
-	uint32_t getCurrentQueueSize();
-	bool hasReachedFinalize();
 
     private:
-	Output* output;
 	uint32_t rank;
-	uint32_t qLimit;
-	bool foundFinalize;
-	std::queue<ZodiacEvent*>* eventQ;
 	FILE* trace;
-	double prevEventTime;
+	SiriusTraceParser* parser;
+	std::vector<ZodiacTraceRecord> records;
 	void generateNextEvent();
-	inline uint32_t readUINT32();
-	inline uint64_t readUINT64();
-	inline double readTime();
-	inline int32_t readINT32();
-	inline int64_t readINT64();
-	void readSend();
-	void readIrecv();
-	void readRecv();
-	void readInit();
-	void readFinalize();
-	void readBarrier();
-	void readWait();
-	void readAllreduce();
-
-	PayloadDataType convertToHermesType(uint32_t dtype);
-	ReductionOperation convertToHermesOp(uint32_t op);
 };
 
 }
@@ -8,6 +8,8 @@ iterations = 1;
 msgSize = 0;
 shape = "2"
 num_vNics = 1
+readerThreads = 0
+traceFormat = "sirius"
 
 netPktSizeBytes="64B"
 netFlitSize="8B"
@@ -17,8 +19,10 @@ def main():
     global msgSize
     global shape
     global num_vNics
+    global readerThreads
+    global traceFormat
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores=","readerThreads=","traceFormat="])
     except getopt.GetopError as err:
         print (str(err))
         sys.exit(2)
@@ -31,6 +35,10 @@ def main():
             num_vNics = a
         elif o in ("--shape"):
             shape = a
+        elif o in ("--readerThreads"):
+            readerThreads = a
+        elif o in ("--traceFormat"):
+            traceFormat = a
         else:
             assert False, "unhandle option" 
 
@@ -100,6 +108,7 @@ driverParams = ({
 		"os.module" : "firefly.hades",
 		"trace" : "npe-" + str(numRanks) + "/allred-" + str(numRanks) +".stf",
 		"sharedTrace" : "allred-128.stf",
+		"readerthreads" : readerThreads,
 		"printStats" : 1,
 		"buffersize" : 140,
 		"os.name" : "hermesParams",
@@ -143,6 +152,11 @@ driverParams = ({
 
 	})
 
+# the binary trace is written by sst-zodiac-traceconvert next to the sirius one
+if traceFormat == "binary":
+	driverParams["format"] = "binary"
+	driverParams["trace"] = "npe-" + str(numRanks) + "/allred-" + str(numRanks) + ".ztrace"
+
 class EmberEP(EndPoint):
 	def getName(self):
 		return "EmberEP"
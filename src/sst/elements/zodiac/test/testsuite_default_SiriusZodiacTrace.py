@@ -29,12 +29,20 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
     def test_Sirius_Zodiac_16(self):
         self.SiriusZodiacTrace_test_template("4x4")
 
+    def test_Sirius_Zodiac_16_readerThreads(self):
+        self.SiriusZodiacTrace_test_template("4x4", readerThreads = 2)
+
+    # converted to one binary trace with sst-zodiac-traceconvert, the
+    # simulation must not change
+    def test_Sirius_Zodiac_16_binary(self):
+        self.SiriusZodiacTrace_test_template("4x4", traceFormat = "binary")
+
     def test_Sirius_Zodiac_128(self):
         self.SiriusZodiacTrace_test_template("8x8x2")
 
 #####
 
-    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60):
+    def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60, readerThreads = 0, traceFormat = "sirius"):
 
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -48,16 +56,24 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
 
         # Set the various file paths
         testDataFileName="test_Sirius_allred_{0}".format(testcase)
+        outFileName = testDataFileName
+        if readerThreads > 0:
+            outFileName = "{0}_readerThreads".format(testDataFileName)
+        if traceFormat != "sirius":
+            outFileName = "{0}_{1}".format(outFileName, traceFormat)
 
         reffile = "{0}/sirius/tests/refFiles/{1}.out".format(self.SiriusZodiacTraceElementDir, testDataFileName)
-        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
-        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
-        tmpfile1 = "{0}/{1}_grepped.tmp".format(outdir, testDataFileName)
-        tmpfile2 = "{0}/{1}_filtered.tmp".format(outdir, testDataFileName)
-        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+        outfile = "{0}/{1}.out".format(outdir, outFileName)
+        errfile = "{0}/{1}.err".format(outdir, outFileName)
+        tmpfile1 = "{0}/{1}_grepped.tmp".format(outdir, outFileName)
+        tmpfile2 = "{0}/{1}_filtered.tmp".format(outdir, outFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, outFileName)
 
         sdlfile = "{0}/allreduce/allreduce.py".format(test_path)
-        otherargs = '--model-options \"--shape={0}\"'.format(testcase)
+        otherargs = '--model-options \"--shape={0} --readerThreads={1} --traceFormat={2}\"'.format(testcase, readerThreads, traceFormat)
+
+        if traceFormat == "binary":
+            self._convertSiriusTrace(testcase)
 
         # Run SST
         self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
@@ -84,6 +100,25 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted/Filtered output file {0} does not match Reference File {1}".format(tmpfile2, reffile))
 
+#####
+
+    def _convertSiriusTrace(self, shape):
+        # Make sure we have access to the sst-zodiac-traceconvert binary
+        elem_bin_dir = sstsimulator_conf_get_value_str("SST_ELEMENT_LIBRARY", "SST_ELEMENT_LIBRARY_BINDIR", "BINDIR_UNDEFINED")
+        traceconvert_app = "{0}/sst-zodiac-traceconvert".format(elem_bin_dir)
+        self.assertTrue(os.path.isfile(traceconvert_app), "SiriusZodiacTrace - Cannot find {0}".format(traceconvert_app))
+
+        numRanks = 1
+        for dim in shape.split('x'):
+            numRanks *= int(dim)
+
+        # allreduce.py looks for the binary trace next to the sirius one
+        trace = "npe-{0}/allred-{0}".format(numRanks)
+        cmd = "{0} -n {1} -o {2}.ztrace {2}.stf".format(traceconvert_app, numRanks, trace)
+        rtn = OSCommand(cmd, set_cwd=self.testSiriusZodiacTraceTestsDir).run()
+        log_debug("sst-zodiac-traceconvert result = {0}; output =\n{1}".format(rtn.result(), rtn.output()))
+        self.assertTrue(rtn.result() == 0, "sst-zodiac-traceconvert failed on {0}.stf".format(trace))
+
 #####
 
     def _setupSiriusZodiacTraceTestFiles(self):
@@ -0,0 +1,342 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+// Converts the per-rank raw Sirius traces <prefix>.0 .. <prefix>.N-1 into a
+// single indexed Zodiac binary trace (see ztraceformat.h) which the
+// ZodiacSiriusTraceReader loads with format=binary. With --ember the inputs
+// are the streams ember's motifRecord mode writes (see emberreplayformat.h),
+// limited to the calls Zodiac models.
+
+#include "sst_config.h"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ztraceformat.h"
+#include "sst/elements/ember/emberreplayformat.h"
+
+static const size_t FlushRecords = 65536;
+
+static bool
+write_records(FILE* out, const std::vector<ZodiacTraceRecord>& records)
+{
+    if ( records.empty() ) return true;
+    return records.size() == fwrite(&records[0], sizeof(ZodiacTraceRecord), records.size(), out);
+}
+
+// writes the records once enough have built up, or all of them at the end of a rank
+static bool
+flush_records(FILE* out, std::vector<ZodiacTraceRecord>& records, ZodiacTraceIndexEntry& entry, bool end)
+{
+    if ( !end && records.size() < FlushRecords ) return true;
+    if ( !write_records(out, records) ) return false;
+    entry.numRecords += records.size();
+    records.clear();
+    return true;
+}
+
+static bool
+convert_sirius(const char* name, FILE* out, std::vector<ZodiacTraceRecord>& records, ZodiacTraceIndexEntry& entry)
+{
+    FILE* input = fopen(name, "rb");
+    if ( NULL == input ) {
+        fprintf(stderr, "Error: unable to open %s\n", name);
+        return false;
+    }
+
+    SiriusTraceParser parser(input);
+    SiriusTraceParser::Status status = SiriusTraceParser::OK;
+
+    while ( SiriusTraceParser::OK == status ) {
+        status = parser.readNext(records);
+
+        if ( SiriusTraceParser::BAD_CALL == status ) {
+            fprintf(stderr, "Error: unknown MPI command (%" PRIu32 ") in %s at position %ld\n",
+                parser.getBadCall(), name, ftell(input));
+            fclose(input);
+            return false;
+        }
+
+        if ( !flush_records(out, records, entry, SiriusTraceParser::END == status) ) {
+            fprintf(stderr, "Error: write failed\n");
+            fclose(input);
+            return false;
+        }
+    }
+
+    fclose(input);
+    return true;
+}
+
+static const char* ember_call_name(uint32_t type)
+{
+    static const char* names[] = { "", "motif", "compute", "getTime", "init", "fini", "rank", "size",
+        "makeProgress", "send", "isend", "recv", "irecv", "wait", "waitall", "waitany", "test", "testany",
+        "cancel", "barrier", "bcast", "reduce", "allreduce", "scatter", "scatterv", "allgather", "allgatherv",
+        "alltoall", "alltoallv", "commSplit", "commCreate", "commDestroy" };
+
+    return type < EMBER_REPLAY_NUM_TYPES ? names[type] : "unknown";
+}
+
+// Zodiac only knows integers and doubles, anything else goes by its size in bytes
+static void
+ember_count(EmberReplayCursor& cursor, ZodiacTraceRecord& rec)
+{
+    rec.count = cursor.get<uint32_t>();
+    cursor.get<uint8_t>();
+    uint8_t size = cursor.get<uint8_t>();
+
+    if ( 4 == size ) {
+        rec.dtype = SIRIUS_MPI_INTEGER;
+    } else if ( 8 == size ) {
+        rec.dtype = SIRIUS_MPI_DOUBLE;
+    } else {
+        rec.dtype = 0;
+        rec.count *= size;
+    }
+}
+
+static bool
+convert_ember(const char* name, FILE* out, std::vector<ZodiacTraceRecord>& records, ZodiacTraceIndexEntry& entry)
+{
+    FILE* input = fopen(name, "rb");
+    if ( NULL == input ) {
+        fprintf(stderr, "Error: unable to open %s\n", name);
+        return false;
+    }
+
+    std::vector<uint8_t> stream;
+    uint8_t buffer[65536];
+    size_t length;
+    while ( 0 < ( length = fread(buffer, 1, sizeof(buffer), input) ) ) {
+        stream.insert(stream.end(), buffer, buffer + length);
+    }
+    fclose(input);
+
+    EmberReplayFileHeader header;
+    if ( stream.size() < sizeof(header) ) {
+        fprintf(stderr, "Error: %s is not an ember recording\n", name);
+        return false;
+    }
+    memcpy(&header, &stream[0], sizeof(header));
+    if ( 0 != memcmp(header.magic, EMBER_REPLAY_MAGIC, sizeof(header.magic)) ||
+         EMBER_REPLAY_VERSION != header.version ) {
+        fprintf(stderr, "Error: %s is not a version %d ember recording\n", name, EMBER_REPLAY_VERSION);
+        return false;
+    }
+
+    EmberReplayCursor cursor(&stream[0], stream.size());
+
+    while ( !cursor.atEnd() ) {
+        uint64_t position = cursor.offset();
+        uint32_t type = cursor.get<uint8_t>();
+        ZodiacTraceRecord rec = SiriusTraceParser::makeRecord(0);
+
+        switch ( type ) {
+        case EMBER_REPLAY_MOTIF: {
+            cursor.get<uint32_t>();
+            uint8_t nameLength = cursor.get<uint8_t>();
+            cursor.getString(nameLength);
+            continue;
+        }
+
+        // the converter adds its own init and finalize around each rank
+        case EMBER_REPLAY_RANK:
+        case EMBER_REPLAY_SIZE:
+            cursor.get<uint32_t>();
+            continue;
+        case EMBER_REPLAY_GETTIME:
+        case EMBER_REPLAY_MAKE_PROGRESS:
+        case EMBER_REPLAY_INIT:
+        case EMBER_REPLAY_FINI:
+            continue;
+
+        case EMBER_REPLAY_COMPUTE:
+            rec.type = ZODIAC_TRACE_COMPUTE;
+            rec.time = cursor.get<uint64_t>() * 1.0e-9;
+            break;
+
+        case EMBER_REPLAY_SEND:
+        case EMBER_REPLAY_RECV:
+        case EMBER_REPLAY_IRECV:
+            rec.type = EMBER_REPLAY_SEND == type ? SIRIUS_MPI_SEND :
+                        EMBER_REPLAY_RECV == type ? SIRIUS_MPI_RECV : SIRIUS_MPI_IRECV;
+            ember_count(cursor, rec);
+            rec.peer = cursor.get<int32_t>();
+            rec.tag = cursor.get<int32_t>();
+            rec.comm = cursor.get<uint32_t>();
+            if ( EMBER_REPLAY_IRECV == type ) {
+                rec.req = cursor.get<uint32_t>();
+            }
+            break;
+
+        case EMBER_REPLAY_WAIT:
+            rec.type = SIRIUS_MPI_WAIT;
+            rec.req = cursor.get<uint32_t>();
+            if ( EMBER_REPLAY_NO_REQUEST == rec.req ) continue;
+            break;
+
+        // waiting on each request in turn completes the same set
+        case EMBER_REPLAY_WAITALL: {
+            uint32_t n = cursor.get<uint32_t>();
+            const uint32_t* ids = cursor.getArray<uint32_t>(n);
+            rec.type = SIRIUS_MPI_WAIT;
+            for ( uint32_t i = 0; i < n && cursor.ok(); i++ ) {
+                if ( EMBER_REPLAY_NO_REQUEST == ids[i] ) continue;
+                rec.req = ids[i];
+                records.push_back(rec);
+            }
+            continue;
+        }
+
+        case EMBER_REPLAY_BARRIER:
+            rec.type = SIRIUS_MPI_BARRIER;
+            rec.comm = cursor.get<uint32_t>();
+            break;
+
+        case EMBER_REPLAY_ALLREDUCE:
+            rec.type = SIRIUS_MPI_ALLREDUCE;
+            ember_count(cursor, rec);
+            switch ( cursor.get<uint8_t>() ) {
+            case EMBER_REPLAY_OP_MIN: rec.op = SIRIUS_MPI_MIN; break;
+            case EMBER_REPLAY_OP_MAX: rec.op = SIRIUS_MPI_MAX; break;
+            default: rec.op = SIRIUS_MPI_SUM; break;
+            }
+            rec.comm = cursor.get<uint32_t>();
+            break;
+
+        default:
+            fprintf(stderr, "Error: %s in %s at offset %" PRIu64 " has no Zodiac equivalent\n",
+                ember_call_name(type), name, position);
+            return false;
+        }
+
+        if ( !cursor.ok() ) {
+            fprintf(stderr, "Error: %s is truncated at offset %" PRIu64 "\n", name, position);
+            return false;
+        }
+
+        records.push_back(rec);
+
+        if ( !flush_records(out, records, entry, false) ) {
+            fprintf(stderr, "Error: write failed\n");
+            return false;
+        }
+    }
+
+    records.push_back(SiriusTraceParser::makeRecord(SIRIUS_MPI_FINALIZE));
+
+    if ( !flush_records(out, records, entry, true) ) {
+        fprintf(stderr, "Error: write failed\n");
+        return false;
+    }
+    return true;
+}
+
+static void
+usage()
+{
+    fprintf(stderr, "usage: sst-zodiac-traceconvert [--ember] -n <ranks> -o <binary trace> <trace prefix>\n");
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t num_ranks = 0;
+    const char* output_path = NULL;
+    const char* prefix = NULL;
+    bool ember = false;
+
+    for ( int i = 1; i < argc; i++ ) {
+        if ( strcmp(argv[i], "-n") == 0 && i + 1 < argc ) {
+            num_ranks = (uint32_t) strtoul(argv[++i], NULL, 10);
+        } else if ( strcmp(argv[i], "-o") == 0 && i + 1 < argc ) {
+            output_path = argv[++i];
+        } else if ( strcmp(argv[i], "--ember") == 0 ) {
+            ember = true;
+        } else if ( argv[i][0] == '-' ) {
+            usage();
+            return 1;
+        } else {
+            prefix = argv[i];
+        }
+    }
+
+    if ( 0 == num_ranks || NULL == output_path || NULL == prefix ) {
+        usage();
+        return 1;
+    }
+
+    FILE* out = fopen(output_path, "wb");
+    if ( NULL == out ) {
+        fprintf(stderr, "Error: unable to open %s\n", output_path);
+        return 1;
+    }
+
+    ZodiacTraceFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, ZODIAC_TRACE_MAGIC, sizeof(header.magic));
+    header.version = ZODIAC_TRACE_VERSION;
+    header.numRanks = num_ranks;
+
+    // the index is written again once the section sizes are known
+    std::vector<ZodiacTraceIndexEntry> index(num_ranks);
+    memset(&index[0], 0, sizeof(ZodiacTraceIndexEntry) * num_ranks);
+
+    if ( 1 != fwrite(&header, sizeof(header), 1, out) ||
+         num_ranks != fwrite(&index[0], sizeof(ZodiacTraceIndexEntry), num_ranks, out) ) {
+        fprintf(stderr, "Error: write to %s failed\n", output_path);
+        return 1;
+    }
+
+    uint64_t offset = sizeof(header) + sizeof(ZodiacTraceIndexEntry) * num_ranks;
+    uint64_t total = 0;
+
+    std::vector<char> name(strlen(prefix) + 20);
+    std::vector<ZodiacTraceRecord> records;
+    records.reserve(FlushRecords);
+
+    for ( uint32_t rank = 0; rank < num_ranks; rank++ ) {
+        snprintf(&name[0], name.size(), "%s.%" PRIu32, prefix, rank);
+
+        index[rank].offset = offset;
+
+        // the Sirius reader starts every rank with an MPI_Init
+        records.clear();
+        records.push_back(SiriusTraceParser::makeRecord(SIRIUS_MPI_INIT));
+
+        if ( ember ? !convert_ember(&name[0], out, records, index[rank]) :
+                     !convert_sirius(&name[0], out, records, index[rank]) ) {
+            return 1;
+        }
+
+        offset += index[rank].numRecords * sizeof(ZodiacTraceRecord);
+        total += index[rank].numRecords;
+    }
+
+    if ( 0 != fseek(out, sizeof(header), SEEK_SET) ||
+         num_ranks != fwrite(&index[0], sizeof(ZodiacTraceIndexEntry), num_ranks, out) ||
+         0 != fclose(out) ) {
+        fprintf(stderr, "Error: write to %s failed\n", output_path);
+        return 1;
+    }
+
+    printf("Converted %" PRIu32 " ranks, %" PRIu64 " records\n", num_ranks, total);
+    return 0;
+}
@@ -0,0 +1,95 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "zbinaryreader.h"
+
+using namespace SST::Zodiac;
+
+ZodiacBinaryReader::ZodiacBinaryReader(const std::string& file, uint32_t rank, uint32_t maxQLen,
+		std::queue<ZodiacEvent*>* evQ, int verbose) :
+	ZodiacTraceSource(maxQLen, evQ),
+	blockIndex(0)
+{
+	output = new Output("ZodiacBinaryReader", verbose, 0, Output::STDOUT);
+
+	trace = fopen(file.c_str(), "rb");
+	if(NULL == trace) {
+		output->fatal(CALL_INFO, -1, "Error opening the Zodiac binary trace file: %s\n", file.c_str());
+	}
+
+	ZodiacTraceFileHeader header;
+	if(1 != fread(&header, sizeof(header), 1, trace) ||
+			0 != memcmp(header.magic, ZODIAC_TRACE_MAGIC, sizeof(header.magic))) {
+		output->fatal(CALL_INFO, -1, "%s is not a Zodiac binary trace\n", file.c_str());
+	}
+	if(ZODIAC_TRACE_VERSION != header.version) {
+		output->fatal(CALL_INFO, -1, "%s is version %" PRIu32 " of the Zodiac binary trace, expected %d\n",
+			file.c_str(), header.version, ZODIAC_TRACE_VERSION);
+	}
+	if(rank >= header.numRanks) {
+		output->fatal(CALL_INFO, -1, "%s holds %" PRIu32 " ranks, rank %" PRIu32 " is not in the trace\n",
+			file.c_str(), header.numRanks, rank);
+	}
+
+	ZodiacTraceIndexEntry entry;
+	if(0 != fseek(trace, sizeof(header) + rank * sizeof(entry), SEEK_SET) ||
+			1 != fread(&entry, sizeof(entry), 1, trace) ||
+			0 != fseek(trace, entry.offset, SEEK_SET)) {
+		output->fatal(CALL_INFO, -1, "Error reading the index of %s for rank %" PRIu32 "\n", file.c_str(), rank);
+	}
+
+	recordsLeft = entry.numRecords;
+	output->verbose(CALL_INFO, 4, 0, "Rank %" PRIu32 " has %" PRIu64 " records at offset %" PRIu64 "\n",
+		rank, entry.numRecords, entry.offset);
+}
+
+ZodiacBinaryReader::~ZodiacBinaryReader() {
+	delete output;
+}
+
+void ZodiacBinaryReader::close() {
+	if(trace) {
+		fclose(trace);
+		trace = NULL;
+	}
+}
+
+uint32_t ZodiacBinaryReader::generateNextEvents() {
+
+	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
+		if(blockIndex == block.size()) {
+			if(0 == recordsLeft) {
+				output->verbose(CALL_INFO, 1, 0, "Trace ended without an MPI_Finalize\n");
+				foundFinalize = true;
+				break;
+			}
+
+			block.resize(std::min((uint64_t) BlockRecords, recordsLeft));
+			if(block.size() != fread(&block[0], sizeof(ZodiacTraceRecord), block.size(), trace)) {
+				fail("Error reading the Zodiac binary trace\n");
+				break;
+			}
+			recordsLeft -= block.size();
+			blockIndex = 0;
+		}
+
+		pushEvent(block[blockIndex++]);
+	}
+
+	return (uint32_t) eventQ->size();
+}
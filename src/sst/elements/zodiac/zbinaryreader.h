@@ -0,0 +1,56 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_BINARY_READER
+#define _H_ZODIAC_BINARY_READER
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <queue>
+#include <vector>
+
+#include "ztraceformat.h"
+#include "ztracesource.h"
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * Reads one rank out of a trace written by sst-zodiac-traceconvert. Only the
+ * rank's index entry is read at startup, records are then read in blocks.
+ */
+class ZodiacBinaryReader : public ZodiacTraceSource {
+    public:
+	ZodiacBinaryReader(const std::string& file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	~ZodiacBinaryReader();
+	void close();
+	uint32_t generateNextEvents();
+
+    private:
+	static const size_t BlockRecords = 1024;
+
+	FILE* trace;
+	uint64_t recordsLeft;
+	std::vector<ZodiacTraceRecord> block;
+	size_t blockIndex;
+};
+
+}
+}
+
+#endif
@@ -37,7 +37,9 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
   retFunctor(DerivedFunctor(this, &ZodiacSiriusTraceReader::completedFunction)),
   sendFunctor(DerivedFunctor(this, &ZodiacSiriusTraceReader::completedSendFunction)),
   waitFunctor(DerivedFunctor(this, &ZodiacSiriusTraceReader::completedWaitFunction)),
-  trace(NULL)
+  trace(NULL),
+  loader(NULL),
+  traceStream(NULL)
 {
     scaleCompute = params.find("scalecompute", 1.0);
 
@@ -67,6 +69,19 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
         std::cout << "Trace prefix: " << trace_file << std::endl;
     }
 
+    trace_format = params.find<std::string>("format", "sirius");
+    if(trace_format != "sirius" && trace_format != "binary") {
+        std::cerr << "Error: unknown trace format " << trace_format << std::endl;
+        exit(-1);
+    }
+
+    queueLimit = params.find<uint32_t>("queuelimit", 64);
+
+    int readerThreads = params.find<int>("readerthreads", 0);
+    if(readerThreads > 0) {
+        loader = ZodiacTraceLoader::attach(readerThreads);
+    }
+
     eventQ = new std::queue<ZodiacEvent*>();
 
     verbosityLevel = params.find("verbose", 0);
@@ -97,19 +112,36 @@ void ZodiacSiriusTraceReader::setup() {
 
     eventQ = new std::queue<ZodiacEvent*>();
 
-    char trace_name[trace_file.length() + 20];
-    snprintf(trace_name, trace_file.length() + 20, "%s.%d", trace_file.c_str(), rank);
-
-    printf("Opening trace file: %s\n", trace_name);
-    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
-    trace->setOutput(&zOut);
+    ZodiacTraceSource* source;
+    if(trace_format == "binary") {
+        printf("Opening trace file: %s rank %d\n", trace_file.c_str(), rank);
+        source = new ZodiacBinaryReader(trace_file, rank, queueLimit, eventQ, verbosityLevel);
+    } else {
+        char trace_name[trace_file.length() + 20];
+        snprintf(trace_name, trace_file.length() + 20, "%s.%d", trace_file.c_str(), rank);
+
+        printf("Opening trace file: %s\n", trace_name);
+        SiriusReader* sirius = new SiriusReader(trace_name, rank, queueLimit, eventQ, verbosityLevel);
+        // zOut's prefix reads the simulation time which a loader thread must not
+        if(NULL == loader) {
+            sirius->setOutput(&zOut);
+        }
+        source = sirius;
+    }
 
-    int count = trace->generateNextEvents();
-    std::cout << "Obtained: " << count << " events" << std::endl;
+    if(loader) {
+        // the loader owns the source and the queue from here on
+        traceStream = loader->add(source, eventQ, queueLimit);
+        eventQ = NULL;
+    } else {
+        trace = source;
+        int count = trace->generateNextEvents();
+        std::cout << "Obtained: " << count << " events" << std::endl;
+    }
 
-    if(eventQ->size() > 0) {
-	selfLink->send(eventQ->front());
-	eventQ->pop();
+    ZodiacEvent* firstEv = nextEvent();
+    if(firstEv) {
+	selfLink->send(firstEv);
     }
 
     char logPrefix[512];
@@ -183,6 +215,12 @@ ZodiacSiriusTraceReader::~ZodiacSiriusTraceReader() {
 
         trace->close();
     }
+    if ( loader ) {
+        if ( traceStream && ! traceStream->hasEnded() ) {
+            zOut.output("WARNING: Component did not reach a finalize event, yet the component destructor has been called.\n");
+        }
+        loader->detach();
+    }
 }
 
 ZodiacSiriusTraceReader::ZodiacSiriusTraceReader() :
@@ -424,16 +462,12 @@ void ZodiacSiriusTraceReader::handleComputeEvent(ZodiacEvent* zEv) {
 		2, 1, "Processing a compute event (duration=%f seconds)\n",
 		zCEv->getComputeDuration());
 
-	if((0 == eventQ->size()) && (!trace->hasReachedFinalize())) {
-		trace->generateNextEvents();
-	}
+	ZodiacEvent* nextEv = nextEvent();
 
-	if(eventQ->size() > 0) {
-		ZodiacEvent* nextEv = eventQ->front();
+	if(nextEv) {
 		zOut.verbose(__LINE__, __FILE__, "handleComputeEvent",
 			2, 1, "Enqueuing next event at a delay of %f seconds, scaled by %f = %f seconds)\n",
 			zCEv->getComputeDuration(), scaleCompute, scaleCompute * zCEv->getComputeDuration());
-		eventQ->pop();
 		selfLink->send(scaleCompute * zCEv->getComputeDurationNano(), tConv, nextEv);
 	} else {
 		zOut.output("No more events to process.\n");
@@ -519,7 +553,15 @@ bool ZodiacSiriusTraceReader::completedWaitFunction(int retVal) {
 	return false;
 }
 
-void ZodiacSiriusTraceReader::enqueueNextEvent() {
+ZodiacEvent* ZodiacSiriusTraceReader::nextEvent() {
+	if(traceStream) {
+		ZodiacEvent* nextEv = traceStream->pop();
+		if(NULL == nextEv && traceStream->hasFailed()) {
+			zOut.fatal(CALL_INFO, -1, "%s", traceStream->getError().c_str());
+		}
+		return nextEv;
+	}
+
 	if((0 == eventQ->size()) && (!trace->hasReachedFinalize())) {
 		zOut.verbose(CALL_INFO, 8, 0, "Generating next set of events from trace...\n");
 		trace->generateNextEvents();
@@ -527,11 +569,23 @@ void ZodiacSiriusTraceReader::enqueueNextEvent() {
 	}
 
 	if(eventQ->size() > 0) {
+		ZodiacEvent* nextEv = eventQ->front();
+		eventQ->pop();
+		return nextEv;
+	}
+	if(trace->hasFailed()) {
+		zOut.fatal(CALL_INFO, -1, "%s", trace->getError().c_str());
+	}
+	return NULL;
+}
+
+void ZodiacSiriusTraceReader::enqueueNextEvent() {
+	ZodiacEvent* nextEv = nextEvent();
+
+	if(nextEv) {
 		zOut.verbose(CALL_INFO,
 			8, 0, "Enqueuing next event into a self link...\n");
 
-		ZodiacEvent* nextEv = eventQ->front();
-		eventQ->pop();
 		selfLink->send(nextEv);
 	} else {
 		zOut.verbose(CALL_INFO, 2, 0, "No more events to process, Zodiac will mark component as complete.\n");
@@ -31,6 +31,8 @@
 #include <sst/elements/hermes/msgapi.h>
 
 #include "siriusreader.h"
+#include "zbinaryreader.h"
+#include "ztraceloader.h"
 #include "zevent.h"
 
 using namespace SST::Hermes;
@@ -57,7 +59,10 @@ public:
   )
 
   SST_ELI_DOCUMENT_PARAMS(
-	{ "trace", "Set the trace file to be read in for this end point." },
+	{ "trace", "Set the trace file to be read in for this end point, the prefix of the per-rank files for the sirius format." },
+	{ "format", "Format of the trace, sirius (one raw trace per rank) or binary (one indexed file written by sst-zodiac-traceconvert)", "sirius" },
+	{ "readerthreads", "Number of threads, shared by every rank in the process, reading the traces ahead of the simulation, 0 reads on the simulation thread", "0" },
+	{ "queuelimit", "Number of decoded events a rank holds ahead of the simulation", "64" },
 	{ "os.module", "Sets the messaging API to use for generation and handling of the message protocol" },
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
@@ -100,6 +105,7 @@ private:
   bool completedBarrierFunction(int val);
 
   void enqueueNextEvent();
+  ZodiacEvent* nextEvent();
 
   ////////////////////////////////////////////////////////
 
@@ -108,7 +114,9 @@ private:
   Output zOut;
   OS* os;
   MP::Interface* msgapi;
-  SiriusReader* trace;
+  ZodiacTraceSource* trace;
+  ZodiacTraceLoader* loader;
+  ZodiacTraceStream* traceStream;
   std::queue<ZodiacEvent*>* eventQ;
   SST::Link* selfLink;
   SST::TimeConverter* tConv;
@@ -129,6 +137,8 @@ private:
   MessageResponse* currentRecv;
   int rank;
   string trace_file;
+  string trace_format;
+  uint32_t queueLimit;
   int verbosityLevel;
 
   uint64_t zSendCount;
@@ -0,0 +1,168 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_TRACE_FORMAT
+#define _H_ZODIAC_TRACE_FORMAT
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include "sirius/siriusconst.h"
+
+/*
+ * Pre-converted Zodiac trace. One file holds every rank:
+ *
+ *   ZodiacTraceFileHeader
+ *   ZodiacTraceIndexEntry[numRanks]
+ *   ZodiacTraceRecord[] for each rank, at the offset its index entry gives
+ *
+ * A record is one event exactly as the Sirius reader would generate it, so
+ * compute gaps are already split out and no per-call parsing is left to do.
+ * This header has no SST dependencies so the converter can share it.
+ */
+
+#define ZODIAC_TRACE_MAGIC "ZODIACBT"
+#define ZODIAC_TRACE_VERSION 1
+
+// record type for the compute time between two calls, the others use the SIRIUS_MPI_ values
+#define ZODIAC_TRACE_COMPUTE 0
+
+struct ZodiacTraceFileHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t numRanks;
+};
+
+struct ZodiacTraceIndexEntry {
+	uint64_t offset;
+	uint64_t numRecords;
+};
+
+struct ZodiacTraceRecord {
+	uint32_t type;
+	uint32_t dtype;
+	uint32_t op;
+	int32_t  peer;
+	int32_t  tag;
+	uint32_t count;
+	uint32_t comm;
+	uint32_t pad;
+	uint64_t req;
+	double   time;
+};
+
+/*
+ * Decodes a raw Sirius trace into records. readNext() appends the records for
+ * one MPI call, a compute record first if time passed since the last call.
+ */
+class SiriusTraceParser {
+public:
+	enum Status { OK, END, BAD_CALL };
+
+	SiriusTraceParser(FILE* trace) : trace(trace), prevEventTime(0), badCall(0) {}
+
+	static ZodiacTraceRecord makeRecord(uint32_t type) {
+		ZodiacTraceRecord rec;
+		memset(&rec, 0, sizeof(rec));
+		rec.type = type;
+		return rec;
+	}
+
+	Status readNext(std::vector<ZodiacTraceRecord>& out) {
+		uint32_t call_type;
+		double callTime;
+
+		if(!read(call_type) || !read(callTime)) {
+			return END;
+		}
+
+		double evTimeDiff = callTime - prevEventTime;
+		if(evTimeDiff > 0) {
+			ZodiacTraceRecord rec = makeRecord(ZODIAC_TRACE_COMPUTE);
+			rec.time = evTimeDiff;
+			out.push_back(rec);
+		}
+
+		ZodiacTraceRecord rec = makeRecord(call_type);
+		uint64_t skip64;
+		uint32_t skip32;
+
+		switch(call_type) {
+		case SIRIUS_MPI_SEND:
+		case SIRIUS_MPI_RECV:
+		case SIRIUS_MPI_IRECV:
+			read(skip64);
+			read(rec.count);
+			read(rec.dtype);
+			read(rec.peer);
+			read(rec.tag);
+			read(rec.comm);
+			if(SIRIUS_MPI_IRECV == call_type) {
+				read(rec.req);
+			}
+			break;
+
+		case SIRIUS_MPI_ALLREDUCE:
+			read(skip64);
+			read(skip64);
+			read(rec.count);
+			read(rec.dtype);
+			read(rec.op);
+			read(rec.comm);
+			break;
+
+		case SIRIUS_MPI_BARRIER:
+			read(rec.comm);
+			break;
+
+		case SIRIUS_MPI_WAIT:
+			read(rec.req);
+			read(skip64);
+			break;
+
+		case SIRIUS_MPI_INIT:
+		case SIRIUS_MPI_FINALIZE:
+			break;
+
+		default:
+			badCall = call_type;
+			return BAD_CALL;
+		}
+		out.push_back(rec);
+
+		// the profiled MPI time and the MPI function result
+		read(prevEventTime);
+		read(skip32);
+
+		return OK;
+	}
+
+	uint32_t getBadCall() { return badCall; }
+
+private:
+	template<class T> bool read(T& value) {
+		return 1 == fread(&value, sizeof(T), 1, trace);
+	}
+
+	FILE* trace;
+	double prevEventTime;
+	uint32_t badCall;
+};
+
+#endif
@@ -0,0 +1,218 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include "ztraceloader.h"
+
+using namespace SST::Zodiac;
+
+std::mutex ZodiacTraceLoader::instanceLock;
+ZodiacTraceLoader* ZodiacTraceLoader::instance = NULL;
+int ZodiacTraceLoader::numAttached = 0;
+
+ZodiacEventRing::ZodiacEventRing(uint32_t capacity) : head(0), tail(0) {
+	size_t size = 1;
+	while(size < capacity) {
+		size <<= 1;
+	}
+	slots.resize(size);
+	mask = size - 1;
+}
+
+bool ZodiacEventRing::push(ZodiacEvent* ev) {
+	size_t t = tail.load(std::memory_order_relaxed);
+	if(t - head.load(std::memory_order_acquire) == slots.size()) {
+		return false;
+	}
+	slots[t & mask] = ev;
+	tail.store(t + 1, std::memory_order_release);
+	return true;
+}
+
+ZodiacEvent* ZodiacEventRing::pop() {
+	size_t h = head.load(std::memory_order_relaxed);
+	if(h == tail.load(std::memory_order_acquire)) {
+		return NULL;
+	}
+	ZodiacEvent* ev = slots[h & mask];
+	head.store(h + 1, std::memory_order_release);
+	return ev;
+}
+
+size_t ZodiacEventRing::size() {
+	return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+}
+
+ZodiacTraceStream::ZodiacTraceStream(ZodiacTraceLoader& loader, int group, ZodiacTraceSource* source,
+		std::queue<ZodiacEvent*>* staging, uint32_t capacity) :
+	loader(loader), group(group), source(source), staging(staging), ring(capacity), ended(false)
+{}
+
+ZodiacTraceStream::~ZodiacTraceStream() {
+	ZodiacEvent* ev;
+	while((ev = ring.pop())) {
+		delete ev;
+	}
+	while(!staging->empty()) {
+		delete staging->front();
+		staging->pop();
+	}
+	source->close();
+	delete source;
+	delete staging;
+}
+
+ZodiacEvent* ZodiacTraceStream::pop() {
+	while(true) {
+		ZodiacEvent* ev = ring.pop();
+		if(ev) {
+			if(ring.size() == ring.capacity() / 2) {
+				loader.wake(group);
+			}
+			return ev;
+		}
+
+		if(ended.load(std::memory_order_acquire)) {
+			// the loader may have pushed the last events before setting ended
+			return ring.pop();
+		}
+
+		// the simulation has caught up with the loader
+		loader.wake(group);
+		std::unique_lock<std::mutex> guard(lock);
+		cond.wait(guard, [&]{ return ring.size() > 0 || ended.load(std::memory_order_acquire); });
+	}
+}
+
+// called on the loader thread after it has pushed events or ended the trace,
+// taking the lock orders it with the consumer checking the ring before it
+// sleeps so the wakeup can't be lost
+void ZodiacTraceStream::notify() {
+	std::lock_guard<std::mutex> guard(lock);
+	cond.notify_one();
+}
+
+// called on the loader thread, returns true if any event was moved
+bool ZodiacTraceStream::fill() {
+	bool moved = false;
+	bool wasEnded = ended.load(std::memory_order_relaxed);
+
+	while(!ended.load(std::memory_order_relaxed)) {
+		if(staging->empty()) {
+			if(source->hasReachedFinalize()) {
+				ended.store(true, std::memory_order_release);
+				break;
+			}
+			source->generateNextEvents();
+			continue;
+		}
+
+		if(!ring.push(staging->front())) {
+			break;
+		}
+		staging->pop();
+		moved = true;
+	}
+
+	if(moved || wasEnded != ended.load(std::memory_order_relaxed)) {
+		notify();
+	}
+	return moved;
+}
+
+ZodiacTraceLoader* ZodiacTraceLoader::attach(int numThreads) {
+	std::lock_guard<std::mutex> guard(instanceLock);
+	if(NULL == instance) {
+		instance = new ZodiacTraceLoader(numThreads);
+	}
+	++numAttached;
+	return instance;
+}
+
+void ZodiacTraceLoader::detach() {
+	std::lock_guard<std::mutex> guard(instanceLock);
+	if(0 == --numAttached) {
+		delete instance;
+		instance = NULL;
+	}
+}
+
+ZodiacTraceLoader::ZodiacTraceLoader(int numThreads) : stop(false), numStreams(0) {
+	for(int i = 0; i < numThreads; i++) {
+		groups.push_back(new Group);
+	}
+	for(int i = 0; i < numThreads; i++) {
+		groups[i]->thread = std::thread(&ZodiacTraceLoader::readLoop, this, i);
+	}
+}
+
+ZodiacTraceLoader::~ZodiacTraceLoader() {
+	stop.store(true);
+	for(unsigned i = 0; i < groups.size(); i++) {
+		wake(i);
+		groups[i]->thread.join();
+	}
+	for(unsigned i = 0; i < groups.size(); i++) {
+		for(unsigned j = 0; j < groups[i]->streams.size(); j++) {
+			delete groups[i]->streams[j];
+		}
+		delete groups[i];
+	}
+}
+
+ZodiacTraceStream* ZodiacTraceLoader::add(ZodiacTraceSource* source, std::queue<ZodiacEvent*>* staging, uint32_t capacity) {
+	std::lock_guard<std::mutex> guard(instanceLock);
+	int group = numStreams++ % groups.size();
+
+	ZodiacTraceStream* stream = new ZodiacTraceStream(*this, group, source, staging, capacity);
+	{
+		std::lock_guard<std::mutex> groupGuard(groups[group]->lock);
+		groups[group]->streams.push_back(stream);
+	}
+	wake(group);
+	return stream;
+}
+
+void ZodiacTraceLoader::wake(int group) {
+	Group* g = groups[group];
+	std::lock_guard<std::mutex> guard(g->lock);
+	g->wakeup = true;
+	g->cond.notify_one();
+}
+
+void ZodiacTraceLoader::readLoop(int group) {
+	Group* g = groups[group];
+	std::vector<ZodiacTraceStream*> streams;
+
+	while(!stop.load()) {
+		{
+			std::lock_guard<std::mutex> guard(g->lock);
+			g->wakeup = false;
+			streams = g->streams;
+		}
+
+		bool moved = false;
+		for(unsigned i = 0; i < streams.size(); i++) {
+			moved |= streams[i]->fill();
+		}
+
+		if(!moved) {
+			std::unique_lock<std::mutex> guard(g->lock);
+			g->cond.wait_for(guard, std::chrono::milliseconds(1), [&]{ return g->wakeup || stop.load(); });
+		}
+	}
+}
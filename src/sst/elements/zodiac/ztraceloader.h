@@ -0,0 +1,135 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_TRACE_LOADER
+#define _H_ZODIAC_TRACE_LOADER
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "ztracesource.h"
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * Single producer, single consumer ring of decoded events. The loader thread
+ * owning the rank pushes, the rank's component pops, neither takes a lock.
+ */
+class ZodiacEventRing {
+    public:
+	ZodiacEventRing(uint32_t capacity);
+
+	bool push(ZodiacEvent* ev);
+	ZodiacEvent* pop();
+	size_t size();
+	size_t capacity() { return mask + 1; }
+
+    private:
+	std::vector<ZodiacEvent*> slots;
+	size_t mask;
+	std::atomic<size_t> head;
+	std::atomic<size_t> tail;
+};
+
+class ZodiacTraceLoader;
+
+/*
+ * A rank's trace being read ahead. The source and the queue it fills are only
+ * touched by the loader thread once the stream has been added.
+ */
+class ZodiacTraceStream {
+    public:
+	// next event of the trace, NULL once the trace has ended, waits for the
+	// loader when it has not caught up
+	ZodiacEvent* pop();
+	bool hasEnded() { return ended.load(std::memory_order_acquire) && 0 == ring.size(); }
+	// the loader is done with the source once the trace has ended
+	bool hasFailed() { return ended.load(std::memory_order_acquire) && source->hasFailed(); }
+	const std::string& getError() { return source->getError(); }
+
+    private:
+	friend class ZodiacTraceLoader;
+
+	ZodiacTraceStream(ZodiacTraceLoader& loader, int group, ZodiacTraceSource* source,
+		std::queue<ZodiacEvent*>* staging, uint32_t capacity);
+	~ZodiacTraceStream();
+	bool fill();
+	void notify();
+
+	ZodiacTraceLoader& loader;
+	int group;
+	ZodiacTraceSource* source;
+	std::queue<ZodiacEvent*>* staging;
+	ZodiacEventRing ring;
+	std::atomic<bool> ended;
+	// the consumer sleeps on this while the ring is empty
+	std::mutex lock;
+	std::condition_variable cond;
+};
+
+/*
+ * Reads traces ahead of the simulation on a fixed number of threads shared by
+ * every rank in the process. Ranks are dealt to the threads in the order they
+ * are added and a thread keeps the rings of its ranks topped up, sleeping
+ * while they are full.
+ */
+class ZodiacTraceLoader {
+    public:
+	// the first component to attach sets the number of threads
+	static ZodiacTraceLoader* attach(int numThreads);
+	void detach();
+
+	// takes ownership of source and staging
+	ZodiacTraceStream* add(ZodiacTraceSource* source, std::queue<ZodiacEvent*>* staging, uint32_t capacity);
+
+    private:
+	friend class ZodiacTraceStream;
+
+	struct Group {
+		Group() : wakeup(false) {}
+		std::mutex lock;
+		std::condition_variable cond;
+		bool wakeup;
+		std::vector<ZodiacTraceStream*> streams;
+		std::thread thread;
+	};
+
+	ZodiacTraceLoader(int numThreads);
+	~ZodiacTraceLoader();
+
+	void wake(int group);
+	void readLoop(int group);
+
+	std::vector<Group*> groups;
+	std::atomic<bool> stop;
+	uint32_t numStreams;
+
+	static std::mutex instanceLock;
+	static ZodiacTraceLoader* instance;
+	static int numAttached;
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,135 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include <sst_config.h>
+
+#include <stdarg.h>
+
+#include "ztracesource.h"
+
+using namespace SST::Zodiac;
+
+void ZodiacTraceSource::pushEvent(const ZodiacTraceRecord& rec) {
+	ZodiacEvent* ev = NULL;
+
+	switch(rec.type) {
+	case ZODIAC_TRACE_COMPUTE:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Generated a compute event (length=%f)\n", rec.time);
+		ev = new ZodiacComputeEvent(rec.time);
+		break;
+
+	case SIRIUS_MPI_SEND:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Send\n");
+		ev = new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm);
+		break;
+
+	case SIRIUS_MPI_RECV:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Recv\n");
+		ev = new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm);
+		break;
+
+	case SIRIUS_MPI_IRECV:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Irecv\n");
+		ev = new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm, rec.req);
+		break;
+
+	case SIRIUS_MPI_ALLREDUCE: {
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Allreduce\n");
+		ReductionOperation op;
+		if(!convertToHermesOp(rec.op, op)) {
+			fail("Unknown MPI operation (%" PRIu32 "), cannot convert to Hermes\n", rec.op);
+			return;
+		}
+		ev = new ZodiacAllreduceEvent(rec.count,
+			convertToHermesType(rec.dtype), op, rec.comm);
+		break;
+	}
+
+	case SIRIUS_MPI_BARRIER:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Barrier\n");
+		ev = new ZodiacBarrierEvent(rec.comm);
+		break;
+
+	case SIRIUS_MPI_WAIT:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Wait\n");
+		ev = new ZodiacWaitEvent(rec.req);
+		break;
+
+	case SIRIUS_MPI_INIT:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Init\n");
+		ev = new ZodiacInitEvent();
+		break;
+
+	case SIRIUS_MPI_FINALIZE:
+		output->verbose(__LINE__, __FILE__, "pushEvent", 8, 0, "Read an MPI_Finalize\n");
+		ev = new ZodiacFinalizeEvent();
+		foundFinalize = true;
+		break;
+
+	default:
+		fail("Unknown event type in trace (%" PRIu32 ")\n", rec.type);
+		return;
+	}
+
+	eventQ->push(ev);
+}
+
+// ends the trace, the events queued so far are still delivered
+void ZodiacTraceSource::fail(const char* format, ...) {
+	char msg[512];
+	va_list args;
+	va_start(args, format);
+	vsnprintf(msg, sizeof(msg), format, args);
+	va_end(args);
+
+	if(error.empty()) {
+		error = msg;
+	}
+	foundFinalize = true;
+}
+
+PayloadDataType ZodiacTraceSource::convertToHermesType(uint32_t dtype) {
+	PayloadDataType hType = CHAR;
+
+	if(dtype == SIRIUS_MPI_INTEGER) {
+		hType = INT;
+	} else if(dtype == SIRIUS_MPI_DOUBLE) {
+		hType = DOUBLE;
+	}
+
+	return hType;
+}
+
+bool ZodiacTraceSource::convertToHermesOp(uint32_t op, ReductionOperation& h_op) {
+	switch(op) {
+	case SIRIUS_MPI_SUM:
+		h_op = SUM;
+		break;
+	case SIRIUS_MPI_MAX:
+		h_op = MAX;
+		break;
+	case SIRIUS_MPI_MIN:
+		h_op = MIN;
+		break;
+	default:
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,86 @@
+// Copyright 2009-2024 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2024, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// of the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_TRACE_SOURCE
+#define _H_ZODIAC_TRACE_SOURCE
+
+#include <stdint.h>
+
+#include <queue>
+#include <string>
+
+#include "sst/core/output.h"
+#include "sst/elements/hermes/msgapi.h"
+
+#include "ztraceformat.h"
+
+#include "zevent.h"
+#include "zinitevent.h"
+#include "zsendevent.h"
+#include "zirecvevent.h"
+#include "zrecvevent.h"
+#include "zbarrierevent.h"
+#include "zcomputeevent.h"
+#include "zwaitevent.h"
+#include "zfinalizeevent.h"
+#include "zallredevent.h"
+
+using namespace SST::Hermes;
+using namespace SST::Hermes::MP;
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * A rank's trace. generateNextEvents() fills the queue given at construction
+ * up to its limit, it is called from the simulation thread or, when the trace
+ * is read ahead, from a ZodiacTraceLoader thread. A source never stops the
+ * simulation itself: a read error ends the trace and is kept for the
+ * component to report with fatal() on the simulation thread.
+ */
+class ZodiacTraceSource {
+    public:
+	ZodiacTraceSource(uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue) :
+		output(NULL), qLimit(qLimit), foundFinalize(false), eventQ(eventQueue) {}
+	virtual ~ZodiacTraceSource() {}
+
+	virtual void close() = 0;
+	virtual uint32_t generateNextEvents() = 0;
+
+	uint32_t getQueueLimit() { return qLimit; }
+	uint32_t getCurrentQueueSize() { return eventQ->size(); }
+	bool hasReachedFinalize() { return foundFinalize; }
+	bool hasFailed() { return ! error.empty(); }
+	const std::string& getError() { return error; }
+
+	static PayloadDataType convertToHermesType(uint32_t dtype);
+	static bool convertToHermesOp(uint32_t op, ReductionOperation& h_op);
+
+    protected:
+	void pushEvent(const ZodiacTraceRecord& rec);
+	void fail(const char* format, ...);
+
+	Output* output;
+	uint32_t qLimit;
+	bool foundFinalize;
+	std::queue<ZodiacEvent*>* eventQ;
+	std::string error;
+};
+
+}
+}
+
+#endif